@@ -24,7 +24,42 @@
 #ifndef IGRAPH_BENCH_H
 #define IGRAPH_BENCH_H
 
+/*
+ * Benchmark harness.
+ *
+ * BENCH_REPEAT(NAME, CODE) runs CODE several times and reports the
+ * median, mean, standard deviation and minimum of the wall-clock time,
+ * the median CPU time, the peak memory allocated through igraph_malloc()
+ * and friends during a single run (memory allocated by C++ code with
+ * new is not included), and the maximum resident set size of the
+ * process. CODE must be repeatable, i.e. it must release everything it
+ * allocates.
+ *
+ * BENCH(NAME, CODE) is the same, but it runs CODE only once.
+ *
+ * igraph_bench_init() must be called at the start of main(); it reads
+ * the configuration and seeds the random number generator.
+ *
+ * The harness is configured with environment variables:
+ *
+ *   IGRAPH_BENCH_REPS    number of repetitions (default: 5)
+ *   IGRAPH_BENCH_SCALE   size of the graphs: small, medium or large
+ *                        (default: medium), see bench_graphs.h
+ *   IGRAPH_BENCH_FORMAT  text (default) or json; in JSON mode each
+ *                        result is a JSON object on a line of its own
+ *   IGRAPH_BENCH_FILTER  only run benchmarks whose name contains this
+ *                        string
+ */
+
+#include <igraph.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <sys/resource.h>
+#include <sys/time.h>
 
 static inline void igraph_get_cpu_time(igraph_real_t *data) {
 
@@ -32,24 +67,159 @@ static inline void igraph_get_cpu_time(igraph_real_t *data) {
     getrusage(RUSAGE_SELF, &self);
     getrusage(RUSAGE_CHILDREN, &children);
     data[0] = (double) self.ru_utime.tv_sec +
-              1e-3 * (self.ru_utime.tv_usec / 1000);
+              1e-6 * self.ru_utime.tv_usec;
     data[1] = (double) self.ru_stime.tv_sec +
-              1e-3 * (self.ru_stime.tv_usec / 1000);
+              1e-6 * self.ru_stime.tv_usec;
     data[2] = (double) children.ru_utime.tv_sec +
-              1e-3 * (children.ru_utime.tv_usec / 1000);
+              1e-6 * children.ru_utime.tv_usec;
     data[3] = (double) children.ru_stime.tv_sec +
-              1e-3 * (children.ru_stime.tv_usec / 1000);
+              1e-6 * children.ru_stime.tv_usec;
 }
 
-#define BENCH(NAME, ...)    do {                                                         \
-        double start[4], stop[4];                                                                \
-        igraph_get_cpu_time(start);                                                          \
-        { __VA_ARGS__; };                                                                                \
-        igraph_get_cpu_time(stop);                                                           \
-        printf("%s %.3gs\n", NAME,                                                           \
-               stop[0]+stop[1]+stop[2]+stop[3] -                               \
-               start[0]-start[1]-start[2]-start[3]);                       \
-    } while (0)
+static inline double igraph_get_wall_time(void) {
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + 1e-6 * tv.tv_usec;
+#endif
+}
 
+static inline double igraph_get_max_rss(void) {
+    struct rusage self;
+    getrusage(RUSAGE_SELF, &self);
+#if defined(__APPLE__)
+    return (double) self.ru_maxrss;           /* bytes */
+#else
+    return 1024.0 * self.ru_maxrss;           /* kilobytes */
 #endif
+}
+
+#define IGRAPH_BENCH_MAX_REPS 1000
+
+typedef struct {
+    int reps;
+    int scale;
+    int json;
+    const char *filter;
+    const char *program;
+} igraph_bench_config_t;
+
+static igraph_bench_config_t igraph_bench_config = { 0, 1, 0, 0, "" };
+
+/* Call once at the start of main() */
+static inline void igraph_bench_init(const char *program) {
+    const char *reps = getenv("IGRAPH_BENCH_REPS");
+    const char *scale = getenv("IGRAPH_BENCH_SCALE");
+    const char *format = getenv("IGRAPH_BENCH_FORMAT");
+
+    igraph_bench_config.program = program;
+    igraph_bench_config.reps = reps ? atoi(reps) : 5;
+    if (igraph_bench_config.reps < 1) {
+        igraph_bench_config.reps = 1;
+    } else if (igraph_bench_config.reps > IGRAPH_BENCH_MAX_REPS) {
+        igraph_bench_config.reps = IGRAPH_BENCH_MAX_REPS;
+    }
+    if (scale && !strcmp(scale, "small")) {
+        igraph_bench_config.scale = 0;
+    } else if (scale && !strcmp(scale, "large")) {
+        igraph_bench_config.scale = 2;
+    } else {
+        igraph_bench_config.scale = 1;
+    }
+    igraph_bench_config.json = format && !strcmp(format, "json");
+    igraph_bench_config.filter = getenv("IGRAPH_BENCH_FILTER");
+
+    /* Benchmarks must be reproducible */
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_set_memory_accounting(1);
+    igraph_set_warning_handler(igraph_warning_handler_ignore);
+}
 
+static inline igraph_bool_t igraph_bench_selected(const char *name) {
+    return !igraph_bench_config.filter ||
+           strstr(name, igraph_bench_config.filter) != 0;
+}
+
+static int igraph_i_bench_cmp(const void *a, const void *b) {
+    double da = *(const double*) a, db = *(const double*) b;
+    return da < db ? -1 : (da > db ? 1 : 0);
+}
+
+/* Sorts the samples */
+static inline double igraph_i_bench_median(double *x, int n) {
+    qsort(x, (size_t) n, sizeof(double), igraph_i_bench_cmp);
+    return n % 2 ? x[n / 2] : (x[n / 2 - 1] + x[n / 2]) / 2.0;
+}
+
+static inline void igraph_bench_report(const char *name, double *wall,
+                                       double *cpu, int reps,
+                                       double peak_bytes) {
+    double mean = 0.0, var = 0.0, median, cpu_median;
+    int i;
+
+    for (i = 0; i < reps; i++) {
+        mean += wall[i];
+    }
+    mean /= reps;
+    for (i = 0; i < reps; i++) {
+        var += (wall[i] - mean) * (wall[i] - mean);
+    }
+    var = reps > 1 ? var / (reps - 1) : 0.0;
+    median = igraph_i_bench_median(wall, reps);
+    cpu_median = igraph_i_bench_median(cpu, reps);
+
+    if (igraph_bench_config.json) {
+        printf("{\"program\": \"%s\", \"name\": \"%s\", \"reps\": %d, "
+               "\"wall_median\": %.6g, \"wall_mean\": %.6g, "
+               "\"wall_stddev\": %.6g, \"wall_min\": %.6g, "
+               "\"cpu_median\": %.6g, \"peak_bytes\": %.0f, "
+               "\"max_rss_bytes\": %.0f}\n",
+               igraph_bench_config.program, name, reps, median, mean,
+               sqrt(var), wall[0], cpu_median, peak_bytes,
+               igraph_get_max_rss());
+    } else {
+        printf("%-40s %9.4fs  (mean %.4fs, sd %.4fs, min %.4fs, cpu %.4fs, "
+               "peak %.1f MB)\n", name, median, mean, sqrt(var), wall[0],
+               cpu_median, peak_bytes / 1048576.0);
+    }
+    fflush(stdout);
+}
+
+#define IGRAPH_I_BENCH(NAME, REPS, ...)    do {                                 \
+        const char *bench_name = (NAME);                                        \
+        if (igraph_bench_selected(bench_name)) {                                \
+            double bench_wall[IGRAPH_BENCH_MAX_REPS];                           \
+            double bench_cpu[IGRAPH_BENCH_MAX_REPS];                            \
+            double bench_peak = 0.0;                                            \
+            int bench_rep;                                                      \
+            int bench_reps = (REPS);                                            \
+            for (bench_rep = 0; bench_rep < bench_reps; bench_rep++) {          \
+                double start[4], stop[4], wstart;                               \
+                size_t current, peak;                                           \
+                igraph_memory_reset_peak();                                     \
+                igraph_memory_usage(&current, 0);                               \
+                igraph_get_cpu_time(start);                                     \
+                wstart = igraph_get_wall_time();                                \
+                { __VA_ARGS__; };                                               \
+                bench_wall[bench_rep] = igraph_get_wall_time() - wstart;        \
+                igraph_get_cpu_time(stop);                                      \
+                bench_cpu[bench_rep] = stop[0] + stop[1] + stop[2] + stop[3] -  \
+                                       start[0] - start[1] - start[2] - start[3]; \
+                igraph_memory_usage(0, &peak);                                  \
+                if (peak - current > bench_peak) {                              \
+                    bench_peak = (double) (peak - current);                     \
+                }                                                               \
+            }                                                                   \
+            igraph_bench_report(bench_name, bench_wall, bench_cpu,              \
+                                bench_reps, bench_peak);                        \
+        }                                                                       \
+    } while (0)
+
+#define BENCH(NAME, ...)           IGRAPH_I_BENCH(NAME, 1, __VA_ARGS__)
+#define BENCH_REPEAT(NAME, ...)    IGRAPH_I_BENCH(NAME, igraph_bench_config.reps, __VA_ARGS__)
+
+#endif
@@ -0,0 +1,178 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef IGRAPH_BENCH_GRAPHS_H
+#define IGRAPH_BENCH_GRAPHS_H
+
+/*
+ * The standard benchmark corpus.
+ *
+ * Each graph is generated from a fixed random seed, so the same graph
+ * is obtained on every run and every machine (for a given version of
+ * igraph), no matter which other graphs were generated before it.
+ * All graphs are undirected and have about five edges per vertex,
+ * except for the grid and road-like graphs, which have two and three.
+ *
+ *   er     Erdos-Renyi G(n, m) random graph
+ *   ba     Barabasi-Albert preferential attachment graph
+ *   sbm    stochastic block model with 10 equal blocks
+ *   grid   two-dimensional square lattice
+ *   road   random geometric graph in the unit square, with Euclidean
+ *          edge lengths as weights; planar-like, low degree, large
+ *          diameter
+ *
+ * The number of vertices is the base size given by the benchmark,
+ * multiplied by 1, 10 or 100 for the small, medium and large scale.
+ */
+
+#include "bench.h"
+
+#ifndef M_PI
+#  define M_PI 3.14159265358979323846
+#endif
+
+typedef enum {
+    IGRAPH_BENCH_ER = 0,
+    IGRAPH_BENCH_BA,
+    IGRAPH_BENCH_SBM,
+    IGRAPH_BENCH_GRID,
+    IGRAPH_BENCH_ROAD,
+    IGRAPH_BENCH_NUM_GRAPHS
+} igraph_bench_graph_t;
+
+static const char *igraph_bench_graph_names[] = {
+    "er", "ba", "sbm", "grid", "road"
+};
+
+static inline igraph_integer_t igraph_bench_size(igraph_integer_t base) {
+    int i;
+    for (i = 0; i < igraph_bench_config.scale; i++) {
+        base *= 10;
+    }
+    return base;
+}
+
+/* Creates a graph of the corpus with about n vertices. If weights is
+   not a null pointer, it is initialized to edge weights: Euclidean
+   lengths for the road-like graph, uniform random integers between 1
+   and 100 for the others. The name of the graph is written to name. */
+static inline int igraph_bench_graph(igraph_t *graph,
+                                     igraph_bench_graph_t type,
+                                     igraph_integer_t n,
+                                     igraph_vector_t *weights,
+                                     char *name, size_t name_size) {
+    igraph_vector_t x, y;
+    long int i, ecount;
+
+    igraph_rng_seed(igraph_rng_default(), 1000 + type);
+
+    switch (type) {
+    case IGRAPH_BENCH_ER:
+        IGRAPH_CHECK(igraph_erdos_renyi_game(graph, IGRAPH_ERDOS_RENYI_GNM,
+                                             n, 5.0 * n, IGRAPH_UNDIRECTED,
+                                             IGRAPH_NO_LOOPS));
+        break;
+    case IGRAPH_BENCH_BA:
+        IGRAPH_CHECK(igraph_barabasi_game(graph, n, /*power=*/ 1, /*m=*/ 5,
+                                          /*outseq=*/ 0, /*outpref=*/ 0,
+                                          /*A=*/ 1, IGRAPH_UNDIRECTED,
+                                          IGRAPH_BARABASI_PSUMTREE,
+                                          /*start_from=*/ 0));
+        break;
+    case IGRAPH_BENCH_SBM: {
+        igraph_matrix_t pref;
+        igraph_vector_int_t sizes;
+        long int blocks = 10, j;
+        /* 8 of the expected 10 neighbors are in the same block */
+        double p_in = 8.0 / (n / blocks), p_out = 2.0 / (n - n / blocks);
+        IGRAPH_CHECK(igraph_matrix_init(&pref, blocks, blocks));
+        IGRAPH_FINALLY(igraph_matrix_destroy, &pref);
+        IGRAPH_CHECK(igraph_vector_int_init(&sizes, blocks));
+        IGRAPH_FINALLY(igraph_vector_int_destroy, &sizes);
+        for (i = 0; i < blocks; i++) {
+            for (j = 0; j < blocks; j++) {
+                MATRIX(pref, i, j) = i == j ? p_in : p_out;
+            }
+            VECTOR(sizes)[i] = n / blocks + (i < n % blocks ? 1 : 0);
+        }
+        IGRAPH_CHECK(igraph_sbm_game(graph, n, &pref, &sizes,
+                                     IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS));
+        igraph_vector_int_destroy(&sizes);
+        igraph_matrix_destroy(&pref);
+        IGRAPH_FINALLY_CLEAN(2);
+        break;
+    }
+    case IGRAPH_BENCH_GRID: {
+        igraph_vector_t dim;
+        igraph_real_t side = ceil(sqrt((double) n));
+        IGRAPH_CHECK(igraph_vector_init(&dim, 2));
+        IGRAPH_FINALLY(igraph_vector_destroy, &dim);
+        VECTOR(dim)[0] = VECTOR(dim)[1] = side;
+        IGRAPH_CHECK(igraph_lattice(graph, &dim, /*nei=*/ 1,
+                                    IGRAPH_UNDIRECTED, /*mutual=*/ 0,
+                                    /*circular=*/ 0));
+        igraph_vector_destroy(&dim);
+        IGRAPH_FINALLY_CLEAN(1);
+        break;
+    }
+    case IGRAPH_BENCH_ROAD:
+        /* An expected degree of 6, just above the percolation threshold,
+           so there is a giant component with a large diameter */
+        IGRAPH_VECTOR_INIT_FINALLY(&x, 0);
+        IGRAPH_VECTOR_INIT_FINALLY(&y, 0);
+        IGRAPH_CHECK(igraph_grg_game(graph, n, sqrt(6.0 / (M_PI * n)),
+                                     /*torus=*/ 0, &x, &y));
+        if (weights) {
+            igraph_integer_t from, to;
+            ecount = igraph_ecount(graph);
+            IGRAPH_CHECK(igraph_vector_init(weights, ecount));
+            for (i = 0; i < ecount; i++) {
+                igraph_edge(graph, (igraph_integer_t) i, &from, &to);
+                VECTOR(*weights)[i] =
+                    hypot(VECTOR(x)[from] - VECTOR(x)[to],
+                          VECTOR(y)[from] - VECTOR(y)[to]);
+            }
+            weights = 0;
+        }
+        igraph_vector_destroy(&y);
+        igraph_vector_destroy(&x);
+        IGRAPH_FINALLY_CLEAN(2);
+        break;
+    default:
+        IGRAPH_ERROR("Unknown benchmark graph", IGRAPH_EINVAL);
+    }
+
+    if (weights) {
+        ecount = igraph_ecount(graph);
+        IGRAPH_CHECK(igraph_vector_init(weights, ecount));
+        for (i = 0; i < ecount; i++) {
+            VECTOR(*weights)[i] = RNG_INTEGER(1, 100);
+        }
+    }
+
+    snprintf(name, name_size, "%s-%ld", igraph_bench_graph_names[type],
+             (long int) igraph_vcount(graph));
+
+    return 0;
+}
+
+#endif
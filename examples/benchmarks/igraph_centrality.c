@@ -0,0 +1,108 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+int main() {
+    igraph_t g;
+    igraph_vector_t weights, res;
+    igraph_arpack_options_t options;
+    char gname[64], name[128];
+    int type;
+
+    igraph_bench_init("centrality");
+    igraph_vector_init(&res, 0);
+    igraph_arpack_options_init(&options);
+
+    /* Quadratic algorithms */
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(100), &weights,
+                           gname, sizeof(gname));
+
+        snprintf(name, sizeof(name), "betweenness %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_betweenness(&g, &res, igraph_vss_all(),
+                                        IGRAPH_UNDIRECTED, 0, 1);
+                    );
+
+        snprintf(name, sizeof(name), "betweenness weighted %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_betweenness(&g, &res, igraph_vss_all(),
+                                        IGRAPH_UNDIRECTED, &weights, 1);
+                    );
+
+        snprintf(name, sizeof(name), "edge betweenness %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_edge_betweenness(&g, &res, IGRAPH_UNDIRECTED, 0);
+                    );
+
+        snprintf(name, sizeof(name), "closeness %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_closeness(&g, &res, igraph_vss_all(), IGRAPH_ALL,
+                                      0, 1);
+                    );
+
+        igraph_vector_destroy(&weights);
+        igraph_destroy(&g);
+    }
+
+    /* Linear or nearly linear algorithms */
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(1000), &weights,
+                           gname, sizeof(gname));
+
+        snprintf(name, sizeof(name), "pagerank prpack %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_pagerank(&g, IGRAPH_PAGERANK_ALGO_PRPACK, &res, 0,
+                                     igraph_vss_all(), IGRAPH_UNDIRECTED,
+                                     0.85, 0, 0);
+                    );
+
+        snprintf(name, sizeof(name), "pagerank arpack %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_pagerank(&g, IGRAPH_PAGERANK_ALGO_ARPACK, &res, 0,
+                                     igraph_vss_all(), IGRAPH_UNDIRECTED,
+                                     0.85, 0, &options);
+                    );
+
+        snprintf(name, sizeof(name), "eigenvector centrality %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_eigenvector_centrality(&g, &res, 0,
+                             IGRAPH_UNDIRECTED, 1, 0, &options);
+                    );
+
+        snprintf(name, sizeof(name), "local transitivity %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_transitivity_local_undirected(&g, &res,
+                             igraph_vss_all(), IGRAPH_TRANSITIVITY_ZERO);
+                    );
+
+        igraph_vector_destroy(&weights);
+        igraph_destroy(&g);
+    }
+
+    igraph_vector_destroy(&res);
+
+    return 0;
+}
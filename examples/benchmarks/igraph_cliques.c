@@ -8,7 +8,7 @@ int main() {
     igraph_vector_ptr_t res;
     igraph_integer_t i, n;
 
-    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_bench_init("cliques");
 
     igraph_erdos_renyi_game(&g, IGRAPH_ERDOS_RENYI_GNM, 100, 3000, /* directed = */ 0, /* loops= */ 0);
 
@@ -7,7 +7,7 @@ int main() {
     igraph_t g;
     igraph_vector_int_t colors;
 
-    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_bench_init("coloring");
 
     igraph_erdos_renyi_game(&g, IGRAPH_ERDOS_RENYI_GNM, 30000, 300000, /* directed = */ 0, /* loops = */ 0);
 
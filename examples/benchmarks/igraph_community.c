@@ -0,0 +1,93 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+int main() {
+    igraph_t g;
+    igraph_vector_t weights, membership, modularity;
+    igraph_matrix_t merges;
+    char gname[64], name[128];
+    int type;
+
+    igraph_bench_init("community");
+    igraph_vector_init(&membership, 0);
+    igraph_vector_init(&modularity, 0);
+    igraph_matrix_init(&merges, 0, 0);
+
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(1000), &weights,
+                           gname, sizeof(gname));
+
+        snprintf(name, sizeof(name), "multilevel %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_community_multilevel(&g, &weights, &membership,
+                             0, 0);
+                    );
+
+        snprintf(name, sizeof(name), "leiden %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_integer_t nb_clusters;
+                     igraph_community_leiden(&g, &weights, 0,
+                                             1.0 / (2 * igraph_ecount(&g)),
+                                             0.01, 0, &membership,
+                                             &nb_clusters, 0);
+                    );
+
+        snprintf(name, sizeof(name), "label propagation %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_community_label_propagation(&g, &membership,
+                             &weights, 0, 0, 0);
+                    );
+
+        snprintf(name, sizeof(name), "fastgreedy %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_community_fastgreedy(&g, &weights, &merges,
+                             &modularity, 0);
+                    );
+
+        igraph_vector_destroy(&weights);
+        igraph_destroy(&g);
+    }
+
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(100), &weights,
+                           gname, sizeof(gname));
+
+        snprintf(name, sizeof(name), "walktrap %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_community_walktrap(&g, &weights, 4, &merges,
+                             &modularity, 0);
+                    );
+
+        igraph_vector_destroy(&weights);
+        igraph_destroy(&g);
+    }
+
+    igraph_matrix_destroy(&merges);
+    igraph_vector_destroy(&modularity);
+    igraph_vector_destroy(&membership);
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+int main() {
+    igraph_t g;
+    igraph_vector_t membership, csize, points;
+    igraph_vector_ptr_t components;
+    char gname[64], name[128];
+    int type;
+
+    igraph_bench_init("components");
+    igraph_vector_init(&membership, 0);
+    igraph_vector_init(&csize, 0);
+    igraph_vector_init(&points, 0);
+    igraph_vector_ptr_init(&components, 0);
+
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(10000), 0,
+                           gname, sizeof(gname));
+
+        snprintf(name, sizeof(name), "weak components %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_integer_t no;
+                     igraph_clusters(&g, &membership, &csize, &no, IGRAPH_WEAK);
+                    );
+
+        snprintf(name, sizeof(name), "biconnected components %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_integer_t no;
+                     igraph_biconnected_components(&g, &no, 0, 0, 0, &points);
+                    );
+
+        snprintf(name, sizeof(name), "articulation points %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_articulation_points(&g, &points);
+                    );
+
+        snprintf(name, sizeof(name), "decompose %s", gname);
+        BENCH_REPEAT(name,
+                     long int i;
+                     igraph_decompose(&g, &components, IGRAPH_WEAK, -1, 2);
+                     for (i = 0; i < igraph_vector_ptr_size(&components); i++) {
+                         igraph_destroy(VECTOR(components)[i]);
+                         igraph_free(VECTOR(components)[i]);
+                     }
+                     igraph_vector_ptr_clear(&components);
+                    );
+
+        igraph_destroy(&g);
+    }
+
+    /* Directed graphs for strongly connected components */
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_t d;
+        igraph_bench_graph(&g, type, igraph_bench_size(10000), 0,
+                           gname, sizeof(gname));
+        igraph_copy(&d, &g);
+        igraph_to_directed(&d, IGRAPH_TO_DIRECTED_ARBITRARY);
+
+        snprintf(name, sizeof(name), "strong components %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_integer_t no;
+                     igraph_clusters(&d, &membership, &csize, &no, IGRAPH_STRONG);
+                    );
+
+        igraph_destroy(&d);
+        igraph_destroy(&g);
+    }
+
+    igraph_vector_ptr_destroy(&components);
+    igraph_vector_destroy(&points);
+    igraph_vector_destroy(&csize);
+    igraph_vector_destroy(&membership);
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+int main() {
+    igraph_t g;
+    igraph_vector_t capacity;
+    char gname[64], name[128];
+    int type;
+
+    igraph_bench_init("flow");
+
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_integer_t source, target;
+        igraph_bench_graph(&g, type, igraph_bench_size(1000), &capacity,
+                           gname, sizeof(gname));
+        /* Two vertices far from each other in the grid, arbitrary
+           ones in the others */
+        source = 0;
+        target = igraph_vcount(&g) - 1;
+
+        snprintf(name, sizeof(name), "maxflow %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_real_t value;
+                     igraph_maxflow_value(&g, &value, source, target,
+                                          &capacity, 0);
+                    );
+
+        snprintf(name, sizeof(name), "st edge connectivity %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_integer_t conn;
+                     igraph_st_edge_connectivity(&g, &conn, source, target);
+                    );
+
+        igraph_vector_destroy(&capacity);
+        igraph_destroy(&g);
+    }
+
+    /* Global minimum cut is much more expensive */
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(100), &capacity,
+                           gname, sizeof(gname));
+
+        snprintf(name, sizeof(name), "mincut %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_real_t value;
+                     igraph_mincut_value(&g, &value, &capacity);
+                    );
+
+        snprintf(name, sizeof(name), "edge connectivity %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_integer_t conn;
+                     igraph_edge_connectivity(&g, &conn, 0);
+                    );
+
+        igraph_vector_destroy(&capacity);
+        igraph_destroy(&g);
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+/* Writes the graph to a temporary file and reads it back */
+#define BENCH_FORMAT(FORMAT, WRITE, READ) do {                           \
+        FILE *file = tmpfile();                                         \
+        igraph_t g2;                                                    \
+        WRITE;                                                          \
+        snprintf(name, sizeof(name), "write %s %s", FORMAT, gname);     \
+        BENCH_REPEAT(name, rewind(file); WRITE; fflush(file););         \
+        snprintf(name, sizeof(name), "read %s %s", FORMAT, gname);      \
+        BENCH_REPEAT(name, rewind(file); READ; igraph_destroy(&g2););   \
+        fclose(file);                                                   \
+    } while (0)
+
+int main() {
+    igraph_t g;
+    char gname[64], name[128];
+    int type;
+
+    igraph_bench_init("io");
+
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(10000), 0,
+                           gname, sizeof(gname));
+
+        BENCH_FORMAT("edgelist",
+                     igraph_write_graph_edgelist(&g, file),
+                     igraph_read_graph_edgelist(&g2, file, 0,
+                             IGRAPH_UNDIRECTED));
+
+        BENCH_FORMAT("ncol",
+                     igraph_write_graph_ncol(&g, file, 0, 0),
+                     igraph_read_graph_ncol(&g2, file, 0, 0,
+                                            IGRAPH_ADD_WEIGHTS_NO,
+                                            IGRAPH_UNDIRECTED));
+
+        BENCH_FORMAT("lgl",
+                     igraph_write_graph_lgl(&g, file, 0, 0, 1),
+                     igraph_read_graph_lgl(&g2, file, 0,
+                                           IGRAPH_ADD_WEIGHTS_NO,
+                                           IGRAPH_UNDIRECTED));
+
+        BENCH_FORMAT("pajek",
+                     igraph_write_graph_pajek(&g, file),
+                     igraph_read_graph_pajek(&g2, file));
+
+        BENCH_FORMAT("gml",
+                     igraph_write_graph_gml(&g, file, 0, 0),
+                     igraph_read_graph_gml(&g2, file));
+
+        igraph_destroy(&g);
+    }
+
+    return 0;
+}
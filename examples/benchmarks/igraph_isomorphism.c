@@ -0,0 +1,89 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+int main() {
+    igraph_t g, perm;
+    igraph_vector_t permutation, labeling;
+    char gname[64], name[128];
+    int type;
+
+    igraph_bench_init("isomorphism");
+    igraph_vector_init(&permutation, 0);
+    igraph_vector_init(&labeling, 0);
+
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(1000), 0,
+                           gname, sizeof(gname));
+        igraph_vector_init_seq(&permutation, 0, igraph_vcount(&g) - 1);
+        igraph_vector_shuffle(&permutation);
+        igraph_permute_vertices(&g, &perm, &permutation);
+
+        snprintf(name, sizeof(name), "canonical permutation %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_canonical_permutation(&g, 0, &labeling,
+                             IGRAPH_BLISS_FL, 0);
+                    );
+
+        snprintf(name, sizeof(name), "isomorphic bliss %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_bool_t iso;
+                     igraph_isomorphic_bliss(&g, &perm, 0, 0, &iso, 0, 0,
+                                             IGRAPH_BLISS_FL, 0, 0);
+                    );
+
+        igraph_destroy(&perm);
+        igraph_vector_destroy(&permutation);
+        igraph_destroy(&g);
+    }
+
+    /* VF2 takes exponential time on graphs with many symmetries, such
+       as the grid or the many leaves of the BA graph */
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        if (type != IGRAPH_BENCH_ER && type != IGRAPH_BENCH_SBM) {
+            continue;
+        }
+        igraph_bench_graph(&g, type, igraph_bench_size(100), 0,
+                           gname, sizeof(gname));
+        igraph_vector_init_seq(&permutation, 0, igraph_vcount(&g) - 1);
+        igraph_vector_shuffle(&permutation);
+        igraph_permute_vertices(&g, &perm, &permutation);
+
+        snprintf(name, sizeof(name), "isomorphic vf2 %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_bool_t iso;
+                     igraph_isomorphic_vf2(&g, &perm, 0, 0, 0, 0, &iso, 0, 0,
+                                           0, 0, 0);
+                    );
+
+        igraph_destroy(&perm);
+        igraph_vector_destroy(&permutation);
+        igraph_destroy(&g);
+    }
+
+    igraph_vector_destroy(&labeling);
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+int main() {
+    igraph_t g;
+    igraph_matrix_t layout;
+    igraph_layout_drl_options_t options;
+    char gname[64], name[128];
+    int type;
+
+    igraph_bench_init("layout");
+    igraph_matrix_init(&layout, 0, 0);
+    igraph_layout_drl_options_init(&options, IGRAPH_LAYOUT_DRL_DEFAULT);
+
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(100), 0,
+                           gname, sizeof(gname));
+
+        snprintf(name, sizeof(name), "fruchterman reingold %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_layout_fruchterman_reingold(&g, &layout, 0, 500,
+                             sqrt(igraph_vcount(&g)), IGRAPH_LAYOUT_AUTOGRID,
+                             0, 0, 0, 0, 0);
+                    );
+
+        snprintf(name, sizeof(name), "kamada kawai %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_layout_kamada_kawai(&g, &layout, 0,
+                             10 * igraph_vcount(&g), 0, igraph_vcount(&g),
+                             0, 0, 0, 0, 0);
+                    );
+
+        snprintf(name, sizeof(name), "drl %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_layout_drl(&g, &layout, 0, &options, 0, 0);
+                    );
+
+        snprintf(name, sizeof(name), "graphopt %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_layout_graphopt(&g, &layout, 100, 0.001, 30,
+                                            0, 1, 5, 0);
+                    );
+
+        igraph_destroy(&g);
+    }
+
+    igraph_matrix_destroy(&layout);
+
+    return 0;
+}
@@ -37,6 +37,7 @@ int main() {
     igraph_vector_ptr_t res;
     int i, n;
 
+    igraph_bench_init("maximal_cliques");
     igraph_vector_view(&toremove, toremovev,
                        sizeof(toremovev) / sizeof(igraph_real_t));
     igraph_full(&g, 200, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
@@ -7,6 +7,7 @@ int main() {
     igraph_vector_t walk, weights;
     igraph_integer_t ec, i;
 
+    igraph_bench_init("random_walk");
     igraph_rng_seed(igraph_rng_default(), 137);
 
     igraph_vector_init(&walk, 0);
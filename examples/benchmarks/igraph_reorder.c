@@ -0,0 +1,92 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+static const char *algo_names[] = {
+    "shuffled", "degree", "hub", "bfs", "dfs", "rcm", "gorder"
+};
+
+int main() {
+    igraph_t g, shuffled, reordered;
+    igraph_vector_t perm, res;
+    char gname[64], name[128];
+    long int i;
+    int type, algo;
+
+    igraph_bench_init("reorder");
+    igraph_vector_init(&perm, 0);
+    igraph_vector_init(&res, 0);
+
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(10000), 0,
+                           gname, sizeof(gname));
+
+        /* Random ids, so that the orders do not start from the good
+           locality of some generators */
+        igraph_vector_resize(&perm, igraph_vcount(&g));
+        for (i = 0; i < igraph_vcount(&g); i++) {
+            VECTOR(perm)[i] = i;
+        }
+        igraph_vector_shuffle(&perm);
+        igraph_permute_vertices(&g, &shuffled, &perm);
+
+        for (algo = 0; algo <= IGRAPH_REORDER_GORDER + 1; algo++) {
+            if (algo == 0) {
+                igraph_copy(&reordered, &shuffled);
+            } else {
+                snprintf(name, sizeof(name), "reorder %s %s",
+                         algo_names[algo], gname);
+                BENCH_REPEAT(name,
+                             igraph_vertex_reordering(&shuffled, &perm, 0,
+                                                      algo - 1);
+                            );
+                igraph_reorder_vertices(&shuffled, &reordered, 0, algo - 1);
+            }
+
+            snprintf(name, sizeof(name), "bfs %s %s", algo_names[algo], gname);
+            BENCH_REPEAT(name,
+                         igraph_bfs(&reordered, 0, 0, IGRAPH_ALL, 1, 0, &res,
+                                    0, 0, 0, 0, 0, 0, 0);
+                        );
+
+            snprintf(name, sizeof(name), "pagerank %s %s",
+                     algo_names[algo], gname);
+            BENCH_REPEAT(name,
+                         igraph_pagerank(&reordered, IGRAPH_PAGERANK_ALGO_PRPACK,
+                                         &res, 0, igraph_vss_all(),
+                                         IGRAPH_UNDIRECTED, 0.85, 0, 0);
+                        );
+
+            igraph_destroy(&reordered);
+        }
+
+        igraph_destroy(&shuffled);
+        igraph_destroy(&g);
+    }
+
+    igraph_vector_destroy(&res);
+    igraph_vector_destroy(&perm);
+
+    return 0;
+}
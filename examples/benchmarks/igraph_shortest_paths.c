@@ -0,0 +1,75 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+int main() {
+    igraph_t g;
+    igraph_vector_t weights;
+    igraph_matrix_t res;
+    igraph_vector_long_t pred, inbound;
+    igraph_vs_t sources;
+    char gname[64], name[128];
+    int type;
+
+    igraph_bench_init("shortest_paths");
+    igraph_matrix_init(&res, 0, 0);
+    igraph_vector_long_init(&pred, 0);
+    igraph_vector_long_init(&inbound, 0);
+
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(1000), &weights,
+                           gname, sizeof(gname));
+        igraph_vs_seq(&sources, 0, 99);
+
+        snprintf(name, sizeof(name), "bfs 100 sources %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_shortest_paths(&g, &res, sources, igraph_vss_all(),
+                                           IGRAPH_ALL);
+                    );
+
+        snprintf(name, sizeof(name), "dijkstra 100 sources %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_shortest_paths_dijkstra(&g, &res, sources,
+                             igraph_vss_all(), &weights, IGRAPH_ALL);
+                    );
+
+        snprintf(name, sizeof(name), "dijkstra tree %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_get_shortest_paths_dijkstra(&g, 0, 0, 0,
+                             igraph_vss_all(), &weights, IGRAPH_ALL,
+                             &pred, &inbound);
+                    );
+
+        igraph_vs_destroy(&sources);
+        igraph_vector_destroy(&weights);
+        igraph_destroy(&g);
+    }
+
+    igraph_vector_long_destroy(&inbound);
+    igraph_vector_long_destroy(&pred);
+    igraph_matrix_destroy(&res);
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+int main() {
+    igraph_t g, g2;
+    igraph_vector_t edges, pairs, eids;
+    igraph_vector_int_t offsets, indices;
+    igraph_vector_ptr_t graphs, operands;
+    igraph_t *operand_array[4];
+    char gname[64], name[128];
+    long int i, n;
+    int type;
+
+    igraph_bench_init("structure");
+    igraph_vector_init(&edges, 0);
+    igraph_vector_init(&pairs, 0);
+    igraph_vector_init(&eids, 0);
+    igraph_vector_int_init(&offsets, 0);
+    igraph_vector_int_init(&indices, 0);
+    igraph_vector_ptr_init(&graphs, 0);
+
+    for (type = 0; type < IGRAPH_BENCH_NUM_GRAPHS; type++) {
+        igraph_bench_graph(&g, type, igraph_bench_size(10000), 0,
+                           gname, sizeof(gname));
+        igraph_get_edgelist(&g, &edges, 0);
+
+        snprintf(name, sizeof(name), "create %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_create(&g2, &edges, igraph_vcount(&g), IGRAPH_UNDIRECTED);
+                     igraph_destroy(&g2);
+                    );
+
+        /* Sparse matrix export and import */
+        snprintf(name, sizeof(name), "get_sparsemat compress %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_sparsemat_t A, B;
+                     igraph_get_sparsemat(&g, &A);
+                     igraph_sparsemat_compress(&A, &B);
+                     igraph_sparsemat_destroy(&B);
+                     igraph_sparsemat_destroy(&A);
+                    );
+        snprintf(name, sizeof(name), "get_csr %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_get_csr(&g, &offsets, &indices, 0, 0, IGRAPH_OUT);
+                    );
+        snprintf(name, sizeof(name), "create_from_csr %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_create_from_csr(&g2, &offsets, &indices, 0, 0,
+                                            IGRAPH_UNDIRECTED, IGRAPH_OUT);
+                     igraph_destroy(&g2);
+                    );
+
+        /* Every edge, in random order */
+        n = igraph_ecount(&g);
+        igraph_vector_resize(&pairs, 2 * n);
+        for (i = 0; i < n; i++) {
+            long int e = RNG_INTEGER(0, n - 1);
+            VECTOR(pairs)[2 * i] = IGRAPH_TO(&g, e);
+            VECTOR(pairs)[2 * i + 1] = IGRAPH_FROM(&g, e);
+        }
+        snprintf(name, sizeof(name), "get_eids %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_get_eids(&g, &eids, &pairs, NULL, 0, 0);
+                    );
+
+        snprintf(name, sizeof(name), "to_directed mutual %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_t g3;
+                     igraph_copy(&g3, &g);
+                     igraph_to_directed(&g3, IGRAPH_TO_DIRECTED_MUTUAL);
+                     igraph_destroy(&g3);
+                    );
+
+        /* Every edge in a random direction, and every tenth edge in both
+           directions */
+        igraph_vector_resize(&pairs, 2 * n + 2 * (n / 10));
+        for (i = 0; i < n; i++) {
+            igraph_bool_t flip = RNG_INTEGER(0, 1);
+            VECTOR(pairs)[2 * i] = flip ? IGRAPH_TO(&g, i) : IGRAPH_FROM(&g, i);
+            VECTOR(pairs)[2 * i + 1] = flip ? IGRAPH_FROM(&g, i) : IGRAPH_TO(&g, i);
+        }
+        for (i = 0; i < n / 10; i++) {
+            VECTOR(pairs)[2 * n + 2 * i] = VECTOR(pairs)[20 * i + 1];
+            VECTOR(pairs)[2 * n + 2 * i + 1] = VECTOR(pairs)[20 * i];
+        }
+        igraph_create(&g2, &pairs, igraph_vcount(&g), IGRAPH_DIRECTED);
+        snprintf(name, sizeof(name), "to_undirected collapse %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_t g3;
+                     igraph_copy(&g3, &g2);
+                     igraph_to_undirected(&g3, IGRAPH_TO_UNDIRECTED_COLLAPSE, 0);
+                     igraph_destroy(&g3);
+                    );
+        snprintf(name, sizeof(name), "to_undirected mutual %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_t g3;
+                     igraph_copy(&g3, &g2);
+                     igraph_to_undirected(&g3, IGRAPH_TO_UNDIRECTED_MUTUAL, 0);
+                     igraph_destroy(&g3);
+                    );
+        igraph_destroy(&g2);
+
+        /* Every edge twice */
+        igraph_vector_append(&edges, &edges);
+        igraph_create(&g2, &edges, igraph_vcount(&g), IGRAPH_UNDIRECTED);
+        snprintf(name, sizeof(name), "simplify %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_t g3;
+                     igraph_copy(&g3, &g2);
+                     igraph_simplify(&g3, 1, 1, NULL);
+                     igraph_destroy(&g3);
+                    );
+        igraph_destroy(&g2);
+
+        /* Set operators, with every other edge in the second graph */
+        igraph_vector_resize(&pairs, 2 * (n / 2));
+        for (i = 0; i < n / 2; i++) {
+            VECTOR(pairs)[2 * i] = IGRAPH_FROM(&g, 2 * i);
+            VECTOR(pairs)[2 * i + 1] = IGRAPH_TO(&g, 2 * i);
+        }
+        igraph_create(&g2, &pairs, igraph_vcount(&g), IGRAPH_UNDIRECTED);
+        operand_array[0] = operand_array[2] = &g;
+        operand_array[1] = operand_array[3] = &g2;
+        igraph_vector_ptr_view(&operands, (void **) operand_array, 4);
+        snprintf(name, sizeof(name), "union %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_t g3;
+                     igraph_union(&g3, &g, &g2, NULL, NULL);
+                     igraph_destroy(&g3);
+                    );
+        snprintf(name, sizeof(name), "intersection %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_t g3;
+                     igraph_intersection(&g3, &g, &g2, NULL, NULL);
+                     igraph_destroy(&g3);
+                    );
+        snprintf(name, sizeof(name), "difference %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_t g3;
+                     igraph_difference(&g3, &g, &g2);
+                     igraph_destroy(&g3);
+                    );
+        snprintf(name, sizeof(name), "union_many 4 %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_t g3;
+                     igraph_union_many(&g3, &operands, NULL);
+                     igraph_destroy(&g3);
+                    );
+        igraph_destroy(&g2);
+
+        /* Every other vertex */
+        igraph_vector_resize(&pairs, igraph_vcount(&g) / 2);
+        for (i = 0; i < igraph_vcount(&g) / 2; i++) {
+            VECTOR(pairs)[i] = 2 * i;
+        }
+        snprintf(name, sizeof(name), "induced_subgraph half %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_induced_subgraph(&g, &g2, igraph_vss_vector(&pairs),
+                                             IGRAPH_SUBGRAPH_AUTO);
+                     igraph_destroy(&g2);
+                    );
+
+        /* Second-order neighborhoods of all vertices */
+        snprintf(name, sizeof(name), "neighborhood_size %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_neighborhood_size(&g, &pairs, igraph_vss_all(), 2,
+                                              IGRAPH_ALL, 0);
+                    );
+
+        /* Ego networks of 1000 vertices */
+        snprintf(name, sizeof(name), "neighborhood_graphs %s", gname);
+        BENCH_REPEAT(name,
+                     igraph_neighborhood_graphs(&g, &graphs,
+                                                igraph_vss_seq(0, 999), 1,
+                                                IGRAPH_ALL, 0);
+                     igraph_decompose_destroy(&graphs);
+                    );
+
+        igraph_destroy(&g);
+    }
+
+    igraph_vector_ptr_destroy(&graphs);
+    igraph_vector_int_destroy(&indices);
+    igraph_vector_int_destroy(&offsets);
+    igraph_vector_destroy(&eids);
+    igraph_vector_destroy(&pairs);
+    igraph_vector_destroy(&edges);
+
+    return 0;
+}
@@ -33,6 +33,7 @@ int main() {
     igraph_t g;
     igraph_vector_t trans;
 
+    igraph_bench_init("transitivity");
     igraph_erdos_renyi_game(&g, IGRAPH_ERDOS_RENYI_GNM, N, M,
                             IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
     igraph_vector_init(&trans, igraph_vcount(&g));
@@ -0,0 +1,117 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include <igraph.h>
+
+#include "bench_graphs.h"
+
+/* Each primitive is applied this many times per measurement, so that
+   the time is not dominated by the timer resolution */
+#define ITER 20
+
+int main() {
+    igraph_vector_t v1, v2, res;
+    igraph_vector_long_t l1;
+    igraph_matrix_t m;
+    long int n = igraph_bench_size(100000), k = igraph_bench_size(100);
+    long int i;
+    char name[128];
+    igraph_real_t sink = 0;
+
+    igraph_bench_init("vector_matrix");
+
+    igraph_vector_init(&v1, n);
+    igraph_vector_init(&v2, n);
+    igraph_vector_init(&res, 0);
+    igraph_vector_long_init(&l1, n);
+    for (i = 0; i < n; i++) {
+        VECTOR(v1)[i] = RNG_UNIF(-1, 1);
+        VECTOR(v2)[i] = RNG_UNIF(1, 2);
+        VECTOR(l1)[i] = RNG_INTEGER(-1000, 1000);
+    }
+
+#define VBENCH(OP, ...) \
+    snprintf(name, sizeof(name), "vector %s n=%ld", OP, n); \
+    BENCH_REPEAT(name, int it; for (it = 0; it < ITER; it++) { __VA_ARGS__; })
+
+    VBENCH("add", igraph_vector_add(&v1, &v2));
+    VBENCH("sub", igraph_vector_sub(&v1, &v2));
+    VBENCH("mul", igraph_vector_mul(&v1, &v2));
+    VBENCH("div", igraph_vector_div(&v1, &v2));
+    VBENCH("scale", igraph_vector_scale(&v1, 1.0001));
+    VBENCH("add_constant", igraph_vector_add_constant(&v1, 0.5));
+    VBENCH("fill", igraph_vector_fill(&v2, 1.5));
+    VBENCH("sum", sink += igraph_vector_sum(&v1));
+    VBENCH("max", sink += igraph_vector_max(&v1));
+    VBENCH("which_max", sink += igraph_vector_which_max(&v1));
+    VBENCH("minmax", igraph_real_t mi; igraph_real_t ma;
+           igraph_vector_minmax(&v1, &mi, &ma); sink += mi + ma);
+    VBENCH("which_minmax", long int mi; long int ma;
+           igraph_vector_which_minmax(&v1, &mi, &ma); sink += mi + ma);
+    VBENCH("isininterval", sink += igraph_vector_isininterval(&v2, 0, 10));
+    /* Keys as in the edge list of a graph with n/10 vertices */
+    for (i = 0; i < n; i++) {
+        VECTOR(v1)[i] = RNG_INTEGER(0, n / 10);
+        VECTOR(v2)[i] = RNG_INTEGER(0, n / 10);
+    }
+    VBENCH("order", igraph_vector_order(&v1, &v2, &res, n / 10));
+    VBENCH("order1", igraph_vector_order1(&v1, &res, n / 10));
+    VBENCH("long add_constant", igraph_vector_long_add_constant(&l1, 1));
+    VBENCH("long sum", sink += igraph_vector_long_sum(&l1));
+    VBENCH("long max", sink += igraph_vector_long_max(&l1));
+    VBENCH("long which_max", sink += igraph_vector_long_which_max(&l1));
+
+#undef VBENCH
+
+    /* Square and skinny matrices */
+    for (i = 0; i < 2; i++) {
+        long int nrow = i == 0 ? k : 16 * k, ncol = i == 0 ? k : k / 16;
+        long int j;
+        igraph_matrix_init(&m, nrow, ncol);
+        for (j = 0; j < nrow * ncol; j++) {
+            VECTOR(m.data)[j] = RNG_UNIF(0, 1);
+        }
+
+        snprintf(name, sizeof(name), "matrix transpose %ldx%ld", nrow, ncol);
+        BENCH_REPEAT(name, igraph_matrix_transpose(&m));
+        snprintf(name, sizeof(name), "matrix rowsum %ldx%ld", nrow, ncol);
+        BENCH_REPEAT(name, igraph_matrix_rowsum(&m, &res));
+        snprintf(name, sizeof(name), "matrix colsum %ldx%ld", nrow, ncol);
+        BENCH_REPEAT(name, igraph_matrix_colsum(&m, &res));
+        snprintf(name, sizeof(name), "matrix scale %ldx%ld", nrow, ncol);
+        BENCH_REPEAT(name, igraph_matrix_scale(&m, 1.0001));
+
+        igraph_matrix_destroy(&m);
+    }
+
+    igraph_vector_long_destroy(&l1);
+    igraph_vector_destroy(&res);
+    igraph_vector_destroy(&v2);
+    igraph_vector_destroy(&v1);
+
+    /* Keeps the compiler from removing the reductions */
+    if (sink == 42) {
+        printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <igraph.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_utilities.inc"
+
+int longest(const igraph_strvector_t *strs, char **res) {
+    long int i, n = igraph_strvector_size(strs);
+    const char *best = "";
+    for (i = 0; i < n; i++) {
+        char *str;
+        igraph_strvector_get(strs, i, &str);
+        if (strlen(str) > strlen(best)) {
+            best = str;
+        }
+    }
+    *res = igraph_malloc(strlen(best) + 1);
+    if (!*res) {
+        return IGRAPH_ENOMEM;
+    }
+    strcpy(*res, best);
+    return 0;
+}
+
+int all_true(const igraph_vector_bool_t *v, igraph_bool_t *res) {
+    long int i, n = igraph_vector_bool_size(v);
+    *res = 1;
+    for (i = 0; i < n; i++) {
+        if (!VECTOR(*v)[i]) {
+            *res = 0;
+        }
+    }
+    return 0;
+}
+
+void print_attrs(const igraph_t *graph) {
+    long int i;
+    printf("edges:");
+    for (i = 0; i < igraph_ecount(graph); i++) {
+        printf(" %d-%d %g %s %s %s %d", (int) IGRAPH_FROM(graph, i),
+               (int) IGRAPH_TO(graph, i), EAN(graph, "weight", i),
+               EAS(graph, "label", i), EAS(graph, "first", i),
+               EAS(graph, "longest", i), (int) EAB(graph, "ok", i));
+    }
+    printf("\n");
+}
+
+int main() {
+    igraph_t g;
+    igraph_attribute_combination_t comb;
+    igraph_vector_t mapping;
+    const char *labels[] = { "a", "b", "c", "d", "ee", "f", "g" };
+    long int i;
+
+    igraph_i_set_attribute_table(&igraph_cattribute_table);
+
+    /* Multigraph with a loop edge */
+    igraph_small(&g, 5, IGRAPH_UNDIRECTED,
+                 0, 1, 1, 2, 0, 1, 2, 2, 1, 0, 1, 2, 3, 4, -1);
+    for (i = 0; i < igraph_ecount(&g); i++) {
+        SETEAN(&g, "weight", i, i + 1);
+        SETEAS(&g, "label", i, labels[i]);
+        SETEAS(&g, "first", i, labels[i]);
+        SETEAS(&g, "longest", i, labels[i]);
+        SETEAB(&g, "ok", i, i != 4);
+        SETEAN(&g, "dropped", i, i);
+    }
+    for (i = 0; i < igraph_vcount(&g); i++) {
+        SETVAN(&g, "size", i, 1);
+        SETVAS(&g, "name", i, labels[i]);
+        SETVAN(&g, "unlisted", i, i);
+    }
+
+    igraph_attribute_combination(&comb,
+                                 "weight", IGRAPH_ATTRIBUTE_COMBINE_SUM,
+                                 "label", IGRAPH_ATTRIBUTE_COMBINE_CONCAT,
+                                 "first", IGRAPH_ATTRIBUTE_COMBINE_FIRST,
+                                 "longest", IGRAPH_ATTRIBUTE_COMBINE_FUNCTION, longest,
+                                 "ok", IGRAPH_ATTRIBUTE_COMBINE_FUNCTION, all_true,
+                                 "dropped", IGRAPH_ATTRIBUTE_COMBINE_IGNORE,
+                                 IGRAPH_NO_MORE_ATTRIBUTES);
+    igraph_simplify(&g, /* multiple= */ 1, /* loops= */ 1, &comb);
+    igraph_attribute_combination_destroy(&comb);
+    print_attrs(&g);
+    if (igraph_cattribute_has_attr(&g, IGRAPH_ATTRIBUTE_EDGE, "dropped")) {
+        return 1;
+    }
+
+    /* Contracting vertices keeps the combined vertex attributes; the
+       ones without a combination rule are dropped */
+    igraph_attribute_combination(&comb,
+                                 "size", IGRAPH_ATTRIBUTE_COMBINE_SUM,
+                                 "name", IGRAPH_ATTRIBUTE_COMBINE_CONCAT,
+                                 IGRAPH_NO_MORE_ATTRIBUTES);
+    igraph_vector_init_int(&mapping, 5, 0, 1, 0, 2, 2);
+    igraph_contract_vertices(&g, &mapping, &comb);
+    igraph_vector_destroy(&mapping);
+    igraph_attribute_combination_destroy(&comb);
+
+    printf("vertices:");
+    for (i = 0; i < igraph_vcount(&g); i++) {
+        printf(" %g %s", VAN(&g, "size", i), VAS(&g, "name", i));
+    }
+    printf("\n");
+    if (igraph_cattribute_has_attr(&g, IGRAPH_ATTRIBUTE_VERTEX, "unlisted")) {
+        return 2;
+    }
+    print_attrs(&g);
+
+    igraph_destroy(&g);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+void print_strvector(const igraph_strvector_t *sv) {
+    long int i, n = igraph_strvector_size(sv);
+    for (i = 0; i < n; i++) {
+        char *str;
+        igraph_strvector_get(sv, i, &str);
+        printf("\"%s\"%s", str, i == n - 1 ? "" : " ");
+    }
+    printf("\n");
+}
+
+void print_eas(const igraph_t *graph, const char *name) {
+    igraph_strvector_t sv;
+    igraph_strvector_init(&sv, 0);
+    igraph_cattribute_EASV(graph, name, igraph_ess_all(IGRAPH_EDGEORDER_ID), &sv);
+    printf("%s: ", name);
+    print_strvector(&sv);
+    igraph_strvector_destroy(&sv);
+}
+
+int main() {
+    igraph_t g, g2;
+    igraph_strvector_t sv, sv2;
+    igraph_vector_t idx;
+    char name[20];
+    long int i;
+
+    igraph_i_set_attribute_table(&igraph_cattribute_table);
+
+    /* String vectors with empty strings */
+    igraph_strvector_init(&sv, 3);
+    igraph_strvector_set(&sv, 1, "foo");
+    igraph_strvector_set(&sv, 2, "");
+    igraph_strvector_resize(&sv, 5);
+    igraph_strvector_add(&sv, "");
+    igraph_strvector_add(&sv, "bar");
+    igraph_strvector_set(&sv, 1, "");
+    igraph_strvector_set(&sv, 3, "baz");
+    print_strvector(&sv);
+    igraph_strvector_copy(&sv2, &sv);
+    igraph_strvector_append(&sv2, &sv);
+    igraph_strvector_remove_section(&sv2, 2, 5);
+    igraph_strvector_remove(&sv2, 0);
+    print_strvector(&sv2);
+    igraph_strvector_clear(&sv2);
+    igraph_strvector_set(&sv, 0, "x");
+    igraph_strvector_resize(&sv, 2);
+    print_strvector(&sv);
+    igraph_strvector_destroy(&sv2);
+    igraph_strvector_destroy(&sv);
+
+    /* Many attributes, so that they are looked up by hashing */
+    igraph_ring(&g, 4, IGRAPH_UNDIRECTED, /* mutual= */ 0, /* circular= */ 0);
+    for (i = 0; i < 40; i++) {
+        snprintf(name, sizeof(name), "attr%ld", i);
+        SETVAN(&g, name, 0, i);
+        SETEAS(&g, name, 1, name);
+    }
+    for (i = 0; i < 40; i += 3) {
+        snprintf(name, sizeof(name), "attr%ld", i);
+        DELVA(&g, name);
+        DELEA(&g, name);
+    }
+    SETVAN(&g, "attr0", 1, 100);
+    SETEAS(&g, "new", 0, "new");
+    for (i = 0; i < 40; i++) {
+        snprintf(name, sizeof(name), "attr%ld", i);
+        if (igraph_cattribute_has_attr(&g, IGRAPH_ATTRIBUTE_VERTEX, name) !=
+            (i == 0 || i % 3 != 0)) {
+            return 1;
+        }
+        if (i % 3 != 0 && VAN(&g, name, 0) != i) {
+            return 2;
+        }
+        if (i % 3 != 0 && strcmp(EAS(&g, name, 1), name)) {
+            return 3;
+        }
+    }
+    if (VAN(&g, "attr0", 1) != 100 || !igraph_is_nan(VAN(&g, "attr0", 0))) {
+        return 4;
+    }
+    print_eas(&g, "new");
+    print_eas(&g, "attr1");
+
+    /* Adding edges and vertices fills in empty strings */
+    igraph_add_vertices(&g, 2, 0);
+    igraph_add_edge(&g, 4, 5);
+    SETEAS(&g, "new", 3, "newer");
+    print_eas(&g, "new");
+
+    /* Permuting in place, with duplicated edges */
+    igraph_to_directed(&g, IGRAPH_TO_DIRECTED_MUTUAL);
+    print_eas(&g, "new");
+    igraph_to_undirected(&g, IGRAPH_TO_UNDIRECTED_EACH, 0);
+    igraph_vector_init_int(&idx, 3, 0, 3, 5);
+    igraph_delete_edges(&g, igraph_ess_vector(&idx));
+    print_eas(&g, "new");
+    print_eas(&g, "attr1");
+    igraph_vector_destroy(&idx);
+
+    /* Copies and subgraphs have working indices */
+    igraph_copy(&g2, &g);
+    SETVAS(&g2, "label", 2, "two");
+    igraph_destroy(&g);
+    igraph_delete_vertices(&g2, igraph_vss_1(0));
+    if (VAN(&g2, "attr0", 0) != 100 || strcmp(VAS(&g2, "label", 1), "two")) {
+        return 5;
+    }
+    print_eas(&g2, "new");
+    igraph_destroy(&g2);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* Every list of the lazy adjacency list must be the list of the same
+   vertex in the lazy adjacency list of the explicitly created graph */
+int check_lists(igraph_lazy_adjlist_t *al, const igraph_t *explicit,
+                igraph_neimode_t mode, igraph_lazy_adlist_simplify_t simplify) {
+    igraph_lazy_adjlist_t expected;
+    long int i;
+
+    if (al->length != igraph_vcount(explicit)) {
+        return 1;
+    }
+    igraph_lazy_adjlist_init(explicit, &expected, mode, simplify);
+    for (i = 0; i < al->length; i++) {
+        igraph_vector_t *list = igraph_lazy_adjlist_get(al, i);
+        if (!igraph_vector_all_e(list, igraph_lazy_adjlist_get(&expected, i))) {
+            return 2;
+        }
+        if (i % 2) {
+            igraph_lazy_adjlist_release(al, i);
+        }
+    }
+    igraph_lazy_adjlist_destroy(&expected);
+    return 0;
+}
+
+/* The complementer lists must be the ones of the (not lazy)
+   complementer adjacency list */
+int check_complementer_lists(igraph_lazy_adjlist_t *al, const igraph_t *graph,
+                             igraph_neimode_t mode, igraph_bool_t loops) {
+    igraph_adjlist_t adjlist;
+    long int i, j;
+
+    igraph_adjlist_init_complementer(graph, &adjlist, mode, loops);
+    for (i = 0; i < al->length; i++) {
+        igraph_vector_t *list = igraph_lazy_adjlist_get(al, i);
+        igraph_vector_int_t *expected = igraph_adjlist_get(&adjlist, i);
+        if (igraph_vector_size(list) != igraph_vector_int_size(expected)) {
+            return 4;
+        }
+        for (j = 0; j < igraph_vector_size(list); j++) {
+            if (VECTOR(*list)[j] != VECTOR(*expected)[j]) {
+                return 5;
+            }
+        }
+    }
+    igraph_adjlist_destroy(&adjlist);
+    return 0;
+}
+
+/* The BFS on the lazy adjacency list must visit the vertices in the
+   same order as the BFS on the explicit graph */
+int check_bfs(igraph_lazy_adjlist_t *al, const igraph_t *explicit,
+              igraph_neimode_t mode) {
+    igraph_vector_t order1, order2, dist1, dist2, father1, father2;
+    int ret = 0;
+
+    igraph_vector_init(&order1, 0);
+    igraph_vector_init(&order2, 0);
+    igraph_vector_init(&dist1, 0);
+    igraph_vector_init(&dist2, 0);
+    igraph_vector_init(&father1, 0);
+    igraph_vector_init(&father2, 0);
+    igraph_bfs_lazy_adjlist(al, 0, NULL, /*unreachable=*/ 1, NULL,
+                            &order1, NULL, &father1, NULL, NULL, &dist1,
+                            NULL, NULL);
+    igraph_bfs(explicit, 0, NULL, mode, /*unreachable=*/ 1, NULL,
+               &order2, NULL, &father2, NULL, NULL, &dist2, NULL, NULL);
+    if (!igraph_vector_all_e(&order1, &order2) ||
+        !igraph_vector_all_e(&dist1, &dist2) ||
+        !igraph_vector_all_e(&father1, &father2)) {
+        ret = 3;
+    }
+    igraph_vector_destroy(&father2);
+    igraph_vector_destroy(&father1);
+    igraph_vector_destroy(&dist2);
+    igraph_vector_destroy(&dist1);
+    igraph_vector_destroy(&order2);
+    igraph_vector_destroy(&order1);
+    return ret;
+}
+
+int main() {
+    igraph_t g, explicit;
+    igraph_lazy_adjlist_t al;
+    igraph_vector_t order;
+    igraph_neimode_t modes[] = { IGRAPH_OUT, IGRAPH_IN, IGRAPH_ALL };
+    int directed, m, loops, ret;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    for (directed = 0; directed < 2; directed++) {
+        /* A multigraph with loop edges */
+        igraph_small(&g, 7, directed,
+                     0, 1, 1, 2, 2, 0, 0, 1, 3, 3, 3, 4, 4, 5, 5, 3, 3, 3,
+                     1, 3, 6, 6, -1);
+
+        for (m = 0; m < 3; m++) {
+            for (loops = 0; loops < 2; loops++) {
+                igraph_complementer(&explicit, &g, loops);
+                igraph_lazy_adjlist_init_complementer(&g, &al, modes[m], loops);
+                if ((ret = check_complementer_lists(&al, &g, modes[m], loops))) {
+                    return ret;
+                }
+                if (modes[m] == IGRAPH_OUT &&
+                    (ret = check_bfs(&al, &explicit, IGRAPH_OUT))) {
+                    return ret;
+                }
+                igraph_lazy_adjlist_destroy(&al);
+                igraph_destroy(&explicit);
+            }
+
+            igraph_linegraph(&g, &explicit);
+            igraph_lazy_adjlist_init_linegraph(&g, &al, modes[m],
+                                               IGRAPH_DONT_SIMPLIFY);
+            if ((ret = check_lists(&al, &explicit, modes[m], IGRAPH_DONT_SIMPLIFY)) ||
+                (ret = check_bfs(&al, &explicit, modes[m]))) {
+                return 10 + ret;
+            }
+            igraph_lazy_adjlist_destroy(&al);
+
+            igraph_lazy_adjlist_init_linegraph(&g, &al, modes[m],
+                                               IGRAPH_SIMPLIFY);
+            if ((ret = check_lists(&al, &explicit, modes[m], IGRAPH_SIMPLIFY))) {
+                return 20 + ret;
+            }
+            igraph_lazy_adjlist_destroy(&al);
+            igraph_destroy(&explicit);
+        }
+        igraph_destroy(&g);
+    }
+
+    /* A large sparse graph whose complementer is not created */
+    igraph_erdos_renyi_game(&g, IGRAPH_ERDOS_RENYI_GNM, 5000, 10000,
+                            IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    igraph_vector_init(&order, 0);
+    igraph_lazy_adjlist_init_complementer(&g, &al, IGRAPH_ALL, /*loops=*/ 0);
+    igraph_bfs_lazy_adjlist(&al, 0, NULL, /*unreachable=*/ 1, NULL,
+                            &order, NULL, NULL, NULL, NULL, NULL,
+                            NULL, NULL);
+    printf("%ld vertices visited\n", igraph_vector_size(&order));
+    igraph_lazy_adjlist_destroy(&al);
+    igraph_vector_destroy(&order);
+    igraph_destroy(&g);
+
+    /* The line graph of a path is a path */
+    igraph_ring(&g, 5, IGRAPH_DIRECTED, /*mutual=*/ 0, /*circular=*/ 0);
+    igraph_vector_init(&order, 0);
+    igraph_lazy_adjlist_init_linegraph(&g, &al, IGRAPH_IN, IGRAPH_DONT_SIMPLIFY);
+    igraph_bfs_lazy_adjlist(&al, 3, NULL, /*unreachable=*/ 0, NULL,
+                            &order, NULL, NULL, NULL, NULL, NULL,
+                            NULL, NULL);
+    igraph_vector_print(&order);
+    igraph_lazy_adjlist_destroy(&al);
+    igraph_vector_destroy(&order);
+    igraph_destroy(&g);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+
+#include <igraph.h>
+#include <time.h>
+
+#include "test_utilities.inc"
+
+static int handler_calls = 0;
+
+static int counting_handler(void *data) {
+    IGRAPH_UNUSED(data);
+    handler_calls++;
+    return IGRAPH_SUCCESS;
+}
+
+int main() {
+    igraph_t graph;
+    igraph_cancellation_t token, token2;
+    igraph_integer_t count;
+    clock_t start;
+    int ret;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    /* A context that is neither cancelled nor expired does not disturb
+       the calculation */
+    igraph_full(&graph, 5, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    igraph_cancellation_init(&token, 0);
+    if (igraph_set_cancellation(&token) != NULL) {
+        return 1;
+    }
+    igraph_maximal_cliques_count(&graph, &count, 0, 0);
+    printf("cliques: %ld\n", (long int) count);
+
+    /* Cancelled calls fail with IGRAPH_INTERRUPTED and clean up */
+    igraph_set_error_handler(igraph_error_handler_ignore);
+    igraph_cancel(&token);
+    ret = igraph_maximal_cliques_count(&graph, &count, 0, 0);
+    printf("cancelled: %s\n", ret == IGRAPH_INTERRUPTED ? "interrupted" : "other");
+    VERIFY_FINALLY_STACK();
+    igraph_destroy(&graph);
+
+    /* The context can be swapped, and the previous one is returned */
+    igraph_cancellation_init(&token2, 0);
+    if (igraph_set_cancellation(&token2) != &token) {
+        return 2;
+    }
+
+    /* The interruption handler is still called when a context is set */
+    igraph_set_interruption_handler(counting_handler);
+    igraph_erdos_renyi_game(&graph, IGRAPH_ERDOS_RENYI_GNP, 100, 0.2,
+                            IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    igraph_maximal_cliques_count(&graph, &count, 0, 0);
+    printf("handler called: %s\n", handler_calls > 0 ? "yes" : "no");
+    igraph_set_interruption_handler(NULL);
+    igraph_destroy(&graph);
+
+    /* A calculation that would take very long stops at the deadline,
+       even though it spends its time in a single deep recursion */
+    igraph_erdos_renyi_game(&graph, IGRAPH_ERDOS_RENYI_GNP, 2000, 0.5,
+                            IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    igraph_cancellation_init(&token, 0.05);
+    igraph_set_cancellation(&token);
+    start = clock();
+    ret = igraph_maximal_cliques_count(&graph, &count, 0, 0);
+    printf("deadline: %s\n", ret == IGRAPH_CPUTIME ? "exceeded" : "other");
+    printf("stopped in time: %s\n",
+           (clock() - start) / (double) CLOCKS_PER_SEC < 5 ? "yes" : "no");
+    VERIFY_FINALLY_STACK();
+
+    /* Without a context, nothing is checked */
+    if (igraph_set_cancellation(NULL) != &token) {
+        return 3;
+    }
+    igraph_destroy(&graph);
+
+    igraph_full(&graph, 4, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    ret = igraph_maximal_cliques_count(&graph, &count, 0, 0);
+    printf("after removal: %d %ld\n", ret, (long int) count);
+    igraph_destroy(&graph);
+
+    VERIFY_FINALLY_STACK();
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* The decoded lists must be the neighbor lists of the graph */
+int check(const igraph_t *graph, igraph_neimode_t mode) {
+    igraph_compressed_adjlist_t cal;
+    igraph_lazy_adjlist_t al;
+    igraph_vector_t neis, res, order1, order2, dist1, dist2;
+    long int i, n = igraph_vcount(graph);
+    int ret = 0;
+
+    igraph_vector_init(&neis, 0);
+    igraph_vector_init(&res, 0);
+    igraph_compressed_adjlist_init(graph, &cal, mode);
+    for (i = 0; i < n && !ret; i++) {
+        igraph_neighbors(graph, &neis, i, mode);
+        igraph_compressed_adjlist_get(&cal, i, &res);
+        if (!igraph_vector_all_e(&neis, &res)) {
+            ret = 1;
+        }
+        if (igraph_compressed_adjlist_degree(&cal, i) != igraph_vector_size(&neis)) {
+            ret = 2;
+        }
+    }
+
+    /* Breadth-first search on the compressed lists */
+    igraph_vector_init(&order1, 0);
+    igraph_vector_init(&order2, 0);
+    igraph_vector_init(&dist1, 0);
+    igraph_vector_init(&dist2, 0);
+    igraph_lazy_adjlist_init_compressed(&cal, &al, IGRAPH_DONT_SIMPLIFY);
+    igraph_bfs_lazy_adjlist(&al, 0, NULL, /*unreachable=*/ 1, NULL,
+                            &order1, NULL, NULL, NULL, NULL, &dist1,
+                            NULL, NULL);
+    igraph_bfs(graph, 0, NULL, mode, /*unreachable=*/ 1, NULL,
+               &order2, NULL, NULL, NULL, NULL, &dist2, NULL, NULL);
+    if (!igraph_vector_all_e(&order1, &order2) ||
+        !igraph_vector_all_e(&dist1, &dist2)) {
+        ret = 3;
+    }
+    igraph_lazy_adjlist_destroy(&al);
+
+    igraph_vector_destroy(&dist2);
+    igraph_vector_destroy(&dist1);
+    igraph_vector_destroy(&order2);
+    igraph_vector_destroy(&order1);
+    igraph_compressed_adjlist_destroy(&cal);
+    igraph_vector_destroy(&res);
+    igraph_vector_destroy(&neis);
+    return ret;
+}
+
+int main() {
+    igraph_t g;
+    igraph_compressed_adjlist_t cal;
+    igraph_lazy_adjlist_t al;
+    igraph_vector_t edges;
+    long int i;
+    int ret;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    /* Multigraph with loop edges */
+    igraph_small(&g, 6, IGRAPH_DIRECTED,
+                 0, 1, 0, 1, 1, 0, 2, 2, 2, 2, 5, 0, 3, 4, 4, 3, -1);
+    if ((ret = check(&g, IGRAPH_OUT)) || (ret = check(&g, IGRAPH_IN)) ||
+        (ret = check(&g, IGRAPH_ALL))) {
+        return ret;
+    }
+    igraph_to_undirected(&g, IGRAPH_TO_UNDIRECTED_EACH, NULL);
+    if ((ret = check(&g, IGRAPH_ALL))) {
+        return 10 + ret;
+    }
+
+    /* Simplified lazy lists */
+    igraph_compressed_adjlist_init(&g, &cal, IGRAPH_ALL);
+    igraph_lazy_adjlist_init_compressed(&cal, &al, IGRAPH_SIMPLIFY);
+    for (i = 0; i < igraph_vcount(&g); i++) {
+        igraph_vector_print(igraph_lazy_adjlist_get(&al, i));
+    }
+    igraph_lazy_adjlist_destroy(&al);
+    igraph_compressed_adjlist_destroy(&cal);
+    igraph_destroy(&g);
+
+    /* Neighbors far from each other need several bytes */
+    igraph_vector_init_int(&edges, 6, 0, 1000000, 1000000, 999999, 300, 20000);
+    igraph_create(&g, &edges, 1000001, IGRAPH_UNDIRECTED);
+    if ((ret = check(&g, IGRAPH_ALL))) {
+        return 20 + ret;
+    }
+    igraph_vector_destroy(&edges);
+    igraph_destroy(&g);
+
+    /* Random graphs */
+    igraph_erdos_renyi_game(&g, IGRAPH_ERDOS_RENYI_GNM, 1000, 5000,
+                            IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    if ((ret = check(&g, IGRAPH_OUT)) || (ret = check(&g, IGRAPH_ALL))) {
+        return 30 + ret;
+    }
+    igraph_destroy(&g);
+
+    /* A ring needs three bytes per vertex: the degree and two deltas */
+    igraph_ring(&g, 1000, IGRAPH_UNDIRECTED, /*mutual=*/ 0, /*circular=*/ 0);
+    igraph_compressed_adjlist_init(&g, &cal, IGRAPH_ALL);
+    printf("%ld bytes\n", igraph_vector_char_size(&cal.data));
+    igraph_compressed_adjlist_destroy(&cal);
+    igraph_destroy(&g);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+
+#include <igraph.h>
+
+#include "test_utilities.inc"
+
+int main() {
+    igraph_t graph;
+    igraph_vector_t res, weights;
+    igraph_matrix_t dist;
+    igraph_counters_t counters;
+    igraph_real_t flow;
+    int i;
+
+    /* Nothing is recorded while the counters are off */
+    igraph_ring(&graph, 10, IGRAPH_UNDIRECTED, 0, 1);
+    igraph_vector_init(&res, 0);
+    igraph_betweenness(&graph, &res, igraph_vss_all(), IGRAPH_UNDIRECTED, 0, 1);
+    igraph_counters_get(&counters);
+    for (i = 0; i < IGRAPH_COUNTER_NUM; i++) {
+        if (counters.counts[i] != 0) {
+            return 1;
+        }
+    }
+
+    igraph_set_counters(1);
+
+    /* Unweighted betweenness: one BFS from each vertex, scanning each
+       edge twice per BFS */
+    igraph_betweenness(&graph, &res, igraph_vss_all(), IGRAPH_UNDIRECTED, 0, 1);
+    igraph_counters_get(&counters);
+    printf("BFS sources: %g\n", counters.counts[IGRAPH_COUNTER_SEARCH_SOURCES]);
+    printf("edges scanned: %g\n", counters.counts[IGRAPH_COUNTER_EDGES_SCANNED]);
+    printf("betweenness calls: %g\n", counters.calls[IGRAPH_TIMER_BETWEENNESS]);
+    if (counters.counts[IGRAPH_COUNTER_ALLOCATED_BYTES] <= 0 ||
+        counters.seconds[IGRAPH_TIMER_BETWEENNESS] < 0) {
+        return 2;
+    }
+
+    /* Dijkstra counts its heap operations as well */
+    igraph_counters_reset();
+    igraph_vector_init(&weights, igraph_ecount(&graph));
+    igraph_vector_fill(&weights, 1);
+    igraph_matrix_init(&dist, 0, 0);
+    igraph_shortest_paths_dijkstra(&graph, &dist, igraph_vss_1(0), igraph_vss_all(),
+                                   &weights, IGRAPH_ALL);
+    igraph_counters_get(&counters);
+    printf("Dijkstra sources: %g\n", counters.counts[IGRAPH_COUNTER_SEARCH_SOURCES]);
+    printf("Dijkstra edges scanned: %g\n", counters.counts[IGRAPH_COUNTER_EDGES_SCANNED]);
+    printf("heap operations > 0: %s\n",
+           counters.counts[IGRAPH_COUNTER_HEAP_OPERATIONS] > 0 ? "yes" : "no");
+    printf("shortest path calls: %g\n", counters.calls[IGRAPH_TIMER_SHORTEST_PATHS]);
+    igraph_matrix_destroy(&dist);
+    igraph_vector_destroy(&weights);
+
+    /* Maximum flow counts push and relabel operations */
+    igraph_counters_reset();
+    igraph_maxflow_value(&graph, &flow, 0, 5, NULL, NULL);
+    igraph_counters_get(&counters);
+    printf("flow: %g, pushes > 0: %s, maxflow calls: %g\n", flow,
+           counters.counts[IGRAPH_COUNTER_FLOW_PUSHES] > 0 ? "yes" : "no",
+           counters.calls[IGRAPH_TIMER_MAXFLOW]);
+    igraph_destroy(&graph);
+
+    /* PageRank and community detection */
+    igraph_counters_reset();
+    igraph_famous(&graph, "Zachary");
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_PRPACK, &res, NULL,
+                    igraph_vss_all(), IGRAPH_UNDIRECTED, 0.85, NULL, NULL);
+    igraph_community_multilevel(&graph, NULL, &res, NULL, NULL);
+    igraph_counters_get(&counters);
+    printf("pagerank calls: %g, community calls: %g, moves > 0: %s\n",
+           counters.calls[IGRAPH_TIMER_PAGERANK],
+           counters.calls[IGRAPH_TIMER_COMMUNITY],
+           counters.counts[IGRAPH_COUNTER_COMMUNITY_MOVES] > 0 ? "yes" : "no");
+    igraph_destroy(&graph);
+
+    /* Failed calls stop the timers without recording them */
+    igraph_counters_reset();
+    igraph_set_error_handler(igraph_error_handler_ignore);
+    igraph_small(&graph, 3, IGRAPH_DIRECTED, 0, 1, 1, 2, -1);
+    if (igraph_maxflow_value(&graph, &flow, 0, 10, NULL, NULL) == IGRAPH_SUCCESS) {
+        return 3;
+    }
+    igraph_maxflow_value(&graph, &flow, 0, 2, NULL, NULL);
+    igraph_counters_get(&counters);
+    printf("maxflow calls after a failure: %g\n", counters.calls[IGRAPH_TIMER_MAXFLOW]);
+    igraph_destroy(&graph);
+
+    /* Names and JSON export */
+    for (i = 0; i < IGRAPH_COUNTER_NUM; i++) {
+        printf("%s ", igraph_counter_name(i));
+    }
+    printf("\n");
+    for (i = 0; i < IGRAPH_TIMER_NUM; i++) {
+        printf("%s ", igraph_timer_name(i));
+    }
+    printf("\n");
+    if (igraph_counter_name(IGRAPH_COUNTER_NUM) != NULL) {
+        return 4;
+    }
+
+    igraph_counters_reset();
+    igraph_counters_get(&counters);
+    counters.seconds[IGRAPH_TIMER_PAGERANK] = 0.5;
+    counters.calls[IGRAPH_TIMER_PAGERANK] = 2;
+    igraph_counters_write_json(&counters, stdout);
+
+    igraph_set_counters(0);
+    igraph_vector_destroy(&res);
+
+    VERIFY_FINALLY_STACK();
+    return 0;
+}
@@ -0,0 +1,246 @@
+#include <igraph.h>
+#include <stdio.h>
+#include <limits.h>
+
+#include "igraph_interface_internal.h"
+#include "test_utilities.inc"
+
+/* The index of the graph must be the one that igraph_create() builds */
+int check_index(const igraph_t *graph) {
+    igraph_t g;
+    igraph_vector_t edges;
+    int ret = 0;
+
+    igraph_vector_init(&edges, 0);
+    igraph_get_edgelist(graph, &edges, 0);
+    igraph_create(&g, &edges, igraph_vcount(graph), igraph_is_directed(graph));
+    if (!igraph_vector_all_e(&g.from, &graph->from) ||
+        !igraph_vector_all_e(&g.to, &graph->to) ||
+        !igraph_vector_all_e(&g.oi, &graph->oi) ||
+        !igraph_vector_all_e(&g.ii, &graph->ii) ||
+        !igraph_vector_all_e(&g.os, &graph->os) ||
+        !igraph_vector_all_e(&g.is, &graph->is)) {
+        ret = 1;
+    }
+    igraph_destroy(&g);
+    igraph_vector_destroy(&edges);
+    return ret;
+}
+
+void print_csr(const igraph_vector_int_t *offsets,
+               const igraph_vector_int_t *indices,
+               const igraph_vector_t *values) {
+    long int i, k;
+    for (i = 0; i < igraph_vector_int_size(offsets) - 1; i++) {
+        printf("%ld:", i);
+        for (k = VECTOR(*offsets)[i]; k < VECTOR(*offsets)[i + 1]; k++) {
+            printf(" %d (%g)", VECTOR(*indices)[k], VECTOR(*values)[k]);
+        }
+        printf("\n");
+    }
+}
+
+void reverse_rows(const igraph_vector_int_t *offsets,
+                  igraph_vector_int_t *indices, igraph_vector_t *values) {
+    long int i, k, l;
+    for (i = 0; i < igraph_vector_int_size(offsets) - 1; i++) {
+        for (k = VECTOR(*offsets)[i], l = VECTOR(*offsets)[i + 1] - 1; k < l; k++, l--) {
+            int tmp = VECTOR(*indices)[k];
+            igraph_real_t tmp2 = VECTOR(*values)[k];
+            VECTOR(*indices)[k] = VECTOR(*indices)[l];
+            VECTOR(*indices)[l] = tmp;
+            VECTOR(*values)[k] = VECTOR(*values)[l];
+            VECTOR(*values)[l] = tmp2;
+        }
+    }
+}
+
+/* Exporting, importing and exporting again must give the same matrix,
+   with the weights following the edges; the import must also work
+   with rows in reverse order */
+int check_round_trip(const igraph_t *graph, igraph_neimode_t mode) {
+    igraph_t g;
+    igraph_vector_int_t offsets, indices, offsets2, indices2;
+    igraph_vector_t weights, values, weights2, values2;
+    igraph_bool_t directed = igraph_is_directed(graph);
+    long int j, k;
+    int ret = 0;
+
+    igraph_vector_int_init(&offsets, 0);
+    igraph_vector_int_init(&indices, 0);
+    igraph_vector_int_init(&offsets2, 0);
+    igraph_vector_int_init(&indices2, 0);
+    igraph_vector_init(&values, 0);
+    igraph_vector_init(&weights2, 0);
+    igraph_vector_init(&values2, 0);
+    igraph_vector_init_seq(&weights, 0, igraph_ecount(graph) - 1);
+
+    igraph_get_csr(graph, &offsets, &indices, &weights, &values, mode);
+    for (j = 0; j < 2 && !ret; j++) {
+        if (j == 1) {
+            reverse_rows(&offsets, &indices, &values);
+        }
+        igraph_create_from_csr(&g, &offsets, &indices, &values, &weights2,
+                               directed, mode);
+        if (check_index(&g)) {
+            ret = 1;
+        }
+        igraph_get_csr(&g, &offsets2, &indices2, &weights2, &values2, mode);
+        if (j == 0 && (!igraph_vector_int_all_e(&offsets, &offsets2) ||
+                       !igraph_vector_int_all_e(&indices, &indices2) ||
+                       !igraph_vector_all_e(&values, &values2))) {
+            ret = 2;
+        }
+        /* The weights are the ids of the edges of the original graph */
+        for (k = 0; k < igraph_ecount(&g) && !ret; k++) {
+            long int e = VECTOR(weights2)[k];
+            if (IGRAPH_FROM(&g, k) != IGRAPH_FROM(graph, e) ||
+                IGRAPH_TO(&g, k) != IGRAPH_TO(graph, e)) {
+                ret = 3;
+            }
+        }
+        igraph_destroy(&g);
+    }
+
+    igraph_vector_destroy(&weights);
+    igraph_vector_destroy(&values2);
+    igraph_vector_destroy(&weights2);
+    igraph_vector_destroy(&values);
+    igraph_vector_int_destroy(&indices2);
+    igraph_vector_int_destroy(&offsets2);
+    igraph_vector_int_destroy(&indices);
+    igraph_vector_int_destroy(&offsets);
+    return ret;
+}
+
+int main() {
+    igraph_t g;
+    igraph_vector_int_t offsets, indices;
+    igraph_vector_t weights, values;
+    int i, ret;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    igraph_vector_int_init(&offsets, 0);
+    igraph_vector_int_init(&indices, 0);
+    igraph_vector_init(&values, 0);
+    igraph_vector_init_seq(&weights, 1, 8);
+
+    /* A multigraph with a loop edge */
+    igraph_small(&g, 4, IGRAPH_DIRECTED,
+                 0, 1, 0, 1, 1, 0, 2, 2, 2, 1, 3, 0, 0, 3, 1, 3, -1);
+    printf("out:\n");
+    igraph_get_csr(&g, &offsets, &indices, &weights, &values, IGRAPH_OUT);
+    print_csr(&offsets, &indices, &values);
+    printf("in:\n");
+    igraph_get_csr(&g, &offsets, &indices, &weights, &values, IGRAPH_IN);
+    print_csr(&offsets, &indices, &values);
+    printf("all:\n");
+    igraph_get_csr(&g, &offsets, &indices, &weights, &values, IGRAPH_ALL);
+    print_csr(&offsets, &indices, &values);
+    igraph_to_undirected(&g, IGRAPH_TO_UNDIRECTED_EACH, 0);
+    printf("undirected:\n");
+    igraph_get_csr(&g, &offsets, &indices, &weights, &values, IGRAPH_OUT);
+    print_csr(&offsets, &indices, &values);
+    igraph_destroy(&g);
+
+    /* Importing the undirected matrix */
+    igraph_create_from_csr(&g, &offsets, &indices, &values, &weights,
+                           IGRAPH_UNDIRECTED, IGRAPH_OUT);
+    print_graph(&g, stdout);
+    igraph_vector_print(&weights);
+    igraph_destroy(&g);
+
+    /* The null graph and a graph without edges */
+    for (i = 0; i < 2; i++) {
+        igraph_empty(&g, i * 3, IGRAPH_DIRECTED);
+        if ((ret = check_round_trip(&g, IGRAPH_OUT))) {
+            return ret;
+        }
+        igraph_destroy(&g);
+    }
+
+    /* Random multigraphs with loop edges */
+    for (i = 0; i < 20; i++) {
+        igraph_vector_t edges;
+        igraph_erdos_renyi_game(&g, IGRAPH_ERDOS_RENYI_GNM, 30, 100,
+                                i % 2 ? IGRAPH_DIRECTED : IGRAPH_UNDIRECTED,
+                                IGRAPH_LOOPS);
+        igraph_vector_init(&edges, 0);
+        igraph_get_edgelist(&g, &edges, 0);
+        igraph_vector_resize(&edges, 40);
+        igraph_add_edges(&g, &edges, 0);
+        igraph_vector_destroy(&edges);
+        if ((ret = check_round_trip(&g, IGRAPH_OUT)) ||
+            (ret = check_round_trip(&g, IGRAPH_IN))) {
+            return 10 + ret;
+        }
+        igraph_destroy(&g);
+    }
+
+    /* Invalid input */
+    igraph_set_error_handler(igraph_error_handler_ignore);
+    igraph_vector_int_resize(&offsets, 3);
+    igraph_vector_int_resize(&indices, 2);
+    VECTOR(offsets)[0] = 0; VECTOR(offsets)[1] = 1; VECTOR(offsets)[2] = 2;
+    VECTOR(indices)[0] = 1; VECTOR(indices)[1] = 2;
+    if (igraph_create_from_csr(&g, &offsets, &indices, 0, 0, IGRAPH_DIRECTED,
+                               IGRAPH_OUT) != IGRAPH_EINVVID) {
+        return 20;
+    }
+    VECTOR(indices)[1] = 0; VECTOR(offsets)[2] = 1;
+    if (igraph_create_from_csr(&g, &offsets, &indices, 0, 0, IGRAPH_DIRECTED,
+                               IGRAPH_OUT) != IGRAPH_EINVAL) {
+        return 21;
+    }
+    VECTOR(offsets)[1] = 3; VECTOR(offsets)[2] = 2;
+    if (igraph_create_from_csr(&g, &offsets, &indices, 0, 0, IGRAPH_DIRECTED,
+                               IGRAPH_OUT) != IGRAPH_EINVAL) {
+        return 22;
+    }
+    VECTOR(offsets)[1] = 1;
+    if (igraph_create_from_csr(&g, &offsets, &indices, 0, 0, IGRAPH_DIRECTED,
+                               IGRAPH_ALL) != IGRAPH_EINVAL) {
+        return 23;
+    }
+    igraph_vector_resize(&weights, 3);
+    if (igraph_create_from_csr(&g, &offsets, &indices, &weights, 0,
+                               IGRAPH_DIRECTED, IGRAPH_OUT) != IGRAPH_EINVAL) {
+        return 24;
+    }
+
+    /* The number of entries must fit into an int */
+    {
+        long int nnz;
+        if (igraph_i_csr_nnz(IGRAPH_DIRECTED, IGRAPH_ALL, INT_MAX / 2, 0,
+                             &nnz) != IGRAPH_SUCCESS || nnz != INT_MAX - 1) {
+            return 25;
+        }
+        if (igraph_i_csr_nnz(IGRAPH_DIRECTED, IGRAPH_ALL, INT_MAX / 2 + 1, 0,
+                             &nnz) != IGRAPH_EOVERFLOW) {
+            return 26;
+        }
+        if (igraph_i_csr_nnz(IGRAPH_DIRECTED, IGRAPH_OUT, INT_MAX / 2 + 1, 0,
+                             &nnz) != IGRAPH_SUCCESS) {
+            return 27;
+        }
+        if (igraph_i_csr_nnz(IGRAPH_UNDIRECTED, IGRAPH_ALL, INT_MAX / 2 + 1, 1,
+                             &nnz) != IGRAPH_SUCCESS || nnz != INT_MAX) {
+            return 28;
+        }
+        if (igraph_i_csr_nnz(IGRAPH_UNDIRECTED, IGRAPH_ALL, INT_MAX / 2 + 1, 0,
+                             &nnz) != IGRAPH_EOVERFLOW) {
+            return 29;
+        }
+    }
+    igraph_set_error_handler(igraph_error_handler_abort);
+
+    igraph_vector_destroy(&weights);
+    igraph_vector_destroy(&values);
+    igraph_vector_int_destroy(&indices);
+    igraph_vector_int_destroy(&offsets);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
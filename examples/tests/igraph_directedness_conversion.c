@@ -0,0 +1,211 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* The index of the graph must be the one that igraph_create() builds */
+int check_index(const igraph_t *graph) {
+    igraph_t g;
+    igraph_vector_t edges;
+
+    igraph_vector_init(&edges, 0);
+    igraph_get_edgelist(graph, &edges, 0);
+    igraph_create(&g, &edges, igraph_vcount(graph), igraph_is_directed(graph));
+    if (!igraph_vector_all_e(&g.from, &graph->from) ||
+        !igraph_vector_all_e(&g.to, &graph->to) ||
+        !igraph_vector_all_e(&g.oi, &graph->oi) ||
+        !igraph_vector_all_e(&g.ii, &graph->ii) ||
+        !igraph_vector_all_e(&g.os, &graph->os) ||
+        !igraph_vector_all_e(&g.is, &graph->is)) {
+        return 1;
+    }
+    igraph_destroy(&g);
+    igraph_vector_destroy(&edges);
+    return 0;
+}
+
+void set_weights(igraph_t *graph) {
+    long int i;
+    for (i = 0; i < igraph_ecount(graph); i++) {
+        SETEAN(graph, "weight", i, 1 << (i % 20));
+    }
+}
+
+void print_weighted(const igraph_t *graph) {
+    long int i;
+    for (i = 0; i < igraph_ecount(graph); i++) {
+        printf("%ld %ld: %g\n", (long int) IGRAPH_FROM(graph, i),
+               (long int) IGRAPH_TO(graph, i), EAN(graph, "weight", i));
+    }
+}
+
+/* Collapsing must give the same edges as keeping each edge and
+   simplifying afterwards, but simplification orders them differently */
+int check_collapse(const igraph_t *graph,
+                   const igraph_attribute_combination_t *comb) {
+    igraph_t g1, g2;
+    long int i;
+    int ret = 0;
+
+    igraph_copy(&g1, graph);
+    igraph_to_undirected(&g1, IGRAPH_TO_UNDIRECTED_COLLAPSE, comb);
+    igraph_copy(&g2, graph);
+    igraph_to_undirected(&g2, IGRAPH_TO_UNDIRECTED_EACH, comb);
+    igraph_simplify(&g2, /*multiple=*/ 1, /*loops=*/ 0, comb);
+
+    if (check_index(&g1) || igraph_ecount(&g1) != igraph_ecount(&g2)) {
+        ret = 1;
+    }
+    for (i = 0; i < igraph_ecount(&g1) && !ret; i++) {
+        igraph_integer_t eid;
+        igraph_get_eid(&g2, &eid, IGRAPH_FROM(&g1, i), IGRAPH_TO(&g1, i),
+                       IGRAPH_UNDIRECTED, /*error=*/ 1);
+        if (EAN(&g1, "weight", i) != EAN(&g2, "weight", eid)) {
+            ret = 2;
+        }
+    }
+    igraph_destroy(&g2);
+    igraph_destroy(&g1);
+    return ret;
+}
+
+/* Every new edge must be a pair of mutual edges */
+int check_mutual(const igraph_t *graph,
+                 const igraph_attribute_combination_t *comb) {
+    igraph_t g;
+    long int i, n = igraph_vcount(graph), count = 0;
+    igraph_matrix_t adj;
+    int ret = 0;
+
+    igraph_copy(&g, graph);
+    igraph_to_undirected(&g, IGRAPH_TO_UNDIRECTED_MUTUAL, comb);
+    if (check_index(&g)) {
+        ret = 1;
+    }
+
+    /* The number of pairs is the sum of min(A_ij, A_ji) over the pairs
+       i > j, plus the number of loop edges */
+    igraph_matrix_init(&adj, 0, 0);
+    igraph_get_adjacency(graph, &adj, IGRAPH_GET_ADJACENCY_BOTH, 0);
+    for (i = 0; i < n; i++) {
+        long int j;
+        for (j = 0; j < i; j++) {
+            count += MATRIX(adj, i, j) < MATRIX(adj, j, i) ?
+                     MATRIX(adj, i, j) : MATRIX(adj, j, i);
+        }
+        count += MATRIX(adj, i, i);
+    }
+    if (count != igraph_ecount(&g)) {
+        ret = 2;
+    }
+    igraph_matrix_destroy(&adj);
+    igraph_destroy(&g);
+    return ret;
+}
+
+/* Edge i must point from its smaller to its larger endpoint, and in
+   mutual mode, edge m + i must be its reverse */
+int check_directed(const igraph_t *graph, igraph_to_directed_t mode) {
+    igraph_t g;
+    long int i, m = igraph_ecount(graph);
+    int ret = 0;
+
+    igraph_copy(&g, graph);
+    igraph_to_directed(&g, mode);
+    if (check_index(&g)) {
+        ret = 1;
+    }
+    if (igraph_ecount(&g) != (mode == IGRAPH_TO_DIRECTED_MUTUAL ? 2 * m : m)) {
+        ret = 2;
+    }
+    for (i = 0; i < m && !ret; i++) {
+        if (IGRAPH_FROM(&g, i) != IGRAPH_TO(graph, i) ||
+            IGRAPH_TO(&g, i) != IGRAPH_FROM(graph, i) ||
+            EAN(&g, "weight", i) != EAN(graph, "weight", i)) {
+            ret = 3;
+        }
+        if (mode == IGRAPH_TO_DIRECTED_MUTUAL &&
+            (IGRAPH_FROM(&g, m + i) != IGRAPH_FROM(graph, i) ||
+             IGRAPH_TO(&g, m + i) != IGRAPH_TO(graph, i) ||
+             EAN(&g, "weight", m + i) != EAN(graph, "weight", i))) {
+            ret = 4;
+        }
+    }
+    igraph_destroy(&g);
+    return ret;
+}
+
+int main() {
+    igraph_t g, g2;
+    igraph_attribute_combination_t comb;
+    int i, ret;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_i_set_attribute_table(&igraph_cattribute_table);
+    igraph_attribute_combination(&comb, "weight", IGRAPH_ATTRIBUTE_COMBINE_SUM,
+                                 IGRAPH_NO_MORE_ATTRIBUTES);
+
+    /* A multigraph with loop edges, the duplicates of 1 -> 0 have no
+       reverse pair */
+    igraph_small(&g, 4, IGRAPH_DIRECTED,
+                 1, 0, 1, 0, 2, 1, 1, 2, 1, 2, 2, 2, 2, 2, 3, 0, 0, 3, -1);
+    set_weights(&g);
+
+    printf("collapse:\n");
+    igraph_copy(&g2, &g);
+    igraph_to_undirected(&g2, IGRAPH_TO_UNDIRECTED_COLLAPSE, &comb);
+    print_weighted(&g2);
+    igraph_destroy(&g2);
+
+    printf("mutual:\n");
+    igraph_copy(&g2, &g);
+    igraph_to_undirected(&g2, IGRAPH_TO_UNDIRECTED_MUTUAL, &comb);
+    print_weighted(&g2);
+    if (check_index(&g2)) {
+        return 1;
+    }
+
+    printf("arbitrary:\n");
+    igraph_to_directed(&g2, IGRAPH_TO_DIRECTED_ARBITRARY);
+    print_weighted(&g2);
+    igraph_to_undirected(&g2, IGRAPH_TO_UNDIRECTED_EACH, &comb);
+
+    printf("mutual:\n");
+    igraph_to_directed(&g2, IGRAPH_TO_DIRECTED_MUTUAL);
+    print_weighted(&g2);
+    igraph_destroy(&g2);
+
+    if ((ret = check_collapse(&g, &comb)) || (ret = check_mutual(&g, &comb))) {
+        return 10 + ret;
+    }
+    igraph_destroy(&g);
+
+    /* Random multigraphs with loop edges */
+    for (i = 0; i < 20; i++) {
+        igraph_vector_t edges;
+        igraph_erdos_renyi_game(&g, IGRAPH_ERDOS_RENYI_GNM, 30, 100,
+                                IGRAPH_DIRECTED, IGRAPH_LOOPS);
+        igraph_vector_init(&edges, 0);
+        igraph_get_edgelist(&g, &edges, 0);
+        igraph_vector_resize(&edges, 40);
+        igraph_add_edges(&g, &edges, 0);
+        igraph_vector_destroy(&edges);
+        set_weights(&g);
+        if ((ret = check_collapse(&g, &comb)) || (ret = check_mutual(&g, &comb))) {
+            return 20 + ret;
+        }
+
+        igraph_to_undirected(&g, IGRAPH_TO_UNDIRECTED_EACH, &comb);
+        if ((ret = check_directed(&g, IGRAPH_TO_DIRECTED_ARBITRARY)) ||
+            (ret = check_directed(&g, IGRAPH_TO_DIRECTED_MUTUAL))) {
+            return 30 + ret;
+        }
+        igraph_destroy(&g);
+    }
+
+    igraph_attribute_combination_destroy(&comb);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
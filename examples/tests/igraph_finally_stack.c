@@ -0,0 +1,68 @@
+
+#include <igraph.h>
+
+#include "test_utilities.inc"
+
+#define DEPTH 10000
+
+static long int destroyed[DEPTH], ndestroyed = 0;
+
+static void record_destroy(long int *i) {
+    destroyed[ndestroyed++] = *i;
+}
+
+static long int ids[DEPTH];
+
+/* Registers objects recursively, much deeper than the initial size of the
+   finally stack, then fails at the bottom. */
+static int deep(long int level) {
+    ids[level] = level;
+    IGRAPH_FINALLY(record_destroy, &ids[level]);
+    if (level == DEPTH - 1) {
+        IGRAPH_ERROR("Bottom reached", IGRAPH_FAILURE);
+    }
+    IGRAPH_CHECK(deep(level + 1));
+    IGRAPH_FINALLY_CLEAN(1);
+    return 0;
+}
+
+int main() {
+    long int i;
+    int mark;
+
+    /* All objects are destroyed, in reverse order, when an error occurs */
+    igraph_set_error_handler(igraph_error_handler_ignore);
+    if (deep(0) != IGRAPH_FAILURE) {
+        return 1;
+    }
+    igraph_set_error_handler(igraph_error_handler_abort);
+    printf("Destroyed %ld objects\n", ndestroyed);
+    for (i = 0; i < DEPTH; i++) {
+        if (destroyed[i] != DEPTH - 1 - i) {
+            return 2;
+        }
+    }
+    VERIFY_FINALLY_STACK();
+
+    /* Scope markers */
+    ndestroyed = 0;
+    IGRAPH_FINALLY(record_destroy, &ids[0]);
+    mark = IGRAPH_FINALLY_STACK_SIZE();
+    for (i = 1; i < 300; i++) {
+        IGRAPH_FINALLY(record_destroy, &ids[i]);
+    }
+    printf("Stack size: %d\n", IGRAPH_FINALLY_STACK_SIZE());
+    IGRAPH_FINALLY_CLEAN_TO(mark);
+    printf("Stack size after restoring the mark: %d\n", IGRAPH_FINALLY_STACK_SIZE());
+    IGRAPH_FINALLY_CLEAN_TO(mark + 5);
+    printf("Stack size after restoring a higher mark: %d\n", IGRAPH_FINALLY_STACK_SIZE());
+    IGRAPH_FINALLY_FREE();
+    printf("Destroyed %ld objects\n", ndestroyed);
+    if (destroyed[0] != 0) {
+        return 3;
+    }
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* Large graphs and many pairs use a sorted batch lookup in
+   igraph_get_eids(); it must give the same edges as igraph_get_eid() */
+int check(const igraph_t *g, igraph_bool_t directed) {
+    igraph_vector_t pairs, path, eids;
+    long int no_of_nodes = igraph_vcount(g), no_of_edges = igraph_ecount(g);
+    long int i, n = no_of_nodes / 2;
+    igraph_integer_t eid;
+    int ret;
+
+    igraph_vector_init(&pairs, 2 * n);
+    igraph_vector_init(&path, n + 1);
+    igraph_vector_init(&eids, 0);
+
+    /* Existing edges in both orientations, and random pairs */
+    for (i = 0; i < n; i++) {
+        long int e = RNG_INTEGER(0, no_of_edges - 1);
+        if (i % 3 == 0) {
+            VECTOR(pairs)[2 * i] = IGRAPH_FROM(g, e);
+            VECTOR(pairs)[2 * i + 1] = IGRAPH_TO(g, e);
+        } else if (i % 3 == 1) {
+            VECTOR(pairs)[2 * i] = IGRAPH_TO(g, e);
+            VECTOR(pairs)[2 * i + 1] = IGRAPH_FROM(g, e);
+        } else {
+            VECTOR(pairs)[2 * i] = RNG_INTEGER(0, no_of_nodes - 1);
+            VECTOR(pairs)[2 * i + 1] = RNG_INTEGER(0, no_of_nodes - 1);
+        }
+        VECTOR(path)[i] = VECTOR(pairs)[2 * i];
+    }
+    VECTOR(path)[n] = VECTOR(pairs)[1];
+
+    igraph_get_eids(g, &eids, &pairs, NULL, directed, /* error= */ 0);
+    for (i = 0; i < n; i++) {
+        igraph_get_eid(g, &eid, VECTOR(pairs)[2 * i], VECTOR(pairs)[2 * i + 1],
+                       directed, /* error= */ 0);
+        if (VECTOR(eids)[i] != eid) {
+            return 1;
+        }
+    }
+
+    igraph_get_eids(g, &eids, NULL, &path, directed, /* error= */ 0);
+    for (i = 0; i < n; i++) {
+        igraph_get_eid(g, &eid, VECTOR(path)[i], VECTOR(path)[i + 1],
+                       directed, /* error= */ 0);
+        if (VECTOR(eids)[i] != eid) {
+            return 2;
+        }
+    }
+
+    igraph_set_error_handler(igraph_error_handler_ignore);
+    ret = igraph_get_eids(g, &eids, &pairs, NULL, directed, /* error= */ 1);
+    igraph_set_error_handler(igraph_error_handler_abort);
+    if (ret != IGRAPH_EINVAL) {
+        return 3;
+    }
+
+    igraph_vector_destroy(&eids);
+    igraph_vector_destroy(&path);
+    igraph_vector_destroy(&pairs);
+    return 0;
+}
+
+int main() {
+    igraph_t g;
+    igraph_vector_t edges;
+    long int i;
+    int ret;
+
+    igraph_rng_seed(igraph_rng_default(), 3);
+
+    /* At least 2^20 edges, some of them multiple */
+    igraph_erdos_renyi_game(&g, IGRAPH_ERDOS_RENYI_GNM, 100000, 1 << 20,
+                            IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    igraph_vector_init(&edges, 2000);
+    for (i = 0; i < 1000; i++) {
+        long int e = RNG_INTEGER(0, igraph_ecount(&g) - 1);
+        VECTOR(edges)[2 * i] = IGRAPH_FROM(&g, e);
+        VECTOR(edges)[2 * i + 1] = IGRAPH_TO(&g, e);
+    }
+    igraph_add_edges(&g, &edges, NULL);
+    igraph_vector_destroy(&edges);
+
+    if ((ret = check(&g, /* directed= */ 1))) {
+        return ret;
+    }
+    if ((ret = check(&g, /* directed= */ 0))) {
+        return 10 + ret;
+    }
+    igraph_to_undirected(&g, IGRAPH_TO_UNDIRECTED_EACH, NULL);
+    if ((ret = check(&g, /* directed= */ 1))) {
+        return 20 + ret;
+    }
+    igraph_destroy(&g);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
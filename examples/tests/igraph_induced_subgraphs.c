@@ -0,0 +1,176 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* The new graph must have the same edge index as igraph_create() would
+   build, and each edge among the kept vertices exactly once, as told
+   by the "id" edge attribute */
+int check_subgraph(const igraph_t *g, const igraph_t *sub,
+                   const igraph_vector_t *invmap) {
+    igraph_t g2;
+    igraph_vector_t edges, seen;
+    long int i, count = 0;
+
+    igraph_vector_init(&edges, 0);
+    igraph_get_edgelist(sub, &edges, 0);
+    igraph_create(&g2, &edges, igraph_vcount(sub), igraph_is_directed(sub));
+    if (!igraph_vector_all_e(&sub->from, &g2.from) ||
+        !igraph_vector_all_e(&sub->to, &g2.to) ||
+        !igraph_vector_all_e(&sub->oi, &g2.oi) ||
+        !igraph_vector_all_e(&sub->ii, &g2.ii) ||
+        !igraph_vector_all_e(&sub->os, &g2.os) ||
+        !igraph_vector_all_e(&sub->is, &g2.is)) {
+        return 1;
+    }
+    igraph_destroy(&g2);
+    igraph_vector_destroy(&edges);
+
+    igraph_vector_init(&seen, igraph_ecount(g));
+    for (i = 0; i < igraph_ecount(sub); i++) {
+        long int eid = (long int) EAN(sub, "id", i);
+        long int from = (long int) VECTOR(*invmap)[IGRAPH_FROM(sub, i)];
+        long int to = (long int) VECTOR(*invmap)[IGRAPH_TO(sub, i)];
+        if (VECTOR(seen)[eid] || IGRAPH_FROM(g, eid) != from ||
+            IGRAPH_TO(g, eid) != to) {
+            return 2;
+        }
+        VECTOR(seen)[eid] = 1;
+    }
+    for (i = 0; i < igraph_vector_size(invmap); i++) {
+        if (VAN(sub, "id", i) != VECTOR(*invmap)[i]) {
+            return 3;
+        }
+    }
+    for (i = 0; i < igraph_ecount(g); i++) {
+        if (igraph_vector_binsearch2(invmap, IGRAPH_FROM(g, i)) &&
+            igraph_vector_binsearch2(invmap, IGRAPH_TO(g, i))) {
+            count++;
+        }
+    }
+    if (count != igraph_ecount(sub)) {
+        return 4;
+    }
+    igraph_vector_destroy(&seen);
+    return 0;
+}
+
+int main() {
+    igraph_t g, sub;
+    igraph_vector_t edges, invmap, ids, *vs;
+    igraph_vector_ptr_t vids, subs;
+    long int i, k, ret;
+
+    igraph_i_set_attribute_table(&igraph_cattribute_table);
+    igraph_rng_seed(igraph_rng_default(), 11);
+
+    /* Multiple loop edges are all kept, once */
+    igraph_small(&g, 4, IGRAPH_UNDIRECTED, 0, 1, 1, 1, 2, 1, 1, 1, 1, 2, 3, 0,
+                 -1);
+    igraph_vector_init_int(&ids, 6, 0, 1, 2, 3, 4, 5);
+    SETEANV(&g, "id", &ids);
+    igraph_vector_init_int(&invmap, 3, 2, 1, 1);
+    igraph_induced_subgraph(&g, &sub, igraph_vss_vector(&invmap),
+                            IGRAPH_SUBGRAPH_CREATE_FROM_SCRATCH);
+    print_graph(&sub, stdout);
+    for (i = 0; i < igraph_ecount(&sub); i++) {
+        printf("%g ", EAN(&sub, "id", i));
+    }
+    printf("\n");
+    igraph_destroy(&sub);
+    igraph_vector_destroy(&invmap);
+    igraph_vector_destroy(&ids);
+    igraph_destroy(&g);
+
+    /* Random multigraphs with loops, random vertex sets with duplicates */
+    igraph_vector_init(&edges, 600);
+    igraph_vector_init(&invmap, 0);
+    igraph_vector_init(&ids, 0);
+    igraph_vector_ptr_init(&vids, 0);
+    igraph_vector_ptr_init(&subs, 0);
+    for (k = 0; k < 10; k++) {
+        for (i = 0; i < 600; i++) {
+            VECTOR(edges)[i] = RNG_INTEGER(0, 39);
+        }
+        igraph_create(&g, &edges, 40, k % 2);
+        igraph_vector_resize(&ids, igraph_ecount(&g));
+        for (i = 0; i < igraph_ecount(&g); i++) {
+            VECTOR(ids)[i] = i;
+        }
+        SETEANV(&g, "id", &ids);
+        igraph_vector_resize(&ids, igraph_vcount(&g));
+        SETVANV(&g, "id", &ids);
+
+        for (i = 0; i < 5; i++) {
+            long int j, n = RNG_INTEGER(0, 50);
+            vs = igraph_Calloc(1, igraph_vector_t);
+            igraph_vector_init(vs, n);
+            for (j = 0; j < n; j++) {
+                VECTOR(*vs)[j] = RNG_INTEGER(0, 39);
+            }
+            igraph_vector_ptr_push_back(&vids, vs);
+
+            igraph_induced_subgraph_map(&g, &sub, igraph_vss_vector(vs),
+                                        IGRAPH_SUBGRAPH_CREATE_FROM_SCRATCH,
+                                        NULL, &invmap);
+            if ((ret = check_subgraph(&g, &sub, &invmap))) {
+                return 10 * k + ret;
+            }
+            igraph_destroy(&sub);
+        }
+
+        /* The batched version gives the same subgraphs */
+        igraph_induced_subgraphs(&g, &subs, &vids);
+        if (igraph_vector_ptr_size(&subs) != 5) {
+            return 100;
+        }
+        for (i = 0; i < 5; i++) {
+            igraph_t *sub2 = VECTOR(subs)[i];
+            igraph_vector_t el1, el2;
+            igraph_induced_subgraph(&g, &sub, igraph_vss_vector(VECTOR(vids)[i]),
+                                    IGRAPH_SUBGRAPH_CREATE_FROM_SCRATCH);
+            igraph_vector_init(&el1, 0);
+            igraph_vector_init(&el2, 0);
+            igraph_get_edgelist(&sub, &el1, 0);
+            igraph_get_edgelist(sub2, &el2, 0);
+            if (igraph_vcount(&sub) != igraph_vcount(sub2) ||
+                !igraph_vector_all_e(&el1, &el2)) {
+                return 101;
+            }
+            igraph_cattribute_EANV(sub2, "id", igraph_ess_all(IGRAPH_EDGEORDER_ID), &el2);
+            igraph_cattribute_EANV(&sub, "id", igraph_ess_all(IGRAPH_EDGEORDER_ID), &el1);
+            if (!igraph_vector_all_e(&el1, &el2)) {
+                return 102;
+            }
+            igraph_vector_destroy(&el2);
+            igraph_vector_destroy(&el1);
+            igraph_destroy(&sub);
+        }
+        igraph_decompose_destroy(&subs);
+        for (i = 0; i < 5; i++) {
+            igraph_vector_destroy(VECTOR(vids)[i]);
+            igraph_free(VECTOR(vids)[i]);
+        }
+        igraph_vector_ptr_clear(&vids);
+        igraph_destroy(&g);
+    }
+
+    /* The default implementation keeps the order of the edges if most
+       vertices are kept */
+    igraph_small(&g, 5, IGRAPH_UNDIRECTED, 3, 4, 0, 1, 2, 3, 1, 2, 0, 4, -1);
+    igraph_induced_subgraph(&g, &sub, igraph_vss_seq(0, 3), IGRAPH_SUBGRAPH_AUTO);
+    igraph_get_edgelist(&sub, &edges, 0);
+    igraph_vector_print(&edges);
+    igraph_destroy(&sub);
+    igraph_destroy(&g);
+
+    igraph_vector_ptr_destroy(&subs);
+    igraph_vector_ptr_destroy(&vids);
+    igraph_vector_destroy(&ids);
+    igraph_vector_destroy(&invmap);
+    igraph_vector_destroy(&edges);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
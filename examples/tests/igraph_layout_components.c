@@ -0,0 +1,95 @@
+
+#include <igraph.h>
+#include <math.h>
+
+#include "test_utilities.inc"
+
+static int circle_layout(const igraph_t *graph, igraph_matrix_t *res,
+                         void *extra) {
+    int *calls = extra;
+    (*calls)++;
+    return igraph_layout_circle(graph, res, igraph_vss_all());
+}
+
+static int bad_layout(const igraph_t *graph, igraph_matrix_t *res,
+                      void *extra) {
+    IGRAPH_UNUSED(graph);
+    IGRAPH_UNUSED(extra);
+    return igraph_matrix_resize(res, 1, 3);
+}
+
+static void print_rounded(igraph_matrix_t *m) {
+    long int i, j;
+    for (i = 0; i < igraph_matrix_nrow(m); i++) {
+        for (j = 0; j < igraph_matrix_ncol(m); j++) {
+            if (fabs(MATRIX(*m, i, j)) < 1e-8) {
+                MATRIX(*m, i, j) = 0;
+            }
+        }
+    }
+    igraph_matrix_printf(m, "%.4f");
+}
+
+int main() {
+    igraph_t g;
+    igraph_matrix_t m1, m2, m3, res;
+    igraph_vector_ptr_t coords;
+    int calls = 0;
+    int ret;
+
+    /* Packing a few hand-made layouts */
+    igraph_matrix_init(&m1, 2, 2);
+    MATRIX(m1, 0, 0) = -1; MATRIX(m1, 0, 1) = -1;
+    MATRIX(m1, 1, 0) =  1; MATRIX(m1, 1, 1) =  2;
+    igraph_matrix_init(&m2, 1, 2);
+    MATRIX(m2, 0, 0) = 5; MATRIX(m2, 0, 1) = 5;
+    igraph_matrix_init(&m3, 0, 2);
+
+    igraph_vector_ptr_init(&coords, 3);
+    VECTOR(coords)[0] = &m1;
+    VECTOR(coords)[1] = &m3;
+    VECTOR(coords)[2] = &m2;
+
+    igraph_matrix_init(&res, 0, 0);
+    igraph_layout_merge_pack(&coords, &res, 1.0);
+    print_rounded(&res);
+    printf("==============\n");
+
+    /* No layouts at all */
+    igraph_vector_ptr_resize(&coords, 0);
+    igraph_layout_merge_pack(&coords, &res, 1.0);
+    printf("%ld %ld\n", igraph_matrix_nrow(&res), igraph_matrix_ncol(&res));
+    printf("==============\n");
+
+    /* Three components: a ring, a path and an isolated vertex, with
+       interleaved vertex ids */
+    igraph_small(&g, 8, IGRAPH_UNDIRECTED,
+                 0, 2, 2, 4, 4, 6, 6, 0, 1, 3, 3, 7,
+                 -1);
+    igraph_layout_components(&g, &res, circle_layout, &calls, 1.0);
+    printf("calls: %d\n", calls);
+    print_rounded(&res);
+    printf("==============\n");
+
+    /* Invalid layout function result */
+    igraph_set_error_handler(igraph_error_handler_ignore);
+    ret = igraph_layout_components(&g, &res, bad_layout, 0, 1.0);
+    if (ret != IGRAPH_EINVAL) {
+        return 1;
+    }
+    ret = igraph_layout_merge_pack(&coords, &res, -1.0);
+    if (ret != IGRAPH_EINVAL) {
+        return 2;
+    }
+
+    igraph_destroy(&g);
+    igraph_matrix_destroy(&res);
+    igraph_vector_ptr_destroy(&coords);
+    igraph_matrix_destroy(&m3);
+    igraph_matrix_destroy(&m2);
+    igraph_matrix_destroy(&m1);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+
+#include <igraph.h>
+#include <math.h>
+
+#include "test_utilities.inc"
+
+static igraph_real_t dist(const igraph_matrix_t *m, long int i, long int j) {
+    igraph_real_t dx = MATRIX(*m, i, 0) - MATRIX(*m, j, 0);
+    igraph_real_t dy = MATRIX(*m, i, 1) - MATRIX(*m, j, 1);
+    return sqrt(dx * dx + dy * dy);
+}
+
+static igraph_bool_t all_finite(const igraph_matrix_t *m) {
+    long int i, n = igraph_matrix_size(m);
+    for (i = 0; i < n; i++) {
+        if (!igraph_finite(VECTOR(m->data)[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main() {
+    igraph_t g;
+    igraph_matrix_t res, old;
+    igraph_vector_t edges, changed;
+    long int i, moved = 0, unchanged_ok = 1;
+    int ret;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    /* A ring, laid out from scratch */
+    igraph_ring(&g, 30, IGRAPH_UNDIRECTED, /* mutual= */ 0, /* circular= */ 1);
+    igraph_matrix_init(&res, 0, 0);
+    igraph_layout_fruchterman_reingold(&g, &res, /* use_seed= */ 0, 500,
+                                       sqrt(30), IGRAPH_LAYOUT_NOGRID,
+                                       NULL, NULL, NULL, NULL, NULL);
+    igraph_matrix_copy(&old, &res);
+
+    /* Two new vertices hanging from vertex 0 and a chord between 10 and 20 */
+    igraph_add_vertices(&g, 2, 0);
+    igraph_vector_init_int(&edges, 6, 30, 0, 31, 30, 10, 20);
+    igraph_add_edges(&g, &edges, 0);
+    igraph_vector_init_int(&changed, 2, 10, 20);
+
+    if (igraph_layout_fruchterman_reingold_incremental(
+            &g, &res, igraph_vss_vector(&changed), /* radius= */ 1,
+            /* niter= */ 30, /* start_temp= */ 1, NULL)) {
+        return 1;
+    }
+
+    printf("Size: %ld x %ld\n", igraph_matrix_nrow(&res), igraph_matrix_ncol(&res));
+    printf("Finite: %d\n", all_finite(&res));
+
+    /* Vertices far from the changes keep their positions */
+    for (i = 0; i < 30; i++) {
+        igraph_bool_t affected = i == 0 || i == 1 || i == 29 || i == 9 ||
+                                 i == 10 || i == 11 || i == 19 || i == 20 ||
+                                 i == 21;
+        if (affected) {
+            moved += MATRIX(res, i, 0) != MATRIX(old, i, 0) ||
+                     MATRIX(res, i, 1) != MATRIX(old, i, 1);
+        } else if (MATRIX(res, i, 0) != MATRIX(old, i, 0) ||
+                   MATRIX(res, i, 1) != MATRIX(old, i, 1)) {
+            unchanged_ok = 0;
+        }
+    }
+    printf("Unaffected vertices unchanged: %d\n", (int) unchanged_ok);
+    printf("Affected vertices moved: %d\n", moved > 0);
+
+    /* New vertices end up near their neighbors */
+    printf("New vertices placed near neighbors: %d\n",
+           dist(&res, 30, 0) < 3 && dist(&res, 31, 30) < 3);
+
+    /* The chord pulls its endpoints closer */
+    printf("Chord shortened: %d\n", dist(&res, 10, 20) < dist(&old, 10, 20));
+
+    /* Radius zero, no new vertices: only the changed vertices move */
+    igraph_matrix_update(&old, &res);
+    if (igraph_layout_fruchterman_reingold_incremental(
+            &g, &res, igraph_vss_1(5), 0, 10, 1, NULL)) {
+        return 1;
+    }
+    unchanged_ok = 1;
+    for (i = 0; i < 32; i++) {
+        if (i != 5 && (MATRIX(res, i, 0) != MATRIX(old, i, 0) ||
+                       MATRIX(res, i, 1) != MATRIX(old, i, 1))) {
+            unchanged_ok = 0;
+        }
+    }
+    printf("Only vertex 5 moved: %d\n", (int) unchanged_ok);
+
+    /* Starting from an empty layout, every vertex is new */
+    igraph_matrix_resize(&res, 0, 0);
+    if (igraph_layout_fruchterman_reingold_incremental(
+            &g, &res, igraph_vss_none(), 1, 10, 1, NULL)) {
+        return 1;
+    }
+    printf("From scratch: %ld x %ld, finite: %d\n", igraph_matrix_nrow(&res),
+           igraph_matrix_ncol(&res), all_finite(&res));
+
+    /* Invalid arguments */
+    igraph_set_error_handler(igraph_error_handler_ignore);
+    igraph_matrix_resize(&res, 40, 2);
+    ret = igraph_layout_fruchterman_reingold_incremental(
+              &g, &res, igraph_vss_none(), 1, 10, 1, NULL);
+    printf("Too many rows: %d\n", ret == IGRAPH_EINVAL);
+    igraph_matrix_resize(&res, 32, 2);
+    ret = igraph_layout_fruchterman_reingold_incremental(
+              &g, &res, igraph_vss_none(), -1, 10, 1, NULL);
+    printf("Negative radius: %d\n", ret == IGRAPH_EINVAL);
+
+    igraph_vector_destroy(&changed);
+    igraph_vector_destroy(&edges);
+    igraph_matrix_destroy(&old);
+    igraph_matrix_destroy(&res);
+    igraph_destroy(&g);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+
+#include <igraph.h>
+
+#include "test_utilities.inc"
+
+int main() {
+    igraph_t g;
+    igraph_matrix_t coords;
+    igraph_vector_t edges;
+    long int i, n = 200000;
+    igraph_bool_t ok = 1;
+
+    igraph_matrix_init(&coords, 0, 0);
+
+    /* A long path rooted at one end; this used to take quadratic time and
+       recurse as deep as the tree */
+    igraph_ring(&g, n, IGRAPH_UNDIRECTED, /* mutual= */ 0, /* circular= */ 0);
+    igraph_vector_init_int(&edges, 1, 0);
+    igraph_layout_reingold_tilford(&g, &coords, IGRAPH_ALL, &edges, 0);
+    for (i = 0; i < n; i++) {
+        if (MATRIX(coords, i, 0) != 0 || MATRIX(coords, i, 1) != i) {
+            ok = 0;
+        }
+    }
+    printf("Path: %d\n", (int) ok);
+    igraph_destroy(&g);
+
+    /* A caterpillar: a long path with a leaf hanging from every vertex */
+    igraph_vector_resize(&edges, 0);
+    for (i = 0; i < n - 1; i++) {
+        igraph_vector_push_back(&edges, i);
+        igraph_vector_push_back(&edges, i + 1);
+        igraph_vector_push_back(&edges, i);
+        igraph_vector_push_back(&edges, n + i);
+    }
+    igraph_create(&g, &edges, 2 * n - 1, IGRAPH_DIRECTED);
+    igraph_layout_reingold_tilford(&g, &coords, IGRAPH_OUT, 0, 0);
+    printf("Caterpillar: %ld rows, root at (%g, %g), last leaf at (%g, %g)\n",
+           igraph_matrix_nrow(&coords), MATRIX(coords, 0, 0), MATRIX(coords, 0, 1),
+           MATRIX(coords, 2 * n - 2, 0), MATRIX(coords, 2 * n - 2, 1));
+    igraph_destroy(&g);
+
+    /* A small forest, the trees are placed next to each other */
+    igraph_small(&g, 9, IGRAPH_UNDIRECTED, 0, 1, 0, 2, 1, 3, 1, 4, 5, 6, 5, 7, 7, 8, -1);
+    igraph_layout_reingold_tilford(&g, &coords, IGRAPH_ALL, 0, 0);
+    igraph_matrix_print(&coords);
+    igraph_destroy(&g);
+
+    igraph_vector_destroy(&edges);
+    igraph_matrix_destroy(&coords);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "igraph_layout_internal.h"
+#include "test_utilities.inc"
+
+/* Counts the pairs of edges between the same layers whose endpoints are
+   in opposite order */
+static igraph_real_t brute_force_crossings(const igraph_t *graph,
+                                           const igraph_matrix_t *layout) {
+    long int i, j, m = igraph_ecount(graph);
+    igraph_real_t result = 0;
+    for (i = 0; i < m; i++) {
+        long int u1 = IGRAPH_FROM(graph, i), v1 = IGRAPH_TO(graph, i);
+        for (j = i + 1; j < m; j++) {
+            long int u2 = IGRAPH_FROM(graph, j), v2 = IGRAPH_TO(graph, j);
+            if (MATRIX(*layout, u1, 1) == MATRIX(*layout, u2, 1) &&
+                MATRIX(*layout, v1, 1) == MATRIX(*layout, v2, 1) &&
+                (MATRIX(*layout, u1, 0) - MATRIX(*layout, u2, 0)) *
+                (MATRIX(*layout, v1, 0) - MATRIX(*layout, v2, 0)) < 0) {
+                result++;
+            }
+        }
+    }
+    return result;
+}
+
+/* The crossings of the layout that igraph_layout_sugiyama() returns */
+static igraph_real_t layout_crossings(const igraph_t *graph,
+                                      const igraph_vector_t *layers,
+                                      long int maxiter,
+                                      igraph_matrix_t *layout) {
+    igraph_real_t crossings;
+    igraph_layout_sugiyama(graph, layout, NULL, NULL, layers, 1, 1, maxiter, NULL);
+    igraph_i_layout_sugiyama_crossings(graph, layout, &crossings);
+    return crossings;
+}
+
+int main() {
+    igraph_t g;
+    igraph_matrix_t layout;
+    igraph_vector_t edges, layers, perm;
+    igraph_real_t crossings;
+    long int i, j, k;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_vector_init(&edges, 0);
+    igraph_matrix_init(&layout, 0, 0);
+
+    /* Random layered multigraphs with random orderings */
+    for (k = 0; k < 50; k++) {
+        long int no_of_layers = RNG_INTEGER(2, 6), n = 0;
+        long int start[7];
+        start[0] = 0;
+        for (i = 0; i < no_of_layers; i++) {
+            start[i + 1] = start[i] + RNG_INTEGER(1, 8);
+        }
+        n = start[no_of_layers];
+        igraph_matrix_resize(&layout, n, 2);
+        for (i = 0; i < no_of_layers; i++) {
+            long int size = start[i + 1] - start[i];
+            igraph_vector_init_seq(&perm, 0, size - 1);
+            igraph_vector_shuffle(&perm);
+            for (j = 0; j < size; j++) {
+                MATRIX(layout, start[i] + j, 0) = VECTOR(perm)[j];
+                MATRIX(layout, start[i] + j, 1) = i;
+            }
+            igraph_vector_destroy(&perm);
+        }
+        igraph_vector_resize(&edges, 0);
+        for (i = 0; i < 40; i++) {
+            long int l = RNG_INTEGER(0, no_of_layers - 2);
+            igraph_vector_push_back(&edges, RNG_INTEGER(start[l], start[l + 1] - 1));
+            igraph_vector_push_back(&edges, RNG_INTEGER(start[l + 1], start[l + 2] - 1));
+        }
+        igraph_create(&g, &edges, n, IGRAPH_DIRECTED);
+
+        igraph_i_layout_sugiyama_crossings(&g, &layout, &crossings);
+        if (crossings != brute_force_crossings(&g, &layout)) {
+            printf("Graph %ld: %g crossings instead of %g\n", k, crossings,
+                   brute_force_crossings(&g, &layout));
+            return 1;
+        }
+        igraph_destroy(&g);
+    }
+
+    /* Fixed orderings with known numbers of crossings */
+    igraph_small(&g, 4, IGRAPH_DIRECTED, 0, 3, 1, 2, 0, 2, -1);
+    igraph_matrix_resize(&layout, 4, 2);
+    MATRIX(layout, 0, 0) = 0; MATRIX(layout, 0, 1) = 0;
+    MATRIX(layout, 1, 0) = 1; MATRIX(layout, 1, 1) = 0;
+    MATRIX(layout, 2, 0) = 0; MATRIX(layout, 2, 1) = 1;
+    MATRIX(layout, 3, 0) = 1; MATRIX(layout, 3, 1) = 1;
+    igraph_i_layout_sugiyama_crossings(&g, &layout, &crossings);
+    printf("crossings: %g\n", crossings);
+    MATRIX(layout, 2, 0) = 1; MATRIX(layout, 3, 0) = 0;
+    igraph_i_layout_sugiyama_crossings(&g, &layout, &crossings);
+    printf("crossings: %g\n", crossings);
+    igraph_destroy(&g);
+
+    /* Any ordering of K(3,3) has 3 * 3 crossings */
+    igraph_full_bipartite(&g, NULL, 3, 3, IGRAPH_DIRECTED, IGRAPH_OUT);
+    igraph_matrix_resize(&layout, 6, 2);
+    for (i = 0; i < 6; i++) {
+        MATRIX(layout, i, 0) = (i * 2) % 3;
+        MATRIX(layout, i, 1) = i / 3;
+    }
+    igraph_i_layout_sugiyama_crossings(&g, &layout, &crossings);
+    printf("crossings: %g\n", crossings);
+    igraph_destroy(&g);
+
+    /* The initial ordering, by vertex id, has a crossing that a single
+       sweep removes; more sweeps keep the crossing-free ordering */
+    igraph_vector_init_int(&layers, 4, 0, 0, 1, 1);
+    igraph_small(&g, 4, IGRAPH_DIRECTED, 0, 3, 1, 2, 0, 2, -1);
+    printf("no sweeps: %g\n", layout_crossings(&g, &layers, 0, &layout));
+    printf("one sweep: %g\n", layout_crossings(&g, &layers, 1, &layout));
+    printf("100 sweeps: %g\n", layout_crossings(&g, &layers, 100, &layout));
+    igraph_destroy(&g);
+    igraph_vector_destroy(&layers);
+
+    /* The crossings of K(3,3) cannot be removed */
+    igraph_vector_init_int(&layers, 6, 0, 0, 0, 1, 1, 1);
+    igraph_full_bipartite(&g, NULL, 3, 3, IGRAPH_DIRECTED, IGRAPH_OUT);
+    printf("K(3,3), 100 sweeps: %g\n", layout_crossings(&g, &layers, 100, &layout));
+    igraph_destroy(&g);
+
+    igraph_vector_destroy(&layers);
+    igraph_matrix_destroy(&layout);
+    igraph_vector_destroy(&edges);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* Every edge must point from a layer to a lower one */
+static int check_layering(const igraph_t *graph, const igraph_matrix_t *layout) {
+    long int i, m = igraph_ecount(graph);
+    for (i = 0; i < m; i++) {
+        if (MATRIX(*layout, IGRAPH_FROM(graph, i), 1) >=
+            MATRIX(*layout, IGRAPH_TO(graph, i), 1)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main() {
+    igraph_t g;
+    igraph_matrix_t layout;
+    igraph_vector_t edges;
+    long int i, n = 1001;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_matrix_init(&layout, 0, 0);
+
+    /* Graphs with more than 1000 vertices are layered heuristically. A
+       path of n vertices and a source with an edge to the end of the
+       path: the longest path layering puts the source in the first layer,
+       the promotion of nodes moves it right above the end of the path,
+       so no dummy nodes are needed */
+    igraph_vector_init(&edges, 0);
+    for (i = 0; i < n - 1; i++) {
+        igraph_vector_push_back(&edges, i);
+        igraph_vector_push_back(&edges, i + 1);
+    }
+    igraph_vector_push_back(&edges, n);
+    igraph_vector_push_back(&edges, n - 1);
+    igraph_create(&g, &edges, n + 1, IGRAPH_DIRECTED);
+    igraph_layout_sugiyama(&g, &layout, NULL, NULL, NULL, 1, 1, 100, NULL);
+    printf("dummy nodes: %ld\n", igraph_matrix_nrow(&layout) - (n + 1));
+    printf("source above the end of the path: %s\n",
+           MATRIX(layout, n, 1) == MATRIX(layout, n - 1, 1) - 1 ? "yes" : "no");
+    igraph_destroy(&g);
+    igraph_vector_destroy(&edges);
+
+    /* Promotions keep the edges of an acyclic graph pointing downwards */
+    igraph_erdos_renyi_game(&g, IGRAPH_ERDOS_RENYI_GNM, 1500, 3000,
+                            IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    igraph_to_directed(&g, IGRAPH_TO_DIRECTED_ARBITRARY);
+    igraph_layout_sugiyama(&g, &layout, NULL, NULL, NULL, 1, 1, 10, NULL);
+    printf("edges point downwards: %s\n",
+           check_layering(&g, &layout) ? "yes" : "no");
+    igraph_destroy(&g);
+
+    igraph_matrix_destroy(&layout);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
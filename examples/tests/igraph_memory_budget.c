@@ -0,0 +1,104 @@
+
+#include <igraph.h>
+
+#include "test_utilities.inc"
+
+int main() {
+    igraph_t graph;
+    igraph_matrix_t res;
+    size_t current, peak, base, old;
+    int ret;
+
+    igraph_set_memory_accounting(1);
+
+    igraph_memory_usage(&base, NULL);
+    igraph_ring(&graph, 1000, IGRAPH_UNDIRECTED, 0, 1);
+    igraph_memory_usage(&current, NULL);
+    printf("Graph uses memory: %s\n", current > base ? "yes" : "no");
+
+    /* Without a budget the call succeeds, and it needs an n by n matrix */
+    igraph_matrix_init(&res, 0, 0);
+    igraph_memory_reset_peak();
+    ret = igraph_similarity_jaccard(&graph, &res, igraph_vss_all(), IGRAPH_ALL, 0);
+    igraph_memory_usage(NULL, &peak);
+    printf("Unlimited: %d, peak above n^2 doubles: %s\n", ret,
+           peak - current >= 1000 * 1000 * sizeof(igraph_real_t) ? "yes" : "no");
+    igraph_matrix_destroy(&res);
+
+    /* With a budget the same call fails cleanly */
+    igraph_set_error_handler(igraph_error_handler_ignore);
+    igraph_set_memory_budget(current + 100000, &old);
+    if (old != 0) {
+        return 1;
+    }
+
+    igraph_matrix_init(&res, 0, 0);
+    ret = igraph_similarity_jaccard(&graph, &res, igraph_vss_all(), IGRAPH_ALL, 0);
+    printf("Jaccard with budget: %s\n", ret == IGRAPH_ENOMEM ? "out of memory" : "success");
+    igraph_matrix_destroy(&res);
+    igraph_memory_usage(&peak, NULL);
+    if (peak != current) {
+        printf("Memory not released: %lu bytes\n", (unsigned long) (peak - current));
+        return 2;
+    }
+    VERIFY_FINALLY_STACK();
+
+    igraph_matrix_init(&res, 0, 0);
+    ret = igraph_layout_kamada_kawai(&graph, &res, 0, 100, 0, 1000, NULL,
+                                     NULL, NULL, NULL, NULL);
+    printf("Kamada-Kawai with budget: %s\n", ret == IGRAPH_ENOMEM ? "out of memory" : "success");
+    igraph_matrix_destroy(&res);
+    igraph_memory_usage(&peak, NULL);
+    if (peak != current) {
+        printf("Memory not released: %lu bytes\n", (unsigned long) (peak - current));
+        return 3;
+    }
+    VERIFY_FINALLY_STACK();
+
+    /* A budget below the current usage makes all allocations fail */
+    igraph_set_memory_budget(1, NULL);
+    if (igraph_malloc(1) != NULL) {
+        return 4;
+    }
+    igraph_set_memory_budget(0, NULL);
+    igraph_set_error_handler(igraph_error_handler_abort);
+
+    /* Reallocation is accounted too */
+    {
+        void *p = igraph_malloc(100);
+        igraph_memory_usage(&peak, NULL);
+        if (peak != current + 100) {
+            return 5;
+        }
+        p = igraph_realloc(p, 1000);
+        igraph_memory_usage(&peak, NULL);
+        if (peak != current + 1000) {
+            return 6;
+        }
+        igraph_free(p);
+
+        /* Resizing to zero bytes releases the block and its entry */
+        p = igraph_malloc(100);
+        if (igraph_realloc(p, 0) != NULL) {
+            return 8;
+        }
+        igraph_memory_usage(&peak, NULL);
+        if (peak != current) {
+            return 9;
+        }
+    }
+
+    igraph_destroy(&graph);
+    igraph_memory_usage(&current, NULL);
+    printf("Memory released: %s\n", current == base ? "yes" : "no");
+
+    igraph_set_memory_accounting(0);
+    igraph_memory_usage(&current, &peak);
+    if (current != 0 || peak != 0) {
+        return 7;
+    }
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
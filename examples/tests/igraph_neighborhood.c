@@ -0,0 +1,134 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* The edges of a graph as sorted codes, to compare graphs with the
+   same vertex ids but a different edge order */
+void edge_codes(const igraph_t *g, igraph_vector_t *codes) {
+    long int i, n = igraph_vcount(g);
+    igraph_vector_resize(codes, igraph_ecount(g));
+    for (i = 0; i < igraph_ecount(g); i++) {
+        VECTOR(*codes)[i] = IGRAPH_FROM(g, i) * n + IGRAPH_TO(g, i);
+    }
+    igraph_vector_sort(codes);
+}
+
+/* Compares the neighborhoods with the distances from each vertex */
+int check_neighborhoods(const igraph_t *g, igraph_integer_t order,
+                        igraph_neimode_t mode, igraph_integer_t mindist) {
+    igraph_matrix_t dist;
+    igraph_vector_t size;
+    igraph_vector_ptr_t nbs, graphs;
+    long int i, j, no_of_nodes = igraph_vcount(g);
+
+    igraph_matrix_init(&dist, 0, 0);
+    igraph_vector_init(&size, 0);
+    igraph_vector_ptr_init(&nbs, 0);
+    igraph_vector_ptr_init(&graphs, 0);
+    igraph_shortest_paths(g, &dist, igraph_vss_all(), igraph_vss_all(), mode);
+    igraph_neighborhood_size(g, &size, igraph_vss_all(), order, mode, mindist);
+    igraph_neighborhood(g, &nbs, igraph_vss_all(), order, mode, mindist);
+    igraph_neighborhood_graphs(g, &graphs, igraph_vss_all(), order, mode,
+                               mindist);
+
+    for (i = 0; i < no_of_nodes; i++) {
+        igraph_vector_t *nb = VECTOR(nbs)[i];
+        igraph_t *ng = VECTOR(graphs)[i], sub;
+        igraph_vector_t codes1, codes2;
+        long int count = 0;
+        igraph_real_t last = -1;
+
+        for (j = 0; j < no_of_nodes; j++) {
+            if (MATRIX(dist, i, j) >= mindist && MATRIX(dist, i, j) <= order) {
+                count++;
+            }
+        }
+        if (VECTOR(size)[i] != count || igraph_vector_size(nb) != count) {
+            return 1;
+        }
+        /* The vertices are listed in the order of their distance */
+        for (j = 0; j < count; j++) {
+            long int v = (long int) VECTOR(*nb)[j];
+            if (MATRIX(dist, i, v) < mindist || MATRIX(dist, i, v) > order ||
+                MATRIX(dist, i, v) < last) {
+                return 2;
+            }
+            last = MATRIX(dist, i, v);
+        }
+        igraph_induced_subgraph(g, &sub, igraph_vss_vector(nb),
+                                IGRAPH_SUBGRAPH_COPY_AND_DELETE);
+        igraph_vector_init(&codes1, 0);
+        igraph_vector_init(&codes2, 0);
+        edge_codes(ng, &codes1);
+        edge_codes(&sub, &codes2);
+        if (igraph_vcount(ng) != igraph_vcount(&sub) ||
+            !igraph_vector_all_e(&codes1, &codes2)) {
+            return 3;
+        }
+        igraph_vector_destroy(&codes2);
+        igraph_vector_destroy(&codes1);
+        igraph_destroy(&sub);
+        igraph_vector_destroy(nb);
+        igraph_free(nb);
+    }
+
+    igraph_decompose_destroy(&graphs);
+    igraph_vector_ptr_destroy(&graphs);
+    igraph_vector_ptr_destroy(&nbs);
+    igraph_vector_destroy(&size);
+    igraph_matrix_destroy(&dist);
+    return 0;
+}
+
+int main() {
+    igraph_t g;
+    igraph_vector_t edges, size;
+    igraph_vector_ptr_t nbs;
+    igraph_neimode_t modes[] = { IGRAPH_OUT, IGRAPH_IN, IGRAPH_ALL };
+    long int i, k, order, mindist, ret;
+
+    igraph_rng_seed(igraph_rng_default(), 7);
+
+    /* Ring with a chord */
+    igraph_ring(&g, 8, IGRAPH_UNDIRECTED, 0, 1);
+    igraph_add_edge(&g, 0, 4);
+    igraph_vector_init(&size, 0);
+    igraph_neighborhood_size(&g, &size, igraph_vss_all(), 2, IGRAPH_ALL, 1);
+    igraph_vector_print(&size);
+    igraph_vector_ptr_init(&nbs, 0);
+    igraph_neighborhood(&g, &nbs, igraph_vss_1(0), 2, IGRAPH_ALL, 0);
+    igraph_vector_print(VECTOR(nbs)[0]);
+    igraph_vector_destroy(VECTOR(nbs)[0]);
+    igraph_free(VECTOR(nbs)[0]);
+    igraph_vector_ptr_destroy(&nbs);
+    igraph_vector_destroy(&size);
+    igraph_destroy(&g);
+
+    /* Random multigraphs with loops */
+    igraph_vector_init(&edges, 120);
+    for (k = 0; k < 6; k++) {
+        for (i = 0; i < 120; i++) {
+            VECTOR(edges)[i] = RNG_INTEGER(0, 29);
+        }
+        igraph_create(&g, &edges, 30, k % 2);
+        for (order = 0; order <= 3; order++) {
+            for (mindist = 0; mindist <= order; mindist++) {
+                for (i = 0; i < 3; i++) {
+                    if ((ret = check_neighborhoods(&g, order, modes[i],
+                                                   mindist))) {
+                        printf("graph %ld order %ld mindist %ld mode %ld\n",
+                               k, order, mindist, i);
+                        return ret;
+                    }
+                }
+            }
+        }
+        igraph_destroy(&g);
+    }
+    igraph_vector_destroy(&edges);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+#define NUM_ALGOS 6
+
+/* The orders must be permutations, and the relabeled graph must be
+   the input graph with the vertices of invmap, in this order */
+int check(const igraph_t *graph, igraph_reorder_algorithm_t algo) {
+    igraph_t res;
+    igraph_vector_t perm, invmap, map2;
+    igraph_vector_bool_t seen;
+    long int i, n = igraph_vcount(graph);
+    int ret = 0;
+
+    igraph_vector_init(&perm, 0);
+    igraph_vector_init(&invmap, 0);
+    igraph_vector_init(&map2, 0);
+    igraph_vector_bool_init(&seen, n);
+
+    igraph_vertex_reordering(graph, &perm, &invmap, algo);
+    if (igraph_vector_size(&perm) != n || igraph_vector_size(&invmap) != n) {
+        ret = 1;
+    }
+    for (i = 0; i < n && !ret; i++) {
+        long int v = VECTOR(invmap)[i];
+        if (v < 0 || v >= n || VECTOR(seen)[v] || VECTOR(perm)[v] != i) {
+            ret = 2;
+        }
+        VECTOR(seen)[v] = 1;
+    }
+
+    igraph_reorder_vertices(graph, &res, &map2, algo);
+    if (!igraph_vector_all_e(&invmap, &map2) ||
+        igraph_ecount(&res) != igraph_ecount(graph) ||
+        igraph_vcount(&res) != n) {
+        ret = 3;
+    }
+    for (i = 0; i < igraph_ecount(graph) && !ret; i++) {
+        if (VECTOR(invmap)[(long int) IGRAPH_FROM(&res, i)] != IGRAPH_FROM(graph, i) ||
+            VECTOR(invmap)[(long int) IGRAPH_TO(&res, i)] != IGRAPH_TO(graph, i)) {
+            if (igraph_is_directed(graph) ||
+                VECTOR(invmap)[(long int) IGRAPH_FROM(&res, i)] != IGRAPH_TO(graph, i) ||
+                VECTOR(invmap)[(long int) IGRAPH_TO(&res, i)] != IGRAPH_FROM(graph, i)) {
+                ret = 4;
+            }
+        }
+    }
+    igraph_destroy(&res);
+
+    igraph_vector_bool_destroy(&seen);
+    igraph_vector_destroy(&map2);
+    igraph_vector_destroy(&invmap);
+    igraph_vector_destroy(&perm);
+    return ret;
+}
+
+/* The largest difference of the new ids of adjacent vertices, the
+   ids are not changed if perm is a null pointer */
+long int bandwidth(const igraph_t *graph, const igraph_vector_t *perm) {
+    long int i, max = 0;
+    for (i = 0; i < igraph_ecount(graph); i++) {
+        long int from = IGRAPH_FROM(graph, i), to = IGRAPH_TO(graph, i);
+        long int d = perm ? VECTOR(*perm)[from] - VECTOR(*perm)[to] : from - to;
+        if (labs(d) > max) {
+            max = labs(d);
+        }
+    }
+    return max;
+}
+
+int main() {
+    igraph_t g, res;
+    igraph_vector_t perm, invmap, dim;
+    int algo, ret;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_i_set_attribute_table(&igraph_cattribute_table);
+
+    /* Null graph and a multigraph with loops and several components */
+    igraph_empty(&g, 0, IGRAPH_UNDIRECTED);
+    for (algo = 0; algo < NUM_ALGOS; algo++) {
+        if ((ret = check(&g, algo))) {
+            return ret;
+        }
+    }
+    igraph_destroy(&g);
+    igraph_small(&g, 9, IGRAPH_DIRECTED,
+                 0, 1, 1, 0, 0, 1, 2, 2, 3, 4, 4, 5, 5, 3, 1, 6, 8, 6, -1);
+    for (algo = 0; algo < NUM_ALGOS; algo++) {
+        if ((ret = check(&g, algo))) {
+            return 10 + ret;
+        }
+    }
+    igraph_destroy(&g);
+
+    /* Random graphs */
+    igraph_barabasi_game(&g, 500, 1, 3, 0, 0, 1, IGRAPH_UNDIRECTED,
+                         IGRAPH_BARABASI_PSUMTREE, 0);
+    for (algo = 0; algo < NUM_ALGOS; algo++) {
+        if ((ret = check(&g, algo))) {
+            return 20 + ret;
+        }
+    }
+    igraph_destroy(&g);
+    igraph_erdos_renyi_game(&g, IGRAPH_ERDOS_RENYI_GNM, 300, 600,
+                            IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    for (algo = 0; algo < NUM_ALGOS; algo++) {
+        if ((ret = check(&g, algo))) {
+            return 30 + ret;
+        }
+    }
+    igraph_destroy(&g);
+
+    /* The orders of a small graph */
+    igraph_vector_init(&perm, 0);
+    igraph_vector_init(&invmap, 0);
+    igraph_small(&g, 7, IGRAPH_UNDIRECTED,
+                 0, 4, 4, 2, 2, 6, 6, 0, 4, 6, 1, 3, 3, 5, 5, 1, 6, 1, -1);
+    for (algo = 0; algo < NUM_ALGOS; algo++) {
+        igraph_vertex_reordering(&g, NULL, &invmap, algo);
+        igraph_vector_print(&invmap);
+    }
+    igraph_destroy(&g);
+
+    /* Reverse Cuthill-McKee on a grid with shuffled ids, the optimal
+       bandwidth is 10 */
+    igraph_vector_init_int(&dim, 2, 20, 10);
+    igraph_lattice(&g, &dim, 1, IGRAPH_UNDIRECTED, 0, 0);
+    igraph_vector_destroy(&perm);
+    igraph_vector_init_seq(&perm, 0, igraph_vcount(&g) - 1);
+    igraph_vector_shuffle(&perm);
+    igraph_permute_vertices(&g, &res, &perm);
+    printf("shuffled bandwidth: %s\n", bandwidth(&res, NULL) > 10 ? "large" : "small");
+    igraph_vertex_reordering(&res, &perm, NULL, IGRAPH_REORDER_RCM);
+    printf("RCM bandwidth: %ld\n", bandwidth(&res, &perm));
+    igraph_destroy(&res);
+    igraph_destroy(&g);
+
+    /* Attributes follow the vertices, and invmap maps back */
+    igraph_ring(&g, 6, IGRAPH_UNDIRECTED, 0, 1);
+    igraph_add_edge(&g, 0, 3);
+    SETVAN(&g, "id", 0, 0);
+    SETVAN(&g, "id", 1, 1);
+    SETVAN(&g, "id", 2, 2);
+    SETVAN(&g, "id", 3, 3);
+    SETVAN(&g, "id", 4, 4);
+    SETVAN(&g, "id", 5, 5);
+    SETEAN(&g, "weight", 6, 42);
+    igraph_reorder_vertices(&g, &res, &invmap, IGRAPH_REORDER_DEGREE);
+    igraph_vector_print(&invmap);
+    for (algo = 0; algo < 6; algo++) {
+        if (VAN(&res, "id", algo) != VECTOR(invmap)[algo]) {
+            return 40;
+        }
+    }
+    printf("weight: %g\n", EAN(&res, "weight", 6));
+    igraph_destroy(&res);
+    igraph_destroy(&g);
+
+    /* Invalid algorithm */
+    igraph_ring(&g, 3, IGRAPH_UNDIRECTED, 0, 1);
+    igraph_set_error_handler(igraph_error_handler_ignore);
+    if (igraph_vertex_reordering(&g, &perm, NULL, 100) != IGRAPH_EINVAL) {
+        return 50;
+    }
+    igraph_set_error_handler(igraph_error_handler_abort);
+    igraph_destroy(&g);
+
+    igraph_vector_destroy(&dim);
+    igraph_vector_destroy(&invmap);
+    igraph_vector_destroy(&perm);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+
+#include <igraph.h>
+
+#include "test_utilities.inc"
+
+/* A counting allocator that keeps the size of each block in a header, so
+ * that it can check that all memory is released with the allocator that
+ * allocated it. */
+
+typedef struct {
+    long int allocs, frees, live;
+    size_t bytes;
+} counter_t;
+
+typedef union {
+    size_t size;
+    double align;
+} header_t;
+
+static void *counting_malloc(size_t size, void *state) {
+    counter_t *counter = state;
+    header_t *h = malloc(sizeof(header_t) + size);
+    if (!h) {
+        return NULL;
+    }
+    h->size = size;
+    counter->allocs++;
+    counter->live++;
+    counter->bytes += size;
+    return h + 1;
+}
+
+static void *counting_calloc(size_t count, size_t size, void *state) {
+    void *p = counting_malloc(count * size, state);
+    if (p) {
+        memset(p, 0, count * size);
+    }
+    return p;
+}
+
+static void counting_free(void *ptr, void *state) {
+    counter_t *counter = state;
+    header_t *h;
+    if (!ptr) {
+        return;
+    }
+    h = (header_t *) ptr - 1;
+    counter->frees++;
+    counter->live--;
+    counter->bytes -= h->size;
+    free(h);
+}
+
+static void *counting_realloc(void *ptr, size_t size, void *state) {
+    counter_t *counter = state;
+    header_t *h;
+    if (!ptr) {
+        return counting_malloc(size, state);
+    }
+    h = (header_t *) ptr - 1;
+    counter->bytes -= h->size;
+    h = realloc(h, sizeof(header_t) + size);
+    if (!h) {
+        counter->bytes += ((header_t *) ptr - 1)->size;
+        return NULL;
+    }
+    h->size = size;
+    counter->bytes += size;
+    return h + 1;
+}
+
+int main() {
+    igraph_t graph;
+    igraph_vector_t membership;
+    igraph_vector_ptr_t cliques;
+    igraph_integer_t nb_clusters;
+    igraph_allocator_t allocator, old, bad;
+    counter_t counter = { 0, 0, 0, 0 };
+    long int i;
+
+    allocator.malloc_func = counting_malloc;
+    allocator.calloc_func = counting_calloc;
+    allocator.realloc_func = counting_realloc;
+    allocator.free_func = counting_free;
+    allocator.state = &counter;
+
+    igraph_i_set_attribute_table(&igraph_cattribute_table);
+
+    /* Incomplete tables are rejected */
+    bad = allocator;
+    bad.realloc_func = NULL;
+    igraph_set_error_handler(igraph_error_handler_ignore);
+    if (igraph_set_allocator(&bad, NULL) != IGRAPH_EINVAL) {
+        return 1;
+    }
+    igraph_set_error_handler(igraph_error_handler_abort);
+
+    IGRAPH_CHECK(igraph_set_allocator(&allocator, &old));
+
+    /* Graph with attributes */
+    igraph_famous(&graph, "Zachary");
+    SETGAS(&graph, "name", "karate");
+    for (i = 0; i < igraph_vcount(&graph); i++) {
+        SETVAN(&graph, "weight", i, i);
+    }
+    SETVAS(&graph, "label", 0, "Mr Hi");
+    SETVAS(&graph, "label", 33, "John A");
+
+    /* Leiden uses scratch memory for its cluster lists */
+    igraph_vector_init(&membership, 0);
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_community_leiden(&graph, NULL, NULL, 0.05, 0.01, 0,
+                            &membership, &nb_clusters, NULL);
+    printf("Leiden clusters: %d\n", (int) nb_clusters);
+    igraph_vector_destroy(&membership);
+
+    /* Maximal cliques */
+    igraph_vector_ptr_init(&cliques, 0);
+    igraph_maximal_cliques(&graph, &cliques, 0, 0);
+    printf("Maximal cliques: %ld\n", igraph_vector_ptr_size(&cliques));
+    for (i = 0; i < igraph_vector_ptr_size(&cliques); i++) {
+        igraph_vector_destroy(VECTOR(cliques)[i]);
+        igraph_free(VECTOR(cliques)[i]);
+    }
+    igraph_vector_ptr_destroy(&cliques);
+
+    igraph_destroy(&graph);
+
+    /* Restore the default allocator */
+    IGRAPH_CHECK(igraph_set_allocator(&old, NULL));
+
+    if (counter.allocs == 0) {
+        return 2;
+    }
+    if (counter.allocs != counter.frees || counter.live != 0 || counter.bytes != 0) {
+        printf("Leaked %ld blocks, %lu bytes\n", counter.live, (unsigned long) counter.bytes);
+        return 3;
+    }
+
+    /* Resetting to the default also works with a null pointer */
+    IGRAPH_CHECK(igraph_set_allocator(NULL, NULL));
+    IGRAPH_CHECK(igraph_set_allocator(&allocator, NULL));
+    IGRAPH_CHECK(igraph_set_allocator(NULL, &old));
+    if (old.state != &counter) {
+        return 4;
+    }
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
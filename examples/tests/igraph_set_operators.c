@@ -0,0 +1,172 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* The index of the result must be the one that igraph_create() builds */
+int check_index(const igraph_t *graph) {
+    igraph_t g;
+    igraph_vector_t edges;
+
+    igraph_vector_init(&edges, 0);
+    igraph_get_edgelist(graph, &edges, 0);
+    igraph_create(&g, &edges, igraph_vcount(graph), igraph_is_directed(graph));
+    if (!igraph_vector_all_e(&g.from, &graph->from) ||
+        !igraph_vector_all_e(&g.to, &graph->to) ||
+        !igraph_vector_all_e(&g.oi, &graph->oi) ||
+        !igraph_vector_all_e(&g.ii, &graph->ii) ||
+        !igraph_vector_all_e(&g.os, &graph->os) ||
+        !igraph_vector_all_e(&g.is, &graph->is)) {
+        return 1;
+    }
+    igraph_destroy(&g);
+    igraph_vector_destroy(&edges);
+    return 0;
+}
+
+/* Every mapped edge must have the same endpoints in the result */
+int check_map(const igraph_t *res, const igraph_t *graph,
+              const igraph_vector_t *map) {
+    long int i;
+    for (i = 0; i < igraph_ecount(graph); i++) {
+        long int e = VECTOR(*map)[i];
+        if (e < 0) {
+            continue;
+        }
+        if (IGRAPH_FROM(res, e) != IGRAPH_FROM(graph, i) ||
+            IGRAPH_TO(res, e) != IGRAPH_TO(graph, i)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* The same for the maps of igraph_intersection(), which are reversed */
+int check_result_map(const igraph_t *res, const igraph_t *graph,
+                     const igraph_vector_t *map) {
+    long int i;
+    if (igraph_vector_size(map) != igraph_ecount(res)) {
+        return 1;
+    }
+    for (i = 0; i < igraph_ecount(res); i++) {
+        long int e = VECTOR(*map)[i];
+        if (IGRAPH_FROM(res, i) != IGRAPH_FROM(graph, e) ||
+            IGRAPH_TO(res, i) != IGRAPH_TO(graph, e)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void print_graph_map(const igraph_t *graph, const igraph_vector_t *map1,
+                     const igraph_vector_t *map2) {
+    igraph_write_graph_edgelist(graph, stdout);
+    if (map1) {
+        igraph_vector_print(map1);
+    }
+    if (map2) {
+        igraph_vector_print(map2);
+    }
+}
+
+int main() {
+    igraph_t left, right, res;
+    igraph_vector_t map1, map2;
+    igraph_vector_ptr_t graphs, maps;
+    int directed;
+
+    igraph_i_set_attribute_table(&igraph_cattribute_table);
+
+    igraph_vector_init(&map1, 0);
+    igraph_vector_init(&map2, 0);
+    igraph_vector_ptr_init(&graphs, 2);
+    igraph_vector_ptr_init(&maps, 0);
+
+    /* Multigraphs with loop edges */
+    for (directed = 0; directed < 2; directed++) {
+        igraph_small(&left, 4, directed,
+                     0, 1, 1, 0, 0, 1, 2, 2, 2, 2, 2, 2, 1, 3, 3, 3, -1);
+        igraph_small(&right, 5, directed,
+                     1, 0, 2, 2, 3, 1, 2, 2, 4, 0, 0, 1, -1);
+        VECTOR(graphs)[0] = &left;
+        VECTOR(graphs)[1] = &right;
+
+        printf("%s union:\n", directed ? "directed" : "undirected");
+        igraph_union(&res, &left, &right, &map1, &map2);
+        print_graph_map(&res, &map1, &map2);
+        if (check_index(&res) || check_map(&res, &left, &map1) ||
+            check_map(&res, &right, &map2)) {
+            return 1;
+        }
+        igraph_destroy(&res);
+
+        printf("intersection:\n");
+        igraph_intersection(&res, &left, &right, &map1, &map2);
+        print_graph_map(&res, &map1, &map2);
+        if (check_index(&res) || check_result_map(&res, &left, &map1) ||
+            check_result_map(&res, &right, &map2)) {
+            return 2;
+        }
+        igraph_destroy(&res);
+
+        printf("difference:\n");
+        igraph_difference(&res, &left, &right);
+        print_graph_map(&res, NULL, NULL);
+        if (check_index(&res)) {
+            return 3;
+        }
+        igraph_destroy(&res);
+
+        igraph_union_many(&res, &graphs, &maps);
+        if (check_index(&res) ||
+            check_map(&res, &left, VECTOR(maps)[0]) ||
+            check_map(&res, &right, VECTOR(maps)[1])) {
+            return 4;
+        }
+        igraph_destroy(&res);
+        igraph_vector_destroy(VECTOR(maps)[0]);
+        igraph_vector_destroy(VECTOR(maps)[1]);
+        igraph_free(VECTOR(maps)[0]);
+        igraph_free(VECTOR(maps)[1]);
+
+        igraph_intersection_many(&res, &graphs, &maps);
+        if (check_index(&res) ||
+            check_map(&res, &left, VECTOR(maps)[0]) ||
+            check_map(&res, &right, VECTOR(maps)[1])) {
+            return 5;
+        }
+        igraph_destroy(&res);
+        igraph_vector_destroy(VECTOR(maps)[0]);
+        igraph_vector_destroy(VECTOR(maps)[1]);
+        igraph_free(VECTOR(maps)[0]);
+        igraph_free(VECTOR(maps)[1]);
+
+        igraph_destroy(&right);
+        igraph_destroy(&left);
+    }
+
+    /* The difference keeps the attributes of the remaining copies */
+    igraph_small(&left, 3, IGRAPH_UNDIRECTED, 1, 1, 0, 1, 1, 1, 1, 0, 1, 1, -1);
+    igraph_small(&right, 3, IGRAPH_UNDIRECTED, 1, 1, 0, 1, -1);
+    SETEAN(&left, "id", 0, 0);
+    SETEAN(&left, "id", 1, 1);
+    SETEAN(&left, "id", 2, 2);
+    SETEAN(&left, "id", 3, 3);
+    SETEAN(&left, "id", 4, 4);
+    igraph_difference(&res, &left, &right);
+    igraph_write_graph_edgelist(&res, stdout);
+    printf("ids: %g %g %g\n", EAN(&res, "id", 0), EAN(&res, "id", 1),
+           EAN(&res, "id", 2));
+    igraph_destroy(&res);
+    igraph_destroy(&right);
+    igraph_destroy(&left);
+
+    igraph_vector_ptr_destroy(&maps);
+    igraph_vector_ptr_destroy(&graphs);
+    igraph_vector_destroy(&map2);
+    igraph_vector_destroy(&map1);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
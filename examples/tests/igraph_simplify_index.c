@@ -0,0 +1,84 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* igraph_simplify() builds the indexed edge list of the result
+   directly; it must be the same as the one of igraph_create() */
+int check_index(const igraph_t *g) {
+    igraph_t g2;
+    igraph_vector_t edges;
+
+    igraph_vector_init(&edges, 0);
+    igraph_get_edgelist(g, &edges, 0);
+    igraph_create(&g2, &edges, igraph_vcount(g), igraph_is_directed(g));
+    if (!igraph_vector_all_e(&g->from, &g2.from) ||
+        !igraph_vector_all_e(&g->to, &g2.to) ||
+        !igraph_vector_all_e(&g->oi, &g2.oi) ||
+        !igraph_vector_all_e(&g->ii, &g2.ii) ||
+        !igraph_vector_all_e(&g->os, &g2.os) ||
+        !igraph_vector_all_e(&g->is, &g2.is)) {
+        return 1;
+    }
+    igraph_destroy(&g2);
+    igraph_vector_destroy(&edges);
+    return 0;
+}
+
+int main() {
+    igraph_t g;
+    igraph_vector_t edges;
+    igraph_bool_t simple;
+    long int i, k;
+    int directed, loops;
+
+    igraph_rng_seed(igraph_rng_default(), 7);
+
+    /* Small multigraph with loops */
+    igraph_small(&g, 5, IGRAPH_UNDIRECTED, 0, 1, 1, 0, 2, 2, 2, 2, 3, 1, 1, 3,
+                 4, 0, 2, 2, -1);
+    igraph_simplify(&g, /* multiple= */ 1, /* loops= */ 0, NULL);
+    print_graph(&g, stdout);
+    igraph_simplify(&g, /* multiple= */ 1, /* loops= */ 1, NULL);
+    print_graph(&g, stdout);
+    igraph_destroy(&g);
+
+    /* Graphs without vertices or edges */
+    igraph_empty(&g, 0, IGRAPH_DIRECTED);
+    igraph_simplify(&g, 1, 1, NULL);
+    if (igraph_vcount(&g) != 0 || check_index(&g)) {
+        return 1;
+    }
+    igraph_destroy(&g);
+    igraph_empty(&g, 3, IGRAPH_UNDIRECTED);
+    igraph_simplify(&g, 1, 1, NULL);
+    if (igraph_vcount(&g) != 3 || check_index(&g)) {
+        return 2;
+    }
+    igraph_destroy(&g);
+
+    /* Random multigraphs with loops */
+    igraph_vector_init(&edges, 2000);
+    for (k = 0; k < 20; k++) {
+        directed = k % 2;
+        loops = (k / 2) % 2;
+        for (i = 0; i < 2000; i++) {
+            VECTOR(edges)[i] = RNG_INTEGER(0, k + 10);
+        }
+        igraph_create(&g, &edges, k + 15, directed);
+        igraph_simplify(&g, /* multiple= */ 1, loops, NULL);
+        if (check_index(&g)) {
+            return 3;
+        }
+        igraph_is_simple(&g, &simple);
+        if (loops && !simple) {
+            return 4;
+        }
+        igraph_destroy(&g);
+    }
+    igraph_vector_destroy(&edges);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* Compares the unrolled reductions with plain loops */
+int check_vector(const igraph_vector_t *v) {
+    long int i, n = igraph_vector_size(v);
+    igraph_real_t max = VECTOR(*v)[0], min = VECTOR(*v)[0], mi, ma;
+    long int which_max = 0, which_min = 0;
+
+    for (i = 1; i < n; i++) {
+        if (VECTOR(*v)[i] > max) {
+            max = VECTOR(*v)[i];
+            which_max = i;
+        }
+        if (VECTOR(*v)[i] < min) {
+            min = VECTOR(*v)[i];
+            which_min = i;
+        }
+    }
+
+    if (igraph_vector_max(v) != max && !igraph_is_nan(max)) {
+        return 1;
+    }
+    if (igraph_vector_min(v) != min && !igraph_is_nan(min)) {
+        return 2;
+    }
+    if (igraph_vector_which_max(v) != which_max) {
+        return 3;
+    }
+    if (igraph_vector_which_min(v) != which_min) {
+        return 4;
+    }
+    igraph_vector_minmax(v, &mi, &ma);
+    if (!igraph_is_nan(max) && (mi != min || ma != max)) {
+        return 5;
+    }
+    return 0;
+}
+
+int check_matrix(long int nrow, long int ncol) {
+    igraph_matrix_t m, t;
+    igraph_vector_t rowsum;
+    long int i, j;
+
+    igraph_matrix_init(&m, nrow, ncol);
+    for (i = 0; i < nrow; i++) {
+        for (j = 0; j < ncol; j++) {
+            MATRIX(m, i, j) = RNG_UNIF(-1, 1);
+        }
+    }
+    igraph_matrix_copy(&t, &m);
+    igraph_matrix_transpose(&t);
+    if (igraph_matrix_nrow(&t) != ncol || igraph_matrix_ncol(&t) != nrow) {
+        return 10;
+    }
+    for (i = 0; i < nrow; i++) {
+        for (j = 0; j < ncol; j++) {
+            if (MATRIX(t, j, i) != MATRIX(m, i, j)) {
+                return 11;
+            }
+        }
+    }
+
+    igraph_vector_init(&rowsum, 0);
+    igraph_matrix_rowsum(&m, &rowsum);
+    if (igraph_vector_size(&rowsum) != nrow) {
+        return 12;
+    }
+    for (i = 0; i < nrow; i++) {
+        igraph_real_t sum = 0.0;
+        for (j = 0; j < ncol; j++) {
+            sum += MATRIX(m, i, j);
+        }
+        if (VECTOR(rowsum)[i] != sum) {
+            return 13;
+        }
+    }
+
+    igraph_vector_destroy(&rowsum);
+    igraph_matrix_destroy(&t);
+    igraph_matrix_destroy(&m);
+    return 0;
+}
+
+int main() {
+    igraph_vector_t v;
+    igraph_vector_long_t l;
+    long int sizes[] = { 1, 2, 3, 4, 5, 7, 8, 9, 31, 1001 };
+    long int i, k, ret;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    /* Random vectors of all lengths modulo four */
+    for (k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        igraph_vector_init(&v, sizes[k]);
+        for (i = 0; i < sizes[k]; i++) {
+            VECTOR(v)[i] = RNG_INTEGER(-50, 50);
+        }
+        if ((ret = check_vector(&v))) {
+            printf("size %ld\n", sizes[k]);
+            return ret;
+        }
+        igraph_vector_destroy(&v);
+    }
+
+    /* Ties: the first extremal element is returned */
+    igraph_vector_init_int(&v, 9, 1, 5, 0, 5, 0, 5, 0, 0, 5);
+    printf("%ld %ld\n", igraph_vector_which_max(&v), igraph_vector_which_min(&v));
+    igraph_vector_destroy(&v);
+
+    /* A leading NaN is returned by max and min */
+    igraph_vector_init_int(&v, 6, 0, 3, 1, 4, 1, 5);
+    VECTOR(v)[0] = IGRAPH_NAN;
+    printf("%d %d %ld %ld\n", igraph_is_nan(igraph_vector_max(&v)),
+           igraph_is_nan(igraph_vector_min(&v)),
+           igraph_vector_which_max(&v), igraph_vector_which_min(&v));
+    igraph_vector_destroy(&v);
+
+    /* Integer vectors */
+    igraph_vector_long_init(&l, 11);
+    for (i = 0; i < 11; i++) {
+        VECTOR(l)[i] = (i * 7) % 11 - 5;
+    }
+    printf("%ld %ld %ld %ld\n", igraph_vector_long_max(&l),
+           igraph_vector_long_min(&l), igraph_vector_long_which_max(&l),
+           igraph_vector_long_which_min(&l));
+    igraph_vector_long_destroy(&l);
+
+    /* Square, wide, tall and degenerate matrices */
+    if ((ret = check_matrix(1, 1)) || (ret = check_matrix(33, 33)) ||
+        (ret = check_matrix(70, 70)) || (ret = check_matrix(1, 100)) ||
+        (ret = check_matrix(100, 1)) || (ret = check_matrix(45, 67)) ||
+        (ret = check_matrix(67, 45)) || (ret = check_matrix(0, 5))) {
+        return ret;
+    }
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <igraph.h>
+#include <stdio.h>
+
+#include "test_utilities.inc"
+
+/* Checks that 'order' lists the elements by 'v', then by 'v2' (if
+   given), then in decreasing index order */
+int check_order(const igraph_vector_t *v, const igraph_vector_t *v2,
+                const igraph_vector_t *order) {
+    long int i, n = igraph_vector_size(v);
+    igraph_vector_bool_t seen;
+
+    if (igraph_vector_size(order) != n) {
+        return 1;
+    }
+    igraph_vector_bool_init(&seen, n);
+    for (i = 0; i < n; i++) {
+        long int e = (long int) VECTOR(*order)[i];
+        if (e < 0 || e >= n || VECTOR(seen)[e]) {
+            return 2;
+        }
+        VECTOR(seen)[e] = 1;
+    }
+    igraph_vector_bool_destroy(&seen);
+    for (i = 1; i < n; i++) {
+        long int a = (long int) VECTOR(*order)[i - 1], b = (long int) VECTOR(*order)[i];
+        if (VECTOR(*v)[a] != VECTOR(*v)[b]) {
+            if (VECTOR(*v)[a] > VECTOR(*v)[b]) {
+                return 3;
+            }
+        } else if (v2 && VECTOR(*v2)[a] != VECTOR(*v2)[b]) {
+            if (VECTOR(*v2)[a] > VECTOR(*v2)[b]) {
+                return 4;
+            }
+        } else if (a < b) {
+            return 5;
+        }
+    }
+    return 0;
+}
+
+int main() {
+    igraph_vector_t v, v2, order;
+    igraph_vector_int_t order_int;
+    igraph_t g;
+    long int i, n, ret;
+
+    igraph_rng_seed(igraph_rng_default(), 137);
+
+    /* Small example with ties in both keys */
+    igraph_vector_init_int(&v, 8, 2, 0, 2, 1, 0, 2, 1, 2);
+    igraph_vector_init_int(&v2, 8, 1, 3, 0, 1, 3, 1, 1, 0);
+    igraph_vector_init(&order, 0);
+    igraph_vector_order(&v, &v2, &order, 3);
+    print_vector(&order, stdout);
+    igraph_vector_order1(&v, &order, 3);
+    print_vector(&order, stdout);
+    igraph_vector_int_init(&order_int, 0);
+    igraph_vector_order1_int(&v2, &order_int, 3);
+    print_vector_int(&order_int, stdout);
+
+    /* Empty vectors */
+    igraph_vector_clear(&v);
+    igraph_vector_clear(&v2);
+    igraph_vector_order(&v, &v2, &order, 0);
+    igraph_vector_order1(&v, &order, 0);
+    if (igraph_vector_size(&order) != 0) {
+        return 1;
+    }
+
+    /* Random keys, few and many buckets */
+    for (n = 1; n <= 1000; n *= 10) {
+        igraph_vector_resize(&v, 5000);
+        igraph_vector_resize(&v2, 5000);
+        for (i = 0; i < 5000; i++) {
+            VECTOR(v)[i] = RNG_INTEGER(0, n);
+            VECTOR(v2)[i] = RNG_INTEGER(0, n);
+        }
+        igraph_vector_order(&v, &v2, &order, n);
+        if ((ret = check_order(&v, &v2, &order))) {
+            return 10 + ret;
+        }
+        igraph_vector_order1(&v, &order, n);
+        if ((ret = check_order(&v, NULL, &order))) {
+            return 20 + ret;
+        }
+    }
+
+    /* The edge indices of a multigraph */
+    igraph_small(&g, 4, IGRAPH_DIRECTED, 2, 1, 0, 3, 2, 1, 1, 2, 0, 3, 2, 1,
+                 3, 3, 1, 0, -1);
+    igraph_vector_resize(&order, 0);
+    igraph_incident(&g, &order, 2, IGRAPH_OUT);
+    print_vector(&order, stdout);
+    igraph_incident(&g, &order, 1, IGRAPH_IN);
+    print_vector(&order, stdout);
+    igraph_incident(&g, &order, 3, IGRAPH_ALL);
+    print_vector(&order, stdout);
+    igraph_destroy(&g);
+
+    igraph_vector_int_destroy(&order_int);
+    igraph_vector_destroy(&order);
+    igraph_vector_destroy(&v2);
+    igraph_vector_destroy(&v);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -105,20 +105,79 @@ DECLDIR int igraph_inclist_fprint(const igraph_inclist_t *il, FILE *outfile);
  */
 #define igraph_inclist_get(il,no) (&(il)->incs[(long int)(no)])
 
+typedef struct igraph_compressed_adjlist_t {
+    igraph_integer_t length;
+    igraph_vector_long_t offsets;
+    igraph_vector_char_t data;
+} igraph_compressed_adjlist_t;
+
+DECLDIR int igraph_compressed_adjlist_init(const igraph_t *graph,
+        igraph_compressed_adjlist_t *cal,
+        igraph_neimode_t mode);
+DECLDIR void igraph_compressed_adjlist_destroy(igraph_compressed_adjlist_t *cal);
+DECLDIR igraph_integer_t igraph_compressed_adjlist_degree(const igraph_compressed_adjlist_t *cal,
+        igraph_integer_t no);
+DECLDIR int igraph_compressed_adjlist_get(const igraph_compressed_adjlist_t *cal,
+        igraph_integer_t no,
+        igraph_vector_t *res);
+
+typedef enum { IGRAPH_LAZY_ADJLIST_NEIGHBORS = 0,
+               IGRAPH_LAZY_ADJLIST_COMPLEMENTER,
+               IGRAPH_LAZY_ADJLIST_LINEGRAPH,
+               IGRAPH_LAZY_ADJLIST_COMPRESSED
+             } igraph_lazy_adjlist_type_t;
+
+/**
+ * \struct igraph_lazy_adjlist_t
+ * \brief Lazy adjacency list.
+ *
+ * Use the functions of this section to query a lazy adjacency list;
+ * the members are described here because code working on lazy
+ * adjacency lists of any kind must not assume more about them.
+ *
+ * \member graph The graph whose neighbor lists are queried. This is a
+ *   null pointer for lists created with \ref
+ *   igraph_lazy_adjlist_init_compressed(), which have no graph; use
+ *   \c length for the number of vertices.
+ * \member length The number of vertices.
+ * \member adjs The neighbor lists queried so far.
+ * \member mode The neighbors that are listed in directed graphs.
+ * \member simplify Whether loop and multiple edges are removed.
+ * \member type The kind of the list, it tells how neighbor lists are
+ *   computed.
+ * \member compressed The compressed adjacency list the neighbors are
+ *   decoded from, or a null pointer.
+ */
+
 typedef struct igraph_lazy_adjlist_t {
     const igraph_t *graph;
     igraph_integer_t length;
     igraph_vector_t **adjs;
     igraph_neimode_t mode;
     igraph_lazy_adlist_simplify_t simplify;
+    igraph_lazy_adjlist_type_t type;
+    const igraph_compressed_adjlist_t *compressed;
 } igraph_lazy_adjlist_t;
 
 DECLDIR int igraph_lazy_adjlist_init(const igraph_t *graph,
                                      igraph_lazy_adjlist_t *al,
                                      igraph_neimode_t mode,
                                      igraph_lazy_adlist_simplify_t simplify);
+DECLDIR int igraph_lazy_adjlist_init_complementer(const igraph_t *graph,
+        igraph_lazy_adjlist_t *al,
+        igraph_neimode_t mode,
+        igraph_bool_t loops);
+DECLDIR int igraph_lazy_adjlist_init_linegraph(const igraph_t *graph,
+        igraph_lazy_adjlist_t *al,
+        igraph_neimode_t mode,
+        igraph_lazy_adlist_simplify_t simplify);
+DECLDIR int igraph_lazy_adjlist_init_compressed(const igraph_compressed_adjlist_t *cal,
+        igraph_lazy_adjlist_t *al,
+        igraph_lazy_adlist_simplify_t simplify);
 DECLDIR void igraph_lazy_adjlist_destroy(igraph_lazy_adjlist_t *al);
 DECLDIR void igraph_lazy_adjlist_clear(igraph_lazy_adjlist_t *al);
+DECLDIR void igraph_lazy_adjlist_release(igraph_lazy_adjlist_t *al,
+        igraph_integer_t no);
 /* igraph_vector_t *igraph_lazy_adjlist_get(igraph_lazy_adjlist_t *al, */
 /*                     igraph_integer_t no); */
 /**
@@ -132,7 +191,9 @@ DECLDIR void igraph_lazy_adjlist_clear(igraph_lazy_adjlist_t *al);
  * \param al The lazy adjacency list.
  * \param no The vertex ID to query.
  * \return Pointer to a vector. It is allowed to modify it and
- *   modification does not affect the original graph.
+ *   modification does not affect the original graph. A null pointer is
+ *   returned if there is not enough memory to query the neighbors; the
+ *   error has already been reported in this case.
  *
  * Time complexity: O(d), the number of neighbor vertices for the
  * first time, O(1) for subsequent calls.
@@ -167,7 +228,9 @@ DECLDIR void igraph_lazy_inclist_clear(igraph_lazy_inclist_t *il);
  * \param al The lazy incidence list object.
  * \param no The vertex id to query.
  * \return Pointer to a vector. It is allowed to modify it and
- *   modification does not affect the original graph.
+ *   modification does not affect the original graph. A null pointer is
+ *   returned if there is not enough memory to query the edges; the
+ *   error has already been reported in this case.
  *
  * Time complexity: O(d), the number of incident edges for the first
  * time, O(1) for subsequent calls with the same \p no argument.
@@ -187,6 +187,14 @@ typedef enum { IGRAPH_RANDOM_WALK_STUCK_ERROR = 0,
                IGRAPH_RANDOM_WALK_STUCK_RETURN
              } igraph_random_walk_stuck_t;
 
+typedef enum { IGRAPH_REORDER_DEGREE = 0,
+               IGRAPH_REORDER_HUB,
+               IGRAPH_REORDER_BFS,
+               IGRAPH_REORDER_DFS,
+               IGRAPH_REORDER_RCM,
+               IGRAPH_REORDER_GORDER
+             } igraph_reorder_algorithm_t;
+
 
 __END_DECLS
 
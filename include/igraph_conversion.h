@@ -53,6 +53,16 @@ DECLDIR int igraph_get_stochastic_sparsemat(const igraph_t *graph,
         igraph_bool_t column_wise);
 
 DECLDIR int igraph_get_edgelist(const igraph_t *graph, igraph_vector_t *res, igraph_bool_t bycol);
+DECLDIR int igraph_get_csr(const igraph_t *graph, igraph_vector_int_t *offsets,
+                           igraph_vector_int_t *indices,
+                           const igraph_vector_t *weights, igraph_vector_t *values,
+                           igraph_neimode_t mode);
+DECLDIR int igraph_create_from_csr(igraph_t *graph,
+                                   const igraph_vector_int_t *offsets,
+                                   const igraph_vector_int_t *indices,
+                                   const igraph_vector_t *values,
+                                   igraph_vector_t *weights,
+                                   igraph_bool_t directed, igraph_neimode_t mode);
 
 DECLDIR int igraph_to_directed(igraph_t *graph,
                                igraph_to_directed_t flags);
@@ -0,0 +1,157 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef IGRAPH_COUNTERS_H
+#define IGRAPH_COUNTERS_H
+
+#include "igraph_decls.h"
+#include "igraph_types.h"
+
+#include <stdio.h>
+
+__BEGIN_DECLS
+
+/**
+ * \section about_counters About performance counters
+ *
+ * <para>
+ * Progress handlers tell how far a calculation got, but not where its
+ * time went. For this, igraph can record performance counters: the
+ * number of certain elementary operations (edges scanned, heap
+ * operations, search sources processed, ARPACK iterations, bytes
+ * allocated, etc.), and the time spent in certain groups of functions
+ * (shortest paths, betweenness, community detection, etc.).
+ * </para>
+ *
+ * <para>
+ * Counting is off by default and it is turned on with
+ * \ref igraph_set_counters(). The counters are accumulated across calls
+ * until they are cleared with \ref igraph_counters_reset(); a snapshot
+ * can be taken at any time with \ref igraph_counters_get() and written
+ * out in JSON format with \ref igraph_counters_write_json(). If igraph
+ * is built with thread-local storage support, then each thread has its
+ * own counters.
+ * </para>
+ *
+ * <para>
+ * The counters can be left out of igraph completely by configuring it
+ * with <code>--disable-counters</code>; in this case
+ * \ref igraph_set_counters() fails and all counters stay zero.
+ * </para>
+ */
+
+/**
+ * \typedef igraph_counter_t
+ * \brief The operations that are counted.
+ *
+ * \enumval IGRAPH_COUNTER_EDGES_SCANNED Number of edges (adjacency
+ *    list entries) examined by graph searches.
+ * \enumval IGRAPH_COUNTER_HEAP_OPERATIONS Number of insertions,
+ *    removals and key updates on priority queues.
+ * \enumval IGRAPH_COUNTER_SEARCH_SOURCES Number of single-source
+ *    searches (BFS or Dijkstra) started.
+ * \enumval IGRAPH_COUNTER_ARPACK_ITERATIONS Number of Arnoldi
+ *    update iterations performed by the ARPACK eigensolvers.
+ * \enumval IGRAPH_COUNTER_ALLOCATED_BYTES Number of bytes requested
+ *    from \ref igraph_malloc(), \ref igraph_calloc() and \ref
+ *    igraph_realloc().
+ * \enumval IGRAPH_COUNTER_FLOW_PUSHES Number of push operations of
+ *    the push-relabel maximum flow algorithm.
+ * \enumval IGRAPH_COUNTER_FLOW_RELABELS Number of relabel operations
+ *    of the push-relabel maximum flow algorithm.
+ * \enumval IGRAPH_COUNTER_COMMUNITY_MOVES Number of vertices moved to
+ *    another community by local moving community detection algorithms.
+ */
+
+typedef enum {
+    IGRAPH_COUNTER_EDGES_SCANNED = 0,
+    IGRAPH_COUNTER_HEAP_OPERATIONS,
+    IGRAPH_COUNTER_SEARCH_SOURCES,
+    IGRAPH_COUNTER_ARPACK_ITERATIONS,
+    IGRAPH_COUNTER_ALLOCATED_BYTES,
+    IGRAPH_COUNTER_FLOW_PUSHES,
+    IGRAPH_COUNTER_FLOW_RELABELS,
+    IGRAPH_COUNTER_COMMUNITY_MOVES,
+    IGRAPH_COUNTER_NUM
+} igraph_counter_t;
+
+/**
+ * \typedef igraph_timer_t
+ * \brief The groups of functions that are timed.
+ *
+ * The time spent in a group is measured from the start until the end
+ * of the outermost call to a function of the group, so nested calls
+ * are not counted twice. Calls that fail are not counted.
+ *
+ * \enumval IGRAPH_TIMER_SHORTEST_PATHS \ref igraph_shortest_paths() and
+ *    \ref igraph_shortest_paths_dijkstra().
+ * \enumval IGRAPH_TIMER_BETWEENNESS Vertex and edge betweenness.
+ * \enumval IGRAPH_TIMER_CLOSENESS Closeness centrality.
+ * \enumval IGRAPH_TIMER_PAGERANK PageRank and personalized PageRank.
+ * \enumval IGRAPH_TIMER_ARPACK The ARPACK eigensolvers, \ref
+ *    igraph_arpack_rssolve() and \ref igraph_arpack_rnsolve().
+ * \enumval IGRAPH_TIMER_MAXFLOW \ref igraph_maxflow() and the
+ *    functions built on it.
+ * \enumval IGRAPH_TIMER_COMMUNITY \ref igraph_community_leiden() and
+ *    \ref igraph_community_multilevel().
+ */
+
+typedef enum {
+    IGRAPH_TIMER_SHORTEST_PATHS = 0,
+    IGRAPH_TIMER_BETWEENNESS,
+    IGRAPH_TIMER_CLOSENESS,
+    IGRAPH_TIMER_PAGERANK,
+    IGRAPH_TIMER_ARPACK,
+    IGRAPH_TIMER_MAXFLOW,
+    IGRAPH_TIMER_COMMUNITY,
+    IGRAPH_TIMER_NUM
+} igraph_timer_t;
+
+/**
+ * \struct igraph_counters_t
+ * \brief A snapshot of the performance counters.
+ *
+ * \member counts The value of each counter, indexed by \ref
+ *    igraph_counter_t.
+ * \member seconds The wall-clock time in seconds spent in each group
+ *    of functions, indexed by \ref igraph_timer_t.
+ * \member calls The number of completed outermost calls in each group
+ *    of functions, indexed by \ref igraph_timer_t.
+ */
+
+typedef struct igraph_counters_t {
+    igraph_real_t counts[IGRAPH_COUNTER_NUM];
+    igraph_real_t seconds[IGRAPH_TIMER_NUM];
+    igraph_real_t calls[IGRAPH_TIMER_NUM];
+} igraph_counters_t;
+
+DECLDIR int igraph_set_counters(igraph_bool_t enabled);
+DECLDIR void igraph_counters_reset(void);
+DECLDIR void igraph_counters_get(igraph_counters_t *counters);
+DECLDIR const char *igraph_counter_name(igraph_counter_t counter);
+DECLDIR const char *igraph_timer_name(igraph_timer_t timer);
+DECLDIR int igraph_counters_write_json(const igraph_counters_t *counters,
+                                       FILE *outstream);
+
+__END_DECLS
+
+#endif
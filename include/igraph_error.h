@@ -488,7 +488,6 @@ DECLDIR const char* igraph_strerror(const int igraph_errno);
  * information. We don't use the exception handling code though.  */
 
 struct igraph_i_protectedPtr {
-    int all;
     void *ptr;
     void (*func)(void*);
 };
@@ -510,6 +509,28 @@ DECLDIR void IGRAPH_FINALLY_REAL(void (*func)(void*), void* ptr);
 
 DECLDIR void IGRAPH_FINALLY_CLEAN(int num);
 
+/**
+ * \function IGRAPH_FINALLY_CLEAN_TO
+ * \brief Signal clean deallocation of objects registered since a point.
+ *
+ * Removes objects from the stack of temporarily allocated objects
+ * until it contains \p size objects. Together with \ref
+ * IGRAPH_FINALLY_STACK_SIZE() it works like a scope marker: save the
+ * size of the stack before a block that registers a varying number of
+ * objects, e.g. an iteration of a loop, and restore it at the end of the
+ * block, instead of counting the objects for \ref IGRAPH_FINALLY_CLEAN().
+ * <programlisting>
+ * int mark = IGRAPH_FINALLY_STACK_SIZE();
+ * ...
+ * IGRAPH_FINALLY_CLEAN_TO(mark);
+ * </programlisting>
+ * Like \ref IGRAPH_FINALLY_CLEAN(), this does not destroy the objects.
+ * \param size The number of objects to keep in the stack. If the stack
+ *   is not larger than this, it is left unchanged.
+ */
+
+DECLDIR void IGRAPH_FINALLY_CLEAN_TO(int size);
+
 /**
  * \function IGRAPH_FINALLY_FREE
  * \brief Deallocate all registered objects.
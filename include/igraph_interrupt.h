@@ -25,6 +25,7 @@
 #define IGRAPH_INTERRUPT_H
 
 #include "igraph_error.h"
+#include "igraph_types.h"
 #include "igraph_decls.h"
 
 __BEGIN_DECLS
@@ -123,6 +124,58 @@ DECLDIR int igraph_allow_interruption(void* data);
 
 DECLDIR igraph_interruption_handler_t * igraph_set_interruption_handler (igraph_interruption_handler_t * new_handler);
 
+/**
+ * \section about_cancellation Cancellation tokens and deadlines
+ *
+ * <para>
+ * Interruption handlers are polled, so they are a poor fit for
+ * programs that want to stop a calculation from another thread, or
+ * that want to give up after a fixed amount of wall-clock time. For
+ * these cases \a igraph provides cancellation contexts of type
+ * \ref igraph_cancellation_t.
+ * </para>
+ * <para>
+ * A cancellation context is initialized with
+ * \ref igraph_cancellation_init(), optionally with a deadline, and
+ * installed for the current thread with \ref igraph_set_cancellation().
+ * From then on, every point where \a igraph checks for interruption
+ * requests also checks the context: if \ref igraph_cancel() was
+ * called on it, the running function fails with
+ * \c IGRAPH_INTERRUPTED; if its deadline has passed, it fails with
+ * \c IGRAPH_CPUTIME. As with interruption handlers, the error code is
+ * passed up to the caller, which reports it to the error handler.
+ * </para>
+ * <para>
+ * The deadline is checked against a monotonic clock, but not on every
+ * checkpoint: the clock is read less often when checkpoints are
+ * frequent, so the overhead stays negligible even in tight loops, while
+ * the deadline is still noticed within a few milliseconds.
+ * </para>
+ */
+
+/**
+ * \struct igraph_cancellation_t
+ * \brief A cancellation context.
+ *
+ * The fields of this structure are internal, use
+ * \ref igraph_cancellation_init() and \ref igraph_cancel() to
+ * manipulate it. The context does not own any memory, so it does not
+ * need to be destroyed.
+ */
+
+typedef struct igraph_cancellation_t {
+    volatile int cancelled;
+    double deadline;
+    double last_check;
+    int stride;
+    int countdown;
+} igraph_cancellation_t;
+
+DECLDIR void igraph_cancellation_init(igraph_cancellation_t *cancellation,
+                                      igraph_real_t timeout);
+DECLDIR void igraph_cancel(igraph_cancellation_t *cancellation);
+DECLDIR igraph_cancellation_t *igraph_set_cancellation(igraph_cancellation_t *cancellation);
+
 __END_DECLS
 
 #endif
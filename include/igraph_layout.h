@@ -57,6 +57,13 @@ DECLDIR int igraph_layout_fruchterman_reingold(const igraph_t *graph,
         const igraph_vector_t *maxx,
         const igraph_vector_t *miny,
         const igraph_vector_t *maxy);
+DECLDIR int igraph_layout_fruchterman_reingold_incremental(const igraph_t *graph,
+        igraph_matrix_t *res,
+        const igraph_vs_t changed,
+        igraph_integer_t radius,
+        igraph_integer_t niter,
+        igraph_real_t start_temp,
+        const igraph_vector_t *weight);
 
 DECLDIR int igraph_layout_kamada_kawai(const igraph_t *graph, igraph_matrix_t *res,
                                        igraph_bool_t use_seed, igraph_integer_t maxiter,
@@ -231,6 +238,27 @@ DECLDIR int igraph_layout_drl_3d(const igraph_t *graph, igraph_matrix_t *res,
 DECLDIR int igraph_layout_merge_dla(igraph_vector_ptr_t *graphs,
                                     igraph_vector_ptr_t *coords,
                                     igraph_matrix_t *res);
+DECLDIR int igraph_layout_merge_pack(const igraph_vector_ptr_t *coords,
+                                     igraph_matrix_t *res, igraph_real_t gap);
+
+/**
+ * \typedef igraph_layout_function_t
+ * \brief Type of layout functions used by \ref igraph_layout_components().
+ *
+ * \param graph The graph to lay out.
+ * \param res Pointer to an initialized matrix, the layout must be
+ *        stored here, one row per vertex, two columns.
+ * \param extra The extra argument that was passed to \ref
+ *        igraph_layout_components().
+ * \return Error code.
+ */
+
+typedef int igraph_layout_function_t(const igraph_t *graph, igraph_matrix_t *res,
+                                     void *extra);
+
+DECLDIR int igraph_layout_components(const igraph_t *graph, igraph_matrix_t *res,
+                                     igraph_layout_function_t *layout, void *extra,
+                                     igraph_real_t gap);
 
 DECLDIR int igraph_layout_gem(const igraph_t *graph, igraph_matrix_t *res,
                               igraph_bool_t use_seed, igraph_integer_t maxiter,
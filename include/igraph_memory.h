@@ -26,12 +26,13 @@
 
 #include <stdlib.h>
 #include "igraph_decls.h"
+#include "igraph_types.h"
 
 __BEGIN_DECLS
 
-#define igraph_Calloc(n,t)    (t*) calloc( (size_t)(n), sizeof(t) )
-#define igraph_Realloc(p,n,t) (t*) realloc((void*)(p), (size_t)((n)*sizeof(t)))
-#define igraph_Free(p)        (free( (void *)(p) ), (p) = NULL)
+#define igraph_Calloc(n,t)    (t*) igraph_calloc( (size_t)(n), sizeof(t) )
+#define igraph_Realloc(p,n,t) (t*) igraph_realloc((void*)(p), (size_t)((n)*sizeof(t)))
+#define igraph_Free(p)        (igraph_free( (void *)(p) ), (p) = NULL)
 
 /* #ifndef IGRAPH_NO_CALLOC */
 /* #  define Calloc igraph_Calloc */
@@ -39,8 +40,46 @@ __BEGIN_DECLS
 /* #  define Free igraph_Free */
 /* #endif */
 
+/**
+ * \struct igraph_allocator_t
+ * \brief The functions used by igraph to allocate memory.
+ *
+ * All memory allocated by igraph functions, and all memory that igraph
+ * functions release, goes through the functions in this table, see \ref
+ * igraph_set_allocator(). The functions have the same semantics as their
+ * counterparts in the C standard library, and they receive the \c state
+ * field of the table as their last argument.
+ *
+ * \member malloc_func Allocates uninitialized memory, like \c malloc().
+ * \member calloc_func Allocates zero-filled memory for an array, like \c
+ *    calloc().
+ * \member realloc_func Resizes a piece of memory, like \c realloc().
+ *    It must accept a null pointer, in which case it allocates new memory.
+ * \member free_func Releases memory, like \c free(). It must accept a null
+ *    pointer and do nothing in this case.
+ * \member state Arbitrary data that is passed to the functions above.
+ */
+
+typedef struct igraph_allocator_t {
+    void *(*malloc_func)(size_t size, void *state);
+    void *(*calloc_func)(size_t count, size_t size, void *state);
+    void *(*realloc_func)(void *ptr, size_t size, void *state);
+    void (*free_func)(void *ptr, void *state);
+    void *state;
+} igraph_allocator_t;
+
+DECLDIR int igraph_set_allocator(const igraph_allocator_t *allocator,
+                                 igraph_allocator_t *old);
+
+DECLDIR int igraph_set_memory_accounting(igraph_bool_t enabled);
+DECLDIR int igraph_set_memory_budget(size_t budget, size_t *old);
+DECLDIR void igraph_memory_usage(size_t *current, size_t *peak);
+DECLDIR void igraph_memory_reset_peak(void);
+
 DECLDIR int igraph_free(void *p);
 DECLDIR void *igraph_malloc(size_t n);
+DECLDIR void *igraph_calloc(size_t count, size_t size);
+DECLDIR void *igraph_realloc(void *p, size_t size);
 
 __END_DECLS
 
@@ -67,6 +67,8 @@ DECLDIR int igraph_induced_subgraph_map(const igraph_t *graph, igraph_t *res,
                                         igraph_vector_t *invmap);
 DECLDIR int igraph_induced_subgraph(const igraph_t *graph, igraph_t *res,
                                     const igraph_vs_t vids, igraph_subgraph_implementation_t impl);
+DECLDIR int igraph_induced_subgraphs(const igraph_t *graph, igraph_vector_ptr_t *res,
+                                     const igraph_vector_ptr_t *vids);
 DECLDIR int igraph_subgraph_edges(const igraph_t *graph, igraph_t *res,
                                   const igraph_es_t eids, igraph_bool_t delete_vertices);
 DECLDIR int igraph_simplify(igraph_t *graph, igraph_bool_t multiple,
@@ -128,6 +130,18 @@ DECLDIR int igraph_feedback_arc_set(const igraph_t *graph, igraph_vector_t *resu
 DECLDIR int igraph_diversity(igraph_t *graph, const igraph_vector_t *weights,
                              igraph_vector_t *res, const igraph_vs_t vs);
 
+/* -------------------------------------------------- */
+/* Vertex reordering                                  */
+/* -------------------------------------------------- */
+
+DECLDIR int igraph_vertex_reordering(const igraph_t *graph,
+                                     igraph_vector_t *permutation,
+                                     igraph_vector_t *invmap,
+                                     igraph_reorder_algorithm_t algo);
+DECLDIR int igraph_reorder_vertices(const igraph_t *graph, igraph_t *res,
+                                    igraph_vector_t *invmap,
+                                    igraph_reorder_algorithm_t algo);
+
 /* -------------------------------------------------- */
 /* Spectral Properties                                */
 /* -------------------------------------------------- */
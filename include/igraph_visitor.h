@@ -28,6 +28,7 @@
 #include "igraph_constants.h"
 #include "igraph_types.h"
 #include "igraph_datatype.h"
+#include "igraph_adjlist.h"
 
 __BEGIN_DECLS
 
@@ -44,7 +45,10 @@ __BEGIN_DECLS
  * callback function must be of type \c igraph_bfshandler_t. It has
  * the following arguments:
  * \param graph The graph that that algorithm is working on. Of course
- *   this must not be modified.
+ *   this must not be modified. For \ref igraph_bfs_lazy_adjlist(),
+ *   this is the \c graph member of the adjacency list, which is a
+ *   null pointer for compressed adjacency lists, see \ref
+ *   igraph_lazy_adjlist_t.
  * \param vid The id of the vertex just found by the breadth-first
  *   search.
  * \param pred The id of the previous vertex visited. It is -1 if
@@ -84,6 +88,15 @@ DECLDIR int igraph_bfs(const igraph_t *graph,
                igraph_vector_t *pred, igraph_vector_t *succ,
                igraph_vector_t *dist, igraph_bfshandler_t *callback,
                void *extra);
+DECLDIR int igraph_bfs_lazy_adjlist(igraph_lazy_adjlist_t *al,
+                            igraph_integer_t root, const igraph_vector_t *roots,
+                            igraph_bool_t unreachable,
+                            const igraph_vector_t *restricted,
+                            igraph_vector_t *order, igraph_vector_t *rank,
+                            igraph_vector_t *father,
+                            igraph_vector_t *pred, igraph_vector_t *succ,
+                            igraph_vector_t *dist, igraph_bfshandler_t *callback,
+                            void *extra);
 
 int igraph_i_bfs(igraph_t *graph, igraph_integer_t vid, igraph_neimode_t mode,
                  igraph_vector_t *vids, igraph_vector_t *layers,
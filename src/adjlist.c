@@ -66,6 +66,21 @@
  * during the computation.
  * </para>
  *
+ * <para>Lazy adjacency lists can also give the neighbors in graphs
+ * derived from the original one, the complementer and the line graph,
+ * see \ref igraph_lazy_adjlist_init_complementer() and \ref
+ * igraph_lazy_adjlist_init_linegraph(). These graphs can be much
+ * larger than the original graph, and they are never created: only the
+ * neighbor lists that are queried are calculated. \ref
+ * igraph_bfs_lazy_adjlist() searches them.
+ * </para>
+ *
+ * <para>Compressed adjacency lists store the neighbors of the vertices
+ * with variable length delta encoding, in a fraction of the memory
+ * needed by a graph or an adjacency list. They are read-only, and the
+ * lists are decoded when they are queried.
+ * </para>
+ *
  * <para>
  * \example examples/simple/adjlist.c
  * </para>
@@ -689,6 +704,221 @@ void igraph_inclist_clear(igraph_inclist_t *il) {
     }
 }
 
+/* Unsigned integers are stored in LEB128 format: seven bits in each
+   byte, the highest bit is set if more bytes follow */
+
+static long int igraph_i_varint_size(unsigned long int x) {
+    long int n = 1;
+    while (x >= 128) {
+        x >>= 7;
+        n++;
+    }
+    return n;
+}
+
+static unsigned char *igraph_i_varint_encode(unsigned char *p,
+        unsigned long int x) {
+    while (x >= 128) {
+        *p++ = (unsigned char) (x | 128);
+        x >>= 7;
+    }
+    *p++ = (unsigned char) x;
+    return p;
+}
+
+static const unsigned char *igraph_i_varint_decode(const unsigned char *p,
+        unsigned long int *x) {
+    unsigned long int res = 0;
+    int shift = 0;
+    while (*p & 128) {
+        res |= (unsigned long int) (*p++ & 127) << shift;
+        shift += 7;
+    }
+    *x = res | (unsigned long int) *p++ << shift;
+    return p;
+}
+
+/* A compressed neighbor list is the degree, the difference of the
+   first neighbor and the vertex itself, in zigzag encoding, as it can
+   be negative, and the differences of the consecutive neighbors. The
+   list is only measured if 'p' is a null pointer. */
+
+static long int igraph_i_compressed_adjlist_encode(long int no,
+        const igraph_vector_t *neis,
+        unsigned char *p) {
+    long int i, n = igraph_vector_size(neis), size;
+    long int prev = no;
+    unsigned long int x = (unsigned long int) n;
+
+    size = igraph_i_varint_size(x);
+    if (p) {
+        p = igraph_i_varint_encode(p, x);
+    }
+    for (i = 0; i < n; i++) {
+        long int nei = (long int) VECTOR(*neis)[i];
+        if (i == 0) {
+            x = nei >= prev ? 2 * (unsigned long int) (nei - prev) :
+                2 * (unsigned long int) (prev - nei) - 1;
+        } else {
+            x = (unsigned long int) (nei - prev);
+        }
+        size += igraph_i_varint_size(x);
+        if (p) {
+            p = igraph_i_varint_encode(p, x);
+        }
+        prev = nei;
+    }
+    return size;
+}
+
+/**
+ * \function igraph_compressed_adjlist_init
+ * \brief Constructs a compressed adjacency list of a graph.
+ *
+ * A compressed adjacency list stores the sorted neighbor lists of the
+ * vertices with variable length delta encoding, similarly to the
+ * Ligra+ and WebGraph systems. It is read-only, and it typically needs
+ * one to three bytes for each neighbor, instead of the 32 bytes per
+ * edge of an \type igraph_t and the 4 or 8 bytes per neighbor of the
+ * other adjacency lists; the less the vertex ids of the neighbors differ,
+ * the smaller it is. Like the other adjacency lists, it is
+ * independent of the graph after creation, so the graph can be
+ * destroyed to save memory.
+ *
+ * </para><para>
+ * The neighbors are queried with \ref igraph_compressed_adjlist_get()
+ * and \ref igraph_compressed_adjlist_degree(). Functions that work on
+ * lazy adjacency lists, e.g. \ref igraph_bfs_lazy_adjlist(), can use a
+ * compressed adjacency list through \ref
+ * igraph_lazy_adjlist_init_compressed().
+ * \param graph The input graph.
+ * \param cal Pointer to an uninitialized
+ *   <type>igraph_compressed_adjlist_t</type> object.
+ * \param mode Constant specifying whether outgoing
+ *   (<code>IGRAPH_OUT</code>), incoming (<code>IGRAPH_IN</code>),
+ *   or both (<code>IGRAPH_ALL</code>) types of neighbors to include
+ *   in the adjacency list. It is ignored for undirected networks.
+ * \return Error code.
+ *
+ * Time complexity: O(|V|+|E|), linear in the number of vertices and
+ * edges.
+ */
+
+int igraph_compressed_adjlist_init(const igraph_t *graph,
+                                   igraph_compressed_adjlist_t *cal,
+                                   igraph_neimode_t mode) {
+    long int no_of_nodes = igraph_vcount(graph);
+    long int i, size = 0;
+    unsigned char *p;
+    igraph_vector_t neis;
+
+    if (mode != IGRAPH_IN && mode != IGRAPH_OUT && mode != IGRAPH_ALL) {
+        IGRAPH_ERROR("Cannot create compressed adjlist", IGRAPH_EINVMODE);
+    }
+
+    if (!igraph_is_directed(graph)) {
+        mode = IGRAPH_ALL;
+    }
+
+    IGRAPH_VECTOR_INIT_FINALLY(&neis, 0);
+    IGRAPH_CHECK(igraph_vector_long_init(&cal->offsets, no_of_nodes + 1));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &cal->offsets);
+
+    /* Measure the lists first, so that the data is allocated only once */
+    for (i = 0; i < no_of_nodes; i++) {
+        IGRAPH_ALLOW_INTERRUPTION();
+        IGRAPH_CHECK(igraph_neighbors(graph, &neis, (igraph_integer_t) i, mode));
+        VECTOR(cal->offsets)[i] = size;
+        size += igraph_i_compressed_adjlist_encode(i, &neis, 0);
+    }
+    VECTOR(cal->offsets)[no_of_nodes] = size;
+
+    IGRAPH_CHECK(igraph_vector_char_init(&cal->data, size));
+    IGRAPH_FINALLY(igraph_vector_char_destroy, &cal->data);
+
+    p = (unsigned char *) VECTOR(cal->data);
+    for (i = 0; i < no_of_nodes; i++) {
+        IGRAPH_ALLOW_INTERRUPTION();
+        IGRAPH_CHECK(igraph_neighbors(graph, &neis, (igraph_integer_t) i, mode));
+        p += igraph_i_compressed_adjlist_encode(i, &neis, p);
+    }
+    cal->length = (igraph_integer_t) no_of_nodes;
+
+    igraph_vector_destroy(&neis);
+    IGRAPH_FINALLY_CLEAN(3);
+
+    return 0;
+}
+
+/**
+ * \function igraph_compressed_adjlist_destroy
+ * \brief Deallocates a compressed adjacency list.
+ *
+ * \param cal The compressed adjacency list to destroy.
+ *
+ * Time complexity: depends on memory management.
+ */
+
+void igraph_compressed_adjlist_destroy(igraph_compressed_adjlist_t *cal) {
+    igraph_vector_char_destroy(&cal->data);
+    igraph_vector_long_destroy(&cal->offsets);
+}
+
+/**
+ * \function igraph_compressed_adjlist_degree
+ * \brief The number of neighbors of a vertex in a compressed adjacency list.
+ *
+ * \param cal The compressed adjacency list.
+ * \param no The vertex.
+ * \return The number of neighbors, with multiplicity.
+ *
+ * Time complexity: O(1).
+ */
+
+igraph_integer_t igraph_compressed_adjlist_degree(const igraph_compressed_adjlist_t *cal,
+        igraph_integer_t no) {
+    unsigned long int n;
+    igraph_i_varint_decode((const unsigned char *) VECTOR(cal->data) +
+                           VECTOR(cal->offsets)[(long int) no], &n);
+    return (igraph_integer_t) n;
+}
+
+/**
+ * \function igraph_compressed_adjlist_get
+ * \brief Decodes the neighbors of a vertex in a compressed adjacency list.
+ *
+ * \param cal The compressed adjacency list.
+ * \param no The vertex.
+ * \param res Pointer to an initialized vector, the neighbors are
+ *   stored here in increasing order, as by \ref igraph_neighbors().
+ * \return Error code.
+ *
+ * Time complexity: O(d), the number of neighbors.
+ */
+
+int igraph_compressed_adjlist_get(const igraph_compressed_adjlist_t *cal,
+                                  igraph_integer_t no,
+                                  igraph_vector_t *res) {
+    const unsigned char *p = (const unsigned char *) VECTOR(cal->data) +
+                             VECTOR(cal->offsets)[(long int) no];
+    unsigned long int n, x;
+    long int i, nei = no;
+
+    p = igraph_i_varint_decode(p, &n);
+    IGRAPH_CHECK(igraph_vector_resize(res, (long int) n));
+    for (i = 0; i < (long int) n; i++) {
+        p = igraph_i_varint_decode(p, &x);
+        if (i == 0) {
+            nei += x % 2 ? -(long int) ((x + 1) / 2) : (long int) (x / 2);
+        } else {
+            nei += (long int) x;
+        }
+        VECTOR(*res)[i] = nei;
+    }
+
+    return 0;
+}
+
 /**
  * \function igraph_lazy_adjlist_init
  * \brief Initialized a lazy adjacency list.
@@ -713,10 +943,12 @@ void igraph_inclist_clear(igraph_inclist_t *il) {
  * depends on the underlying memory management too.
  */
 
-int igraph_lazy_adjlist_init(const igraph_t *graph,
-                             igraph_lazy_adjlist_t *al,
-                             igraph_neimode_t mode,
-                             igraph_lazy_adlist_simplify_t simplify) {
+static int igraph_i_lazy_adjlist_init(const igraph_t *graph,
+                                      igraph_lazy_adjlist_t *al,
+                                      igraph_neimode_t mode,
+                                      igraph_lazy_adlist_simplify_t simplify,
+                                      igraph_lazy_adjlist_type_t type,
+                                      igraph_integer_t length) {
     if (mode != IGRAPH_IN && mode != IGRAPH_OUT && mode != IGRAPH_ALL) {
         IGRAPH_ERROR("Cannor create adjlist view", IGRAPH_EINVMODE);
     }
@@ -727,8 +959,134 @@ int igraph_lazy_adjlist_init(const igraph_t *graph,
     al->mode = mode;
     al->simplify = simplify;
     al->graph = graph;
+    al->type = type;
+    al->compressed = 0;
 
-    al->length = igraph_vcount(graph);
+    al->length = length;
+    al->adjs = igraph_Calloc(al->length, igraph_vector_t*);
+    if (al->adjs == 0) {
+        IGRAPH_ERROR("Cannot create lazy adjlist view", IGRAPH_ENOMEM);
+    }
+
+    return 0;
+}
+
+int igraph_lazy_adjlist_init(const igraph_t *graph,
+                             igraph_lazy_adjlist_t *al,
+                             igraph_neimode_t mode,
+                             igraph_lazy_adlist_simplify_t simplify) {
+    return igraph_i_lazy_adjlist_init(graph, al, mode, simplify,
+                                      IGRAPH_LAZY_ADJLIST_NEIGHBORS,
+                                      igraph_vcount(graph));
+}
+
+/**
+ * \function igraph_lazy_adjlist_init_complementer
+ * \brief Lazy adjacency list of the complementer graph.
+ *
+ * Creates a lazy adjacency list that gives the neighbors of the
+ * vertices in the complementer graph, see \ref igraph_complementer(),
+ * without creating the complementer. A neighbor list is only
+ * calculated when it is queried with \ref igraph_lazy_adjlist_get(),
+ * and it needs O(|V|) time and memory. Use \ref
+ * igraph_lazy_adjlist_release() to free the lists that are not needed
+ * any more, if the complementer graph is too large to be stored.
+ * \param graph The input graph.
+ * \param al Pointer to an uninitialized adjacency list object.
+ * \param mode Constant, it gives whether incoming edges
+ *   (<code>IGRAPH_IN</code>), outgoing edges
+ *   (<code>IGRPAH_OUT</code>) or both types of edges
+ *   (<code>IGRAPH_ALL</code>) are considered in the original graph.
+ *   It is ignored for undirected graphs.
+ * \param loops Whether to consider loop edges in the complementer
+ *   graph.
+ * \return Error code.
+ *
+ * Time complexity: O(|V|), the number of vertices, possibly, but
+ * depends on the underlying memory management too.
+ */
+
+int igraph_lazy_adjlist_init_complementer(const igraph_t *graph,
+        igraph_lazy_adjlist_t *al,
+        igraph_neimode_t mode,
+        igraph_bool_t loops) {
+    /* The complementer has no multiple edges, simplification only
+       removes the loop edges */
+    return igraph_i_lazy_adjlist_init(graph, al, mode,
+                                      loops ? IGRAPH_DONT_SIMPLIFY : IGRAPH_SIMPLIFY,
+                                      IGRAPH_LAZY_ADJLIST_COMPLEMENTER,
+                                      igraph_vcount(graph));
+}
+
+/**
+ * \function igraph_lazy_adjlist_init_linegraph
+ * \brief Lazy adjacency list of the line graph.
+ *
+ * Creates a lazy adjacency list that gives the neighbors of the
+ * vertices in the line graph, see \ref igraph_linegraph(), without
+ * creating the line graph. Vertex \em i of the line graph corresponds
+ * to edge \em i of the original graph, and its neighbor list is only
+ * calculated from the edges incident on the endpoints of edge \em i
+ * when it is queried with \ref igraph_lazy_adjlist_get().
+ * \param graph The input graph.
+ * \param al Pointer to an uninitialized adjacency list object.
+ * \param mode Constant, it gives whether incoming edges
+ *   (<code>IGRAPH_IN</code>), outgoing edges
+ *   (<code>IGRPAH_OUT</code>) or both types of edges
+ *   (<code>IGRAPH_ALL</code>) of the line graph are considered. It is
+ *   ignored for undirected graphs.
+ * \param simplify Constant, it gives whether to simplify the vectors
+ *   in the adjacency list (<code>IGRAPH_SIMPLIFY</code>) or not
+ *   (<code>IGRAPH_DONT_SIMPLIFY</code>).
+ * \return Error code.
+ *
+ * Time complexity: O(|E|), the number of edges, possibly, but
+ * depends on the underlying memory management too.
+ */
+
+int igraph_lazy_adjlist_init_linegraph(const igraph_t *graph,
+                                       igraph_lazy_adjlist_t *al,
+                                       igraph_neimode_t mode,
+                                       igraph_lazy_adlist_simplify_t simplify) {
+    return igraph_i_lazy_adjlist_init(graph, al, mode, simplify,
+                                      IGRAPH_LAZY_ADJLIST_LINEGRAPH,
+                                      igraph_ecount(graph));
+}
+
+/**
+ * \function igraph_lazy_adjlist_init_compressed
+ * \brief Lazy adjacency list of a compressed adjacency list.
+ *
+ * Creates a lazy adjacency list that decodes the neighbor lists of a
+ * compressed adjacency list when they are queried with \ref
+ * igraph_lazy_adjlist_get(), so that functions working on lazy
+ * adjacency lists can be used on compressed graphs, see \ref
+ * igraph_compressed_adjlist_init(). The \c graph member of the lazy
+ * adjacency list is a null pointer, so code working on it must take
+ * the number of vertices from its \c length member, see \ref
+ * igraph_lazy_adjlist_t. The compressed adjacency list must be kept
+ * until the lazy adjacency list is destroyed.
+ * \param cal The compressed adjacency list.
+ * \param al Pointer to an uninitialized adjacency list object.
+ * \param simplify Constant, it gives whether to simplify the vectors
+ *   in the adjacency list (<code>IGRAPH_SIMPLIFY</code>) or not
+ *   (<code>IGRAPH_DONT_SIMPLIFY</code>).
+ * \return Error code.
+ *
+ * Time complexity: O(|V|), the number of vertices, possibly, but
+ * depends on the underlying memory management too.
+ */
+
+int igraph_lazy_adjlist_init_compressed(const igraph_compressed_adjlist_t *cal,
+                                        igraph_lazy_adjlist_t *al,
+                                        igraph_lazy_adlist_simplify_t simplify) {
+    al->mode = IGRAPH_OUT;
+    al->simplify = simplify;
+    al->graph = 0;
+    al->type = IGRAPH_LAZY_ADJLIST_COMPRESSED;
+    al->compressed = cal;
+
+    al->length = cal->length;
     al->adjs = igraph_Calloc(al->length, igraph_vector_t*);
     if (al->adjs == 0) {
         IGRAPH_ERROR("Cannot create lazy adjlist view", IGRAPH_ENOMEM);
@@ -763,34 +1121,142 @@ void igraph_lazy_adjlist_destroy(igraph_lazy_adjlist_t *al) {
 void igraph_lazy_adjlist_clear(igraph_lazy_adjlist_t *al) {
     long int i, n = al->length;
     for (i = 0; i < n; i++) {
-        if (al->adjs[i] != 0) {
-            igraph_vector_destroy(al->adjs[i]);
-            igraph_Free(al->adjs[i]);
+        igraph_lazy_adjlist_release(al, i);
+    }
+}
+
+/**
+ * \function igraph_lazy_adjlist_release
+ * \brief Frees the neighbor list of a vertex in a lazy adjacency list.
+ *
+ * The neighbors are queried again if they are needed later. This is
+ * useful for the lazy adjacency lists of large derived graphs, when
+ * each list is only needed once, e.g. in a breadth-first search.
+ * \param al The lazy adjacency list.
+ * \param no The vertex.
+ *
+ * Time complexity: depends on memory management.
+ */
+void igraph_lazy_adjlist_release(igraph_lazy_adjlist_t *al,
+                                 igraph_integer_t no) {
+    if (al->adjs[(long int) no] != 0) {
+        igraph_vector_destroy(al->adjs[(long int) no]);
+        igraph_Free(al->adjs[(long int) no]);
+    }
+}
+
+/* The vertices that are not neighbors of 'no'; the neighbor list
+   of igraph_neighbors() is sorted, so this is a merge. */
+static int igraph_i_lazy_adjlist_complementer(igraph_lazy_adjlist_t *al,
+        igraph_integer_t no,
+        igraph_vector_t *res) {
+    long int i, j = 0, k = 0, n = al->length, m;
+    igraph_vector_t neis;
+
+    IGRAPH_VECTOR_INIT_FINALLY(&neis, 0);
+    IGRAPH_CHECK(igraph_neighbors(al->graph, &neis, no, al->mode));
+    m = igraph_vector_size(&neis);
+    IGRAPH_CHECK(igraph_vector_resize(res, n));
+    for (i = 0; i < n; i++) {
+        while (j < m && VECTOR(neis)[j] < i) {
+            j++;
+        }
+        if (j == m || VECTOR(neis)[j] != i) {
+            VECTOR(*res)[k++] = i;
+        }
+    }
+    IGRAPH_CHECK(igraph_vector_resize(res, k));
+    igraph_vector_resize_min(res);
+
+    igraph_vector_destroy(&neis);
+    IGRAPH_FINALLY_CLEAN(1);
+    return 0;
+}
+
+/* The edges that follow edge 'no' (IGRAPH_OUT), precede it
+   (IGRAPH_IN), or both, in the line graph, in increasing order. In
+   undirected graphs, these are the other edges incident on its
+   endpoints, each once for every shared endpoint, as in
+   igraph_linegraph(). */
+static int igraph_i_lazy_adjlist_linegraph(igraph_lazy_adjlist_t *al,
+        igraph_integer_t no,
+        igraph_vector_t *res) {
+    const igraph_t *graph = al->graph;
+    igraph_integer_t from = IGRAPH_FROM(graph, (long int) no);
+    igraph_integer_t to = IGRAPH_TO(graph, (long int) no);
+    igraph_vector_t incs;
+    long int i, j, n;
+
+    IGRAPH_VECTOR_INIT_FINALLY(&incs, 0);
+    igraph_vector_clear(res);
+    for (i = 0; i < 2; i++) {
+        if (!igraph_is_directed(graph)) {
+            IGRAPH_CHECK(igraph_incident(graph, &incs, i == 0 ? from : to,
+                                         IGRAPH_ALL));
+        } else if (i == 0 && al->mode != IGRAPH_OUT) {
+            IGRAPH_CHECK(igraph_incident(graph, &incs, from, IGRAPH_IN));
+        } else if (i == 1 && al->mode != IGRAPH_IN) {
+            IGRAPH_CHECK(igraph_incident(graph, &incs, to, IGRAPH_OUT));
+        } else {
+            continue;
+        }
+        n = igraph_vector_size(&incs);
+        for (j = 0; j < n; j++) {
+            if (igraph_is_directed(graph) || VECTOR(incs)[j] != no) {
+                IGRAPH_CHECK(igraph_vector_push_back(res, VECTOR(incs)[j]));
+            }
         }
     }
+    igraph_vector_sort(res);
+
+    igraph_vector_destroy(&incs);
+    IGRAPH_FINALLY_CLEAN(1);
+    return 0;
 }
 
 igraph_vector_t *igraph_lazy_adjlist_get_real(igraph_lazy_adjlist_t *al,
         igraph_integer_t pno) {
     igraph_integer_t no = pno;
+    igraph_vector_t *v;
     int ret;
+
+    /* On error the finally stack may already have destroyed the adjacency
+       list, so it is only updated once the neighbors are ready. */
     if (al->adjs[no] == 0) {
-        al->adjs[no] = igraph_Calloc(1, igraph_vector_t);
-        if (al->adjs[no] == 0) {
+        v = igraph_Calloc(1, igraph_vector_t);
+        if (v == 0) {
             igraph_error("Lazy adjlist failed", __FILE__, __LINE__,
                          IGRAPH_ENOMEM);
+            return 0;
         }
-        ret = igraph_vector_init(al->adjs[no], 0);
+        ret = igraph_vector_init(v, 0);
         if (ret != 0) {
-            igraph_error("", __FILE__, __LINE__, ret);
+            igraph_Free(v);
+            igraph_error("Lazy adjlist failed", __FILE__, __LINE__, ret);
+            return 0;
+        }
+        switch (al->type) {
+        case IGRAPH_LAZY_ADJLIST_COMPLEMENTER:
+            ret = igraph_i_lazy_adjlist_complementer(al, no, v);
+            break;
+        case IGRAPH_LAZY_ADJLIST_LINEGRAPH:
+            ret = igraph_i_lazy_adjlist_linegraph(al, no, v);
+            break;
+        case IGRAPH_LAZY_ADJLIST_COMPRESSED:
+            ret = igraph_compressed_adjlist_get(al->compressed, no, v);
+            break;
+        default:
+            ret = igraph_neighbors(al->graph, v, no, al->mode);
+            break;
         }
-        ret = igraph_neighbors(al->graph, al->adjs[no], no, al->mode);
         if (ret != 0) {
-            igraph_error("", __FILE__, __LINE__, ret);
+            igraph_vector_destroy(v);
+            igraph_Free(v);
+            igraph_error("Lazy adjlist failed", __FILE__, __LINE__, ret);
+            return 0;
         }
 
         if (al->simplify == IGRAPH_SIMPLIFY) {
-            igraph_vector_t *v = al->adjs[no];
             long int i, p = 0, n = igraph_vector_size(v);
             for (i = 0; i < n; i++) {
                 if (VECTOR(*v)[i] != no &&
@@ -801,6 +1267,7 @@ igraph_vector_t *igraph_lazy_adjlist_get_real(igraph_lazy_adjlist_t *al,
             }
             igraph_vector_resize(v, p);
         }
+        al->adjs[no] = v;
     }
 
     return al->adjs[no];
@@ -938,21 +1405,29 @@ void igraph_lazy_inclist_clear(igraph_lazy_inclist_t *il) {
 igraph_vector_t *igraph_lazy_inclist_get_real(igraph_lazy_inclist_t *il,
         igraph_integer_t pno) {
     igraph_integer_t no = pno;
+    igraph_vector_t *v;
     int ret;
     if (il->incs[no] == 0) {
-        il->incs[no] = igraph_Calloc(1, igraph_vector_t);
-        if (il->incs[no] == 0) {
+        v = igraph_Calloc(1, igraph_vector_t);
+        if (v == 0) {
             igraph_error("Lazy incidence list query failed", __FILE__, __LINE__,
                          IGRAPH_ENOMEM);
+            return 0;
         }
-        ret = igraph_vector_init(il->incs[no], 0);
+        ret = igraph_vector_init(v, 0);
         if (ret != 0) {
-            igraph_error("", __FILE__, __LINE__, ret);
+            igraph_Free(v);
+            igraph_error("Lazy incidence list query failed", __FILE__, __LINE__, ret);
+            return 0;
         }
-        ret = igraph_incident(il->graph, il->incs[no], no, il->mode);
+        ret = igraph_incident(il->graph, v, no, il->mode);
         if (ret != 0) {
-            igraph_error("", __FILE__, __LINE__, ret);
+            igraph_vector_destroy(v);
+            igraph_Free(v);
+            igraph_error("Lazy incidence list query failed", __FILE__, __LINE__, ret);
+            return 0;
         }
+        il->incs[no] = v;
     }
     return il->incs[no];
 }
@@ -25,6 +25,7 @@
 #include "igraph_arpack.h"
 #include "igraph_arpack_internal.h"
 #include "igraph_memory.h"
+#include "igraph_counters_internal.h"
 
 #include <math.h>
 #include <stdio.h>
@@ -965,6 +966,7 @@ int igraph_arpack_rssolve(igraph_arpack_function_t *fun, void *extra,
     }
 
     /* Ok, we have everything */
+    IGRAPH_TIMER_START(IGRAPH_TIMER_ARPACK);
     while (1) {
 #ifdef HAVE_GFORTRAN
         igraphdsaupd_(&ido, options->bmat, &options->n, options->which,
@@ -1031,6 +1033,9 @@ int igraph_arpack_rssolve(igraph_arpack_function_t *fun, void *extra,
     options->numopb = options->iparam[9];
     options->numreo = options->iparam[10];
 
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_ARPACK);
+    IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_ARPACK_ITERATIONS, options->noiter);
+
     if (options->nconv < options->nev) {
         IGRAPH_WARNING("Not enough eigenvalues/vectors in symmetric ARPACK "
                        "solver");
@@ -1219,6 +1224,7 @@ int igraph_arpack_rnsolve(igraph_arpack_function_t *fun, void *extra,
     }
 
     /* Ok, we have everything */
+    IGRAPH_TIMER_START(IGRAPH_TIMER_ARPACK);
     while (1) {
 #ifdef HAVE_GFORTRAN
         igraphdnaupd_(&ido, options->bmat, &options->n, options->which,
@@ -1284,6 +1290,9 @@ int igraph_arpack_rnsolve(igraph_arpack_function_t *fun, void *extra,
     options->numopb = options->iparam[9];
     options->numreo = options->iparam[10];
 
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_ARPACK);
+    IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_ARPACK_ITERATIONS, options->noiter);
+
     if (options->nconv < options->nev) {
         IGRAPH_WARNING("Not enough eigenvalues/vectors in ARPACK "
                        "solver");
@@ -23,6 +23,7 @@
 
 #include "igraph_attributes.h"
 #include "igraph_memory.h"
+#include "igraph_hacks_internal.h"
 #include "config.h"
 
 #include <string.h>
@@ -329,7 +330,7 @@ int igraph_attribute_combination_add(igraph_attribute_combination_t *comb,
         if (!name) {
             rec->name = 0;
         } else {
-            rec->name = strdup(name);
+            rec->name = igraph_i_strdup(name);
         }
         rec->type = type;
         rec->func = func;
@@ -23,9 +23,11 @@
 
 #include "igraph_attributes.h"
 #include "igraph_memory.h"
+#include "igraph_hacks_internal.h"
 #include "igraph_math.h"
 #include "igraph_interface.h"
 #include "igraph_random.h"
+#include "igraph_types_internal.h"
 #include "config.h"
 
 #include <string.h>
@@ -52,12 +54,136 @@ igraph_bool_t igraph_i_cattribute_find(const igraph_vector_ptr_t *ptrvec,
     return l;
 }
 
+/* A hash table from attribute names to their positions in one of the
+   attribute lists, so that looking up an attribute does not need a
+   string comparison with every other attribute. The table is rebuilt
+   whenever attributes are added to or removed from the list, lookups
+   only read it. 'count' is the length of the list at the time the
+   table was built, the table is only used if it is still the same;
+   hits are always verified with strcmp() and misses fall back to a
+   linear search, so an outdated table is never a correctness issue. */
+
+typedef struct igraph_i_cattribute_index_t {
+    long int *slots;            /* position + 1, or zero if empty */
+    long int size;              /* number of slots, a power of two */
+    long int count;
+} igraph_i_cattribute_index_t;
+
+/* Shorter lists are searched linearly */
+#define IGRAPH_I_CATTRIBUTE_INDEX_MIN 8
+
 typedef struct igraph_i_cattributes_t {
     igraph_vector_ptr_t gal;
     igraph_vector_ptr_t val;
     igraph_vector_ptr_t eal;
+    igraph_i_cattribute_index_t index[3];
 } igraph_i_cattributes_t;
 
+static unsigned long int igraph_i_cattribute_hash(const char *name) {
+    /* FNV-1a */
+    unsigned long int h = 2166136261UL;
+    for (; *name; name++) {
+        h ^= (unsigned char) *name;
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+static igraph_i_cattribute_index_t *igraph_i_cattribute_index_of(
+    const igraph_i_cattributes_t *attr, const igraph_vector_ptr_t *al) {
+    long int which = al == &attr->gal ? 0 : (al == &attr->val ? 1 : 2);
+    return (igraph_i_cattribute_index_t *) &attr->index[which];
+}
+
+static void igraph_i_cattribute_index_free(igraph_i_cattributes_t *attr) {
+    long int a;
+    for (a = 0; a < 3; a++) {
+        if (attr->index[a].slots) {
+            igraph_Free(attr->index[a].slots);
+        }
+        attr->index[a].size = 0;
+        attr->index[a].count = 0;
+    }
+}
+
+/* Rebuilds the name index of an attribute list after records were
+   added or removed. If there is not enough memory for the index, then
+   lookups simply stay linear. */
+
+static void igraph_i_cattribute_reindex(igraph_i_cattributes_t *attr,
+                                        igraph_vector_ptr_t *al) {
+    igraph_i_cattribute_index_t *index = igraph_i_cattribute_index_of(attr, al);
+    long int i, n = igraph_vector_ptr_size(al), size = 16;
+
+    index->count = -1;
+    if (n < IGRAPH_I_CATTRIBUTE_INDEX_MIN) {
+        if (index->slots) {
+            igraph_Free(index->slots);
+        }
+        index->size = 0;
+        return;
+    }
+
+    while (size < 2 * n) {
+        size *= 2;
+    }
+    if (index->size != size) {
+        if (index->slots) {
+            igraph_Free(index->slots);
+        }
+        index->size = 0;
+        index->slots = igraph_Calloc(size, long int);
+        if (!index->slots) {
+            return;
+        }
+        index->size = size;
+    } else {
+        memset(index->slots, 0, (size_t) size * sizeof(long int));
+    }
+
+    for (i = 0; i < n; i++) {
+        igraph_attribute_record_t *rec = VECTOR(*al)[i];
+        unsigned long int h = igraph_i_cattribute_hash(rec->name);
+        long int slot = (long int) (h & (unsigned long int) (size - 1));
+        while (index->slots[slot] != 0) {
+            slot = (slot + 1) & (size - 1);
+        }
+        index->slots[slot] = i + 1;
+    }
+    index->count = n;
+}
+
+/* Like igraph_i_cattribute_find(), but uses the name index of the
+   attribute list, if there is one. 'al' must be one of the lists of
+   'attr'. */
+
+static igraph_bool_t igraph_i_cattribute_lookup(const igraph_i_cattributes_t *attr,
+        const igraph_vector_ptr_t *al,
+        const char *name, long int *idx) {
+    const igraph_i_cattribute_index_t *index =
+        igraph_i_cattribute_index_of(attr, al);
+    long int n = igraph_vector_ptr_size(al);
+
+    if (index->slots && index->count == n) {
+        long int mask = index->size - 1;
+        long int slot = (long int) (igraph_i_cattribute_hash(name) &
+                                    (unsigned long int) mask);
+        while (index->slots[slot] != 0) {
+            long int pos = index->slots[slot] - 1;
+            igraph_attribute_record_t *rec = VECTOR(*al)[pos];
+            if (!strcmp(rec->name, name)) {
+                if (idx) {
+                    *idx = pos;
+                }
+                return 1;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    return igraph_i_cattribute_find(al, name, idx);
+}
+
 int igraph_i_cattributes_copy_attribute_record(igraph_attribute_record_t **newrec,
         const igraph_attribute_record_t *rec) {
     igraph_vector_t *num, *newnum;
@@ -69,7 +195,7 @@ int igraph_i_cattributes_copy_attribute_record(igraph_attribute_record_t **newre
     }
     IGRAPH_FINALLY(igraph_free, *newrec);
     (*newrec)->type = rec->type;
-    (*newrec)->name = strdup(rec->name);
+    (*newrec)->name = igraph_i_strdup(rec->name);
     if (!(*newrec)->name) {
         IGRAPH_ERROR("Cannot copy attributes", IGRAPH_ENOMEM);
     }
@@ -136,6 +262,7 @@ int igraph_i_cattribute_init(igraph_t *graph, igraph_vector_ptr_t *attr) {
                          &attr_rec, VECTOR(*attr)[i]));
         VECTOR(nattr->gal)[i] = attr_rec;
     }
+    igraph_i_cattribute_reindex(nattr, &nattr->gal);
 
     graph->attr = nattr;
 
@@ -176,6 +303,7 @@ void igraph_i_cattribute_destroy(igraph_t *graph) {
     igraph_vector_ptr_destroy(&attr->gal);
     igraph_vector_ptr_destroy(&attr->val);
     igraph_vector_ptr_destroy(&attr->eal);
+    igraph_i_cattribute_index_free(attr);
     igraph_free(graph->attr);
     graph->attr = 0;
 }
@@ -213,6 +341,7 @@ void igraph_i_cattribute_copy_free(igraph_i_cattributes_t *attr) {
             igraph_free(rec);
         }
     }
+    igraph_i_cattribute_index_free(attr);
 }
 
 /* No reference counting here. If you use attributes in C you should
@@ -249,6 +378,7 @@ int igraph_i_cattribute_copy(igraph_t *to, const igraph_t *from,
                              VECTOR(*alfrom[a])[i]));
                 VECTOR(*alto[a])[i] = newrec;
             }
+            igraph_i_cattribute_reindex(attrto, alto[a]);
         }
     }
 
@@ -274,7 +404,7 @@ int igraph_i_cattribute_add_vertices(igraph_t *graph, long int nv,
         igraph_attribute_record_t *nattr_entry = VECTOR(*nattr)[i];
         const char *nname = nattr_entry->name;
         long int j;
-        igraph_bool_t l = igraph_i_cattribute_find(val, nname, &j);
+        igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, nname, &j);
         if (!l) {
             newattrs++;
             IGRAPH_CHECK(igraph_vector_push_back(&news, i));
@@ -298,7 +428,7 @@ int igraph_i_cattribute_add_vertices(igraph_t *graph, long int nv,
             }
             IGRAPH_FINALLY(igraph_free, newrec);
             newrec->type = type;
-            newrec->name = strdup(tmp->name);
+            newrec->name = igraph_i_strdup(tmp->name);
             if (!newrec->name) {
                 IGRAPH_ERROR("Cannot add attributes", IGRAPH_ENOMEM);
             }
@@ -334,6 +464,7 @@ int igraph_i_cattribute_add_vertices(igraph_t *graph, long int nv,
             IGRAPH_CHECK(igraph_vector_ptr_push_back(val, newrec));
             IGRAPH_FINALLY_CLEAN(4);
         }
+        igraph_i_cattribute_reindex(attr, val);
         length = igraph_vector_ptr_size(val);
     }
 
@@ -423,8 +554,15 @@ void igraph_i_cattribute_permute_free(igraph_vector_ptr_t *v) {
     long int i, n = igraph_vector_ptr_size(v);
     for (i = 0; i < n; i++) {
         igraph_attribute_record_t *rec = VECTOR(*v)[i];
-        igraph_Free(rec->name);
-        if (rec->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+        if (!rec) {
+            continue;
+        }
+        if (rec->name) {
+            igraph_Free(rec->name);
+        }
+        if (!rec->value) {
+            /* not filled in yet */
+        } else if (rec->type == IGRAPH_ATTRIBUTE_NUMERIC) {
             igraph_vector_t *numv = (igraph_vector_t*) rec->value;
             igraph_vector_destroy(numv);
             igraph_Free(numv);
@@ -457,7 +595,7 @@ int igraph_i_cattribute_permute_vertices(const igraph_t *graph,
             igraph_attribute_record_t *oldrec = VECTOR(*val)[i];
             igraph_attribute_type_t type = oldrec->type;
             igraph_vector_t *num, *newnum;
-            igraph_strvector_t *str, *newstr;
+            igraph_strvector_t *str;
             igraph_vector_bool_t *oldbool, *newbool;
             switch (type) {
             case IGRAPH_ATTRIBUTE_NUMERIC:
@@ -488,18 +626,9 @@ int igraph_i_cattribute_permute_vertices(const igraph_t *graph,
                 IGRAPH_FINALLY_CLEAN(1);
                 break;
             case IGRAPH_ATTRIBUTE_STRING:
+                /* Moves the strings instead of copying them */
                 str = (igraph_strvector_t*)oldrec->value;
-                newstr = igraph_Calloc(1, igraph_strvector_t);
-                if (!newstr) {
-                    IGRAPH_ERROR("Cannot permute vertex attributes", IGRAPH_ENOMEM);
-                }
-                IGRAPH_CHECK(igraph_strvector_init(newstr, 0));
-                IGRAPH_FINALLY(igraph_strvector_destroy, newstr);
-                igraph_strvector_index(str, newstr, idx);
-                oldrec->value = newstr;
-                igraph_strvector_destroy(str);
-                igraph_Free(str);
-                IGRAPH_FINALLY_CLEAN(1);
+                IGRAPH_CHECK(igraph_i_strvector_index_move(str, idx));
                 break;
             default:
                 IGRAPH_WARNING("Unknown edge attribute ignored");
@@ -536,7 +665,7 @@ int igraph_i_cattribute_permute_vertices(const igraph_t *graph,
             if (!new_rec) {
                 IGRAPH_ERROR("Cannot create vertex attributes", IGRAPH_ENOMEM);
             }
-            new_rec->name = strdup(oldrec->name);
+            new_rec->name = igraph_i_strdup(oldrec->name);
             new_rec->type = oldrec->type;
             VECTOR(*new_val)[i] = new_rec;
 
@@ -573,7 +702,7 @@ int igraph_i_cattribute_permute_vertices(const igraph_t *graph,
                 }
                 IGRAPH_CHECK(igraph_strvector_init(newstr, 0));
                 IGRAPH_FINALLY(igraph_strvector_destroy, newstr);
-                igraph_strvector_index(str, newstr, idx);
+                IGRAPH_CHECK(igraph_strvector_index(str, newstr, idx));
                 new_rec->value = newstr;
                 IGRAPH_FINALLY_CLEAN(1);
                 break;
@@ -581,6 +710,7 @@ int igraph_i_cattribute_permute_vertices(const igraph_t *graph,
                 IGRAPH_WARNING("Unknown vertex attribute ignored");
             }
         }
+        igraph_i_cattribute_reindex(new_attr, new_val);
     }
 
     IGRAPH_FINALLY_CLEAN(1);
@@ -1147,7 +1277,7 @@ int igraph_i_cattributes_cb_func(const igraph_attribute_record_t *oldrec,
     IGRAPH_FINALLY(igraph_vector_bool_destroy, newv);
 
     IGRAPH_CHECK(igraph_vector_bool_init(&values, 0));
-    IGRAPH_FINALLY(igraph_vector_bool_destroy, newv);
+    IGRAPH_FINALLY(igraph_vector_bool_destroy, &values);
 
     for (i = 0; i < newlen; i++) {
         igraph_vector_t *idx = VECTOR(*merges)[i];
@@ -1196,11 +1326,11 @@ int igraph_i_cattributes_sn_random(const igraph_attribute_record_t *oldrec,
         if (n == 0) {
             IGRAPH_CHECK(igraph_strvector_set(newv, i, ""));
         } else if (n == 1) {
-            igraph_strvector_get(oldv, 0, &tmp);
+            igraph_strvector_get(oldv, (long int) VECTOR(*idx)[0], &tmp);
             IGRAPH_CHECK(igraph_strvector_set(newv, i, tmp));
         } else {
             long int r = RNG_INTEGER(0, n - 1);
-            igraph_strvector_get(oldv, r, &tmp);
+            igraph_strvector_get(oldv, (long int) VECTOR(*idx)[r], &tmp);
             IGRAPH_CHECK(igraph_strvector_set(newv, i, tmp));
         }
     }
@@ -1286,6 +1416,7 @@ int igraph_i_cattributes_sn_concat(const igraph_attribute_record_t *oldrec,
     const igraph_strvector_t *oldv = oldrec->value;
     long int i, newlen = igraph_vector_ptr_size(merges);
     igraph_strvector_t *newv = igraph_Calloc(1, igraph_strvector_t);
+    igraph_vector_char_t buffer;
 
     if (!newv) {
         IGRAPH_ERROR("Cannot combine attributes", IGRAPH_ENOMEM);
@@ -1293,34 +1424,34 @@ int igraph_i_cattributes_sn_concat(const igraph_attribute_record_t *oldrec,
     IGRAPH_FINALLY(igraph_free, newv);
     IGRAPH_CHECK(igraph_strvector_init(newv, newlen));
     IGRAPH_FINALLY(igraph_strvector_destroy, newv);
+    IGRAPH_CHECK(igraph_vector_char_init(&buffer, 1));
+    IGRAPH_FINALLY(igraph_vector_char_destroy, &buffer);
 
+    /* The concatenations are assembled in the same buffer */
     for (i = 0; i < newlen; i++) {
         igraph_vector_t *idx = VECTOR(*merges)[i];
         long int j, n = igraph_vector_size(idx);
         size_t len = 0;
-        char *tmp, *tmp2;
+        char *tmp;
         for (j = 0; j < n; j++) {
-            igraph_strvector_get(oldv, j, &tmp);
+            igraph_strvector_get(oldv, (long int) VECTOR(*idx)[j], &tmp);
             len += strlen(tmp);
         }
-        tmp2 = igraph_Calloc(len + 1, char);
-        if (!tmp2) {
-            IGRAPH_ERROR("Cannot combine attributes", IGRAPH_ENOMEM);
+        if (len == 0) {
+            continue;
         }
-        IGRAPH_FINALLY(igraph_free, tmp2);
+        IGRAPH_CHECK(igraph_vector_char_resize(&buffer, (long int) len + 1));
         len = 0;
         for (j = 0; j < n; j++) {
-            igraph_strvector_get(oldv, j, &tmp);
-            strcpy(tmp2 + len, tmp);
+            igraph_strvector_get(oldv, (long int) VECTOR(*idx)[j], &tmp);
+            strcpy(VECTOR(buffer) + len, tmp);
             len += strlen(tmp);
         }
-
-        IGRAPH_CHECK(igraph_strvector_set(newv, i, tmp2));
-        igraph_Free(tmp2);
-        IGRAPH_FINALLY_CLEAN(1);
+        IGRAPH_CHECK(igraph_strvector_set2(newv, i, VECTOR(buffer), (int) len));
     }
 
-    IGRAPH_FINALLY_CLEAN(2);
+    igraph_vector_char_destroy(&buffer);
+    IGRAPH_FINALLY_CLEAN(3);
     newrec->value = newv;
 
     return 0;
@@ -1344,7 +1475,7 @@ int igraph_i_cattributes_sn_func(const igraph_attribute_record_t *oldrec,
     IGRAPH_CHECK(igraph_strvector_init(newv, newlen));
     IGRAPH_FINALLY(igraph_strvector_destroy, newv);
 
-    IGRAPH_CHECK(igraph_strvector_init(newv, 0));
+    IGRAPH_CHECK(igraph_strvector_init(&values, 0));
     IGRAPH_FINALLY(igraph_strvector_destroy, &values);
 
     for (i = 0; i < newlen; i++) {
@@ -1356,7 +1487,7 @@ int igraph_i_cattributes_sn_func(const igraph_attribute_record_t *oldrec,
             long int x = (long int) VECTOR(*idx)[j];
             char *elem;
             igraph_strvector_get(oldv, x, &elem);
-            IGRAPH_CHECK(igraph_strvector_set(newv, j, elem));
+            IGRAPH_CHECK(igraph_strvector_set(&values, j, elem));
         }
         IGRAPH_CHECK(func(&values, &res));
         IGRAPH_FINALLY(igraph_free, res);
@@ -1408,7 +1539,8 @@ int igraph_i_cattribute_combine_vertices(const igraph_t *graph,
         igraph_attribute_combination_query(comb, name, &todo, &voidfunc);
         TODO[i] = todo;
         funcs[i] = voidfunc;
-        if (todo != IGRAPH_ATTRIBUTE_COMBINE_IGNORE) {
+        if (todo != IGRAPH_ATTRIBUTE_COMBINE_DEFAULT &&
+            todo != IGRAPH_ATTRIBUTE_COMBINE_IGNORE) {
             keepno++;
         }
     }
@@ -1439,7 +1571,7 @@ int igraph_i_cattribute_combine_vertices(const igraph_t *graph,
             IGRAPH_ERROR("Cannot combine vertex attributes",
                          IGRAPH_ENOMEM);
         }
-        newrec->name = strdup(name);
+        newrec->name = igraph_i_strdup(name);
         newrec->type = type;
         VECTOR(*new_val)[j] = newrec;
 
@@ -1575,9 +1707,9 @@ int igraph_i_cattribute_combine_vertices(const igraph_t *graph,
         j++;
     }
 
+    igraph_i_cattribute_reindex(toattr, new_val);
     igraph_free(funcs);
     igraph_free(TODO);
-    igraph_i_cattribute_permute_free(new_val);
     IGRAPH_FINALLY_CLEAN(3);
 
     return 0;
@@ -1665,7 +1797,7 @@ int igraph_i_cattribute_add_edges(igraph_t *graph, const igraph_vector_t *edges,
         igraph_attribute_record_t *nattr_entry = VECTOR(*nattr)[i];
         const char *nname = nattr_entry->name;
         long int j;
-        igraph_bool_t l = igraph_i_cattribute_find(eal, nname, &j);
+        igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, nname, &j);
         if (!l) {
             newattrs++;
             IGRAPH_CHECK(igraph_vector_push_back(&news, i));
@@ -1689,7 +1821,7 @@ int igraph_i_cattribute_add_edges(igraph_t *graph, const igraph_vector_t *edges,
             }
             IGRAPH_FINALLY(igraph_free, newrec);
             newrec->type = type;
-            newrec->name = strdup(tmp->name);
+            newrec->name = igraph_i_strdup(tmp->name);
             if (!newrec->name) {
                 IGRAPH_ERROR("Cannot add attributes", IGRAPH_ENOMEM);
             }
@@ -1725,6 +1857,7 @@ int igraph_i_cattribute_add_edges(igraph_t *graph, const igraph_vector_t *edges,
             IGRAPH_CHECK(igraph_vector_ptr_push_back(eal, newrec));
             IGRAPH_FINALLY_CLEAN(4);
         }
+        igraph_i_cattribute_reindex(attr, eal);
         ealno = igraph_vector_ptr_size(eal);
     }
 
@@ -1858,7 +1991,7 @@ int igraph_i_cattribute_permute_edges(const igraph_t *graph,
             igraph_attribute_record_t *oldrec = VECTOR(*eal)[i];
             igraph_attribute_type_t type = oldrec->type;
             igraph_vector_t *num, *newnum;
-            igraph_strvector_t *str, *newstr;
+            igraph_strvector_t *str;
             igraph_vector_bool_t *oldbool, *newbool;
             switch (type) {
             case IGRAPH_ATTRIBUTE_NUMERIC:
@@ -1889,18 +2022,9 @@ int igraph_i_cattribute_permute_edges(const igraph_t *graph,
                 IGRAPH_FINALLY_CLEAN(1);
                 break;
             case IGRAPH_ATTRIBUTE_STRING:
+                /* Moves the strings instead of copying them */
                 str = (igraph_strvector_t*)oldrec->value;
-                newstr = igraph_Calloc(1, igraph_strvector_t);
-                if (!newstr) {
-                    IGRAPH_ERROR("Cannot permute edge attributes", IGRAPH_ENOMEM);
-                }
-                IGRAPH_CHECK(igraph_strvector_init(newstr, 0));
-                IGRAPH_FINALLY(igraph_strvector_destroy, newstr);
-                igraph_strvector_index(str, newstr, idx);
-                oldrec->value = newstr;
-                igraph_strvector_destroy(str);
-                igraph_Free(str);
-                IGRAPH_FINALLY_CLEAN(1);
+                IGRAPH_CHECK(igraph_i_strvector_index_move(str, idx));
                 break;
             default:
                 IGRAPH_WARNING("Unknown edge attribute ignored");
@@ -1934,7 +2058,7 @@ int igraph_i_cattribute_permute_edges(const igraph_t *graph,
             if (!new_rec) {
                 IGRAPH_ERROR("Cannot create edge attributes", IGRAPH_ENOMEM);
             }
-            new_rec->name = strdup(oldrec->name);
+            new_rec->name = igraph_i_strdup(oldrec->name);
             new_rec->type = oldrec->type;
             VECTOR(*new_eal)[i] = new_rec;
 
@@ -1958,7 +2082,7 @@ int igraph_i_cattribute_permute_edges(const igraph_t *graph,
                 }
                 IGRAPH_CHECK(igraph_strvector_init(newstr, 0));
                 IGRAPH_FINALLY(igraph_strvector_destroy, newstr);
-                igraph_strvector_index(str, newstr, idx);
+                IGRAPH_CHECK(igraph_strvector_index(str, newstr, idx));
                 new_rec->value = newstr;
                 IGRAPH_FINALLY_CLEAN(1);
                 break;
@@ -1978,6 +2102,7 @@ int igraph_i_cattribute_permute_edges(const igraph_t *graph,
                 IGRAPH_WARNING("Unknown edge attribute ignored");
             }
         }
+        igraph_i_cattribute_reindex(new_attr, new_eal);
         IGRAPH_FINALLY_CLEAN(1);
     }
 
@@ -2019,7 +2144,8 @@ int igraph_i_cattribute_combine_edges(const igraph_t *graph,
         igraph_attribute_combination_query(comb, name, &todo, &voidfunc);
         TODO[i] = todo;
         funcs[i] = voidfunc;
-        if (todo != IGRAPH_ATTRIBUTE_COMBINE_IGNORE) {
+        if (todo != IGRAPH_ATTRIBUTE_COMBINE_DEFAULT &&
+            todo != IGRAPH_ATTRIBUTE_COMBINE_IGNORE) {
             keepno++;
         }
     }
@@ -2050,7 +2176,7 @@ int igraph_i_cattribute_combine_edges(const igraph_t *graph,
             IGRAPH_ERROR("Cannot combine edge attributes",
                          IGRAPH_ENOMEM);
         }
-        newrec->name = strdup(name);
+        newrec->name = igraph_i_strdup(name);
         newrec->type = type;
         VECTOR(*new_eal)[j] = newrec;
 
@@ -2186,6 +2312,7 @@ int igraph_i_cattribute_combine_edges(const igraph_t *graph,
         j++;
     }
 
+    igraph_i_cattribute_reindex(toattr, new_eal);
     igraph_free(funcs);
     igraph_free(TODO);
     IGRAPH_FINALLY_CLEAN(3);
@@ -2258,7 +2385,7 @@ igraph_bool_t igraph_i_cattribute_has_attr(const igraph_t *graph,
         break;
     }
 
-    return igraph_i_cattribute_find(attr[attrnum], name, 0);
+    return igraph_i_cattribute_lookup(at, attr[attrnum], name, 0);
 }
 
 int igraph_i_cattribute_gettype(const igraph_t *graph,
@@ -2289,7 +2416,7 @@ int igraph_i_cattribute_gettype(const igraph_t *graph,
     }
 
     al = attr[attrnum];
-    l = igraph_i_cattribute_find(al, name, &j);
+    l = igraph_i_cattribute_lookup(at, al, name, &j);
     if (!l) {
         IGRAPH_ERROR("Unknown attribute", IGRAPH_EINVAL);
     }
@@ -2307,7 +2434,7 @@ int igraph_i_cattribute_get_numeric_graph_attr(const igraph_t *graph,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_t *num;
-    igraph_bool_t l = igraph_i_cattribute_find(gal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, gal, name, &j);
 
     if (!l) {
         IGRAPH_ERROR("Unknown attribute", IGRAPH_EINVAL);
@@ -2329,7 +2456,7 @@ int igraph_i_cattribute_get_bool_graph_attr(const igraph_t *graph,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_bool_t *log;
-    igraph_bool_t l = igraph_i_cattribute_find(gal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, gal, name, &j);
 
     if (!l) {
         IGRAPH_ERROR("Unknown attribute", IGRAPH_EINVAL);
@@ -2351,7 +2478,7 @@ int igraph_i_cattribute_get_string_graph_attr(const igraph_t *graph,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_strvector_t *str;
-    igraph_bool_t l = igraph_i_cattribute_find(gal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, gal, name, &j);
 
     if (!l) {
         IGRAPH_ERROR("Unknown attribute", IGRAPH_EINVAL);
@@ -2374,7 +2501,7 @@ int igraph_i_cattribute_get_numeric_vertex_attr(const igraph_t *graph,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_t *num;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     if (!l) {
         IGRAPH_ERROR("Unknown attribute", IGRAPH_EINVAL);
@@ -2412,7 +2539,7 @@ int igraph_i_cattribute_get_bool_vertex_attr(const igraph_t *graph,
     long int i, j, v;
     igraph_attribute_record_t *rec;
     igraph_vector_bool_t *log;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     if (!l) {
         IGRAPH_ERROR("Unknown attribute", IGRAPH_EINVAL);
@@ -2447,7 +2574,7 @@ int igraph_i_cattribute_get_string_vertex_attr(const igraph_t *graph,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_strvector_t *str;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     if (!l) {
         IGRAPH_ERROR("Unknown attribute", IGRAPH_EINVAL);
@@ -2486,7 +2613,7 @@ int igraph_i_cattribute_get_numeric_edge_attr(const igraph_t *graph,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_t *num;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     if (!l) {
         IGRAPH_ERROR("Unknown attribute", IGRAPH_EINVAL);
@@ -2523,7 +2650,7 @@ int igraph_i_cattribute_get_string_edge_attr(const igraph_t *graph,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_strvector_t *str;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     if (!l) {
         IGRAPH_ERROR("Unknown attribute", IGRAPH_EINVAL);
@@ -2562,7 +2689,7 @@ int igraph_i_cattribute_get_bool_edge_attr(const igraph_t *graph,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_bool_t *log;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     if (!l) {
         IGRAPH_ERROR("Unknown attribute", IGRAPH_EINVAL);
@@ -2671,7 +2798,7 @@ igraph_real_t igraph_cattribute_GAN(const igraph_t *graph, const char *name) {
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_t *num;
-    igraph_bool_t l = igraph_i_cattribute_find(gal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, gal, name, &j);
 
     if (!l) {
         igraph_error("Unknown attribute", __FILE__, __LINE__, IGRAPH_EINVAL);
@@ -2704,7 +2831,7 @@ igraph_bool_t igraph_cattribute_GAB(const igraph_t *graph, const char *name) {
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_bool_t *log;
-    igraph_bool_t l = igraph_i_cattribute_find(gal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, gal, name, &j);
 
     if (!l) {
         igraph_error("Unknown attribute", __FILE__, __LINE__, IGRAPH_EINVAL);
@@ -2738,7 +2865,7 @@ const char* igraph_cattribute_GAS(const igraph_t *graph, const char *name) {
     long int j;
     igraph_attribute_record_t *rec;
     igraph_strvector_t *str;
-    igraph_bool_t l = igraph_i_cattribute_find(gal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, gal, name, &j);
 
     if (!l) {
         igraph_error("Unknown attribute", __FILE__, __LINE__, IGRAPH_EINVAL);
@@ -2771,7 +2898,7 @@ igraph_real_t igraph_cattribute_VAN(const igraph_t *graph, const char *name,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_t *num;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     if (!l) {
         igraph_error("Unknown attribute", __FILE__, __LINE__, IGRAPH_EINVAL);
@@ -2804,7 +2931,7 @@ igraph_bool_t igraph_cattribute_VAB(const igraph_t *graph, const char *name,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_bool_t *log;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     if (!l) {
         igraph_error("Unknown attribute", __FILE__, __LINE__, IGRAPH_EINVAL);
@@ -2837,7 +2964,7 @@ const char* igraph_cattribute_VAS(const igraph_t *graph, const char *name,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_strvector_t *str;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     if (!l) {
         igraph_error("Unknown attribute", __FILE__, __LINE__, IGRAPH_EINVAL);
@@ -2870,7 +2997,7 @@ igraph_real_t igraph_cattribute_EAN(const igraph_t *graph, const char *name,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_t *num;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     if (!l) {
         igraph_error("Unknown attribute", __FILE__, __LINE__, IGRAPH_EINVAL);
@@ -2903,7 +3030,7 @@ igraph_bool_t igraph_cattribute_EAB(const igraph_t *graph, const char *name,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_vector_bool_t *log;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     if (!l) {
         igraph_error("Unknown attribute", __FILE__, __LINE__, IGRAPH_EINVAL);
@@ -2936,7 +3063,7 @@ const char* igraph_cattribute_EAS(const igraph_t *graph, const char *name,
     long int j;
     igraph_attribute_record_t *rec;
     igraph_strvector_t *str;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     if (!l) {
         igraph_error("Unknown attribute", __FILE__, __LINE__, IGRAPH_EINVAL);
@@ -3143,7 +3270,7 @@ int igraph_cattribute_GAN_set(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *gal = &attr->gal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(gal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, gal, name, &j);
 
     if (l) {
         igraph_attribute_record_t *rec = VECTOR(*gal)[j];
@@ -3160,7 +3287,7 @@ int igraph_cattribute_GAN_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM);
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM);
         }
@@ -3175,6 +3302,7 @@ int igraph_cattribute_GAN_set(igraph_t *graph, const char *name,
         VECTOR(*num)[0] = value;
         rec->value = num;
         IGRAPH_CHECK(igraph_vector_ptr_push_back(gal, rec));
+        igraph_i_cattribute_reindex(attr, gal);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3201,7 +3329,7 @@ int igraph_cattribute_GAB_set(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *gal = &attr->gal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(gal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, gal, name, &j);
 
     if (l) {
         igraph_attribute_record_t *rec = VECTOR(*gal)[j];
@@ -3218,7 +3346,7 @@ int igraph_cattribute_GAB_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM);
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM);
         }
@@ -3234,6 +3362,7 @@ int igraph_cattribute_GAB_set(igraph_t *graph, const char *name,
         VECTOR(*log)[0] = value;
         rec->value = log;
         IGRAPH_CHECK(igraph_vector_ptr_push_back(gal, rec));
+        igraph_i_cattribute_reindex(attr, gal);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3261,7 +3390,7 @@ int igraph_cattribute_GAS_set(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *gal = &attr->gal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(gal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, gal, name, &j);
 
     if (l) {
         igraph_attribute_record_t *rec = VECTOR(*gal)[j];
@@ -3278,7 +3407,7 @@ int igraph_cattribute_GAS_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM);
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM);
         }
@@ -3293,6 +3422,7 @@ int igraph_cattribute_GAS_set(igraph_t *graph, const char *name,
         IGRAPH_CHECK(igraph_strvector_set(str, 0, value));
         rec->value = str;
         IGRAPH_CHECK(igraph_vector_ptr_push_back(gal, rec));
+        igraph_i_cattribute_reindex(attr, gal);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3323,7 +3453,7 @@ int igraph_cattribute_VAN_set(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *val = &attr->val;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     if (l) {
         igraph_attribute_record_t *rec = VECTOR(*val)[j];
@@ -3340,7 +3470,7 @@ int igraph_cattribute_VAN_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM);
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM);
         }
@@ -3356,6 +3486,7 @@ int igraph_cattribute_VAN_set(igraph_t *graph, const char *name,
         VECTOR(*num)[(long int)vid] = value;
         rec->value = num;
         IGRAPH_CHECK(igraph_vector_ptr_push_back(val, rec));
+        igraph_i_cattribute_reindex(attr, val);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3386,7 +3517,7 @@ int igraph_cattribute_VAB_set(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *val = &attr->val;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     if (l) {
         igraph_attribute_record_t *rec = VECTOR(*val)[j];
@@ -3403,7 +3534,7 @@ int igraph_cattribute_VAB_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM);
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM);
         }
@@ -3420,6 +3551,7 @@ int igraph_cattribute_VAB_set(igraph_t *graph, const char *name,
         VECTOR(*log)[(long int)vid] = value;
         rec->value = log;
         IGRAPH_CHECK(igraph_vector_ptr_push_back(val, rec));
+        igraph_i_cattribute_reindex(attr, val);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3451,7 +3583,7 @@ int igraph_cattribute_VAS_set(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *val = &attr->val;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     if (l) {
         igraph_attribute_record_t *rec = VECTOR(*val)[j];
@@ -3468,7 +3600,7 @@ int igraph_cattribute_VAS_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM);
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM);
         }
@@ -3483,6 +3615,7 @@ int igraph_cattribute_VAS_set(igraph_t *graph, const char *name,
         IGRAPH_CHECK(igraph_strvector_set(str, vid, value));
         rec->value = str;
         IGRAPH_CHECK(igraph_vector_ptr_push_back(val, rec));
+        igraph_i_cattribute_reindex(attr, val);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3513,7 +3646,7 @@ int igraph_cattribute_EAN_set(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *eal = &attr->eal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     if (l) {
         igraph_attribute_record_t *rec = VECTOR(*eal)[j];
@@ -3530,7 +3663,7 @@ int igraph_cattribute_EAN_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM);
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM);
         }
@@ -3546,6 +3679,7 @@ int igraph_cattribute_EAN_set(igraph_t *graph, const char *name,
         VECTOR(*num)[(long int)eid] = value;
         rec->value = num;
         IGRAPH_CHECK(igraph_vector_ptr_push_back(eal, rec));
+        igraph_i_cattribute_reindex(attr, eal);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3576,7 +3710,7 @@ int igraph_cattribute_EAB_set(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *eal = &attr->eal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     if (l) {
         igraph_attribute_record_t *rec = VECTOR(*eal)[j];
@@ -3593,7 +3727,7 @@ int igraph_cattribute_EAB_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM);
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM);
         }
@@ -3610,6 +3744,7 @@ int igraph_cattribute_EAB_set(igraph_t *graph, const char *name,
         VECTOR(*log)[(long int)eid] = value;
         rec->value = log;
         IGRAPH_CHECK(igraph_vector_ptr_push_back(eal, rec));
+        igraph_i_cattribute_reindex(attr, eal);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3641,7 +3776,7 @@ int igraph_cattribute_EAS_set(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *eal = &attr->eal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     if (l) {
         igraph_attribute_record_t *rec = VECTOR(*eal)[j];
@@ -3658,7 +3793,7 @@ int igraph_cattribute_EAS_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM);
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM);
         }
@@ -3673,6 +3808,7 @@ int igraph_cattribute_EAS_set(igraph_t *graph, const char *name,
         IGRAPH_CHECK(igraph_strvector_set(str, eid, value));
         rec->value = str;
         IGRAPH_CHECK(igraph_vector_ptr_push_back(eal, rec));
+        igraph_i_cattribute_reindex(attr, eal);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3700,7 +3836,7 @@ int igraph_cattribute_VAN_setv(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *val = &attr->val;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     /* Check length first */
     if (igraph_vector_size(v) != igraph_vcount(graph)) {
@@ -3725,7 +3861,7 @@ int igraph_cattribute_VAN_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_NUMERIC;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM);
         }
@@ -3739,6 +3875,7 @@ int igraph_cattribute_VAN_setv(igraph_t *graph, const char *name,
         IGRAPH_CHECK(igraph_vector_copy(num, v));
         IGRAPH_FINALLY(igraph_vector_destroy, num);
         IGRAPH_CHECK(igraph_vector_ptr_push_back(val, rec));
+        igraph_i_cattribute_reindex(attr, val);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3765,7 +3902,7 @@ int igraph_cattribute_VAB_setv(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *val = &attr->val;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     /* Check length first */
     if (igraph_vector_bool_size(v) != igraph_vcount(graph)) {
@@ -3790,7 +3927,7 @@ int igraph_cattribute_VAB_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_BOOLEAN;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM);
         }
@@ -3804,6 +3941,7 @@ int igraph_cattribute_VAB_setv(igraph_t *graph, const char *name,
         IGRAPH_CHECK(igraph_vector_bool_copy(log, v));
         IGRAPH_FINALLY(igraph_vector_bool_destroy, log);
         IGRAPH_CHECK(igraph_vector_ptr_push_back(val, rec));
+        igraph_i_cattribute_reindex(attr, val);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3832,7 +3970,7 @@ int igraph_cattribute_VAS_setv(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *val = &attr->val;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     /* Check length first */
     if (igraph_strvector_size(sv) != igraph_vcount(graph)) {
@@ -3857,7 +3995,7 @@ int igraph_cattribute_VAS_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_STRING;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM);
         }
@@ -3871,6 +4009,7 @@ int igraph_cattribute_VAS_setv(igraph_t *graph, const char *name,
         IGRAPH_CHECK(igraph_strvector_copy(str, sv));
         IGRAPH_FINALLY(igraph_strvector_destroy, str);
         IGRAPH_CHECK(igraph_vector_ptr_push_back(val, rec));
+        igraph_i_cattribute_reindex(attr, val);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3898,7 +4037,7 @@ int igraph_cattribute_EAN_setv(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *eal = &attr->eal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     /* Check length first */
     if (igraph_vector_size(v) != igraph_ecount(graph)) {
@@ -3923,7 +4062,7 @@ int igraph_cattribute_EAN_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_NUMERIC;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM);
         }
@@ -3937,6 +4076,7 @@ int igraph_cattribute_EAN_setv(igraph_t *graph, const char *name,
         IGRAPH_CHECK(igraph_vector_copy(num, v));
         IGRAPH_FINALLY(igraph_vector_destroy, num);
         IGRAPH_CHECK(igraph_vector_ptr_push_back(eal, rec));
+        igraph_i_cattribute_reindex(attr, eal);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -3964,7 +4104,7 @@ int igraph_cattribute_EAB_setv(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *eal = &attr->eal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     /* Check length first */
     if (igraph_vector_bool_size(v) != igraph_ecount(graph)) {
@@ -3989,7 +4129,7 @@ int igraph_cattribute_EAB_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_BOOLEAN;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM);
         }
@@ -4003,6 +4143,7 @@ int igraph_cattribute_EAB_setv(igraph_t *graph, const char *name,
         IGRAPH_CHECK(igraph_vector_bool_copy(log, v));
         IGRAPH_FINALLY(igraph_vector_bool_destroy, log);
         IGRAPH_CHECK(igraph_vector_ptr_push_back(eal, rec));
+        igraph_i_cattribute_reindex(attr, eal);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -4031,7 +4172,7 @@ int igraph_cattribute_EAS_setv(igraph_t *graph, const char *name,
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *eal = &attr->eal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     /* Check length first */
     if (igraph_strvector_size(sv) != igraph_ecount(graph)) {
@@ -4056,7 +4197,7 @@ int igraph_cattribute_EAS_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_STRING;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM);
         }
@@ -4070,6 +4211,7 @@ int igraph_cattribute_EAS_setv(igraph_t *graph, const char *name,
         IGRAPH_CHECK(igraph_strvector_copy(str, sv));
         IGRAPH_FINALLY(igraph_strvector_destroy, str);
         IGRAPH_CHECK(igraph_vector_ptr_push_back(eal, rec));
+        igraph_i_cattribute_reindex(attr, eal);
         IGRAPH_FINALLY_CLEAN(4);
     }
 
@@ -4108,11 +4250,12 @@ void igraph_cattribute_remove_g(igraph_t *graph, const char *name) {
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *gal = &attr->gal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(gal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, gal, name, &j);
 
     if (l) {
         igraph_i_cattribute_free_rec(VECTOR(*gal)[j]);
         igraph_vector_ptr_remove(gal, j);
+        igraph_i_cattribute_reindex(attr, gal);
     } else {
         IGRAPH_WARNING("Cannot remove non-existent graph attribute");
     }
@@ -4133,11 +4276,12 @@ void igraph_cattribute_remove_v(igraph_t *graph, const char *name) {
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *val = &attr->val;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(val, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, val, name, &j);
 
     if (l) {
         igraph_i_cattribute_free_rec(VECTOR(*val)[j]);
         igraph_vector_ptr_remove(val, j);
+        igraph_i_cattribute_reindex(attr, val);
     } else {
         IGRAPH_WARNING("Cannot remove non-existent graph attribute");
     }
@@ -4158,11 +4302,12 @@ void igraph_cattribute_remove_e(igraph_t *graph, const char *name) {
     igraph_i_cattributes_t *attr = graph->attr;
     igraph_vector_ptr_t *eal = &attr->eal;
     long int j;
-    igraph_bool_t l = igraph_i_cattribute_find(eal, name, &j);
+    igraph_bool_t l = igraph_i_cattribute_lookup(attr, eal, name, &j);
 
     if (l) {
         igraph_i_cattribute_free_rec(VECTOR(*eal)[j]);
         igraph_vector_ptr_remove(eal, j);
+        igraph_i_cattribute_reindex(attr, eal);
     } else {
         IGRAPH_WARNING("Cannot remove non-existent graph attribute");
     }
@@ -4192,6 +4337,7 @@ void igraph_cattribute_remove_all(igraph_t *graph, igraph_bool_t g,
             igraph_i_cattribute_free_rec(VECTOR(*gal)[i]);
         }
         igraph_vector_ptr_clear(gal);
+        igraph_i_cattribute_reindex(attr, gal);
     }
     if (v) {
         igraph_vector_ptr_t *val = &attr->val;
@@ -4200,6 +4346,7 @@ void igraph_cattribute_remove_all(igraph_t *graph, igraph_bool_t g,
             igraph_i_cattribute_free_rec(VECTOR(*val)[i]);
         }
         igraph_vector_ptr_clear(val);
+        igraph_i_cattribute_reindex(attr, val);
     }
     if (e) {
         igraph_vector_ptr_t *eal = &attr->eal;
@@ -4208,5 +4355,6 @@ void igraph_cattribute_remove_all(igraph_t *graph, igraph_bool_t g,
             igraph_i_cattribute_free_rec(VECTOR(*eal)[i]);
         }
         igraph_vector_ptr_clear(eal);
+        igraph_i_cattribute_reindex(attr, eal);
     }
 }
@@ -30,6 +30,7 @@
 #include "igraph_interface.h"
 #include "igraph_progress.h"
 #include "igraph_interrupt_internal.h"
+#include "igraph_counters_internal.h"
 #include "igraph_topology.h"
 #include "igraph_types_internal.h"
 #include "igraph_stack.h"
@@ -1302,6 +1303,15 @@ int igraph_personalized_pagerank(const igraph_t *graph,
                                  igraph_vector_t *reset,
                                  const igraph_vector_t *weights,
                                  void *options) {
+    int ret;
+
+    if (algo != IGRAPH_PAGERANK_ALGO_POWER &&
+        algo != IGRAPH_PAGERANK_ALGO_ARPACK &&
+        algo != IGRAPH_PAGERANK_ALGO_PRPACK) {
+        IGRAPH_ERROR("Unknown PageRank algorithm", IGRAPH_EINVAL);
+    }
+
+    IGRAPH_TIMER_START(IGRAPH_TIMER_PAGERANK);
 
     if (algo == IGRAPH_PAGERANK_ALGO_POWER) {
         igraph_pagerank_power_options_t *o =
@@ -1310,23 +1320,24 @@ int igraph_personalized_pagerank(const igraph_t *graph,
             IGRAPH_WARNING("Cannot use weights with power method, "
                            "weights will be ignored");
         }
-        return igraph_pagerank_old(graph, vector, vids, directed,
-                                   o->niter, o->eps, damping,
-                                   /*old=*/ 0);
+        ret = igraph_pagerank_old(graph, vector, vids, directed,
+                                  o->niter, o->eps, damping,
+                                  /*old=*/ 0);
     } else if (algo == IGRAPH_PAGERANK_ALGO_ARPACK) {
         igraph_arpack_options_t *o = (igraph_arpack_options_t*) options;
-        return igraph_personalized_pagerank_arpack(graph, vector, value, vids,
+        ret = igraph_personalized_pagerank_arpack(graph, vector, value, vids,
                 directed, damping, reset,
                 weights, o);
-    } else if (algo == IGRAPH_PAGERANK_ALGO_PRPACK) {
-        return igraph_personalized_pagerank_prpack(graph, vector, value, vids,
+    } else {
+        ret = igraph_personalized_pagerank_prpack(graph, vector, value, vids,
                 directed, damping, reset,
                 weights);
-    } else {
-        IGRAPH_ERROR("Unknown PageRank algorithm", IGRAPH_EINVAL);
     }
 
-    return 0;
+    /* A no-op if the error handler has already stopped the timer */
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_PAGERANK);
+
+    return ret;
 }
 
 /*
@@ -1655,7 +1666,11 @@ static int igraph_i_betweenness_estimate_weighted(
         IGRAPH_VECTOR_INIT_FINALLY(tmpres, no_of_nodes);
     }
 
+    IGRAPH_TIMER_START(IGRAPH_TIMER_BETWEENNESS);
+
     for (source = 0; source < no_of_nodes; source++) {
+        long int scanned = 0, heapops = 1;
+
         IGRAPH_PROGRESS("Betweenness centrality: ", 100.0 * source / no_of_nodes, 0);
         IGRAPH_ALLOW_INTERRUPTION();
 
@@ -1669,6 +1684,8 @@ static int igraph_i_betweenness_estimate_weighted(
             igraph_vector_int_t *neis;
             long int nlen;
 
+            heapops++;
+
             /* Ignore vertices that are more distant than the cutoff */
             if (cutoff >= 0 && mindist > cutoff + 1.0) {
                 /* Reset variables if node is too distant */
@@ -1684,6 +1701,7 @@ static int igraph_i_betweenness_estimate_weighted(
             /* Now check all neighbors of 'minnei' for a shorter path */
             neis = igraph_inclist_get(&inclist, minnei);
             nlen = igraph_vector_int_size(neis);
+            scanned += nlen;
             for (j = 0; j < nlen; j++) {
                 long int edge = (long int) VECTOR(*neis)[j];
                 long int to = IGRAPH_OTHER(graph, edge, minnei);
@@ -1706,6 +1724,7 @@ static int igraph_i_betweenness_estimate_weighted(
 
                     VECTOR(dist)[to] = altdist;
                     IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q, to, -altdist));
+                    heapops++;
                 } else if (cmp_result < 0) {
                     /* This is a shorter path */
                     igraph_vector_int_t *v = igraph_adjlist_get(&fathers, to);
@@ -1715,6 +1734,7 @@ static int igraph_i_betweenness_estimate_weighted(
 
                     VECTOR(dist)[to] = altdist;
                     IGRAPH_CHECK(igraph_2wheap_modify(&Q, to, -altdist));
+                    heapops++;
                 } else if (cmp_result == 0 &&
                     (altdist <= cutoff + 1.0 || cutoff < 0)) {
                     /* Only add if the node is not more distant than the cutoff */
@@ -1726,6 +1746,10 @@ static int igraph_i_betweenness_estimate_weighted(
 
         } /* !igraph_2wheap_empty(&Q) */
 
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_SEARCH_SOURCES, 1);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_EDGES_SCANNED, scanned);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_HEAP_OPERATIONS, heapops);
+
         while (!igraph_stack_empty(&S)) {
             long int w = (long int) igraph_stack_pop(&S);
             igraph_vector_int_t *fatv = igraph_adjlist_get(&fathers, w);
@@ -1747,6 +1771,8 @@ static int igraph_i_betweenness_estimate_weighted(
 
     } /* source < no_of_nodes */
 
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_BETWEENNESS);
+
     if (!igraph_vs_is_all(&vids)) {
         IGRAPH_CHECK(igraph_vit_create(graph, vids, &vit));
         IGRAPH_FINALLY(igraph_vit_destroy, &vit);
@@ -1948,7 +1974,11 @@ int igraph_betweenness_estimate(const igraph_t *graph, igraph_vector_t *res,
 
     /* here we go */
 
+    IGRAPH_TIMER_START(IGRAPH_TIMER_BETWEENNESS);
+
     for (source = 0; source < no_of_nodes; source++) {
+        long int scanned = 0;
+
         IGRAPH_PROGRESS("Betweenness centrality: ", 100.0 * source / no_of_nodes, 0);
         IGRAPH_ALLOW_INTERRUPTION();
 
@@ -1980,6 +2010,7 @@ int igraph_betweenness_estimate(const igraph_t *graph, igraph_vector_t *res,
             IGRAPH_CHECK(igraph_stack_push(&stack, actnode));
             neis = igraph_adjlist_get(adjlist_out_p, actnode);
             nneis = igraph_vector_int_size(neis);
+            scanned += nneis;
             for (j = 0; j < nneis; j++) {
                 long int neighbor = (long int) VECTOR(*neis)[j];
                 if (distance[neighbor] == 0) {
@@ -2003,6 +2034,9 @@ int igraph_betweenness_estimate(const igraph_t *graph, igraph_vector_t *res,
             }
         } /* while !igraph_dqueue_empty */
 
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_SEARCH_SOURCES, 1);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_EDGES_SCANNED, scanned);
+
         /* Ok, we've the distance of each node and also the number of
            shortest paths to them. Now we do an inverse search, starting
            with the farthest nodes. */
@@ -2047,6 +2081,8 @@ int igraph_betweenness_estimate(const igraph_t *graph, igraph_vector_t *res,
 
     } /* for source < no_of_nodes */
 
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_BETWEENNESS);
+
     IGRAPH_PROGRESS("Betweenness centrality: ", 100.0, 0);
 
     /* clean  */
@@ -2147,7 +2183,11 @@ static int igraph_i_edge_betweenness_estimate_weighted(
     IGRAPH_CHECK(igraph_vector_resize(result, no_of_edges));
     igraph_vector_null(result);
 
+    IGRAPH_TIMER_START(IGRAPH_TIMER_BETWEENNESS);
+
     for (source = 0; source < no_of_nodes; source++) {
+        long int scanned = 0, heapops = 1;
+
         IGRAPH_PROGRESS("Edge betweenness centrality: ", 100.0 * source / no_of_nodes, 0);
         IGRAPH_ALLOW_INTERRUPTION();
 
@@ -2167,6 +2207,8 @@ static int igraph_i_edge_betweenness_estimate_weighted(
             igraph_vector_int_t *neis;
             long int nlen;
 
+            heapops++;
+
             /* printf("SP to %li is final, dist: %g, nrgeo: %li\n", minnei, */
             /* VECTOR(distance)[minnei]-1.0, VECTOR(nrgeo)[minnei]); */
 
@@ -2178,6 +2220,7 @@ static int igraph_i_edge_betweenness_estimate_weighted(
 
             neis = igraph_inclist_get(&inclist, minnei);
             nlen = igraph_vector_int_size(neis);
+            scanned += nlen;
             for (j = 0; j < nlen; j++) {
                 long int edge = (long int) VECTOR(*neis)[j];
                 long int to = IGRAPH_OTHER(graph, edge, minnei);
@@ -2202,6 +2245,7 @@ static int igraph_i_edge_betweenness_estimate_weighted(
                     VECTOR(nrgeo)[to] = VECTOR(nrgeo)[minnei];
                     VECTOR(distance)[to] = altdist;
                     IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q, to, -altdist));
+                    heapops++;
                 } else if (cmp_result < 0) {
                     /* This is a shorter path */
                     igraph_vector_int_t *v = igraph_inclist_get(&fathers, to);
@@ -2211,6 +2255,7 @@ static int igraph_i_edge_betweenness_estimate_weighted(
                     VECTOR(nrgeo)[to] = VECTOR(nrgeo)[minnei];
                     VECTOR(distance)[to] = altdist;
                     IGRAPH_CHECK(igraph_2wheap_modify(&Q, to, -altdist));
+                    heapops++;
                 } else if (cmp_result == 0) {
                     igraph_vector_int_t *v = igraph_inclist_get(&fathers, to);
                     /* printf("Found a second SP to %li (from %li)\n", to, minnei); */
@@ -2221,6 +2266,10 @@ static int igraph_i_edge_betweenness_estimate_weighted(
 
         } /* igraph_2wheap_empty(&Q) */
 
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_SEARCH_SOURCES, 1);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_EDGES_SCANNED, scanned);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_HEAP_OPERATIONS, heapops);
+
         while (!igraph_stack_empty(&S)) {
             long int w = (long int) igraph_stack_pop(&S);
             igraph_vector_int_t *fatv = igraph_inclist_get(&fathers, w);
@@ -2245,6 +2294,8 @@ static int igraph_i_edge_betweenness_estimate_weighted(
 
     } /* source < no_of_nodes */
 
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_BETWEENNESS);
+
     if (!directed || !igraph_is_directed(graph)) {
         for (j = 0; j < no_of_edges; j++) {
             VECTOR(*result)[j] /= 2.0;
@@ -2409,7 +2460,11 @@ int igraph_edge_betweenness_estimate(const igraph_t *graph, igraph_vector_t *res
 
     /* here we go */
 
+    IGRAPH_TIMER_START(IGRAPH_TIMER_BETWEENNESS);
+
     for (source = 0; source < no_of_nodes; source++) {
+        long int scanned = 0;
+
         IGRAPH_PROGRESS("Edge betweenness centrality: ", 100.0 * source / no_of_nodes, 0);
         IGRAPH_ALLOW_INTERRUPTION();
 
@@ -2433,6 +2488,7 @@ int igraph_edge_betweenness_estimate(const igraph_t *graph, igraph_vector_t *res
             /* check the neighbors and add to them to the queue if unseen before */
             neip = igraph_inclist_get(elist_out_p, actnode);
             neino = igraph_vector_int_size(neip);
+            scanned += neino;
             for (i = 0; i < neino; i++) {
                 igraph_integer_t edge = (igraph_integer_t) VECTOR(*neip)[i], from, to;
                 long int neighbor;
@@ -2453,6 +2509,9 @@ int igraph_edge_betweenness_estimate(const igraph_t *graph, igraph_vector_t *res
             }
         } /* while !igraph_dqueue_empty */
 
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_SEARCH_SOURCES, 1);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_EDGES_SCANNED, scanned);
+
         /* Ok, we've the distance of each node and also the number of
            shortest paths to them. Now we do an inverse search, starting
            with the farthest nodes. */
@@ -2482,6 +2541,9 @@ int igraph_edge_betweenness_estimate(const igraph_t *graph, igraph_vector_t *res
         }
         /* Ok, we've the scores for this source */
     } /* for source <= no_of_nodes */
+
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_BETWEENNESS);
+
     IGRAPH_PROGRESS("Edge betweenness centrality: ", 100.0, 0);
 
     /* clean and return */
@@ -2642,9 +2704,12 @@ static int igraph_i_closeness_estimate_weighted(const igraph_t *graph,
     IGRAPH_CHECK(igraph_vector_resize(res, nodes_to_calc));
     igraph_vector_null(res);
 
+    IGRAPH_TIMER_START(IGRAPH_TIMER_CLOSENESS);
+
     for (i = 0; !IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit), i++) {
 
         long int source = IGRAPH_VIT_GET(vit);
+        long int scanned = 0, heapops = 1;
         igraph_2wheap_clear(&Q);
         igraph_2wheap_push_with_index(&Q, source, -1.0);
         VECTOR(which)[source] = i + 1;
@@ -2658,6 +2723,7 @@ static int igraph_i_closeness_estimate_weighted(const igraph_t *graph,
             long int nlen = igraph_vector_size(neis);
 
             mindist = -igraph_2wheap_delete_max(&Q);
+            heapops++;
 
             VECTOR(*res)[i] += (mindist - 1.0);
             nodes_reached++;
@@ -2666,6 +2732,7 @@ static int igraph_i_closeness_estimate_weighted(const igraph_t *graph,
                 continue;    /* NOT break!!! */
             }
 
+            scanned += nlen;
             for (j = 0; j < nlen; j++) {
                 long int edge = (long int) VECTOR(*neis)[j];
                 long int to = IGRAPH_OTHER(graph, edge, minnei);
@@ -2683,15 +2750,21 @@ static int igraph_i_closeness_estimate_weighted(const igraph_t *graph,
                     VECTOR(which)[to] = i + 1;
                     VECTOR(dist)[to] = altdist;
                     IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q, to, -altdist));
+                    heapops++;
                 } else if (cmp_result < 0) {
                     /* This is a shorter path */
                     VECTOR(dist)[to] = altdist;
                     IGRAPH_CHECK(igraph_2wheap_modify(&Q, to, -altdist));
+                    heapops++;
                 }
             }
 
         } /* !igraph_2wheap_empty(&Q) */
 
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_SEARCH_SOURCES, 1);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_EDGES_SCANNED, scanned);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_HEAP_OPERATIONS, heapops);
+
         /* using igraph_real_t here instead of igraph_integer_t to avoid overflow */
         VECTOR(*res)[i] += ((igraph_real_t)no_of_nodes * (no_of_nodes - nodes_reached));
         VECTOR(*res)[i] = (no_of_nodes - 1) / VECTOR(*res)[i];
@@ -2703,6 +2776,8 @@ static int igraph_i_closeness_estimate_weighted(const igraph_t *graph,
         }
     } /* !IGRAPH_VIT_END(vit) */
 
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_CLOSENESS);
+
     if (!normalized) {
         for (i = 0; i < nodes_to_calc; i++) {
             VECTOR(*res)[i] /= (no_of_nodes - 1);
@@ -2829,9 +2904,12 @@ int igraph_closeness_estimate(const igraph_t *graph, igraph_vector_t *res,
     IGRAPH_CHECK(igraph_vector_resize(res, nodes_to_calc));
     igraph_vector_null(res);
 
+    IGRAPH_TIMER_START(IGRAPH_TIMER_CLOSENESS);
+
     for (IGRAPH_VIT_RESET(vit), i = 0;
          !IGRAPH_VIT_END(vit);
          IGRAPH_VIT_NEXT(vit), i++) {
+        long int scanned = 0;
         igraph_dqueue_clear(&q);
         IGRAPH_CHECK(igraph_dqueue_push(&q, IGRAPH_VIT_GET(vit)));
         IGRAPH_CHECK(igraph_dqueue_push(&q, 0));
@@ -2853,6 +2931,7 @@ int igraph_closeness_estimate(const igraph_t *graph, igraph_vector_t *res,
 
             /* check the neighbors */
             neis = igraph_adjlist_get(&allneis, act);
+            scanned += igraph_vector_int_size(neis);
             for (j = 0; j < igraph_vector_int_size(neis); j++) {
                 long int neighbor = (long int) VECTOR(*neis)[j];
                 if (VECTOR(already_counted)[neighbor] == i + 1) {
@@ -2865,6 +2944,9 @@ int igraph_closeness_estimate(const igraph_t *graph, igraph_vector_t *res,
             }
         }
 
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_SEARCH_SOURCES, 1);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_EDGES_SCANNED, scanned);
+
         /* using igraph_real_t here instead of igraph_integer_t to avoid overflow */
         VECTOR(*res)[i] += ((igraph_real_t)no_of_nodes * (no_of_nodes - nodes_reached));
         VECTOR(*res)[i] = (no_of_nodes - 1) / VECTOR(*res)[i];
@@ -2876,6 +2958,8 @@ int igraph_closeness_estimate(const igraph_t *graph, igraph_vector_t *res,
         }
     }
 
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_CLOSENESS);
+
     if (!normalized) {
         for (i = 0; i < nodes_to_calc; i++) {
             VECTOR(*res)[i] /= (no_of_nodes - 1);
@@ -239,16 +239,17 @@ static int igraph_i_cliques(const igraph_t *graph, igraph_vector_ptr_t *res,
     if (min_size <= 1) {
         IGRAPH_CHECK(igraph_vector_ptr_resize(res, no_of_nodes));
         igraph_vector_ptr_null(res);
+        /* The vectors are stored in res before they are initialized, so
+           igraph_i_cliques_free_res() releases them on error and they
+           need not be registered one by one */
         for (i = 0; i < no_of_nodes; i++) {
             igraph_vector_t *p = igraph_Calloc(1, igraph_vector_t);
             if (p == 0) {
                 IGRAPH_ERROR("cliques failed", IGRAPH_ENOMEM);
             }
-            IGRAPH_FINALLY(igraph_free, p);
+            VECTOR(*res)[i] = p;
             IGRAPH_CHECK(igraph_vector_init(p, 1));
             VECTOR(*p)[0] = i;
-            VECTOR(*res)[i] = p;
-            IGRAPH_FINALLY_CLEAN(1);
         }
     }
 
@@ -278,16 +279,15 @@ static int igraph_i_cliques(const igraph_t *graph, igraph_vector_ptr_t *res,
 
         /* Add the cliques just found to the result if requested */
         if (i >= min_size && i <= max_size) {
+            IGRAPH_CHECK(igraph_vector_ptr_reserve(res, igraph_vector_ptr_size(res) + clique_count));
             for (j = 0, k = 0; j < clique_count; j++, k += i) {
                 igraph_vector_t *p = igraph_Calloc(1, igraph_vector_t);
                 if (p == 0) {
                     IGRAPH_ERROR("cliques failed", IGRAPH_ENOMEM);
                 }
-                IGRAPH_FINALLY(igraph_free, p);
+                /* cannot fail, the space is reserved */
+                igraph_vector_ptr_push_back(res, p);
                 IGRAPH_CHECK(igraph_vector_init_copy(p, &new_member_storage[k], i));
-                IGRAPH_FINALLY(igraph_vector_destroy, p);
-                IGRAPH_CHECK(igraph_vector_ptr_push_back(res, p));
-                IGRAPH_FINALLY_CLEAN(2);
             }
         }
 
@@ -652,7 +652,7 @@ static int igraph_i_maximal_independent_vertex_sets_backtrack(
                     j = igraph_vector_ptr_size(res);
                     for (v1 = 0; v1 < j; v1++) {
                         igraph_vector_destroy(VECTOR(*res)[v1]);
-                        free(VECTOR(*res)[v1]);
+                        igraph_free(VECTOR(*res)[v1]);
                     }
                     igraph_vector_ptr_clear(res);
                     IGRAPH_CHECK(igraph_vector_ptr_push_back(res, vec));
@@ -660,7 +660,7 @@ static int igraph_i_maximal_independent_vertex_sets_backtrack(
                     IGRAPH_CHECK(igraph_vector_ptr_push_back(res, vec));
                 } else {
                     igraph_vector_destroy(vec);
-                    free(vec);
+                    igraph_Free(vec);
                 }
             }
             IGRAPH_FINALLY_CLEAN(1);
@@ -1101,7 +1101,7 @@ static void igraph_i_maximal_cliques_stack_destroy(igraph_stack_ptr_t *stack) {
     while (!igraph_stack_ptr_empty(stack)) {
         frame = (igraph_i_maximal_cliques_stack_frame*)igraph_stack_ptr_pop(stack);
         igraph_i_maximal_cliques_stack_frame_destroy(frame);
-        free(frame);
+        igraph_Free(frame);
     }
 
     igraph_stack_ptr_destroy(stack);
@@ -1187,7 +1187,7 @@ static int igraph_i_maximal_cliques(const igraph_t *graph, igraph_i_maximal_cliq
             igraph_i_maximal_cliques_stack_frame *newframe = igraph_stack_ptr_pop(&stack);
             igraph_i_maximal_cliques_stack_frame_destroy(&frame);
             frame = *newframe;
-            free(newframe);
+            igraph_Free(newframe);
 
             if (igraph_stack_ptr_size(&stack) == 1) {
                 /* We will be using the next candidate node in the next iteration, so we can increase
@@ -347,8 +347,11 @@ int igraph_similarity_jaccard(const igraph_t *graph, igraph_matrix_t *res,
         for (IGRAPH_VIT_RESET(vit); !IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit)) {
             i = IGRAPH_VIT_GET(vit);
             v1 = igraph_lazy_adjlist_get(&al, (igraph_integer_t) i);
+            if (v1 == 0) {
+                IGRAPH_ERROR("cannot calculate Jaccard similarity", IGRAPH_ENOMEM);
+            }
             if (!igraph_vector_binsearch(v1, i, &k)) {
-                igraph_vector_insert(v1, k, i);
+                IGRAPH_CHECK(igraph_vector_insert(v1, k, i));
             }
         }
     }
@@ -363,6 +366,9 @@ int igraph_similarity_jaccard(const igraph_t *graph, igraph_matrix_t *res,
             }
             v1 = igraph_lazy_adjlist_get(&al, IGRAPH_VIT_GET(vit));
             v2 = igraph_lazy_adjlist_get(&al, IGRAPH_VIT_GET(vit2));
+            if (v1 == 0 || v2 == 0) {
+                IGRAPH_ERROR("cannot calculate Jaccard similarity", IGRAPH_ENOMEM);
+            }
             igraph_i_neisets_intersect(v1, v2, &len_union, &len_intersection);
             if (len_union > 0) {
                 MATRIX(*res, i, j) = ((igraph_real_t)len_intersection) / len_union;
@@ -466,8 +472,11 @@ int igraph_similarity_jaccard_pairs(const igraph_t *graph, igraph_vector_t *res,
             }
             seen[j] = 1;
             v1 = igraph_lazy_adjlist_get(&al, (igraph_integer_t) j);
+            if (v1 == 0) {
+                IGRAPH_ERROR("cannot calculate Jaccard similarity", IGRAPH_ENOMEM);
+            }
             if (!igraph_vector_binsearch(v1, j, &u)) {
-                igraph_vector_insert(v1, u, j);
+                IGRAPH_CHECK(igraph_vector_insert(v1, u, j));
             }
         }
 
@@ -486,6 +495,9 @@ int igraph_similarity_jaccard_pairs(const igraph_t *graph, igraph_vector_t *res,
 
         v1 = igraph_lazy_adjlist_get(&al, (igraph_integer_t) u);
         v2 = igraph_lazy_adjlist_get(&al, (igraph_integer_t) v);
+        if (v1 == 0 || v2 == 0) {
+            IGRAPH_ERROR("cannot calculate Jaccard similarity", IGRAPH_ENOMEM);
+        }
         igraph_i_neisets_intersect(v1, v2, &len_union, &len_intersection);
         if (len_union > 0) {
             VECTOR(*res)[j] = ((igraph_real_t)len_intersection) / len_union;
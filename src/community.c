@@ -30,6 +30,7 @@
 #include "igraph_adjlist.h"
 #include "igraph_interface.h"
 #include "igraph_interrupt_internal.h"
+#include "igraph_counters_internal.h"
 #include "igraph_components.h"
 #include "igraph_dqueue.h"
 #include "igraph_progress.h"
@@ -3108,6 +3109,7 @@ static int igraph_i_community_multilevel_step(
         }
 
         q = igraph_i_multilevel_community_modularity(&communities);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_COMMUNITY_MOVES, changed);
 
         if (changed && (q > pass_q)) {
             /* debug("Pass %d (changed: %d) Communities: %ld Modularity from %lf to %lf\n",
@@ -3244,6 +3246,8 @@ int igraph_community_multilevel(const igraph_t *graph,
         igraph_vector_clear(modularity);
     }
 
+    IGRAPH_TIMER_START(IGRAPH_TIMER_COMMUNITY);
+
     while (1) {
         /* Remember the previous modularity and vertex count, do a single step */
         igraph_integer_t step_vcount = igraph_vcount(&g);
@@ -3282,6 +3286,8 @@ int igraph_community_multilevel(const igraph_t *graph,
         level++;
     }
 
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_COMMUNITY);
+
     /* It might happen that there are no merges, so every vertex is in its
        own community. We still might want the modularity score for that. */
     if (modularity && igraph_vector_size(modularity) == 0) {
@@ -27,10 +27,14 @@
 #include "igraph_dqueue.h"
 #include "igraph_interface.h"
 #include "igraph_interrupt_internal.h"
+#include "igraph_counters_internal.h"
 #include "igraph_memory.h"
 #include "igraph_random.h"
 #include "igraph_stack.h"
 #include "igraph_constructors.h"
+#include "igraph_types_internal.h"
+
+#include <string.h>
 
 /* Move nodes in order to improve the quality of a partition.
  *
@@ -61,7 +65,7 @@ static int igraph_i_community_leiden_fastmovenodes(
     igraph_vector_t node_order, cluster_weights, edge_weights_per_cluster, neighbor_clusters;
     igraph_vector_int_t nb_nodes_per_cluster;
     igraph_stack_t empty_clusters;
-    long int i, j, c, nb_neigh_clusters;
+    long int i, j, c, nb_neigh_clusters, nb_moves = 0;
 
     /* Initialize queue of unstable nodes and whether node is stable. Only
      * unstable nodes are in the queue. */
@@ -174,6 +178,7 @@ static int igraph_i_community_leiden_fastmovenodes(
         /* Add stable neighbours that are not part of the new cluster to the queue */
         if (best_cluster != current_cluster) {
             VECTOR(*membership)[v] = best_cluster;
+            nb_moves++;
 
             for (i = 0; i < degree; i++) {
                 long int e = VECTOR(*edges)[i];
@@ -192,6 +197,8 @@ static int igraph_i_community_leiden_fastmovenodes(
         }
     }
 
+    IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_COMMUNITY_MOVES, nb_moves);
+
     IGRAPH_CHECK(igraph_reindex_membership(membership, NULL, nb_clusters));
 
     igraph_vector_destroy(&neighbor_clusters);
@@ -479,35 +486,46 @@ static int igraph_i_community_leiden_mergenodes(
 
 /* Create clusters out of a membership vector.
  *
- * The cluster pointer vector should be initialized for all entries of the
- * membership vector, no range checking is performed. If a vector for a cluster
- * does not yet exist it will be created and initialized. If a vector for a
- * cluster already does exist it will not be emptied on first use. Hence, it
- * should be ensured that all clusters are always properly empty (or
- * non-existing) before calling this function.
+ * The membership vector should contain cluster indices between zero and
+ * \c nb_clusters - 1, no range checking is performed. On return \c *clusters
+ * points to an array of \c nb_clusters vectors, each of which is a view of the
+ * nodes in the corresponding cluster. The array and the storage of all
+ * vectors are allocated from \c arena in two blocks, so the vectors must not
+ * be destroyed or resized; they are released when the arena is reset or
+ * destroyed.
  */
-static int igraph_i_community_get_clusters(const igraph_vector_t *membership, igraph_vector_ptr_t *clusters) {
+static int igraph_i_community_get_clusters(const igraph_vector_t *membership,
+        long int nb_clusters, igraph_arena_t *arena, igraph_vector_t **clusters) {
     long int i, c, n = igraph_vector_size(membership);
-    igraph_vector_t *cluster;
-    for (i = 0; i < n; i++) {
-        /* Get cluster for node i */
-        c = VECTOR(*membership)[i];
-        cluster = (igraph_vector_t*)VECTOR(*clusters)[c];
+    igraph_real_t *nodes;
+    igraph_vector_t *result;
+    long int *pos;
+
+    result = igraph_arena_alloc(arena, (nb_clusters > 0 ? nb_clusters : 1) * sizeof(igraph_vector_t));
+    nodes = igraph_arena_alloc(arena, (n > 0 ? n : 1) * sizeof(igraph_real_t));
+    pos = igraph_arena_alloc(arena, (nb_clusters + 1) * sizeof(long int));
+    if (result == 0 || nodes == 0 || pos == 0) {
+        IGRAPH_ERROR("Cannot allocate memory for assigning cluster", IGRAPH_ENOMEM);
+    }
 
-        /* No cluster vector exists yet, so we create a new one */
-        if (!cluster) {
-            cluster = igraph_Calloc(1, igraph_vector_t);
-            if (cluster == 0) {
-                IGRAPH_ERROR("Cannot allocate memory for assigning cluster", IGRAPH_ENOMEM);
-            }
-            IGRAPH_CHECK(igraph_vector_init(cluster, 0));
-            VECTOR(*clusters)[c] = cluster;
-        }
+    /* Count the nodes in each cluster and turn the counts into offsets */
+    memset(pos, 0, (nb_clusters + 1) * sizeof(long int));
+    for (i = 0; i < n; i++) {
+        pos[(long int) VECTOR(*membership)[i] + 1]++;
+    }
+    for (c = 0; c < nb_clusters; c++) {
+        pos[c + 1] += pos[c];
+        igraph_vector_view(&result[c], nodes + pos[c], pos[c + 1] - pos[c]);
+    }
 
-        /* Add node i to cluster vector */
-        IGRAPH_CHECK(igraph_vector_push_back(cluster, i));
+    /* Add node i to its cluster vector, keeping the nodes in increasing order */
+    for (i = 0; i < n; i++) {
+        c = (long int) VECTOR(*membership)[i];
+        nodes[pos[c]++] = i;
     }
 
+    *clusters = result;
+
     return IGRAPH_SUCCESS;
 }
 
@@ -530,17 +548,18 @@ static int igraph_i_community_leiden_aggregate(
     const igraph_vector_t *membership, const igraph_vector_t *refined_membership, const igraph_integer_t nb_refined_clusters,
     igraph_t *aggregated_graph, igraph_vector_t *aggregated_edge_weights, igraph_vector_t *aggregated_node_weights, igraph_vector_t *aggregated_membership) {
     igraph_vector_t aggregated_edges, edge_weight_to_cluster;
-    igraph_vector_ptr_t refined_clusters;
+    igraph_arena_t arena;
+    igraph_vector_t *refined_clusters;
     igraph_vector_int_t *incident_edges;
     igraph_vector_t neighbor_clusters;
     igraph_vector_bool_t neighbor_cluster_added;
     long int i, j, c, degree, nb_neigh_clusters;
 
     /* Get refined clusters */
-    IGRAPH_CHECK(igraph_vector_ptr_init(&refined_clusters, nb_refined_clusters));
-    IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&refined_clusters, igraph_vector_destroy);
-    IGRAPH_FINALLY(igraph_vector_ptr_destroy_all, &refined_clusters);
-    IGRAPH_CHECK(igraph_i_community_get_clusters(refined_membership, &refined_clusters));
+    IGRAPH_CHECK(igraph_arena_init(&arena, 0));
+    IGRAPH_FINALLY(igraph_arena_destroy, &arena);
+    IGRAPH_CHECK(igraph_i_community_get_clusters(refined_membership, nb_refined_clusters,
+                 &arena, &refined_clusters));
 
     /* Initialize new edges */
     IGRAPH_CHECK(igraph_vector_init(&aggregated_edges, 0));
@@ -564,7 +583,7 @@ static int igraph_i_community_leiden_aggregate(
 
     /* Check per cluster */
     for (c = 0; c < nb_refined_clusters; c++) {
-        igraph_vector_t* refined_cluster = (igraph_vector_t*)VECTOR(refined_clusters)[c];
+        igraph_vector_t* refined_cluster = &refined_clusters[c];
         long int n_c = igraph_vector_size(refined_cluster);
         long int v = -1;
 
@@ -615,7 +634,7 @@ static int igraph_i_community_leiden_aggregate(
     igraph_vector_destroy(&neighbor_clusters);
     igraph_vector_bool_destroy(&neighbor_cluster_added);
     igraph_vector_destroy(&edge_weight_to_cluster);
-    igraph_vector_ptr_destroy_all(&refined_clusters);
+    igraph_arena_destroy(&arena);
 
     IGRAPH_FINALLY_CLEAN(4);
 
@@ -721,7 +740,8 @@ int igraph_i_community_leiden(const igraph_t *graph,
     igraph_vector_t tmp_edge_weights, tmp_node_weights, tmp_membership;
     igraph_vector_t refined_membership;
     igraph_vector_int_t aggregate_node;
-    igraph_vector_ptr_t clusters;
+    igraph_arena_t arena;
+    igraph_vector_t *clusters;
     igraph_inclist_t edges_per_node;
     igraph_bool_t continue_clustering;
     igraph_integer_t level = 0;
@@ -734,10 +754,9 @@ int igraph_i_community_leiden(const igraph_t *graph,
     IGRAPH_CHECK(igraph_vector_init(&tmp_membership, 0));
     IGRAPH_FINALLY(igraph_vector_destroy, &tmp_membership);
 
-    /* Initialize clusters */
-    IGRAPH_CHECK(igraph_vector_ptr_init(&clusters, n));
-    IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&clusters, igraph_vector_destroy);
-    IGRAPH_FINALLY(igraph_vector_ptr_destroy_all, &clusters);
+    /* Initialize scratch memory for the clusters; it is reused on each level */
+    IGRAPH_CHECK(igraph_arena_init(&arena, 0));
+    IGRAPH_FINALLY(igraph_arena_destroy, &arena);
 
     /* Initialize aggregate nodes, which initially is identical to simply the
      * nodes in the graph. */
@@ -810,7 +829,9 @@ int igraph_i_community_leiden(const igraph_t *graph,
             }
 
             /* Get node sets for each cluster. */
-            IGRAPH_CHECK(igraph_i_community_get_clusters(i_membership, &clusters));
+            igraph_arena_reset(&arena);
+            IGRAPH_CHECK(igraph_i_community_get_clusters(i_membership, *nb_clusters,
+                         &arena, &clusters));
 
             /* Ensure refined membership is correct size */
             IGRAPH_CHECK(igraph_vector_resize(&refined_membership, igraph_vcount(i_graph)));
@@ -818,15 +839,12 @@ int igraph_i_community_leiden(const igraph_t *graph,
             /* Refine each cluster */
             nb_refined_clusters = 0;
             for (c = 0; c < *nb_clusters; c++) {
-                igraph_vector_t* cluster = (igraph_vector_t*)VECTOR(clusters)[c];
                 IGRAPH_CHECK(igraph_i_community_leiden_mergenodes(i_graph,
                              &edges_per_node,
                              i_edge_weights, i_node_weights,
-                             cluster, i_membership, c,
+                             &clusters[c], i_membership, c,
                              resolution_parameter, beta,
                              &nb_refined_clusters, &refined_membership));
-                /* Empty cluster */
-                igraph_vector_clear(cluster);
             }
 
             /* If refinement didn't aggregate anything, we aggregate on the basis of
@@ -884,7 +902,7 @@ int igraph_i_community_leiden(const igraph_t *graph,
     /* Free remaining memory */
     igraph_vector_destroy(&refined_membership);
     igraph_vector_int_destroy(&aggregate_node);
-    igraph_vector_ptr_destroy_all(&clusters);
+    igraph_arena_destroy(&arena);
     igraph_vector_destroy(&tmp_membership);
     igraph_vector_destroy(&tmp_node_weights);
     igraph_vector_destroy(&tmp_edge_weights);
@@ -1040,9 +1058,11 @@ int igraph_community_leiden(const igraph_t *graph,
     }
 
     /* Perform actual Leiden algorithm */
+    IGRAPH_TIMER_START(IGRAPH_TIMER_COMMUNITY);
     IGRAPH_CHECK(igraph_i_community_leiden(graph, i_edge_weights, i_node_weights,
                                            resolution_parameter, beta,
                                            membership, nb_clusters, quality));
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_COMMUNITY);
 
     if (!edge_weights) {
         igraph_vector_destroy(i_edge_weights);
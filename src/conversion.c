@@ -28,9 +28,12 @@
 #include "igraph_constructors.h"
 #include "igraph_structural.h"
 #include "igraph_types_internal.h"
+#include "igraph_interface_internal.h"
 #include "igraph_sparsemat.h"
 #include "config.h"
 
+#include <limits.h>
+
 /**
  * \ingroup conversion
  * \function igraph_get_adjacency
@@ -319,6 +322,255 @@ int igraph_get_edgelist(const igraph_t *graph, igraph_vector_t *res, igraph_bool
     return 0;
 }
 
+/* The number of entries of the compressed sparse row matrix of a graph
+   with 'no_of_edges' edges, 'no_of_loops' of which are loop edges; these
+   are only counted in undirected graphs. Fails with IGRAPH_EOVERFLOW if
+   the offsets, which are ints, cannot hold it. */
+
+int igraph_i_csr_nnz(igraph_bool_t directed, igraph_neimode_t mode,
+                     long int no_of_edges, long int no_of_loops,
+                     long int *nnz) {
+    if (directed) {
+        *nnz = mode == IGRAPH_ALL ? 2 * no_of_edges : no_of_edges;
+    } else {
+        *nnz = 2 * no_of_edges - no_of_loops;
+    }
+    if (*nnz > INT_MAX) {
+        IGRAPH_ERROR("Too many entries for a compressed sparse row matrix",
+                     IGRAPH_EOVERFLOW);
+    }
+    return 0;
+}
+
+/**
+ * \ingroup conversion
+ * \function igraph_get_csr
+ * \brief Returns the adjacency matrix of a graph in compressed sparse row format
+ *
+ * </para><para>
+ * The adjacency matrix is returned as two integer arrays, in the
+ * format that most sparse linear algebra code expects: the neighbors
+ * of vertex \c i are the elements of \p indices from position
+ * <code>offsets[i]</code> to <code>offsets[i+1]-1</code>, sorted in
+ * increasing order. A neighbor is listed as many times as there are
+ * edges to it; except with \c IGRAPH_ALL, these entries follow the
+ * order of the edge ids, like the edges that \ref
+ * igraph_create_from_csr() creates from them. The rows are read from
+ * the sorted edge index of the graph, so no sorting is needed; the data
+ * is copied once into \p offsets and \p indices, and the caller can
+ * pass their element arrays to external code directly.
+ *
+ * </para><para>
+ * With \c IGRAPH_OUT the result is the adjacency matrix in compressed
+ * sparse row (CSR) format, with \c IGRAPH_IN it is the adjacency
+ * matrix in compressed sparse column (CSC) format. For undirected
+ * graphs, the matrix is symmetric, and a loop edge appears once in
+ * the row of its vertex, like in \ref igraph_get_sparsemat().
+ *
+ * </para><para>
+ * The number of entries must fit into an \c int, so the matrix can
+ * have at most \c INT_MAX entries: every edge gives one entry with
+ * \c IGRAPH_OUT and \c IGRAPH_IN, and two entries with \c IGRAPH_ALL
+ * and in undirected graphs, except loop edges of undirected graphs.
+ * \param graph The input graph.
+ * \param offsets Pointer to an initialized integer vector, the start
+ *        of each row is stored here. It will be resized to the number
+ *        of vertices plus one; its last element is the number of
+ *        entries.
+ * \param indices Pointer to an initialized integer vector, the
+ *        neighbors of the vertices are stored here.
+ * \param weights Pointer to a vector with the weights of the edges,
+ *        or a null pointer.
+ * \param values Pointer to an initialized vector, the weight of the
+ *        edge of each entry of \p indices is stored here. It is
+ *        ignored if \p weights is a null pointer.
+ * \param mode Constant, which neighbors to list for directed graphs:
+ *        \c IGRAPH_OUT for the out-neighbors, \c IGRAPH_IN for the
+ *        in-neighbors and \c IGRAPH_ALL for both, i.e. the adjacency
+ *        matrix of the graph plus its transpose. It is ignored for
+ *        undirected graphs.
+ * \return Error code:
+ *        \c IGRAPH_EINVAL invalid mode argument or weight vector
+ *        length, \c IGRAPH_EOVERFLOW if the matrix would have more
+ *        than \c INT_MAX entries.
+ *
+ * \sa \ref igraph_create_from_csr() for the reverse conversion,
+ * \ref igraph_get_sparsemat() to create a sparse matrix object.
+ *
+ * Time complexity: O(|V|+|E|), the number of vertices plus the number
+ * of edges.
+ */
+
+int igraph_get_csr(const igraph_t *graph, igraph_vector_int_t *offsets,
+                   igraph_vector_int_t *indices,
+                   const igraph_vector_t *weights, igraph_vector_t *values,
+                   igraph_neimode_t mode) {
+
+    long int no_of_edges = igraph_ecount(graph);
+    long int i, no_of_loops = 0, nnz;
+
+    if (mode != IGRAPH_OUT && mode != IGRAPH_IN && mode != IGRAPH_ALL) {
+        IGRAPH_ERROR("Invalid mode argument", IGRAPH_EINVAL);
+    }
+    if (weights && igraph_vector_size(weights) != no_of_edges) {
+        IGRAPH_ERROR("Weight vector length must match the number of edges",
+                     IGRAPH_EINVAL);
+    }
+
+    if (!igraph_is_directed(graph)) {
+        for (i = 0; i < no_of_edges; i++) {
+            if (IGRAPH_FROM(graph, i) == IGRAPH_TO(graph, i)) {
+                no_of_loops++;
+            }
+        }
+    }
+    IGRAPH_CHECK(igraph_i_csr_nnz(igraph_is_directed(graph), mode,
+                                  no_of_edges, no_of_loops, &nnz));
+
+    IGRAPH_CHECK(igraph_i_get_csr(graph, offsets, indices, weights,
+                                  weights ? values : 0, mode, nnz));
+
+    return 0;
+}
+
+/**
+ * \ingroup conversion
+ * \function igraph_create_from_csr
+ * \brief Creates a graph from an adjacency matrix in compressed sparse row format
+ *
+ * </para><para>
+ * This is the reverse of \ref igraph_get_csr(). Each entry of the
+ * matrix is an edge: entry <code>k</code>, from position
+ * <code>offsets[i]</code> to <code>offsets[i+1]-1</code>, is an
+ * edge between vertex \c i and vertex <code>indices[k]</code>. The
+ * edges get their ids in the order of the entries.
+ *
+ * </para><para>
+ * If the neighbors of each vertex are sorted in increasing order, the
+ * edge index of the graph is built directly from the rows, without
+ * sorting the edges; otherwise the graph is created with \ref
+ * igraph_create(). The result is the same in both cases.
+ * \param graph Pointer to an uninitialized graph object.
+ * \param offsets The start of each row in \p indices. Its length is
+ *        the number of vertices plus one; it must start with zero,
+ *        be non-decreasing and end with the length of \p indices.
+ * \param indices The neighbors of the vertices.
+ * \param values Pointer to a vector with the value of each entry of
+ *        \p indices, or a null pointer.
+ * \param weights Pointer to an initialized vector, the value of the
+ *        entry of each edge is stored here. It is ignored if
+ *        \p values is a null pointer.
+ * \param directed Whether to create a directed graph. For undirected
+ *        graphs, the matrix must be symmetric, and only the entries
+ *        of its lower triangle, including the diagonal, are used;
+ *        i.e. entry \c k in row \c i is an edge if
+ *        <code>indices[k] <= i</code>.
+ * \param mode Constant, the format of the matrix for directed graphs:
+ *        \c IGRAPH_OUT for compressed sparse row format, i.e. the
+ *        edges point from \c i to <code>indices[k]</code>, or
+ *        \c IGRAPH_IN for compressed sparse column format, i.e. the
+ *        edges point from <code>indices[k]</code> to \c i. It is
+ *        ignored for undirected graphs.
+ * \return Error code:
+ *        \c IGRAPH_EINVAL invalid offsets, indices, value vector length
+ *        or mode argument.
+ *
+ * \sa \ref igraph_get_csr(), \ref igraph_create().
+ *
+ * Time complexity: O(|V|+|E|), the number of vertices plus the
+ * number of entries, if the rows are sorted, O(|V|+|E| log|E|)
+ * otherwise.
+ */
+
+int igraph_create_from_csr(igraph_t *graph,
+                           const igraph_vector_int_t *offsets,
+                           const igraph_vector_int_t *indices,
+                           const igraph_vector_t *values,
+                           igraph_vector_t *weights,
+                           igraph_bool_t directed, igraph_neimode_t mode) {
+
+    long int no_of_nodes = igraph_vector_int_size(offsets) - 1;
+    long int nnz = igraph_vector_int_size(indices);
+    igraph_bool_t sorted = 1;
+    long int i, k, m = 0;
+
+    if (directed && mode != IGRAPH_OUT && mode != IGRAPH_IN) {
+        IGRAPH_ERROR("Invalid mode argument", IGRAPH_EINVAL);
+    }
+    if (no_of_nodes < 0 || VECTOR(*offsets)[0] != 0 ||
+        VECTOR(*offsets)[no_of_nodes] != nnz) {
+        IGRAPH_ERROR("Offsets must start with zero and end with the number "
+                     "of entries", IGRAPH_EINVAL);
+    }
+    if (values && igraph_vector_size(values) != nnz) {
+        IGRAPH_ERROR("Value vector length must match the number of entries",
+                     IGRAPH_EINVAL);
+    }
+
+    for (i = 0; i < no_of_nodes; i++) {
+        if (VECTOR(*offsets)[i + 1] < VECTOR(*offsets)[i]) {
+            IGRAPH_ERROR("Offsets must be non-decreasing", IGRAPH_EINVAL);
+        }
+    }
+
+    for (i = 0; i < no_of_nodes; i++) {
+        long int prev = -1;
+        for (k = VECTOR(*offsets)[i]; k < VECTOR(*offsets)[i + 1]; k++) {
+            long int nei = VECTOR(*indices)[k];
+            if (nei < 0 || nei >= no_of_nodes) {
+                IGRAPH_ERROR("Invalid vertex id in indices", IGRAPH_EINVVID);
+            }
+            if (directed || nei <= i) {
+                if (nei < prev) {
+                    sorted = 0;
+                }
+                prev = nei;
+                m++;
+            }
+        }
+    }
+
+    if (sorted) {
+        IGRAPH_CHECK(igraph_i_create_csr_sorted(graph, offsets, indices,
+                                                directed, mode));
+    } else {
+        igraph_vector_t edges;
+        igraph_bool_t byrow = !directed || mode == IGRAPH_OUT;
+        IGRAPH_VECTOR_INIT_FINALLY(&edges, 2 * m);
+        m = 0;
+        for (i = 0; i < no_of_nodes; i++) {
+            for (k = VECTOR(*offsets)[i]; k < VECTOR(*offsets)[i + 1]; k++) {
+                long int nei = VECTOR(*indices)[k];
+                if (directed || nei <= i) {
+                    VECTOR(edges)[2 * m] = byrow ? i : nei;
+                    VECTOR(edges)[2 * m + 1] = byrow ? nei : i;
+                    m++;
+                }
+            }
+        }
+        IGRAPH_CHECK(igraph_create(graph, &edges, (igraph_integer_t) no_of_nodes,
+                                   directed));
+        igraph_vector_destroy(&edges);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
+
+    if (values && weights) {
+        IGRAPH_FINALLY(igraph_destroy, graph);
+        IGRAPH_CHECK(igraph_vector_resize(weights, m));
+        m = 0;
+        for (i = 0; i < no_of_nodes; i++) {
+            for (k = VECTOR(*offsets)[i]; k < VECTOR(*offsets)[i + 1]; k++) {
+                if (directed || VECTOR(*indices)[k] <= i) {
+                    VECTOR(*weights)[m++] = VECTOR(*values)[k];
+                }
+            }
+        }
+        IGRAPH_FINALLY_CLEAN(1);
+    }
+
+    return 0;
+}
+
 /**
  * \function igraph_to_directed
  * \brief Convert an undirected graph to a directed one
@@ -342,6 +594,8 @@ int igraph_get_edgelist(const igraph_t *graph, igraph_vector_t *res, igraph_bool
 int igraph_to_directed(igraph_t *graph,
                        igraph_to_directed_t mode) {
 
+    igraph_t newgraph;
+
     if (mode != IGRAPH_TO_DIRECTED_ARBITRARY &&
         mode != IGRAPH_TO_DIRECTED_MUTUAL) {
         IGRAPH_ERROR("Cannot direct graph, invalid mode", IGRAPH_EINVAL);
@@ -351,62 +605,32 @@ int igraph_to_directed(igraph_t *graph,
         return 0;
     }
 
-    if (mode == IGRAPH_TO_DIRECTED_ARBITRARY) {
-
-        igraph_t newgraph;
-        igraph_vector_t edges;
-        long int no_of_edges = igraph_ecount(graph);
-        long int no_of_nodes = igraph_vcount(graph);
-        long int size = no_of_edges * 2;
-        IGRAPH_VECTOR_INIT_FINALLY(&edges, size);
-        IGRAPH_CHECK(igraph_get_edgelist(graph, &edges, 0));
+    /* Builds the new graph directly from the sorted edge indices */
+    IGRAPH_CHECK(igraph_i_to_directed_sorted(graph, &newgraph,
+                 mode == IGRAPH_TO_DIRECTED_MUTUAL));
+    IGRAPH_FINALLY(igraph_destroy, &newgraph);
 
-        IGRAPH_CHECK(igraph_create(&newgraph, &edges,
-                                   (igraph_integer_t) no_of_nodes,
-                                   IGRAPH_DIRECTED));
-        IGRAPH_FINALLY(igraph_destroy, &newgraph);
-        igraph_vector_destroy(&edges);
-        IGRAPH_I_ATTRIBUTE_DESTROY(&newgraph);
+    IGRAPH_I_ATTRIBUTE_DESTROY(&newgraph);
+    if (mode == IGRAPH_TO_DIRECTED_ARBITRARY) {
         IGRAPH_I_ATTRIBUTE_COPY(&newgraph, graph, 1, 1, 1);
-        IGRAPH_FINALLY_CLEAN(2);
-        igraph_destroy(graph);
-        *graph = newgraph;
-
-    } else if (mode == IGRAPH_TO_DIRECTED_MUTUAL) {
-
-        igraph_t newgraph;
-        igraph_vector_t edges;
+    } else {
         igraph_vector_t index;
         long int no_of_edges = igraph_ecount(graph);
-        long int no_of_nodes = igraph_vcount(graph);
-        long int size = no_of_edges * 4;
         long int i;
-        IGRAPH_VECTOR_INIT_FINALLY(&edges, 0);
-        IGRAPH_CHECK(igraph_vector_reserve(&edges, size));
-        IGRAPH_CHECK(igraph_get_edgelist(graph, &edges, 0));
-        IGRAPH_CHECK(igraph_vector_resize(&edges, no_of_edges * 4));
+        IGRAPH_I_ATTRIBUTE_COPY(&newgraph, graph, 1, 1,/*edges=*/0);
         IGRAPH_VECTOR_INIT_FINALLY(&index, no_of_edges * 2);
         for (i = 0; i < no_of_edges; i++) {
-            VECTOR(edges)[no_of_edges * 2 + i * 2]  = VECTOR(edges)[i * 2 + 1];
-            VECTOR(edges)[no_of_edges * 2 + i * 2 + 1] = VECTOR(edges)[i * 2];
             VECTOR(index)[i] = VECTOR(index)[no_of_edges + i] = i;
         }
-
-        IGRAPH_CHECK(igraph_create(&newgraph, &edges,
-                                   (igraph_integer_t) no_of_nodes,
-                                   IGRAPH_DIRECTED));
-        IGRAPH_FINALLY(igraph_destroy, &newgraph);
-        IGRAPH_I_ATTRIBUTE_DESTROY(&newgraph);
-        IGRAPH_I_ATTRIBUTE_COPY(&newgraph, graph, 1, 1,/*edges=*/0);
         IGRAPH_CHECK(igraph_i_attribute_permute_edges(graph, &newgraph, &index));
-
         igraph_vector_destroy(&index);
-        igraph_vector_destroy(&edges);
-        igraph_destroy(graph);
-        IGRAPH_FINALLY_CLEAN(3);
-        *graph = newgraph;
+        IGRAPH_FINALLY_CLEAN(1);
     }
 
+    IGRAPH_FINALLY_CLEAN(1);
+    igraph_destroy(graph);
+    *graph = newgraph;
+
     return 0;
 }
 
@@ -445,7 +669,6 @@ int igraph_to_undirected(igraph_t *graph,
 
     long int no_of_nodes = igraph_vcount(graph);
     long int no_of_edges = igraph_ecount(graph);
-    igraph_vector_t edges;
     igraph_t newgraph;
     igraph_bool_t attr = edge_comb && igraph_has_attribute_table();
 
@@ -459,31 +682,11 @@ int igraph_to_undirected(igraph_t *graph,
         return 0;
     }
 
-    IGRAPH_VECTOR_INIT_FINALLY(&edges, 0);
-
     if (mode == IGRAPH_TO_UNDIRECTED_EACH) {
-        igraph_es_t es;
-        igraph_eit_t eit;
-
-        IGRAPH_CHECK(igraph_vector_reserve(&edges, no_of_edges * 2));
-        IGRAPH_CHECK(igraph_es_all(&es, IGRAPH_EDGEORDER_ID));
-        IGRAPH_FINALLY(igraph_es_destroy, &es);
-        IGRAPH_CHECK(igraph_eit_create(graph, es, &eit));
-        IGRAPH_FINALLY(igraph_eit_destroy, &eit);
-
-        while (!IGRAPH_EIT_END(eit)) {
-            long int edge = IGRAPH_EIT_GET(eit);
-            igraph_integer_t from, to;
-            igraph_edge(graph, (igraph_integer_t) edge, &from, &to);
-            IGRAPH_CHECK(igraph_vector_push_back(&edges, from));
-            IGRAPH_CHECK(igraph_vector_push_back(&edges, to));
-            IGRAPH_EIT_NEXT(eit);
-        }
-
-        igraph_eit_destroy(&eit);
-        igraph_es_destroy(&es);
-        IGRAPH_FINALLY_CLEAN(2);
+        igraph_vector_t edges;
 
+        IGRAPH_VECTOR_INIT_FINALLY(&edges, no_of_edges * 2);
+        IGRAPH_CHECK(igraph_get_edgelist(graph, &edges, 0));
         IGRAPH_CHECK(igraph_create(&newgraph, &edges,
                                    (igraph_integer_t) no_of_nodes,
                                    IGRAPH_UNDIRECTED));
@@ -495,233 +698,39 @@ int igraph_to_undirected(igraph_t *graph,
         igraph_destroy(graph);
         *graph = newgraph;
 
-    } else if (mode == IGRAPH_TO_UNDIRECTED_COLLAPSE) {
-        igraph_vector_t inadj, outadj;
-        long int i;
+    } else {
         igraph_vector_t mergeinto;
-        long int actedge = 0;
 
         if (attr) {
             IGRAPH_VECTOR_INIT_FINALLY(&mergeinto, no_of_edges);
         }
 
-        IGRAPH_CHECK(igraph_vector_reserve(&edges, no_of_edges * 2));
-        IGRAPH_VECTOR_INIT_FINALLY(&inadj, 0);
-        IGRAPH_VECTOR_INIT_FINALLY(&outadj, 0);
-
-        for (i = 0; i < no_of_nodes; i++) {
-            long int n_out, n_in;
-            long int p1 = -1, p2 = -1;
-            long int e1 = 0, e2 = 0, n1 = 0, n2 = 0;
-            IGRAPH_CHECK(igraph_incident(graph, &outadj, (igraph_integer_t) i,
-                                         IGRAPH_OUT));
-            IGRAPH_CHECK(igraph_incident(graph, &inadj, (igraph_integer_t) i,
-                                         IGRAPH_IN));
-            n_out = igraph_vector_size(&outadj);
-            n_in = igraph_vector_size(&inadj);
-
-#define STEPOUT() if ( (++p1) < n_out) {    \
-        e1 = (long int) VECTOR(outadj)[p1]; \
-        n1 = IGRAPH_TO(graph, e1);      \
-    }
-#define STEPIN()  if ( (++p2) < n_in) {         \
-        e2 = (long int) VECTOR(inadj )[p2]; \
-        n2 = IGRAPH_FROM(graph, e2);        \
-    }
-
-            STEPOUT();
-            STEPIN();
-
-            while (p1 < n_out && n1 <= i && p2 < n_in && n2 <= i) {
-                long int last;
-                if (n1 == n2) {
-                    last = n1;
-                    IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
-                    IGRAPH_CHECK(igraph_vector_push_back(&edges, n1));
-                    if (attr) {
-                        VECTOR(mergeinto)[e1] = actedge;
-                        VECTOR(mergeinto)[e2] = actedge;
-                        actedge++;
-                    }
-                    while (p1 < n_out && last == n1) {
-                        STEPOUT();
-                    }
-                    while (p2 < n_in  && last == n2) {
-                        STEPIN ();
-                    }
-                } else if (n1 < n2) {
-                    last = n1;
-                    IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
-                    IGRAPH_CHECK(igraph_vector_push_back(&edges, n1));
-                    if (attr) {
-                        VECTOR(mergeinto)[e1] = actedge;
-                        actedge++;
-                    }
-                    while (p1 < n_out && last == n1) {
-                        STEPOUT();
-                    }
-                } else { /* n2<n1 */
-                    last = n2;
-                    IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
-                    IGRAPH_CHECK(igraph_vector_push_back(&edges, n2));
-                    if (attr) {
-                        VECTOR(mergeinto)[e2] = actedge;
-                        actedge++;
-                    }
-                    while (p2 < n_in && last == n2) {
-                        STEPIN();
-                    }
-                }
-            }
-            while (p1 < n_out && n1 <= i) {
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, n1));
-                if (attr) {
-                    VECTOR(mergeinto)[e1] = actedge;
-                    actedge++;
-                }
-                STEPOUT();
-            }
-            while (p2 < n_in && n2 <= i) {
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, n2));
-                if (attr) {
-                    VECTOR(mergeinto)[e2] = actedge;
-                    actedge++;
-                }
-                STEPIN();
-            }
-        }
-
-#undef STEPOUT
-#undef STEPIN
-
-        igraph_vector_destroy(&outadj);
-        igraph_vector_destroy(&inadj);
-        IGRAPH_FINALLY_CLEAN(2);
-
-        IGRAPH_CHECK(igraph_create(&newgraph, &edges,
-                                   (igraph_integer_t) no_of_nodes,
-                                   IGRAPH_UNDIRECTED));
+        /* Builds the new graph directly from the sorted edge indices */
+        IGRAPH_CHECK(igraph_i_to_undirected_sorted(graph, &newgraph,
+                     mode == IGRAPH_TO_UNDIRECTED_MUTUAL,
+                     attr ? &mergeinto : NULL));
         IGRAPH_FINALLY(igraph_destroy, &newgraph);
-        igraph_vector_destroy(&edges);
-        IGRAPH_I_ATTRIBUTE_DESTROY(&newgraph);
-        IGRAPH_I_ATTRIBUTE_COPY(&newgraph, graph, 1, 1, 0); /* no edge attributes */
 
-        if (attr) {
-            igraph_fixed_vectorlist_t vl;
-            IGRAPH_CHECK(igraph_fixed_vectorlist_convert(&vl, &mergeinto,
-                         actedge));
-            IGRAPH_FINALLY(igraph_fixed_vectorlist_destroy, &vl);
-
-            IGRAPH_CHECK(igraph_i_attribute_combine_edges(graph, &newgraph, &vl.v,
-                         edge_comb));
-
-            igraph_fixed_vectorlist_destroy(&vl);
-            IGRAPH_FINALLY_CLEAN(1);
-        }
-
-        IGRAPH_FINALLY_CLEAN(2);
-        igraph_destroy(graph);
-        *graph = newgraph;
-
-        if (attr) {
-            igraph_vector_destroy(&mergeinto);
-            IGRAPH_FINALLY_CLEAN(1);
-        }
-    } else if (mode == IGRAPH_TO_UNDIRECTED_MUTUAL) {
-        igraph_vector_t inadj, outadj;
-        long int i;
-        igraph_vector_t mergeinto;
-        long int actedge = 0;
-
-        if (attr) {
-            IGRAPH_VECTOR_INIT_FINALLY(&mergeinto, no_of_edges);
-            igraph_vector_fill(&mergeinto, -1);
-        }
-
-        IGRAPH_CHECK(igraph_vector_reserve(&edges, no_of_edges * 2));
-        IGRAPH_VECTOR_INIT_FINALLY(&inadj, 0);
-        IGRAPH_VECTOR_INIT_FINALLY(&outadj, 0);
-
-        for (i = 0; i < no_of_nodes; i++) {
-            long int n_out, n_in;
-            long int p1 = -1, p2 = -1;
-            long int e1 = 0, e2 = 0, n1 = 0, n2 = 0;
-            IGRAPH_CHECK(igraph_incident(graph, &outadj, (igraph_integer_t) i,
-                                         IGRAPH_OUT));
-            IGRAPH_CHECK(igraph_incident(graph, &inadj,  (igraph_integer_t) i,
-                                         IGRAPH_IN));
-            n_out = igraph_vector_size(&outadj);
-            n_in = igraph_vector_size(&inadj);
-
-#define STEPOUT() if ( (++p1) < n_out) {    \
-        e1 = (long int) VECTOR(outadj)[p1]; \
-        n1 = IGRAPH_TO(graph, e1);      \
-    }
-#define STEPIN()  if ( (++p2) < n_in) {         \
-        e2 = (long int) VECTOR(inadj )[p2]; \
-        n2 = IGRAPH_FROM(graph, e2);        \
-    }
-
-            STEPOUT();
-            STEPIN();
-
-            while (p1 < n_out && n1 <= i && p2 < n_in && n2 <= i) {
-                if (n1 == n2) {
-                    IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
-                    IGRAPH_CHECK(igraph_vector_push_back(&edges, n1));
-                    if (attr) {
-                        VECTOR(mergeinto)[e1] = actedge;
-                        VECTOR(mergeinto)[e2] = actedge;
-                        actedge++;
-                    }
-                    STEPOUT();
-                    STEPIN();
-                } else if (n1 < n2) {
-                    STEPOUT();
-                } else { /* n2<n1 */
-                    STEPIN();
-                }
-            }
-        }
-
-#undef STEPOUT
-#undef STEPIN
-
-        igraph_vector_destroy(&outadj);
-        igraph_vector_destroy(&inadj);
-        IGRAPH_FINALLY_CLEAN(2);
-
-        IGRAPH_CHECK(igraph_create(&newgraph, &edges,
-                                   (igraph_integer_t) no_of_nodes,
-                                   IGRAPH_UNDIRECTED));
-        IGRAPH_FINALLY(igraph_destroy, &newgraph);
-        igraph_vector_destroy(&edges);
         IGRAPH_I_ATTRIBUTE_DESTROY(&newgraph);
         IGRAPH_I_ATTRIBUTE_COPY(&newgraph, graph, 1, 1, 0); /* no edge attributes */
 
         if (attr) {
             igraph_fixed_vectorlist_t vl;
             IGRAPH_CHECK(igraph_fixed_vectorlist_convert(&vl, &mergeinto,
-                         actedge));
+                         igraph_ecount(&newgraph)));
             IGRAPH_FINALLY(igraph_fixed_vectorlist_destroy, &vl);
 
             IGRAPH_CHECK(igraph_i_attribute_combine_edges(graph, &newgraph, &vl.v,
                          edge_comb));
 
             igraph_fixed_vectorlist_destroy(&vl);
-            IGRAPH_FINALLY_CLEAN(1);
+            igraph_vector_destroy(&mergeinto);
+            IGRAPH_FINALLY_CLEAN(2);
         }
 
-        IGRAPH_FINALLY_CLEAN(2);
+        IGRAPH_FINALLY_CLEAN(1);
         igraph_destroy(graph);
         *graph = newgraph;
-
-        if (attr) {
-            igraph_vector_destroy(&mergeinto);
-            IGRAPH_FINALLY_CLEAN(1);
-        }
     }
 
     return 0;
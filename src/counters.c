@@ -0,0 +1,221 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include "igraph_counters.h"
+#include "igraph_counters_internal.h"
+#include "igraph_error.h"
+#include "config.h"
+
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+    #include <sys/time.h>
+#endif
+
+static const char *igraph_i_counter_names[IGRAPH_COUNTER_NUM] = {
+    "edges_scanned", "heap_operations", "search_sources",
+    "arpack_iterations", "allocated_bytes", "flow_pushes",
+    "flow_relabels", "community_moves"
+};
+
+static const char *igraph_i_timer_names[IGRAPH_TIMER_NUM] = {
+    "shortest_paths", "betweenness", "closeness", "pagerank", "arpack",
+    "maxflow", "community"
+};
+
+double igraph_i_monotonic_time(void) {
+#if defined(_WIN32)
+    return GetTickCount64() / 1000.0;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+#endif
+}
+
+#ifdef IGRAPH_COUNTERS
+
+IGRAPH_THREAD_LOCAL igraph_i_counters_state_t igraph_i_counters;
+
+void igraph_i_timer_start(igraph_timer_t timer) {
+    if (igraph_i_counters.depth[timer]++ == 0) {
+        igraph_i_counters.start[timer] = igraph_i_monotonic_time();
+    }
+}
+
+void igraph_i_timer_stop(igraph_timer_t timer) {
+    if (igraph_i_counters.depth[timer] > 0 &&
+        --igraph_i_counters.depth[timer] == 0) {
+        igraph_i_counters.values.seconds[timer] +=
+            igraph_i_monotonic_time() - igraph_i_counters.start[timer];
+        igraph_i_counters.values.calls[timer] += 1;
+    }
+}
+
+/* Called when the finally stack is unwound after an error: the timed
+   calls that were running will not return normally. */
+void igraph_i_timers_abort(void) {
+    memset(igraph_i_counters.depth, 0, sizeof(igraph_i_counters.depth));
+}
+
+#endif
+
+/**
+ * \function igraph_set_counters
+ * \brief Turns the recording of performance counters on or off.
+ *
+ * Turning the counters off does not clear them, so they can still be
+ * queried with \ref igraph_counters_get().
+ *
+ * \param enabled Whether to record the counters.
+ * \return Error code: \c IGRAPH_UNIMPLEMENTED if igraph was built
+ *    without performance counters and \p enabled is true.
+ *
+ * Time complexity: O(1).
+ */
+
+int igraph_set_counters(igraph_bool_t enabled) {
+#ifdef IGRAPH_COUNTERS
+    igraph_i_timers_abort();
+    igraph_i_counters.enabled = enabled;
+    return 0;
+#else
+    if (enabled) {
+        IGRAPH_ERROR("igraph was built without performance counters",
+                     IGRAPH_UNIMPLEMENTED);
+    }
+    return 0;
+#endif
+}
+
+/**
+ * \function igraph_counters_reset
+ * \brief Sets all performance counters to zero.
+ *
+ * Time complexity: O(1).
+ */
+
+void igraph_counters_reset(void) {
+#ifdef IGRAPH_COUNTERS
+    memset(&igraph_i_counters.values, 0, sizeof(igraph_counters_t));
+#endif
+}
+
+/**
+ * \function igraph_counters_get
+ * \brief Takes a snapshot of the performance counters.
+ *
+ * \param counters The current values of the counters are copied here.
+ *
+ * Time complexity: O(1).
+ */
+
+void igraph_counters_get(igraph_counters_t *counters) {
+#ifdef IGRAPH_COUNTERS
+    *counters = igraph_i_counters.values;
+#else
+    memset(counters, 0, sizeof(igraph_counters_t));
+#endif
+}
+
+/**
+ * \function igraph_counter_name
+ * \brief The name of a counter.
+ *
+ * \param counter The counter.
+ * \return A short lowercase name, e.g. <code>"edges_scanned"</code>,
+ *    or a null pointer if \p counter is invalid.
+ *
+ * Time complexity: O(1).
+ */
+
+const char *igraph_counter_name(igraph_counter_t counter) {
+    if ((int) counter < 0 || counter >= IGRAPH_COUNTER_NUM) {
+        return 0;
+    }
+    return igraph_i_counter_names[counter];
+}
+
+/**
+ * \function igraph_timer_name
+ * \brief The name of a timer.
+ *
+ * \param timer The timer.
+ * \return A short lowercase name, e.g. <code>"betweenness"</code>, or
+ *    a null pointer if \p timer is invalid.
+ *
+ * Time complexity: O(1).
+ */
+
+const char *igraph_timer_name(igraph_timer_t timer) {
+    if ((int) timer < 0 || timer >= IGRAPH_TIMER_NUM) {
+        return 0;
+    }
+    return igraph_i_timer_names[timer];
+}
+
+/**
+ * \function igraph_counters_write_json
+ * \brief Writes a snapshot of the performance counters in JSON format.
+ *
+ * The output is a single JSON object with two members:
+ * <code>"counters"</code> maps the name of each counter to its value,
+ * and <code>"timers"</code> maps the name of each timer to an object
+ * with the <code>"seconds"</code> and <code>"calls"</code> members.
+ *
+ * \param counters The snapshot to write, see \ref igraph_counters_get().
+ * \param outstream The stream to write to.
+ * \return Error code: \c IGRAPH_EFILE if writing fails.
+ *
+ * Time complexity: O(1).
+ */
+
+int igraph_counters_write_json(const igraph_counters_t *counters,
+                               FILE *outstream) {
+    int i, ret = 0;
+
+    ret |= fprintf(outstream, "{\"counters\": {") < 0;
+    for (i = 0; i < IGRAPH_COUNTER_NUM; i++) {
+        ret |= fprintf(outstream, "%s\"%s\": %.0f", i ? ", " : "",
+                       igraph_i_counter_names[i], counters->counts[i]) < 0;
+    }
+    ret |= fprintf(outstream, "}, \"timers\": {") < 0;
+    for (i = 0; i < IGRAPH_TIMER_NUM; i++) {
+        ret |= fprintf(outstream,
+                       "%s\"%s\": {\"seconds\": %.6f, \"calls\": %.0f}",
+                       i ? ", " : "", igraph_i_timer_names[i],
+                       counters->seconds[i], counters->calls[i]) < 0;
+    }
+    ret |= fprintf(outstream, "}}\n") < 0;
+
+    if (ret) {
+        IGRAPH_ERROR("Cannot write performance counters", IGRAPH_EFILE);
+    }
+    return 0;
+}
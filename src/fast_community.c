@@ -694,17 +694,17 @@ int igraph_community_fastgreedy(const igraph_t *graph,
     debug("Creating community list\n");
     communities.n = no_of_nodes;
     communities.no_of_communities = no_of_nodes;
-    communities.e = (igraph_i_fastgreedy_community*)calloc((size_t) no_of_nodes, sizeof(igraph_i_fastgreedy_community));
+    communities.e = igraph_Calloc(no_of_nodes, igraph_i_fastgreedy_community);
     if (communities.e == 0) {
         IGRAPH_ERROR("can't run fast greedy community detection", IGRAPH_ENOMEM);
     }
     IGRAPH_FINALLY(igraph_free, communities.e);
-    communities.heap = (igraph_i_fastgreedy_community**)calloc((size_t) no_of_nodes, sizeof(igraph_i_fastgreedy_community*));
+    communities.heap = igraph_Calloc(no_of_nodes, igraph_i_fastgreedy_community*);
     if (communities.heap == 0) {
         IGRAPH_ERROR("can't run fast greedy community detection", IGRAPH_ENOMEM);
     }
     IGRAPH_FINALLY(igraph_free, communities.heap);
-    communities.heapindex = (igraph_integer_t*)calloc((size_t)no_of_nodes, sizeof(igraph_integer_t));
+    communities.heapindex = igraph_Calloc(no_of_nodes, igraph_integer_t);
     if (communities.heapindex == 0) {
         IGRAPH_ERROR("can't run fast greedy community detection", IGRAPH_ENOMEM);
     }
@@ -718,7 +718,7 @@ int igraph_community_fastgreedy(const igraph_t *graph,
 
     /* Create list of community pairs from edges */
     debug("Allocating dq vector\n");
-    dq = (igraph_real_t*)calloc((size_t) no_of_edges, sizeof(igraph_real_t));
+    dq = igraph_Calloc(no_of_edges, igraph_real_t);
     if (dq == 0) {
         IGRAPH_ERROR("can't run fast greedy community detection", IGRAPH_ENOMEM);
     }
@@ -726,7 +726,7 @@ int igraph_community_fastgreedy(const igraph_t *graph,
     debug("Creating community pair list\n");
     IGRAPH_CHECK(igraph_eit_create(graph, igraph_ess_all(0), &edgeit));
     IGRAPH_FINALLY(igraph_eit_destroy, &edgeit);
-    pairs = (igraph_i_fastgreedy_commpair*)calloc(2 * (size_t) no_of_edges, sizeof(igraph_i_fastgreedy_commpair));
+    pairs = igraph_Calloc(2 * (size_t) no_of_edges, igraph_i_fastgreedy_commpair);
     if (pairs == 0) {
         IGRAPH_ERROR("can't run fast greedy community detection", IGRAPH_ENOMEM);
     }
@@ -36,6 +36,7 @@
 #include "igraph_math.h"
 #include "igraph_dqueue.h"
 #include "igraph_interrupt_internal.h"
+#include "igraph_counters_internal.h"
 #include "igraph_topology.h"
 #include "config.h"
 
@@ -497,10 +498,13 @@ int igraph_maxflow(const igraph_t *graph, igraph_real_t *value,
         stats = &local_stats;
     }
 
+    IGRAPH_TIMER_START(IGRAPH_TIMER_MAXFLOW);
+
     if (!igraph_is_directed(graph)) {
         IGRAPH_CHECK(igraph_i_maxflow_undirected(graph, value, flow, cut,
                      partition, partition2, source,
                      target, capacity, stats));
+        IGRAPH_TIMER_STOP(IGRAPH_TIMER_MAXFLOW);
         return 0;
     }
 
@@ -1009,6 +1013,10 @@ int igraph_maxflow(const igraph_t *graph, igraph_real_t *value,
     igraph_dqueue_long_destroy(&bfsq);
     IGRAPH_FINALLY_CLEAN(10);
 
+    IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_FLOW_PUSHES, stats->nopush);
+    IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_FLOW_RELABELS, stats->norelabel);
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_MAXFLOW);
+
     return 0;
 }
 
@@ -33,6 +33,7 @@
 #include <ctype.h>      /* isspace */
 #include <string.h>
 #include "igraph_memory.h"
+#include "igraph_hacks_internal.h"
 #include <stdarg.h>         /* va_start & co */
 
 #define GRAPHML_NAMESPACE_URI "http://graphml.graphdrawing.org/xmlns"
@@ -193,7 +194,9 @@ static void igraph_i_graphml_attribute_record_destroy(igraph_i_graphml_attribute
         }
     }
     if (rec->id != 0) {
-        igraph_Free(rec->id);
+        /* allocated by libxml2 */
+        free((char*)rec->id);
+        rec->id = 0;
     }
     if (rec->record.name != 0) {
         igraph_Free(rec->record.name);
@@ -215,13 +218,13 @@ static void igraph_i_graphml_destroy_state(struct igraph_i_graphml_parser_state*
     igraph_vector_int_destroy(&state->prev_state_stack);
 
     if (state->error_message) {
-        free(state->error_message);
+        igraph_Free(state->error_message);
     }
     if (state->data_key) {
         free(state->data_key);
     }
     if (state->data_char) {
-        free(state->data_char);
+        igraph_Free(state->data_char);
     }
 
     igraph_vector_ptr_destroy_all(&state->v_attrs);
@@ -604,7 +607,7 @@ static igraph_i_graphml_attribute_record_t* igraph_i_graphml_add_attribute_key(
             } else if (!xmlStrncmp(toXmlChar("string"), XML_ATTR_VALUE(it))) {
                 rec->type = I_GRAPHML_STRING;
                 rec->record.type = IGRAPH_ATTRIBUTE_STRING;
-                rec->default_value.as_string = strdup("");
+                rec->default_value.as_string = igraph_i_strdup("");
             } else if (!xmlStrncmp(toXmlChar("float"), XML_ATTR_VALUE(it))) {
                 rec->type = I_GRAPHML_FLOAT;
                 rec->record.type = IGRAPH_ATTRIBUTE_NUMERIC;
@@ -670,7 +673,7 @@ static igraph_i_graphml_attribute_record_t* igraph_i_graphml_add_attribute_key(
 
     /* in case of a missing attr.name attribute, use the id as the attribute name */
     if (rec->record.name == 0) {
-        rec->record.name = strdup(rec->id);
+        rec->record.name = igraph_i_strdup(rec->id);
     }
 
     /* if the attribute type is missing, throw an error */
@@ -772,7 +775,7 @@ static void igraph_i_graphml_attribute_data_setup(struct igraph_i_graphml_parser
             }
             state->data_key = xmlStrndup(XML_ATTR_VALUE(it));
             if (state->data_char) {
-                free(state->data_char);
+                igraph_Free(state->data_char);
             }
             state->data_char = 0;
             state->data_type = type;
@@ -957,9 +960,9 @@ static void igraph_i_graphml_attribute_default_value_finish(
     case IGRAPH_ATTRIBUTE_STRING:
         if (state->data_char) {
             if (graphmlrec->default_value.as_string != 0) {
-                free(graphmlrec->default_value.as_string);
+                igraph_Free(graphmlrec->default_value.as_string);
             }
-            graphmlrec->default_value.as_string = strdup(state->data_char);
+            graphmlrec->default_value.as_string = igraph_i_strdup(state->data_char);
         }
         break;
     default:
@@ -1489,7 +1492,7 @@ int igraph_write_graph_graphml(const igraph_t *graph, FILE *outstream,
     const char *eprefix = prefixattr ? "e_" : "";
 
     /* set standard C locale lest we sometimes get commas instead of dots */
-    char *saved_locale = strdup(setlocale(LC_NUMERIC, NULL));
+    char *saved_locale = igraph_i_strdup(setlocale(LC_NUMERIC, NULL));
     if (saved_locale == NULL) {
         IGRAPH_ERROR("Not enough memory", IGRAPH_ENOMEM);
     }
@@ -555,7 +555,7 @@ int igraph_i_pajek_add_numeric_attribute(igraph_trie_t *names,
     rec=igraph_Calloc(1, igraph_attribute_record_t);
     na=igraph_Calloc(1, igraph_vector_t);
     igraph_vector_init(na, count);
-    rec->name=strdup(attrname);
+    rec->name=igraph_i_strdup(attrname);
     rec->type=IGRAPH_ATTRIBUTE_NUMERIC;
     rec->value=na;
     igraph_vector_ptr_push_back(attrs, rec);
@@ -601,7 +601,7 @@ int igraph_i_pajek_add_string_attribute(igraph_trie_t *names,
     for (i=0; i<count; i++) {
       igraph_strvector_set(na, i, "");
     }
-    rec->name=strdup(attrname);
+    rec->name=igraph_i_strdup(attrname);
     rec->type=IGRAPH_ATTRIBUTE_STRING;
     rec->value=na;
     igraph_vector_ptr_push_back(attrs, rec);
@@ -723,7 +723,7 @@ int igraph_i_pajek_add_bipartite_type(igraph_i_pajek_parsedata_t *context) {
   rec=igraph_Calloc(1, igraph_attribute_record_t);
   na=igraph_Calloc(1, igraph_vector_t);
   igraph_vector_init(na, n);
-  rec->name=strdup(attrname);
+  rec->name=igraph_i_strdup(attrname);
   rec->type=IGRAPH_ATTRIBUTE_NUMERIC;
   rec->value=na;
   igraph_vector_ptr_push_back(attrs, rec);
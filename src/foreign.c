@@ -25,6 +25,7 @@
 #include "igraph_math.h"
 #include "igraph_gml_tree.h"
 #include "igraph_memory.h"
+#include "igraph_hacks_internal.h"
 #include "igraph_attributes.h"
 #include "igraph_interface.h"
 #include "igraph_interrupt_internal.h"
@@ -1200,7 +1201,7 @@ int igraph_read_graph_gml(igraph_t *graph, FILE *instream) {
                         IGRAPH_ERROR("Cannot read GML file", IGRAPH_ENOMEM);
                     }
                     IGRAPH_CHECK(igraph_vector_ptr_push_back(&vattrs, atrec));
-                    atrec->name = strdup(name);
+                    atrec->name = igraph_i_strdup(name);
                     if (type == IGRAPH_I_GML_TREE_INTEGER || type == IGRAPH_I_GML_TREE_REAL) {
                         atrec->type = IGRAPH_ATTRIBUTE_NUMERIC;
                     } else {
@@ -1264,7 +1265,7 @@ int igraph_read_graph_gml(igraph_t *graph, FILE *instream) {
                             IGRAPH_ERROR("Cannot read GML file", IGRAPH_ENOMEM);
                         }
                         IGRAPH_CHECK(igraph_vector_ptr_push_back(&eattrs, atrec));
-                        atrec->name = strdup(name);
+                        atrec->name = igraph_i_strdup(name);
                         if (type == IGRAPH_I_GML_TREE_INTEGER || type == IGRAPH_I_GML_TREE_REAL) {
                             atrec->type = IGRAPH_ATTRIBUTE_NUMERIC;
                         } else {
@@ -2801,7 +2802,7 @@ static int igraph_i_dot_escape(const char *orig, char **result) {
     }
 
     if (is_number || !need_quote) {
-        *result = strdup(orig);
+        *result = igraph_i_strdup(orig);
         if (!*result) {
             IGRAPH_ERROR("Writing DOT file failed", IGRAPH_ENOMEM);
         }
@@ -40,7 +40,7 @@ void igraph_i_glpk_interruption_hook(glp_tree *tree, void *info) {
        signals to GLPK that it should terminate the optimization and return
        with the code GLP_ESTOP.
     */
-    if (igraph_i_interruption_handler) {
+    if (IGRAPH_I_INTERRUPTION_ENABLED()) {
         if (igraph_allow_interruption(NULL) != IGRAPH_SUCCESS) {
             glp_ios_terminate(tree);
         }
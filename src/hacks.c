@@ -25,6 +25,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "igraph_hacks_internal.h"
+#include "igraph_memory.h"
 
 /* These are implementations of common C functions that may be missing from some
  * compilers; for instance, icc does not provide stpcpy so we implement it
@@ -32,11 +33,13 @@
 
 /**
  * Drop-in replacement for strdup.
- * Used only in compilers that do not have strdup or _strdup
+ * The copy is allocated with igraph_malloc(), so it can be released with
+ * igraph_free(). It is also used in place of strdup in compilers that do
+ * not have strdup or _strdup.
  */
 char* igraph_i_strdup(const char *s) {
     size_t n = strlen(s) + 1;
-    char* result = (char*)malloc(sizeof(char) * n);
+    char* result = (char*)igraph_malloc(sizeof(char) * n);
     if (result) {
         memcpy(result, s, n);
     }
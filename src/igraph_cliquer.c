@@ -12,11 +12,13 @@
 /* Call this to allow for interruption in Cliquer callback functions */
 #define CLIQUER_ALLOW_INTERRUPTION() \
     { \
-        if (igraph_i_interruption_handler) \
-            if (igraph_allow_interruption(NULL) != IGRAPH_SUCCESS) { \
-                cliquer_interrupted = 1; \
+        if (IGRAPH_I_INTERRUPTION_ENABLED()) { \
+            int igraph_i_ret = igraph_allow_interruption(NULL); \
+            if (igraph_i_ret != IGRAPH_SUCCESS) { \
+                cliquer_interrupted = igraph_i_ret == IGRAPH_CPUTIME ? IGRAPH_CPUTIME : IGRAPH_INTERRUPTED; \
                 return FALSE; \
             } \
+        } \
     }
 
 /* Interruptable Cliquer functions must be wrapped in CLIQUER_INTERRUPTABLE when called */
@@ -24,11 +26,12 @@
     { \
         cliquer_interrupted = 0; \
         x; \
-        if (cliquer_interrupted) return IGRAPH_INTERRUPTED; \
+        if (cliquer_interrupted) return cliquer_interrupted; \
     }
 
 
-/* Nonzero value signals interuption from Cliquer callback function */
+/* Nonzero value signals interuption from Cliquer callback function,
+   it holds the error code to return */
 static IGRAPH_THREAD_LOCAL int cliquer_interrupted;
 
 
@@ -107,7 +110,7 @@ static boolean collect_cliques_callback(set_t s, graph_t *g, clique_options *opt
     CLIQUER_ALLOW_INTERRUPTION();
 
     list = (igraph_vector_ptr_t *) opt->user_data;
-    clique = (igraph_vector_t *) malloc(sizeof(igraph_vector_t));
+    clique = igraph_Calloc(1, igraph_vector_t);
     igraph_vector_init(clique, set_size(s));
 
     i = -1; j = 0;
@@ -234,7 +237,7 @@ static boolean callback_callback(set_t s, graph_t *g, clique_options *opt) {
 
     cd = (struct callback_data *) opt->user_data;
 
-    clique = (igraph_vector_t *) malloc(sizeof(igraph_vector_t));
+    clique = igraph_Calloc(1, igraph_vector_t);
     igraph_vector_init(clique, set_size(s));
 
     i = -1; j = 0;
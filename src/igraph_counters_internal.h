@@ -0,0 +1,91 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef IGRAPH_COUNTERS_INTERNAL_H
+#define IGRAPH_COUNTERS_INTERNAL_H
+
+#include "config.h"
+#include "igraph_counters.h"
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+    #define __BEGIN_DECLS extern "C" {
+    #define __END_DECLS }
+#else
+    #define __BEGIN_DECLS /* empty */
+    #define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+/* Seconds elapsed since an arbitrary, fixed point in the past */
+double igraph_i_monotonic_time(void);
+
+#ifdef IGRAPH_COUNTERS
+
+typedef struct igraph_i_counters_state_t {
+    igraph_bool_t enabled;
+    igraph_counters_t values;
+    int depth[IGRAPH_TIMER_NUM];
+    double start[IGRAPH_TIMER_NUM];
+} igraph_i_counters_state_t;
+
+extern IGRAPH_THREAD_LOCAL igraph_i_counters_state_t igraph_i_counters;
+
+void igraph_i_timer_start(igraph_timer_t timer);
+void igraph_i_timer_stop(igraph_timer_t timer);
+void igraph_i_timers_abort(void);
+
+/* Counters are cheap enough to be updated from inner loops, but it is
+   better to count into a local variable and add it once per search or
+   per iteration. Timers must be stopped on every successful return
+   path; the error handler stops all running timers without recording
+   them. */
+
+#define IGRAPH_COUNTER_ADD(counter, n) \
+    do { \
+        if (igraph_i_counters.enabled) { \
+            igraph_i_counters.values.counts[(counter)] += (n); \
+        } } while (0)
+
+#define IGRAPH_TIMER_START(timer) \
+    do { \
+        if (igraph_i_counters.enabled) { igraph_i_timer_start(timer); } \
+    } while (0)
+
+#define IGRAPH_TIMER_STOP(timer) \
+    do { \
+        if (igraph_i_counters.enabled) { igraph_i_timer_stop(timer); } \
+    } while (0)
+
+#else
+
+#define IGRAPH_COUNTER_ADD(counter, n) do { (void) (n); } while (0)
+#define IGRAPH_TIMER_START(timer) do { } while (0)
+#define IGRAPH_TIMER_STOP(timer) do { } while (0)
+
+#endif
+
+__END_DECLS
+
+#endif
@@ -24,11 +24,13 @@
 #include "config.h"
 #include "igraph_error.h"
 #include "igraph_types.h"
+#include "igraph_counters_internal.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <stdarg.h>
+#include <string.h>
 
 static IGRAPH_THREAD_LOCAL igraph_error_handler_t *igraph_i_error_handler = 0;
 static IGRAPH_THREAD_LOCAL char igraph_i_errormsg_buffer[500];
@@ -175,42 +177,122 @@ igraph_set_error_handler (igraph_error_handler_t * new_handler) {
     return previous_handler;
 }
 
-IGRAPH_THREAD_LOCAL struct igraph_i_protectedPtr igraph_i_finally_stack[100];
+/* The finally stack. The first IGRAPH_I_FINALLY_INITIAL entries live in
+ * thread-local storage, so that the common case never allocates; deeper
+ * stacks move to the heap. The heap memory is taken directly from the C
+ * library and not from igraph_malloc(), because registering an object
+ * must not fail due to a memory budget, see igraph_set_memory_budget(). */
+
+#define IGRAPH_I_FINALLY_INITIAL 100
+
+typedef struct igraph_i_finally_stack_t {
+    int size;
+    int capacity;
+    struct igraph_i_protectedPtr *entries;
+    struct igraph_i_protectedPtr initial[IGRAPH_I_FINALLY_INITIAL];
+} igraph_i_finally_stack_t;
+
+static IGRAPH_THREAD_LOCAL igraph_i_finally_stack_t igraph_i_finally_stack;
+
+/* Keep the slow path out of IGRAPH_FINALLY_REAL(), so that the common case
+ * needs no stack frame */
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+static void igraph_i_finally_grow(igraph_i_finally_stack_t *stack,
+                                  void (*func)(void*), void *ptr) {
+    struct igraph_i_protectedPtr *entries;
+    int capacity = 2 * stack->capacity;
+
+    if (stack->entries == 0) {
+        /* first use in this thread */
+        entries = stack->initial;
+        capacity = IGRAPH_I_FINALLY_INITIAL;
+    } else if (stack->entries == stack->initial) {
+        entries = malloc(capacity * sizeof(struct igraph_i_protectedPtr));
+        if (entries) {
+            memcpy(entries, stack->initial,
+                   stack->size * sizeof(struct igraph_i_protectedPtr));
+        }
+    } else {
+        entries = realloc(stack->entries,
+                          capacity * sizeof(struct igraph_i_protectedPtr));
+    }
+    if (!entries) {
+        /* The object cannot be registered, and the caller has no way to
+           know about it, so continuing could leak or double free it. */
+        fprintf(stderr, "Cannot grow the finally stack beyond %d elements\n",
+                stack->capacity);
+        abort();
+    }
+    stack->entries = entries;
+    stack->capacity = capacity;
+    entries[stack->size].ptr = ptr;
+    entries[stack->size].func = func;
+    stack->size++;
+}
+
+/* Returns to the thread-local storage. This is only done when the stack
+ * is emptied by IGRAPH_FINALLY_FREE(), so that IGRAPH_FINALLY_CLEAN() stays
+ * cheap; a thread that once needed a deep stack keeps it until then. */
+static void igraph_i_finally_reset(igraph_i_finally_stack_t *stack) {
+    if (stack->entries != stack->initial) {
+        free(stack->entries);
+    }
+    stack->entries = stack->initial;
+    stack->capacity = IGRAPH_I_FINALLY_INITIAL;
+    stack->size = 0;
+}
 
 /*
  * Adds another element to the free list
  */
 
 void IGRAPH_FINALLY_REAL(void (*func)(void*), void* ptr) {
-    int no = igraph_i_finally_stack[0].all;
-    assert (no < 100);
-    assert (no >= 0);
-    igraph_i_finally_stack[no].ptr = ptr;
-    igraph_i_finally_stack[no].func = func;
-    igraph_i_finally_stack[0].all ++;
-    /* printf("--> Finally stack contains now %d elements\n", igraph_i_finally_stack[0].all); */
+    igraph_i_finally_stack_t *stack = &igraph_i_finally_stack;
+    struct igraph_i_protectedPtr *entry;
+    if (IGRAPH_UNLIKELY(stack->size >= stack->capacity)) {
+        igraph_i_finally_grow(stack, func, ptr);
+        return;
+    }
+    entry = stack->entries + stack->size++;
+    entry->ptr = ptr;
+    entry->func = func;
 }
 
 void IGRAPH_FINALLY_CLEAN(int minus) {
-    igraph_i_finally_stack[0].all -= minus;
-    if (igraph_i_finally_stack[0].all < 0) {
-        /* fprintf(stderr, "corrupt finally stack, popping %d elements when only %d left\n", minus, igraph_i_finally_stack[0].all+minus); */
-        igraph_i_finally_stack[0].all = 0;
+    igraph_i_finally_stack_t *stack = &igraph_i_finally_stack;
+    stack->size -= minus;
+    if (IGRAPH_UNLIKELY(stack->size < 0)) {
+        /* corrupt finally stack, popping more elements than there are */
+        stack->size = 0;
+    }
+}
+
+void IGRAPH_FINALLY_CLEAN_TO(int size) {
+    igraph_i_finally_stack_t *stack = &igraph_i_finally_stack;
+    if (size < stack->size) {
+        stack->size = size < 0 ? 0 : size;
     }
-    /* printf("<-- Finally stack contains now %d elements\n", igraph_i_finally_stack[0].all); */
 }
 
 void IGRAPH_FINALLY_FREE(void) {
-    int p;
-    /*   printf("[X] Finally stack will be cleaned (contained %d elements)\n", igraph_i_finally_stack[0].all);  */
-    for (p = igraph_i_finally_stack[0].all - 1; p >= 0; p--) {
-        igraph_i_finally_stack[p].func(igraph_i_finally_stack[p].ptr);
+    igraph_i_finally_stack_t *stack = &igraph_i_finally_stack;
+    /* The stack may be modified by the destructors, so entries are popped
+       one by one */
+    while (stack->size > 0) {
+        struct igraph_i_protectedPtr *entry = stack->entries + --stack->size;
+        entry->func(entry->ptr);
     }
-    igraph_i_finally_stack[0].all = 0;
+    igraph_i_finally_reset(stack);
+#ifdef IGRAPH_COUNTERS
+    /* The timed calls are being unwound, they will not stop their timers */
+    igraph_i_timers_abort();
+#endif
 }
 
 int IGRAPH_FINALLY_STACK_SIZE(void) {
-    return igraph_i_finally_stack[0].all;
+    return igraph_i_finally_stack.size;
 }
 
 static IGRAPH_THREAD_LOCAL igraph_warning_handler_t *igraph_i_warning_handler = 0;
@@ -24,26 +24,27 @@
 #include "igraph_types_internal.h"
 #include "igraph_memory.h"
 
+/* The list is built with a counting sort: the elements of all vectors
+   are stored contiguously in 'elements', grouped by vector and in
+   increasing order within each group, and the vectors themselves are
+   only views into it. So converting needs a constant number of
+   allocations, however many vectors there are, and a pass over the
+   groups reads the elements sequentially. */
+
 void igraph_fixed_vectorlist_destroy(igraph_fixed_vectorlist_t *l) {
-    long int i, n = igraph_vector_ptr_size(&l->v);
-    for (i = 0; i < n; i++) {
-        igraph_vector_t *v = VECTOR(l->v)[i];
-        if (v) {
-            igraph_vector_destroy(v);
-        }
-    }
     igraph_vector_ptr_destroy(&l->v);
     igraph_free(l->vecs);
+    igraph_vector_destroy(&l->elements);
 }
 
 int igraph_fixed_vectorlist_convert(igraph_fixed_vectorlist_t *l,
                                     const igraph_vector_t *from,
                                     long int size) {
 
-    igraph_vector_t sizes;
+    igraph_vector_t starts;
     long int i, no = igraph_vector_size(from);
 
-    l->vecs = igraph_Calloc(size, igraph_vector_t);
+    l->vecs = igraph_Calloc(size > 0 ? size : 1, igraph_vector_t);
     if (!l->vecs) {
         IGRAPH_ERROR("Cannot merge attributes for simplify",
                      IGRAPH_ENOMEM);
@@ -51,30 +52,39 @@ int igraph_fixed_vectorlist_convert(igraph_fixed_vectorlist_t *l,
     IGRAPH_FINALLY(igraph_free, l->vecs);
     IGRAPH_CHECK(igraph_vector_ptr_init(&l->v, size));
     IGRAPH_FINALLY(igraph_vector_ptr_destroy, &l->v);
-    IGRAPH_VECTOR_INIT_FINALLY(&sizes, size);
+    IGRAPH_VECTOR_INIT_FINALLY(&starts, size + 1);
 
     for (i = 0; i < no; i++) {
         long int to = (long int) VECTOR(*from)[i];
         if (to >= 0) {
-            VECTOR(sizes)[to] += 1;
+            VECTOR(starts)[to + 1] += 1;
         }
     }
     for (i = 0; i < size; i++) {
-        igraph_vector_t *v = &(l->vecs[i]);
-        IGRAPH_CHECK(igraph_vector_init(v, (long int) VECTOR(sizes)[i]));
-        igraph_vector_clear(v);
-        VECTOR(l->v)[i] = v;
+        VECTOR(starts)[i + 1] += VECTOR(starts)[i];
     }
+
+    IGRAPH_VECTOR_INIT_FINALLY(&l->elements, (long int) VECTOR(starts)[size]);
     for (i = 0; i < no; i++) {
         long int to = (long int) VECTOR(*from)[i];
         if (to >= 0) {
-            igraph_vector_t *v = &(l->vecs[to]);
-            igraph_vector_push_back(v, i);
+            long int pos = (long int) VECTOR(starts)[to];
+            VECTOR(l->elements)[pos] = i;
+            VECTOR(starts)[to] += 1;
         }
     }
 
-    igraph_vector_destroy(&sizes);
-    IGRAPH_FINALLY_CLEAN(3);
+    /* Now starts[i] is the end of group i, i.e. the start of group i+1 */
+    for (i = 0; i < size; i++) {
+        long int begin = i == 0 ? 0 : (long int) VECTOR(starts)[i - 1];
+        long int end = (long int) VECTOR(starts)[i];
+        igraph_vector_view(&(l->vecs[i]), VECTOR(l->elements) + begin,
+                           end - begin);
+        VECTOR(l->v)[i] = &(l->vecs[i]);
+    }
+
+    igraph_vector_destroy(&starts);
+    IGRAPH_FINALLY_CLEAN(4);
 
     return 0;
 }
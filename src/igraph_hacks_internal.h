@@ -38,9 +38,10 @@
 
 __BEGIN_DECLS
 
+char* igraph_i_strdup(const char *s);
+
 #ifndef HAVE_STRDUP
     #define strdup igraph_i_strdup
-    char* igraph_i_strdup(const char *s);
 #endif
 
 #ifndef HAVE_STPCPY
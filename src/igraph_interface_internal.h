@@ -0,0 +1,78 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef IGRAPH_INTERFACE_INTERNAL_H
+#define IGRAPH_INTERFACE_INTERNAL_H
+
+#include "igraph_decls.h"
+#include "igraph_constants.h"
+#include "igraph_datatype.h"
+#include "igraph_types.h"
+#include "igraph_vector_ptr.h"
+
+__BEGIN_DECLS
+
+/* -------------------------------------------------- */
+/* Functions that build graphs from the indexed edge  */
+/* list of another graph directly                     */
+/* -------------------------------------------------- */
+
+int igraph_i_simplify_multiple(const igraph_t *graph, igraph_t *res,
+                               igraph_bool_t loops,
+                               igraph_vector_t *mergeinto);
+int igraph_i_create_induced_subgraph(const igraph_t *graph, igraph_t *res,
+                                     const igraph_vector_t *vids,
+                                     const igraph_vector_t *old2new,
+                                     igraph_vector_t *eids);
+int igraph_i_to_undirected_sorted(const igraph_t *graph, igraph_t *res,
+                                  igraph_bool_t mutual,
+                                  igraph_vector_t *mergeinto);
+int igraph_i_to_directed_sorted(const igraph_t *graph, igraph_t *res,
+                                igraph_bool_t mutual);
+int igraph_i_csr_nnz(igraph_bool_t directed, igraph_neimode_t mode,
+                     long int no_of_edges, long int no_of_loops,
+                     long int *nnz);
+int igraph_i_get_csr(const igraph_t *graph, igraph_vector_int_t *offsets,
+                     igraph_vector_int_t *indices,
+                     const igraph_vector_t *weights, igraph_vector_t *values,
+                     igraph_neimode_t mode, long int nnz);
+int igraph_i_create_csr_sorted(igraph_t *res,
+                               const igraph_vector_int_t *offsets,
+                               const igraph_vector_int_t *indices,
+                               igraph_bool_t directed,
+                               igraph_neimode_t mode);
+
+typedef enum { IGRAPH_I_MERGE_UNION = 0,
+               IGRAPH_I_MERGE_INTERSECTION,
+               IGRAPH_I_MERGE_DIFFERENCE
+             } igraph_i_merge_mode_t;
+
+int igraph_i_merge_sorted(igraph_t *res, const igraph_vector_ptr_t *graphs,
+                          igraph_integer_t no_of_nodes,
+                          igraph_bool_t directed, igraph_i_merge_mode_t mode,
+                          igraph_bool_t desc_vertices,
+                          igraph_bool_t desc_neighbors,
+                          igraph_vector_ptr_t *edgemaps);
+
+__END_DECLS
+
+#endif
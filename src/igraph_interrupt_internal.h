@@ -41,6 +41,11 @@ __BEGIN_DECLS
 
 extern IGRAPH_THREAD_LOCAL igraph_interruption_handler_t
 *igraph_i_interruption_handler;
+extern IGRAPH_THREAD_LOCAL igraph_cancellation_t *igraph_i_cancellation;
+
+/* Nonzero if interruption checkpoints need to call igraph_allow_interruption() */
+#define IGRAPH_I_INTERRUPTION_ENABLED() \
+    (igraph_i_interruption_handler || igraph_i_cancellation)
 
 /**
  * \define IGRAPH_ALLOW_INTERRUPTION
@@ -50,17 +55,33 @@ extern IGRAPH_THREAD_LOCAL igraph_interruption_handler_t
  * \ref igraph_allow_interruption() with the proper parameters and if that returns
  * anything but \c IGRAPH_SUCCESS then
  * the macro returns the "calling" function as well, with the proper
- * error code (\c IGRAPH_INTERRUPTED).
+ * error code (\c IGRAPH_INTERRUPTED, or \c IGRAPH_CPUTIME if the
+ * deadline of the current cancellation context has passed).
  */
 
 #define IGRAPH_ALLOW_INTERRUPTION() \
     do { \
-        if (igraph_i_interruption_handler) { if (igraph_allow_interruption(NULL) != IGRAPH_SUCCESS) return IGRAPH_INTERRUPTED; \
+        if (IGRAPH_I_INTERRUPTION_ENABLED()) { \
+            int igraph_i_ret = igraph_allow_interruption(NULL); \
+            if (igraph_i_ret != IGRAPH_SUCCESS) { \
+                return igraph_i_ret == IGRAPH_CPUTIME ? IGRAPH_CPUTIME : IGRAPH_INTERRUPTED; \
+            } \
+        } } while (0)
+
+/* Like IGRAPH_ALLOW_INTERRUPTION(), but only checks on every 'period'-th
+   call, using 'counter' (an int lvalue) to keep track. Use it in tight
+   loops and deep recursions where a check per iteration would be too
+   costly even with the cheap path above. */
+#define IGRAPH_ALLOW_INTERRUPTION_LIMITED(counter, period) \
+    do { \
+        if (++(counter) >= (period)) { \
+            (counter) = 0; \
+            IGRAPH_ALLOW_INTERRUPTION(); \
         } } while (0)
 
 #define IGRAPH_ALLOW_INTERRUPTION_NORETURN() \
     do { \
-        if (igraph_i_interruption_handler) { igraph_allow_interruption(NULL); } \
+        if (IGRAPH_I_INTERRUPTION_ENABLED()) { igraph_allow_interruption(NULL); } \
     } while (0)
 
 __END_DECLS
@@ -0,0 +1,39 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef IGRAPH_LAYOUT_INTERNAL_H
+#define IGRAPH_LAYOUT_INTERNAL_H
+
+#include "igraph_decls.h"
+#include "igraph_datatype.h"
+#include "igraph_matrix.h"
+#include "igraph_types.h"
+
+__BEGIN_DECLS
+
+int igraph_i_layout_sugiyama_crossings(const igraph_t *graph,
+                                       const igraph_matrix_t *layout,
+                                       igraph_real_t *crossings);
+
+__END_DECLS
+
+#endif
@@ -24,6 +24,7 @@
 #include "igraph_types.h"
 #include "igraph_strvector.h"
 #include "igraph_memory.h"
+#include "igraph_hacks_internal.h"
 #include "igraph_error.h"
 #include "config.h"
 
@@ -40,11 +41,42 @@
  * igraph_cattribute_list(). Do not expect great performance from this
  * type.</para>
  *
+ * <para>Empty strings do not allocate memory: all of them share the
+ * same empty buffer. Therefore creating or extending a string vector
+ * by empty elements is cheap, and the strings returned by
+ * \ref igraph_strvector_get() must not be modified.</para>
+ *
  * <para>
  * \example examples/simple/igraph_strvector.c
  * </para>
  */
 
+/* The buffer shared by all empty strings. It is writable only because
+   igraph_strvector_get() gives out non-const pointers. */
+static char igraph_i_strvector_empty[1] = { '\0' };
+
+#define IGRAPH_I_STRVECTOR_FREE(str) \
+    do { \
+        if ((str) != 0 && (str) != igraph_i_strvector_empty) { \
+            igraph_Free(str); \
+        } \
+        (str) = 0; \
+    } while (0)
+
+/* Copies a string, unless it is empty */
+static char *igraph_i_strvector_dup(const char *str, size_t len) {
+    char *res;
+    if (len == 0) {
+        return igraph_i_strvector_empty;
+    }
+    res = igraph_Calloc(len + 1, char);
+    if (res) {
+        memcpy(res, str, len * sizeof(char));
+        res[len] = '\0';
+    }
+    return res;
+}
+
 /**
  * \ingroup strvector
  * \function igraph_strvector_init
@@ -62,17 +94,12 @@
 
 int igraph_strvector_init(igraph_strvector_t *sv, long int len) {
     long int i;
-    sv->data = igraph_Calloc(len, char*);
+    sv->data = igraph_Calloc(len > 0 ? len : 1, char*);
     if (sv->data == 0) {
         IGRAPH_ERROR("strvector init failed", IGRAPH_ENOMEM);
     }
     for (i = 0; i < len; i++) {
-        sv->data[i] = igraph_Calloc(1, char);
-        if (sv->data[i] == 0) {
-            igraph_strvector_destroy(sv);
-            IGRAPH_ERROR("strvector init failed", IGRAPH_ENOMEM);
-        }
-        sv->data[i][0] = '\0';
+        sv->data[i] = igraph_i_strvector_empty;
     }
     sv->len = len;
 
@@ -97,9 +124,7 @@ void igraph_strvector_destroy(igraph_strvector_t *sv) {
     assert(sv != 0);
     if (sv->data != 0) {
         for (i = 0; i < sv->len; i++) {
-            if (sv->data[i] != 0) {
-                igraph_Free(sv->data[i]);
-            }
+            IGRAPH_I_STRVECTOR_FREE(sv->data[i]);
         }
         igraph_Free(sv->data);
     }
@@ -148,21 +173,7 @@ int igraph_strvector_set(igraph_strvector_t *sv, long int idx,
                          const char *value) {
     assert(sv != 0);
     assert(sv->data != 0);
-    if (sv->data[idx] == 0) {
-        sv->data[idx] = igraph_Calloc(strlen(value) + 1, char);
-        if (sv->data[idx] == 0) {
-            IGRAPH_ERROR("strvector set failed", IGRAPH_ENOMEM);
-        }
-    } else {
-        char *tmp = igraph_Realloc(sv->data[idx], strlen(value) + 1, char);
-        if (tmp == 0) {
-            IGRAPH_ERROR("strvector set failed", IGRAPH_ENOMEM);
-        }
-        sv->data[idx] = tmp;
-    }
-    strcpy(sv->data[idx], value);
-
-    return 0;
+    return igraph_strvector_set2(sv, idx, value, (int) strlen(value));
 }
 
 /**
@@ -185,9 +196,15 @@ int igraph_strvector_set2(igraph_strvector_t *sv, long int idx,
                           const char *value, int len) {
     assert(sv != 0);
     assert(sv->data != 0);
-    if (sv->data[idx] == 0) {
+    if (len == 0) {
+        IGRAPH_I_STRVECTOR_FREE(sv->data[idx]);
+        sv->data[idx] = igraph_i_strvector_empty;
+        return 0;
+    }
+    if (sv->data[idx] == 0 || sv->data[idx] == igraph_i_strvector_empty) {
         sv->data[idx] = igraph_Calloc(len + 1, char);
         if (sv->data[idx] == 0) {
+            sv->data[idx] = igraph_i_strvector_empty;
             IGRAPH_ERROR("strvector set failed", IGRAPH_ENOMEM);
         }
     } else {
@@ -219,9 +236,7 @@ void igraph_strvector_remove_section(igraph_strvector_t *v, long int from,
     assert(v->data != 0);
 
     for (i = from; i < to; i++) {
-        if (v->data[i] != 0) {
-            igraph_Free(v->data[i]);
-        }
+        IGRAPH_I_STRVECTOR_FREE(v->data[i]);
     }
     for (i = 0; i < v->len - to; i++) {
         v->data[from + i] = v->data[to + i];
@@ -266,15 +281,12 @@ void igraph_strvector_move_interval(igraph_strvector_t *v, long int begin,
     assert(v != 0);
     assert(v->data != 0);
     for (i = to; i < to + end - begin; i++) {
-        if (v->data[i] != 0) {
-            igraph_Free(v->data[i]);
-        }
+        IGRAPH_I_STRVECTOR_FREE(v->data[i]);
     }
     for (i = 0; i < end - begin; i++) {
         if (v->data[begin + i] != 0) {
-            size_t len = strlen(v->data[begin + i]) + 1;
-            v->data[to + i] = igraph_Calloc(len, char);
-            memcpy(v->data[to + i], v->data[begin + i], sizeof(char)*len);
+            v->data[to + i] = igraph_i_strvector_dup(v->data[begin + i],
+                              strlen(v->data[begin + i]));
         }
     }
 }
@@ -298,19 +310,18 @@ int igraph_strvector_copy(igraph_strvector_t *to,
     char *str;
     assert(from != 0);
     /*   assert(from->data != 0); */
-    to->data = igraph_Calloc(from->len, char*);
+    to->data = igraph_Calloc(from->len > 0 ? from->len : 1, char*);
     if (to->data == 0) {
         IGRAPH_ERROR("Cannot copy string vector", IGRAPH_ENOMEM);
     }
     to->len = from->len;
 
     for (i = 0; i < from->len; i++) {
-        int ret;
         igraph_strvector_get(from, i, &str);
-        ret = igraph_strvector_set(to, i, str);
-        if (ret != 0) {
+        to->data[i] = igraph_i_strvector_dup(str, strlen(str));
+        if (to->data[i] == 0) {
             igraph_strvector_destroy(to);
-            IGRAPH_ERROR("cannot copy string vector", ret);
+            IGRAPH_ERROR("cannot copy string vector", IGRAPH_ENOMEM);
         }
     }
 
@@ -338,9 +349,9 @@ int igraph_strvector_append(igraph_strvector_t *to,
     IGRAPH_CHECK(igraph_strvector_resize(to, len1 + len2));
     for (i = 0; i < len2; i++) {
         if (from->data[i][0] != '\0') {
-            igraph_Free(to->data[len1 + i]);
-            to->data[len1 + i] = strdup(from->data[i]);
+            to->data[len1 + i] = igraph_i_strdup(from->data[i]);
             if (!to->data[len1 + i]) {
+                to->data[len1 + i] = igraph_i_strvector_empty;
                 error = 1;
                 break;
             }
@@ -369,7 +380,7 @@ void igraph_strvector_clear(igraph_strvector_t *sv) {
     char **tmp;
 
     for (i = 0; i < n; i++) {
-        igraph_Free(sv->data[i]);
+        IGRAPH_I_STRVECTOR_FREE(sv->data[i]);
     }
     sv->len = 0;
     /* try to give back some memory */
@@ -396,7 +407,7 @@ void igraph_strvector_clear(igraph_strvector_t *sv) {
  */
 
 int igraph_strvector_resize(igraph_strvector_t* v, long int newsize) {
-    long int toadd = newsize - v->len, i, j;
+    long int i;
     char **tmp;
     long int reallocsize = newsize;
     if (reallocsize == 0) {
@@ -405,46 +416,24 @@ int igraph_strvector_resize(igraph_strvector_t* v, long int newsize) {
 
     assert(v != 0);
     assert(v->data != 0);
-    /*   printf("resize %li to %li\n", v->len, newsize); */
     if (newsize < v->len) {
         for (i = newsize; i < v->len; i++) {
-            igraph_Free(v->data[i]);
+            IGRAPH_I_STRVECTOR_FREE(v->data[i]);
         }
         /* try to give back some space */
         tmp = igraph_Realloc(v->data, (size_t) reallocsize, char*);
-        /*     printf("resize %li to %li, %p\n", v->len, newsize, tmp); */
         if (tmp != 0) {
             v->data = tmp;
         }
     } else if (newsize > v->len) {
-        igraph_bool_t error = 0;
         tmp = igraph_Realloc(v->data, (size_t) reallocsize, char*);
         if (tmp == 0) {
             IGRAPH_ERROR("cannot resize string vector", IGRAPH_ENOMEM);
         }
         v->data = tmp;
 
-        for (i = 0; i < toadd; i++) {
-            v->data[v->len + i] = igraph_Calloc(1, char);
-            if (v->data[v->len + i] == 0) {
-                error = 1;
-                break;
-            }
-            v->data[v->len + i][0] = '\0';
-        }
-        if (error) {
-            /* There was an error, free everything we've allocated so far */
-            for (j = 0; j < i; j++) {
-                if (v->data[v->len + i] != 0) {
-                    igraph_Free(v->data[v->len + i]);
-                }
-            }
-            /* Try to give back space */
-            tmp = igraph_Realloc(v->data, (size_t) (v->len), char*);
-            if (tmp != 0) {
-                v->data = tmp;
-            }
-            IGRAPH_ERROR("Cannot resize string vector", IGRAPH_ENOMEM);
+        for (i = v->len; i < newsize; i++) {
+            v->data[i] = igraph_i_strvector_empty;
         }
     }
     v->len = newsize;
@@ -492,11 +481,10 @@ int igraph_strvector_add(igraph_strvector_t *v, const char *value) {
         IGRAPH_ERROR("cannot add string to string vector", IGRAPH_ENOMEM);
     }
     v->data = tmp;
-    v->data[s] = igraph_Calloc(strlen(value) + 1, char);
+    v->data[s] = igraph_i_strvector_dup(value, strlen(value));
     if (v->data[s] == 0) {
         IGRAPH_ERROR("cannot add string to string vector", IGRAPH_ENOMEM);
     }
-    strcpy(v->data[s], value);
     v->len += 1;
 
     return 0;
@@ -519,7 +507,7 @@ void igraph_strvector_permdelete(igraph_strvector_t *v, const igraph_vector_t *i
         if (VECTOR(*index)[i] != 0) {
             v->data[ (long int) VECTOR(*index)[i] - 1 ] = v->data[i];
         } else {
-            igraph_Free(v->data[i]);
+            IGRAPH_I_STRVECTOR_FREE(v->data[i]);
         }
     }
     /* Try to make it shorter */
@@ -547,7 +535,7 @@ void igraph_strvector_remove_negidx(igraph_strvector_t *v, const igraph_vector_t
         if (VECTOR(*neg)[i] >= 0) {
             v->data[idx++] = v->data[i];
         } else {
-            igraph_Free(v->data[i]);
+            IGRAPH_I_STRVECTOR_FREE(v->data[i]);
         }
     }
     /* Try to give back some memory */
@@ -584,8 +572,67 @@ int igraph_strvector_index(const igraph_strvector_t *v,
         long int j = (long int) VECTOR(*idx)[i];
         char *str;
         igraph_strvector_get(v, j, &str);
-        igraph_strvector_set(newv, i, str);
+        IGRAPH_CHECK(igraph_strvector_set(newv, i, str));
     }
 
     return 0;
 }
+
+/* The same as igraph_strvector_index(), but the result replaces the
+   contents of v. Each string is moved to its first position in the
+   result and only copied if it occurs more than once, so permuting or
+   selecting elements does not copy any strings. */
+
+int igraph_i_strvector_index_move(igraph_strvector_t *v,
+                                  const igraph_vector_t *idx) {
+
+    long int i, n = v->len, newlen = igraph_vector_size(idx);
+    char **newdata;
+    igraph_vector_bool_t moved;
+
+    newdata = igraph_Calloc(newlen > 0 ? newlen : 1, char*);
+    if (!newdata) {
+        IGRAPH_ERROR("Cannot index string vector", IGRAPH_ENOMEM);
+    }
+    IGRAPH_FINALLY(igraph_free, newdata);
+    IGRAPH_CHECK(igraph_vector_bool_init(&moved, n));
+    IGRAPH_FINALLY(igraph_vector_bool_destroy, &moved);
+
+    for (i = 0; i < newlen; i++) {
+        long int j = (long int) VECTOR(*idx)[i];
+        if (!VECTOR(moved)[j]) {
+            newdata[i] = v->data[j];
+            VECTOR(moved)[j] = 1;
+        } else {
+            newdata[i] = igraph_i_strvector_dup(v->data[j],
+                                                strlen(v->data[j]));
+            if (!newdata[i]) {
+                /* Undo: move the strings back and free the copies */
+                for (i--; i >= 0; i--) {
+                    j = (long int) VECTOR(*idx)[i];
+                    if (VECTOR(moved)[j] && newdata[i] == v->data[j]) {
+                        VECTOR(moved)[j] = 0;
+                    } else {
+                        IGRAPH_I_STRVECTOR_FREE(newdata[i]);
+                    }
+                }
+                IGRAPH_ERROR("Cannot index string vector", IGRAPH_ENOMEM);
+            }
+        }
+    }
+
+    for (i = 0; i < n; i++) {
+        if (!VECTOR(moved)[i]) {
+            IGRAPH_I_STRVECTOR_FREE(v->data[i]);
+        }
+    }
+
+    igraph_vector_bool_destroy(&moved);
+    IGRAPH_FINALLY_CLEAN(2);
+
+    igraph_Free(v->data);
+    v->data = newdata;
+    v->len = newlen;
+
+    return 0;
+}
@@ -24,6 +24,7 @@
 #include "igraph_types.h"
 #include "igraph_types_internal.h"
 #include "igraph_memory.h"
+#include "igraph_hacks_internal.h"
 #include "igraph_random.h"
 #include "igraph_error.h"
 #include "config.h"
@@ -209,7 +210,7 @@ int igraph_trie_get_node(igraph_trie_node_t *t, const char *key,
             VECTOR(node->children)[0] = VECTOR(t->children)[i];
             VECTOR(node->values)[0] = VECTOR(t->values)[i];
 
-            str2 = strdup(str);
+            str2 = igraph_i_strdup(str);
             if (str2 == 0) {
                 IGRAPH_ERROR("cannot add to trie", IGRAPH_ENOMEM);
             }
@@ -245,7 +246,7 @@ int igraph_trie_get_node(igraph_trie_node_t *t, const char *key,
             VECTOR(node->values)[0] = VECTOR(t->values)[i];
             VECTOR(node->values)[1] = newvalue;
 
-            str2 = strdup(str);
+            str2 = igraph_i_strdup(str);
             if (str2 == 0) {
                 IGRAPH_ERROR("cannot add to trie", IGRAPH_ENOMEM);
             }
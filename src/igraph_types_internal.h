@@ -158,6 +158,13 @@ igraph_real_t igraph_2wheap_delete_max_index(igraph_2wheap_t *h, long int *idx);
 int igraph_2wheap_modify(igraph_2wheap_t *h, long int idx, igraph_real_t elem);
 int igraph_2wheap_check(igraph_2wheap_t *h);
 
+/* -------------------------------------------------- */
+/* String vector helpers                              */
+/* -------------------------------------------------- */
+
+int igraph_i_strvector_index_move(igraph_strvector_t *v,
+                                  const igraph_vector_t *idx);
+
 /**
  * Trie data type
  * \ingroup internal
@@ -194,6 +201,25 @@ void igraph_trie_idx(igraph_trie_t *t, long int idx, char **str);
 int igraph_trie_getkeys(igraph_trie_t *t, const igraph_strvector_t **strv);
 long int igraph_trie_size(igraph_trie_t *t);
 
+/* -------------------------------------------------- */
+/* Arena allocator for scratch memory                 */
+/* -------------------------------------------------- */
+
+/* Memory is handed out from large blocks and is released all at once by
+ * igraph_arena_reset() or igraph_arena_destroy(); individual allocations
+ * cannot be freed. Register igraph_arena_destroy() on the finally stack to
+ * release the scratch memory of an algorithm on errors as well. */
+
+typedef struct igraph_arena_t {
+    struct igraph_i_arena_block_t *block;
+    size_t block_size;
+} igraph_arena_t;
+
+int igraph_arena_init(igraph_arena_t *arena, size_t block_size);
+void igraph_arena_destroy(igraph_arena_t *arena);
+void igraph_arena_reset(igraph_arena_t *arena);
+void *igraph_arena_alloc(igraph_arena_t *arena, size_t size);
+
 /**
  * 2d grid containing points
  */
@@ -382,7 +408,7 @@ igraph_bool_t igraph_set_iterate (igraph_set_t* set, long int* state,
 typedef struct igraph_fixed_vectorlist_t {
     igraph_vector_t *vecs;
     igraph_vector_ptr_t v;
-    long int length;
+    igraph_vector_t elements;
 } igraph_fixed_vectorlist_t;
 
 void igraph_fixed_vectorlist_destroy(igraph_fixed_vectorlist_t *l);
@@ -172,6 +172,9 @@ int infomap_partition(FlowGraph * fgraph, bool rcall) {
             double inner_oldCodeLength = 1000;
 
             while (moved) { // main greedy optimizing loop
+                if (!rcall) {
+                    IGRAPH_ALLOW_INTERRUPTION();
+                }
                 inner_oldCodeLength = greedy->codeLength;
                 moved = greedy->optimize();
 
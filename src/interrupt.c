@@ -22,12 +22,61 @@
 */
 
 #include "igraph_interrupt.h"
+#include "igraph_interrupt_internal.h"
+#include "igraph_counters_internal.h"
 #include "config.h"
 
 IGRAPH_THREAD_LOCAL igraph_interruption_handler_t
 *igraph_i_interruption_handler = 0;
 
+IGRAPH_THREAD_LOCAL igraph_cancellation_t *igraph_i_cancellation = 0;
+
+/* The deadline of a cancellation context is only checked on every
+   'stride'-th checkpoint. The stride is doubled while the clock shows
+   that checkpoints come faster than MIN_GAP seconds apart, and halved
+   when they are more than MAX_GAP seconds apart. */
+#define IGRAPH_I_CANCELLATION_MIN_GAP 0.001
+#define IGRAPH_I_CANCELLATION_MAX_GAP 0.01
+#define IGRAPH_I_CANCELLATION_MAX_STRIDE (1 << 20)
+
+/* Returns plain error codes, like interruption handlers do, and leaves
+   reporting to the caller: this is also reached from the GLPK and
+   cliquer callbacks, where freeing the finally stack would release
+   objects the solver is still using. */
+static int igraph_i_check_cancellation(igraph_cancellation_t *c) {
+    double now, gap;
+
+    if (c->cancelled) {
+        return IGRAPH_INTERRUPTED;
+    }
+    if (c->deadline == 0 || --c->countdown > 0) {
+        return IGRAPH_SUCCESS;
+    }
+
+    now = igraph_i_monotonic_time();
+    gap = now - c->last_check;
+    if (gap < IGRAPH_I_CANCELLATION_MIN_GAP &&
+        c->stride < IGRAPH_I_CANCELLATION_MAX_STRIDE) {
+        c->stride *= 2;
+    } else if (gap > IGRAPH_I_CANCELLATION_MAX_GAP && c->stride > 1) {
+        c->stride /= 2;
+    }
+    c->countdown = c->stride;
+    c->last_check = now;
+
+    if (now >= c->deadline) {
+        return IGRAPH_CPUTIME;
+    }
+    return IGRAPH_SUCCESS;
+}
+
 int igraph_allow_interruption(void* data) {
+    if (igraph_i_cancellation) {
+        int ret = igraph_i_check_cancellation(igraph_i_cancellation);
+        if (ret != IGRAPH_SUCCESS) {
+            return ret;
+        }
+    }
     if (igraph_i_interruption_handler) {
         return igraph_i_interruption_handler(data);
     }
@@ -40,3 +89,67 @@ igraph_set_interruption_handler (igraph_interruption_handler_t * new_handler) {
     igraph_i_interruption_handler = new_handler;
     return previous_handler;
 }
+
+/**
+ * \function igraph_cancellation_init
+ * \brief Initializes a cancellation context.
+ *
+ * The context starts out in the non-cancelled state.
+ *
+ * \param cancellation The context to initialize.
+ * \param timeout The number of seconds, measured from now, after which
+ *    calculations running under this context fail with
+ *    \c IGRAPH_CPUTIME. Zero or a negative value means no deadline.
+ *
+ * Time complexity: O(1).
+ */
+
+void igraph_cancellation_init(igraph_cancellation_t *cancellation,
+                              igraph_real_t timeout) {
+    cancellation->cancelled = 0;
+    cancellation->last_check = igraph_i_monotonic_time();
+    cancellation->deadline = timeout > 0 ? cancellation->last_check + timeout : 0;
+    cancellation->stride = 1;
+    cancellation->countdown = 1;
+}
+
+/**
+ * \function igraph_cancel
+ * \brief Requests the cancellation of the calculations using a context.
+ *
+ * This function only sets a flag in the context, so it may be called
+ * from a thread other than the one running the calculation, or from a
+ * signal handler. The calculation notices the request at its next
+ * interruption checkpoint and fails with \c IGRAPH_INTERRUPTED.
+ * Cancellation cannot be undone; call \ref igraph_cancellation_init()
+ * to reuse the context.
+ *
+ * \param cancellation The context to cancel.
+ *
+ * Time complexity: O(1).
+ */
+
+void igraph_cancel(igraph_cancellation_t *cancellation) {
+    cancellation->cancelled = 1;
+}
+
+/**
+ * \function igraph_set_cancellation
+ * \brief Installs a cancellation context for the current thread.
+ *
+ * The context must stay valid as long as it is installed. Calculations
+ * started in other threads are not affected, those threads need to
+ * install their own context, which may be the same object.
+ *
+ * \param cancellation The context to install, or a null pointer to
+ *    remove the current one.
+ * \return The previously installed context, or a null pointer.
+ *
+ * Time complexity: O(1).
+ */
+
+igraph_cancellation_t *igraph_set_cancellation(igraph_cancellation_t *cancellation) {
+    igraph_cancellation_t *previous = igraph_i_cancellation;
+    igraph_i_cancellation = cancellation;
+    return previous;
+}
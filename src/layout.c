@@ -41,6 +41,8 @@
 #include "igraph_blas.h"
 #include "igraph_centrality.h"
 #include "igraph_eigen.h"
+#include "igraph_constructors.h"
+#include "igraph_qsort.h"
 #include "config.h"
 #include <math.h>
 #include "igraph_math.h"
@@ -719,14 +721,15 @@ static int igraph_i_layout_reingold_tilford_unreachable(
 
     /* start from real_root and go BFS */
     IGRAPH_CHECK(igraph_dqueue_push(&q, real_root));
+    VECTOR(visited)[real_root] = 1;
     while (!igraph_dqueue_empty(&q)) {
         long int actnode = (long int) igraph_dqueue_pop(&q);
         neis = igraph_adjlist_get(&allneis, actnode);
         n = igraph_vector_int_size(neis);
-        VECTOR(visited)[actnode] = 1;
         for (j = 0; j < n; j++) {
             long int neighbor = (long int) VECTOR(*neis)[j];
             if (!(long int)VECTOR(visited)[neighbor]) {
+                VECTOR(visited)[neighbor] = 1;
                 IGRAPH_CHECK(igraph_dqueue_push(&q, neighbor));
             }
         }
@@ -781,11 +784,9 @@ struct igraph_i_reingold_tilford_vertex {
     igraph_real_t offset_to_right_extreme;  /* X offset when jumping to the right extreme node */
 };
 
-static int igraph_i_layout_reingold_tilford_postorder(struct igraph_i_reingold_tilford_vertex *vdata,
-                                                      long int node, long int vcount);
-static int igraph_i_layout_reingold_tilford_calc_coords(struct igraph_i_reingold_tilford_vertex *vdata,
-                                                        igraph_matrix_t *res, long int node,
-                                                        long int vcount, igraph_real_t xpos);
+static void igraph_i_layout_reingold_tilford_postorder(struct igraph_i_reingold_tilford_vertex *vdata,
+                                                       long int node, const long int *children,
+                                                       long int childcount);
 
 /* uncomment the next line for debugging the Reingold-Tilford layout */
 /* #define LAYOUT_RT_DEBUG 1 */
@@ -795,14 +796,21 @@ static int igraph_i_layout_reingold_tilford(const igraph_t *graph,
                                             igraph_neimode_t mode,
                                             long int root) {
     long int no_of_nodes = igraph_vcount(graph);
-    long int i, n, j;
+    long int i, n, j, no_reached;
     igraph_dqueue_t q = IGRAPH_DQUEUE_NULL;
     igraph_adjlist_t allneis;
     igraph_vector_int_t *neis;
+    igraph_vector_long_t order, child_start, children;
     struct igraph_i_reingold_tilford_vertex *vdata;
 
     IGRAPH_CHECK(igraph_matrix_resize(res, no_of_nodes, 2));
     IGRAPH_DQUEUE_INIT_FINALLY(&q, 100);
+    IGRAPH_CHECK(igraph_vector_long_init(&order, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &order);
+    IGRAPH_CHECK(igraph_vector_long_init(&child_start, no_of_nodes + 1));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &child_start);
+    IGRAPH_CHECK(igraph_vector_long_init(&children, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &children);
 
     IGRAPH_CHECK(igraph_adjlist_init(graph, &allneis, mode));
     IGRAPH_FINALLY(igraph_adjlist_destroy, &allneis);
@@ -836,6 +844,7 @@ static int igraph_i_layout_reingold_tilford(const igraph_t *graph,
     while (!igraph_dqueue_empty(&q)) {
         long int actnode = (long int) igraph_dqueue_pop(&q);
         long int actdist = (long int) igraph_dqueue_pop(&q);
+        IGRAPH_CHECK(igraph_vector_long_push_back(&order, actnode));
         neis = igraph_adjlist_get(&allneis, actnode);
         n = igraph_vector_int_size(neis);
 
@@ -852,17 +861,55 @@ static int igraph_i_layout_reingold_tilford(const igraph_t *graph,
         }
     }
 
-    /* Step 2: postorder tree traversal, determines the appropriate X
-     * offsets for every node */
-    igraph_i_layout_reingold_tilford_postorder(vdata, root, no_of_nodes);
-
-    /* Step 3: calculate real coordinates based on X offsets */
-    igraph_i_layout_reingold_tilford_calc_coords(vdata, res, root, no_of_nodes, vdata[root].offset);
+    /* Collect the children of every node, in increasing order of their
+     * vertex IDs; this is the order in which the subtrees are placed */
+    for (i = 0; i < no_of_nodes; i++) {
+        if (i != root && vdata[i].parent >= 0) {
+            VECTOR(child_start)[vdata[i].parent + 1] += 1;
+        }
+    }
+    for (i = 0; i < no_of_nodes; i++) {
+        VECTOR(child_start)[i + 1] += VECTOR(child_start)[i];
+    }
+    for (i = 0; i < no_of_nodes; i++) {
+        if (i != root && vdata[i].parent >= 0) {
+            long int parent = vdata[i].parent;
+            VECTOR(children)[VECTOR(child_start)[parent]++] = i;
+        }
+    }
+    for (i = no_of_nodes; i > 0; i--) {
+        VECTOR(child_start)[i] = VECTOR(child_start)[i - 1];
+    }
+    VECTOR(child_start)[0] = 0;
 
+    /* Step 2: postorder tree traversal, determines the appropriate X
+     * offsets for every node. Visiting the nodes in reverse BFS order
+     * ensures that all subtrees of a node are placed before the node
+     * itself, without recursion. */
+    no_reached = igraph_vector_long_size(&order);
+    for (i = no_reached - 1; i >= 0; i--) {
+        long int node = VECTOR(order)[i];
+        long int from = VECTOR(child_start)[node];
+        igraph_i_layout_reingold_tilford_postorder(vdata, node,
+                VECTOR(children) + from, VECTOR(child_start)[node + 1] - from);
+    }
+
+    /* Step 3: calculate real coordinates based on X offsets, in BFS
+     * order so that the parent of a node is always placed before it */
+    MATRIX(*res, root, 0) = vdata[root].offset;
+    for (i = 1; i < no_reached; i++) {
+        long int node = VECTOR(order)[i];
+        MATRIX(*res, node, 0) = MATRIX(*res, vdata[node].parent, 0) +
+                                vdata[node].offset;
+    }
+
+    igraph_vector_long_destroy(&children);
+    igraph_vector_long_destroy(&child_start);
+    igraph_vector_long_destroy(&order);
     igraph_dqueue_destroy(&q);
     igraph_adjlist_destroy(&allneis);
     igraph_free(vdata);
-    IGRAPH_FINALLY_CLEAN(3);
+    IGRAPH_FINALLY_CLEAN(6);
 
     IGRAPH_PROGRESS("Reingold-Tilford tree layout", 100.0, NULL);
 
@@ -887,28 +934,12 @@ static int igraph_i_layout_reingold_tilford(const igraph_t *graph,
     return 0;
 }
 
-static int igraph_i_layout_reingold_tilford_calc_coords(
-        struct igraph_i_reingold_tilford_vertex *vdata,
-        igraph_matrix_t *res, long int node,
-        long int vcount, igraph_real_t xpos) {
-    long int i;
-    MATRIX(*res, node, 0) = xpos;
-    for (i = 0; i < vcount; i++) {
-        if (i == node) {
-            continue;
-        }
-        if (vdata[i].parent == node) {
-            igraph_i_layout_reingold_tilford_calc_coords(vdata, res, i, vcount,
-                    xpos + vdata[i].offset);
-        }
-    }
-    return 0;
-}
-
-static int igraph_i_layout_reingold_tilford_postorder(
+/* Places the subtrees rooted at the children of 'node' next to each other.
+ * The subtrees of the children must have been placed already. */
+static void igraph_i_layout_reingold_tilford_postorder(
         struct igraph_i_reingold_tilford_vertex *vdata,
-        long int node, long int vcount) {
-    long int i, j, childcount, leftroot, leftrootidx;
+        long int node, const long int *children, long int childcount) {
+    long int i, j, k, leftroot, leftrootidx;
     const igraph_real_t minsep = 1;
     igraph_real_t avg;
 
@@ -917,20 +948,8 @@ static int igraph_i_layout_reingold_tilford_postorder(
 #endif
 
     /* Check whether this node is a leaf node */
-    childcount = 0;
-    for (i = 0; i < vcount; i++) {
-        if (i == node) {
-            continue;
-        }
-        if (vdata[i].parent == node) {
-            /* Node i is a child, so visit it recursively */
-            childcount++;
-            igraph_i_layout_reingold_tilford_postorder(vdata, i, vcount);
-        }
-    }
-
     if (childcount == 0) {
-        return 0;
+        return;
     }
 
     /* Here we can assume that all of the subtrees have been placed and their
@@ -946,145 +965,141 @@ static int igraph_i_layout_reingold_tilford_postorder(
 #ifdef LAYOUT_RT_DEBUG
     printf("Visited node %ld and arranged its subtrees\n", node);
 #endif
-    for (i = 0, j = 0; i < vcount; i++) {
-        if (i == node) {
-            continue;
-        }
-        if (vdata[i].parent == node) {
-            if (leftroot >= 0) {
-                /* Now we will follow the right contour of leftroot and the
-                 * left contour of the subtree rooted at i */
-                long lnode, rnode, auxnode;
-                igraph_real_t loffset, roffset, rootsep, newoffset;
+    for (k = 0, j = 0; k < childcount; k++) {
+        i = children[k];
+        if (leftroot >= 0) {
+            /* Now we will follow the right contour of leftroot and the
+             * left contour of the subtree rooted at i */
+            long lnode, rnode, auxnode;
+            igraph_real_t loffset, roffset, rootsep, newoffset;
 
 #ifdef LAYOUT_RT_DEBUG
-                printf("  Placing child %ld on level %ld, to the right of %ld\n", i, vdata[i].level, leftroot);
+            printf("  Placing child %ld on level %ld, to the right of %ld\n", i, vdata[i].level, leftroot);
 #endif
-                lnode = leftroot; rnode = i;
-                rootsep = vdata[leftroot].offset + minsep;
-                loffset = vdata[leftroot].offset; roffset = loffset + minsep;
+            lnode = leftroot; rnode = i;
+            rootsep = vdata[leftroot].offset + minsep;
+            loffset = vdata[leftroot].offset; roffset = loffset + minsep;
 
-                /* Keep on updating the right contour now that we have attached
-                 * a new node to the subtree being built */
-                vdata[node].right_contour = i;
-                vdata[node].offset_to_right_contour = rootsep;
+            /* Keep on updating the right contour now that we have attached
+             * a new node to the subtree being built */
+            vdata[node].right_contour = i;
+            vdata[node].offset_to_right_contour = rootsep;
 
 #ifdef LAYOUT_RT_DEBUG
-                printf("    Contour: [%ld, %ld], offsets: [%lf, %lf], rootsep: %lf\n",
-                       lnode, rnode, loffset, roffset, rootsep);
+            printf("    Contour: [%ld, %ld], offsets: [%lf, %lf], rootsep: %lf\n",
+                   lnode, rnode, loffset, roffset, rootsep);
 #endif
-                while ((lnode >= 0) && (rnode >= 0)) {
-                    /* Step to the next level on the right contour of the left subtree */
-                    if (vdata[lnode].right_contour >= 0) {
-                        loffset += vdata[lnode].offset_to_right_contour;
-                        lnode = vdata[lnode].right_contour;
-                    } else {
-                        /* Left subtree ended there. The left and right contour
-                         * of the left subtree will continue to the next step
-                         * on the right subtree. */
-                        if (vdata[rnode].left_contour >= 0) {
-                            auxnode = vdata[node].left_extreme;
-
-                            /* this is the "threading" step that the original
-                             * paper is talking about */
-                            newoffset = (vdata[node].offset_to_right_extreme - vdata[node].offset_to_left_extreme) + minsep + vdata[rnode].offset_to_left_contour;
-                            vdata[auxnode].left_contour = vdata[rnode].left_contour;
-                            vdata[auxnode].right_contour = vdata[rnode].left_contour;
-                            vdata[auxnode].offset_to_left_contour = vdata[auxnode].offset_to_right_contour = newoffset;
-
-                            /* since we attached a larger subtree to the
-                             * already placed left subtree, we need to update
-                             * the extrema of the subtree rooted at 'node' */
-                            vdata[node].left_extreme = vdata[i].left_extreme;
-                            vdata[node].right_extreme = vdata[i].right_extreme;
-                            vdata[node].offset_to_left_extreme = vdata[i].offset_to_left_extreme + rootsep;
-                            vdata[node].offset_to_right_extreme = vdata[i].offset_to_right_extreme + rootsep;
+            while ((lnode >= 0) && (rnode >= 0)) {
+                /* Step to the next level on the right contour of the left subtree */
+                if (vdata[lnode].right_contour >= 0) {
+                    loffset += vdata[lnode].offset_to_right_contour;
+                    lnode = vdata[lnode].right_contour;
+                } else {
+                    /* Left subtree ended there. The left and right contour
+                     * of the left subtree will continue to the next step
+                     * on the right subtree. */
+                    if (vdata[rnode].left_contour >= 0) {
+                        auxnode = vdata[node].left_extreme;
+
+                        /* this is the "threading" step that the original
+                         * paper is talking about */
+                        newoffset = (vdata[node].offset_to_right_extreme - vdata[node].offset_to_left_extreme) + minsep + vdata[rnode].offset_to_left_contour;
+                        vdata[auxnode].left_contour = vdata[rnode].left_contour;
+                        vdata[auxnode].right_contour = vdata[rnode].left_contour;
+                        vdata[auxnode].offset_to_left_contour = vdata[auxnode].offset_to_right_contour = newoffset;
+
+                        /* since we attached a larger subtree to the
+                         * already placed left subtree, we need to update
+                         * the extrema of the subtree rooted at 'node' */
+                        vdata[node].left_extreme = vdata[i].left_extreme;
+                        vdata[node].right_extreme = vdata[i].right_extreme;
+                        vdata[node].offset_to_left_extreme = vdata[i].offset_to_left_extreme + rootsep;
+                        vdata[node].offset_to_right_extreme = vdata[i].offset_to_right_extreme + rootsep;
 #ifdef LAYOUT_RT_DEBUG
-                            printf("      Left subtree ended earlier, continuing left subtree's left and right contour on right subtree (node %ld gets connected to node %ld)\n", auxnode, vdata[rnode].left_contour);
-                            printf("      New contour following offset for node %ld is %lf\n", auxnode, vdata[auxnode].offset_to_left_contour);
+                        printf("      Left subtree ended earlier, continuing left subtree's left and right contour on right subtree (node %ld gets connected to node %ld)\n", auxnode, vdata[rnode].left_contour);
+                        printf("      New contour following offset for node %ld is %lf\n", auxnode, vdata[auxnode].offset_to_left_contour);
 #endif
-                        } else {
-                            /* Both subtrees are ending at the same time; the
-                             * left extreme node of the subtree rooted at
-                             * 'node' remains the same but the right extreme
-                             * will change */
-                            vdata[node].right_extreme = vdata[i].right_extreme;
-                            vdata[node].offset_to_right_extreme = vdata[i].offset_to_right_extreme + rootsep;
-                        }
-                        lnode = -1;
-                    }
-                    /* Step to the next level on the left contour of the right subtree */
-                    if (vdata[rnode].left_contour >= 0) {
-                        roffset += vdata[rnode].offset_to_left_contour;
-                        rnode = vdata[rnode].left_contour;
                     } else {
-                        /* Right subtree ended here. The right contour of the right
-                         * subtree will continue to the next step on the left subtree.
-                         * Note that lnode has already been advanced here */
-                        if (lnode >= 0) {
-                            auxnode = vdata[i].right_extreme;
-
-                            /* this is the "threading" step that the original
-                             * paper is talking about */
-                            newoffset = loffset - rootsep - vdata[i].offset_to_right_extreme;
-                            vdata[auxnode].left_contour = lnode;
-                            vdata[auxnode].right_contour = lnode;
-                            vdata[auxnode].offset_to_left_contour = vdata[auxnode].offset_to_right_contour = newoffset;
-
-                            /* no need to update the extrema of the subtree
-                             * rooted at 'node' because the right subtree was
-                             * smaller */
+                        /* Both subtrees are ending at the same time; the
+                         * left extreme node of the subtree rooted at
+                         * 'node' remains the same but the right extreme
+                         * will change */
+                        vdata[node].right_extreme = vdata[i].right_extreme;
+                        vdata[node].offset_to_right_extreme = vdata[i].offset_to_right_extreme + rootsep;
+                    }
+                    lnode = -1;
+                }
+                /* Step to the next level on the left contour of the right subtree */
+                if (vdata[rnode].left_contour >= 0) {
+                    roffset += vdata[rnode].offset_to_left_contour;
+                    rnode = vdata[rnode].left_contour;
+                } else {
+                    /* Right subtree ended here. The right contour of the right
+                     * subtree will continue to the next step on the left subtree.
+                     * Note that lnode has already been advanced here */
+                    if (lnode >= 0) {
+                        auxnode = vdata[i].right_extreme;
+
+                        /* this is the "threading" step that the original
+                         * paper is talking about */
+                        newoffset = loffset - rootsep - vdata[i].offset_to_right_extreme;
+                        vdata[auxnode].left_contour = lnode;
+                        vdata[auxnode].right_contour = lnode;
+                        vdata[auxnode].offset_to_left_contour = vdata[auxnode].offset_to_right_contour = newoffset;
+
+                        /* no need to update the extrema of the subtree
+                         * rooted at 'node' because the right subtree was
+                         * smaller */
 #ifdef LAYOUT_RT_DEBUG
-                            printf("      Right subtree ended earlier, continuing right subtree's left and right contour on left subtree (node %ld gets connected to node %ld)\n", auxnode, lnode);
-                            printf("      New contour following offset for node %ld is %lf\n", auxnode, vdata[auxnode].offset_to_left_contour);
+                        printf("      Right subtree ended earlier, continuing right subtree's left and right contour on left subtree (node %ld gets connected to node %ld)\n", auxnode, lnode);
+                        printf("      New contour following offset for node %ld is %lf\n", auxnode, vdata[auxnode].offset_to_left_contour);
 #endif
-                        }
-                        rnode = -1;
                     }
+                    rnode = -1;
+                }
 #ifdef LAYOUT_RT_DEBUG
-                    printf("    Contour: [%ld, %ld], offsets: [%lf, %lf], rootsep: %lf\n", 
-                           lnode, rnode, loffset, roffset, rootsep);
+                printf("    Contour: [%ld, %ld], offsets: [%lf, %lf], rootsep: %lf\n", 
+                       lnode, rnode, loffset, roffset, rootsep);
 #endif
 
-                    /* Push subtrees away if necessary */
-                    if ((lnode >= 0) && (rnode >= 0) && (roffset - loffset < minsep)) {
+                /* Push subtrees away if necessary */
+                if ((lnode >= 0) && (rnode >= 0) && (roffset - loffset < minsep)) {
 #ifdef LAYOUT_RT_DEBUG
-                        printf("    Pushing right subtree away by %lf\n", minsep-roffset+loffset);
+                    printf("    Pushing right subtree away by %lf\n", minsep-roffset+loffset);
 #endif
-                        rootsep += minsep - roffset + loffset;
-                        roffset = loffset + minsep;
-                        vdata[node].offset_to_right_contour = rootsep;
-                    }
+                    rootsep += minsep - roffset + loffset;
+                    roffset = loffset + minsep;
+                    vdata[node].offset_to_right_contour = rootsep;
                 }
+            }
 
 #ifdef LAYOUT_RT_DEBUG
-                printf("  Offset of subtree with root node %ld will be %lf\n", i, rootsep);
+            printf("  Offset of subtree with root node %ld will be %lf\n", i, rootsep);
 #endif
-                vdata[i].offset = rootsep;
-                vdata[node].offset_to_right_contour = rootsep;
-                avg = (avg * j) / (j + 1) + rootsep / (j + 1);
-                leftrootidx = j;
-                leftroot = i;
-            } else {
-                /* This is the first child of the node being considered so we
-                 * can simply place the subtree on our virtual canvas */
+            vdata[i].offset = rootsep;
+            vdata[node].offset_to_right_contour = rootsep;
+            avg = (avg * j) / (j + 1) + rootsep / (j + 1);
+            leftrootidx = j;
+            leftroot = i;
+        } else {
+            /* This is the first child of the node being considered so we
+             * can simply place the subtree on our virtual canvas */
 #ifdef LAYOUT_RT_DEBUG
-                printf("  Placing child %ld on level %ld as first child\n", i, vdata[i].level);
+            printf("  Placing child %ld on level %ld as first child\n", i, vdata[i].level);
 #endif
-                leftrootidx = j;
-                leftroot = i;
-                vdata[node].left_contour = i;
-                vdata[node].right_contour = i;
-                vdata[node].offset_to_left_contour = 0.0;
-                vdata[node].offset_to_right_contour = 0.0;
-                vdata[node].left_extreme = vdata[i].left_extreme;
-                vdata[node].right_extreme = vdata[i].right_extreme;
-                vdata[node].offset_to_left_extreme = vdata[i].offset_to_left_extreme;
-                vdata[node].offset_to_right_extreme = vdata[i].offset_to_right_extreme;
-                avg = vdata[i].offset;
-            }
-            j++;
+            leftrootidx = j;
+            leftroot = i;
+            vdata[node].left_contour = i;
+            vdata[node].right_contour = i;
+            vdata[node].offset_to_left_contour = 0.0;
+            vdata[node].offset_to_right_contour = 0.0;
+            vdata[node].left_extreme = vdata[i].left_extreme;
+            vdata[node].right_extreme = vdata[i].right_extreme;
+            vdata[node].offset_to_left_extreme = vdata[i].offset_to_left_extreme;
+            vdata[node].offset_to_right_extreme = vdata[i].offset_to_right_extreme;
+            avg = vdata[i].offset;
         }
+        j++;
     }
 #ifdef LAYOUT_RT_DEBUG
     printf("Shifting node %ld to be centered above children. Shift amount: %lf\n", node, avg);
@@ -1093,16 +1108,9 @@ static int igraph_i_layout_reingold_tilford_postorder(
     vdata[node].offset_to_right_contour -= avg;
     vdata[node].offset_to_left_extreme -= avg;
     vdata[node].offset_to_right_extreme -= avg;
-    for (i = 0, j = 0; i < vcount; i++) {
-        if (i == node) {
-            continue;
-        }
-        if (vdata[i].parent == node) {
-            vdata[i].offset -= avg;
-        }
+    for (k = 0; k < childcount; k++) {
+        vdata[children[k]].offset -= avg;
     }
-
-    return 0;
 }
 
 /**
@@ -1169,12 +1177,6 @@ int igraph_layout_reingold_tilford(const igraph_t *graph,
     long int i;
     igraph_vector_t newedges;
 
-    /* TODO: possible speedup could be achieved if we use a table for storing
-     * the children of each node in the tree. (Now the implementation uses a
-     * single array containing the parent of each node and a node's children
-     * are determined by looking for other nodes that have this node as parent)
-     */
-
     /* at various steps it might be necessary to add edges to the graph */
     IGRAPH_VECTOR_INIT_FINALLY(&newedges, 0);
 
@@ -1516,13 +1518,11 @@ static int igraph_i_determine_electric_axal_forces(
         long int other_node,
         long int this_node);
 
-static int igraph_i_apply_electrical_force(
-        const igraph_matrix_t *pos,
-        igraph_vector_t *pending_forces_x,
-        igraph_vector_t *pending_forces_y,
-        long int other_node, long int this_node,
-        igraph_real_t node_charge,
-        igraph_real_t distance);
+static void igraph_i_apply_electrical_forces(
+        const igraph_real_t *xs, const igraph_real_t *ys,
+        igraph_real_t *pending_forces_x, igraph_real_t *pending_forces_y,
+        long int this_node, long int no_of_nodes,
+        igraph_real_t node_charge);
 
 static int igraph_i_determine_spring_axal_forces(
         const igraph_matrix_t *pos,
@@ -1609,28 +1609,63 @@ static int igraph_i_determine_electric_axal_forces(const igraph_matrix_t *pos,
     return 0;
 }
 
-static int igraph_i_apply_electrical_force(
-        const igraph_matrix_t *pos,
-        igraph_vector_t *pending_forces_x,
-        igraph_vector_t *pending_forces_y,
-        long int other_node, long int this_node,
-        igraph_real_t node_charge,
-        igraph_real_t distance) {
-
-    igraph_real_t directed_force = COULOMBS_CONSTANT *
-                                   ((node_charge * node_charge) / (distance * distance));
+/* Applies the electrical forces between this_node and all nodes with a
+ * larger index. This is the O(|V|^2) part of graphopt, so it works on the
+ * coordinate columns of the layout matrix and the force vectors directly,
+ * without function calls in the inner loop. The forces acting on this_node
+ * are accumulated in registers in the same order as before, hence the
+ * results are the same as those of the per-pair formulation in
+ * igraph_i_determine_electric_axal_forces(). */
+static void igraph_i_apply_electrical_forces(
+        const igraph_real_t *xs, const igraph_real_t *ys,
+        igraph_real_t *pending_forces_x, igraph_real_t *pending_forces_y,
+        long int this_node, long int no_of_nodes,
+        igraph_real_t node_charge) {
+
+    const igraph_real_t this_x = xs[this_node], this_y = ys[this_node];
+    const igraph_real_t charge2 = node_charge * node_charge;
+    igraph_real_t sum_x = pending_forces_x[this_node];
+    igraph_real_t sum_y = pending_forces_y[this_node];
+    long int other_node;
+
+    for (other_node = this_node + 1; other_node < no_of_nodes; other_node++) {
+        igraph_real_t diffx = this_x - xs[other_node];
+        igraph_real_t diffy = this_y - ys[other_node];
+        igraph_real_t distance = sqrt(diffx * diffx + diffy * diffy);
+        igraph_real_t directed_force, x_force, y_force;
+
+        // let's protect ourselves from division by zero by ignoring
+        // two nodes that happen to be in the same place.  Since we
+        // separate all nodes before we work on any of them, this
+        // will only happen in extremely rare circumstances, and when
+        // it does, springs will probably pull them apart anyway.
+        // also, if we are more than 50 away, the electric force
+        // will be negligible.
+        // ***** may not always be desirable ****
+        if (distance == 0.0 || distance >= 500.0) {
+            continue;
+        }
 
-    igraph_real_t x_force, y_force;
-    igraph_i_determine_electric_axal_forces(pos, &x_force, &y_force,
-                                            directed_force, distance,
-                                            other_node, this_node);
+        // See igraph_i_determine_electric_axal_forces() for the geometry;
+        // the force is directed away from other_node.
+        directed_force = COULOMBS_CONSTANT * (charge2 / (distance * distance));
+        x_force = -1 * ((directed_force * fabs(diffx)) / distance);
+        y_force = -1 * ((directed_force * fabs(diffy)) / distance);
+        if (diffx > 0) {
+            x_force = -x_force;
+        }
+        if (diffy > 0) {
+            y_force = -y_force;
+        }
 
-    VECTOR(*pending_forces_x)[this_node] += x_force;
-    VECTOR(*pending_forces_y)[this_node] += y_force;
-    VECTOR(*pending_forces_x)[other_node] -= x_force;
-    VECTOR(*pending_forces_y)[other_node] -= y_force;
+        sum_x += x_force;
+        sum_y += y_force;
+        pending_forces_x[other_node] -= x_force;
+        pending_forces_y[other_node] -= y_force;
+    }
 
-    return 0;
+    pending_forces_x[this_node] = sum_x;
+    pending_forces_y[this_node] = sum_y;
 }
 
 static int igraph_i_determine_spring_axal_forces(
@@ -1835,8 +1870,7 @@ int igraph_layout_graphopt(const igraph_t *graph, igraph_matrix_t *res,
     /* apply on each other based on if both node types' charges are zero. */
     igraph_bool_t apply_electric_charges = (node_charge != 0);
 
-    long int this_node, other_node, edge;
-    igraph_real_t distance;
+    long int this_node, edge;
     long int i;
 
     IGRAPH_VECTOR_INIT_FINALLY(&pending_forces_x, no_of_nodes);
@@ -1868,29 +1902,10 @@ int igraph_layout_graphopt(const igraph_t *graph, igraph_matrix_t *res,
             // Iterate through all nodes
             for (this_node = 0; this_node < no_of_nodes; this_node++) {
                 IGRAPH_ALLOW_INTERRUPTION();
-                for (other_node = this_node + 1;
-                     other_node < no_of_nodes;
-                     other_node++) {
-                    distance = igraph_i_distance_between(res, this_node, other_node);
-                    // let's protect ourselves from division by zero by ignoring
-                    // two nodes that happen to be in the same place.  Since we
-                    // separate all nodes before we work on any of them, this
-                    // will only happen in extremely rare circumstances, and when
-                    // it does, springs will probably pull them apart anyway.
-                    // also, if we are more than 50 away, the electric force
-                    // will be negligible.
-                    // ***** may not always be desirable ****
-                    if ((distance != 0.0) && (distance < 500.0)) {
-                        //    if (distance != 0.0) {
-                        // Apply electrical force from node(counter2) on
-                        // node(counter)
-                        igraph_i_apply_electrical_force(res, &pending_forces_x,
-                                                        &pending_forces_y,
-                                                        other_node, this_node,
-                                                        node_charge,
-                                                        distance);
-                    }
-                }
+                igraph_i_apply_electrical_forces(&MATRIX(*res, 0, 0), &MATRIX(*res, 0, 1),
+                                                 VECTOR(pending_forces_x),
+                                                 VECTOR(pending_forces_y),
+                                                 this_node, no_of_nodes, node_charge);
             }
         }
 
@@ -2078,6 +2093,343 @@ int igraph_layout_merge_dla(igraph_vector_ptr_t *thegraphs,
     return 0;
 }
 
+static int igraph_i_layout_merge_pack_cmp(void *extra, const void *a,
+        const void *b) {
+    igraph_vector_t *heights = extra;
+    long int ia = *(const long int *) a;
+    long int ib = *(const long int *) b;
+    igraph_real_t ha = VECTOR(*heights)[ia];
+    igraph_real_t hb = VECTOR(*heights)[ib];
+    /* Taller boxes first, ties are broken by the index to keep the
+       result independent of the qsort implementation */
+    if (ha > hb) {
+        return -1;
+    } else if (ha < hb) {
+        return 1;
+    } else if (ia < ib) {
+        return -1;
+    } else if (ia > ib) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * \function igraph_layout_merge_pack
+ * \brief Merge multiple layouts by packing their bounding boxes.
+ *
+ * </para><para>
+ * This is a fast, deterministic alternative to \ref
+ * igraph_layout_merge_dla(). Each layout is enclosed in its
+ * axis-parallel bounding box, then the boxes are packed into shelves
+ * (rows) in decreasing order of their heights. The width of the
+ * shelves is chosen so that the result is roughly square. The
+ * layouts are translated but not scaled or rotated.
+ *
+ * </para><para>
+ * The packed layouts occupy a region whose lower left corner is the
+ * origin.
+ * \param coords Pointer vector containing matrix objects with the 2D
+ *        layouts to merge. Empty (zero-row) matrices are allowed.
+ * \param res Pointer to an initialized matrix object, the result will
+ *        be stored here. It will be resized if needed. The rows of the
+ *        result come in the same order as the rows of the matrices in
+ *        \p coords, i.e. first all rows of the first layout, then all
+ *        rows of the second layout, etc.
+ * \param gap The minimum horizontal and vertical distance between the
+ *        bounding boxes of two layouts. Must be non-negative.
+ * \return Error code.
+ *
+ * \sa \ref igraph_layout_merge_dla(), \ref igraph_layout_components().
+ *
+ * Time complexity: O(k log k + n), k is the number of layouts, n is
+ * the total number of rows in them.
+ */
+
+int igraph_layout_merge_pack(const igraph_vector_ptr_t *coords,
+                             igraph_matrix_t *res, igraph_real_t gap) {
+    long int graphs = igraph_vector_ptr_size(coords);
+    igraph_vector_t minx, miny, widths, heights, offx, offy;
+    igraph_vector_long_t order;
+    long int allnodes = 0;
+    long int i, j, respos;
+    igraph_real_t area = 0.0, maxwidth = 0.0, shelfwidth;
+    igraph_real_t curx = 0.0, shelfy = 0.0, shelfheight = 0.0;
+
+    if (gap < 0) {
+        IGRAPH_ERROR("Gap between packed layouts must be non-negative",
+                     IGRAPH_EINVAL);
+    }
+
+    IGRAPH_VECTOR_INIT_FINALLY(&minx, graphs);
+    IGRAPH_VECTOR_INIT_FINALLY(&miny, graphs);
+    IGRAPH_VECTOR_INIT_FINALLY(&widths, graphs);
+    IGRAPH_VECTOR_INIT_FINALLY(&heights, graphs);
+    IGRAPH_VECTOR_INIT_FINALLY(&offx, graphs);
+    IGRAPH_VECTOR_INIT_FINALLY(&offy, graphs);
+    IGRAPH_CHECK(igraph_vector_long_init_seq(&order, 0, graphs - 1));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &order);
+
+    /* Bounding boxes */
+    for (i = 0; i < graphs; i++) {
+        igraph_matrix_t *mat = VECTOR(*coords)[i];
+        long int size = igraph_matrix_nrow(mat);
+        igraph_real_t xmin, xmax, ymin, ymax;
+
+        if (size == 0) {
+            continue;
+        }
+        if (igraph_matrix_ncol(mat) != 2) {
+            IGRAPH_ERROR("igraph_layout_merge_pack works for 2D layouts only",
+                         IGRAPH_EINVAL);
+        }
+
+        xmin = xmax = MATRIX(*mat, 0, 0);
+        ymin = ymax = MATRIX(*mat, 0, 1);
+        for (j = 1; j < size; j++) {
+            igraph_real_t xx = MATRIX(*mat, j, 0), yy = MATRIX(*mat, j, 1);
+            if (xx < xmin) {
+                xmin = xx;
+            } else if (xx > xmax) {
+                xmax = xx;
+            }
+            if (yy < ymin) {
+                ymin = yy;
+            } else if (yy > ymax) {
+                ymax = yy;
+            }
+        }
+
+        allnodes += size;
+        VECTOR(minx)[i] = xmin;
+        VECTOR(miny)[i] = ymin;
+        VECTOR(widths)[i] = xmax - xmin;
+        VECTOR(heights)[i] = ymax - ymin;
+        area += (xmax - xmin + gap) * (ymax - ymin + gap);
+        if (xmax - xmin + gap > maxwidth) {
+            maxwidth = xmax - xmin + gap;
+        }
+    }
+
+    /* Shelf packing, tallest boxes first */
+    igraph_qsort_r(VECTOR(order), (size_t) graphs, sizeof(VECTOR(order)[0]),
+                   &heights, igraph_i_layout_merge_pack_cmp);
+
+    shelfwidth = sqrt(area);
+    if (shelfwidth < maxwidth) {
+        shelfwidth = maxwidth;
+    }
+
+    for (i = 0; i < graphs; i++) {
+        long int actg = VECTOR(order)[i];
+        igraph_real_t w = VECTOR(widths)[actg];
+        igraph_real_t h = VECTOR(heights)[actg];
+
+        if (igraph_matrix_nrow(VECTOR(*coords)[actg]) == 0) {
+            continue;
+        }
+        if (curx > 0 && curx + w > shelfwidth) {
+            shelfy += shelfheight + gap;
+            curx = 0.0;
+            shelfheight = 0.0;
+        }
+        VECTOR(offx)[actg] = curx - VECTOR(minx)[actg];
+        VECTOR(offy)[actg] = shelfy - VECTOR(miny)[actg];
+        curx += w + gap;
+        if (h > shelfheight) {
+            shelfheight = h;
+        }
+    }
+
+    /* Create the result */
+    IGRAPH_CHECK(igraph_matrix_resize(res, allnodes, 2));
+    respos = 0;
+    for (i = 0; i < graphs; i++) {
+        igraph_matrix_t *mat = VECTOR(*coords)[i];
+        long int size = igraph_matrix_nrow(mat);
+        igraph_real_t xx = VECTOR(offx)[i], yy = VECTOR(offy)[i];
+        for (j = 0; j < size; j++) {
+            MATRIX(*res, respos, 0) = MATRIX(*mat, j, 0) + xx;
+            MATRIX(*res, respos, 1) = MATRIX(*mat, j, 1) + yy;
+            respos++;
+        }
+    }
+
+    igraph_vector_long_destroy(&order);
+    igraph_vector_destroy(&offy);
+    igraph_vector_destroy(&offx);
+    igraph_vector_destroy(&heights);
+    igraph_vector_destroy(&widths);
+    igraph_vector_destroy(&miny);
+    igraph_vector_destroy(&minx);
+    IGRAPH_FINALLY_CLEAN(7);
+
+    return 0;
+}
+
+/**
+ * \function igraph_layout_components
+ * \brief Lay out each connected component separately and pack the results.
+ *
+ * </para><para>
+ * Many layout algorithms give poor results for disconnected graphs,
+ * or work for connected graphs only. This function decomposes the
+ * graph into its weakly connected components, lays out each component
+ * with the supplied layout function, and merges the component layouts
+ * with \ref igraph_layout_merge_pack().
+ *
+ * </para><para>
+ * The decomposition is done in a single pass over the edges, without
+ * calling \ref igraph_induced_subgraph() for each component, so it
+ * stays fast even for graphs with many small components.
+ * \param graph The input graph. Edge directions are ignored when
+ *        finding the components, but the component graphs passed to
+ *        \p layout keep the directedness of \p graph.
+ * \param res Pointer to an initialized matrix object, the result will
+ *        be stored here. It will be resized if needed. Row \c i
+ *        contains the coordinates of vertex \c i.
+ * \param layout The layout function to call for each component. It
+ *        must produce a two-column matrix with one row for each vertex
+ *        of the component graph it is given. Vertex ids in the
+ *        component graph follow the order of the vertex ids in the
+ *        original graph.
+ * \param extra Extra argument passed to \p layout.
+ * \param gap The minimum distance between the bounding boxes of two
+ *        components, see \ref igraph_layout_merge_pack().
+ * \return Error code. Errors returned by \p layout are passed on.
+ *
+ * \sa \ref igraph_layout_merge_pack(), \ref igraph_decompose().
+ *
+ * Time complexity: O(|V|+|E|+c log c), plus the time required by the
+ * layout function for each component; c is the number of components.
+ */
+
+int igraph_layout_components(const igraph_t *graph, igraph_matrix_t *res,
+                             igraph_layout_function_t *layout, void *extra,
+                             igraph_real_t gap) {
+    long int no_of_nodes = igraph_vcount(graph);
+    long int no_of_edges = igraph_ecount(graph);
+    igraph_bool_t directed = igraph_is_directed(graph);
+    igraph_vector_t membership;
+    igraph_vector_long_t vstart, estart, localid, vfill, efill;
+    igraph_vector_t edges;
+    igraph_vector_ptr_t layouts;
+    igraph_matrix_t merged;
+    igraph_integer_t no_comps;
+    long int i, c;
+
+    if (layout == 0) {
+        IGRAPH_ERROR("Layout function must be given", IGRAPH_EINVAL);
+    }
+
+    IGRAPH_VECTOR_INIT_FINALLY(&membership, 0);
+    IGRAPH_CHECK(igraph_clusters(graph, &membership, /*csize=*/ 0, &no_comps,
+                                 IGRAPH_WEAK));
+
+    /* Counting sort of the vertices and the edges by component */
+    IGRAPH_CHECK(igraph_vector_long_init(&vstart, no_comps + 1));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &vstart);
+    IGRAPH_CHECK(igraph_vector_long_init(&estart, no_comps + 1));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &estart);
+    IGRAPH_CHECK(igraph_vector_long_init(&localid, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &localid);
+    IGRAPH_CHECK(igraph_vector_long_init(&vfill, no_comps));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &vfill);
+    IGRAPH_CHECK(igraph_vector_long_init(&efill, no_comps));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &efill);
+    IGRAPH_VECTOR_INIT_FINALLY(&edges, no_of_edges * 2);
+
+    for (i = 0; i < no_of_nodes; i++) {
+        c = (long int) VECTOR(membership)[i];
+        VECTOR(localid)[i] = VECTOR(vfill)[c]++;
+    }
+    for (i = 0; i < no_of_edges; i++) {
+        c = (long int) VECTOR(membership)[IGRAPH_FROM(graph, i)];
+        VECTOR(estart)[c + 1] += 1;
+    }
+    for (c = 0; c < no_comps; c++) {
+        VECTOR(vstart)[c + 1] = VECTOR(vstart)[c] + VECTOR(vfill)[c];
+        VECTOR(estart)[c + 1] += VECTOR(estart)[c];
+    }
+    for (i = 0; i < no_of_edges; i++) {
+        long int from = IGRAPH_FROM(graph, i), to = IGRAPH_TO(graph, i);
+        long int pos;
+        c = (long int) VECTOR(membership)[from];
+        pos = 2 * (VECTOR(estart)[c] + VECTOR(efill)[c]++);
+        VECTOR(edges)[pos] = VECTOR(localid)[from];
+        VECTOR(edges)[pos + 1] = VECTOR(localid)[to];
+    }
+
+    IGRAPH_CHECK(igraph_vector_ptr_init(&layouts, no_comps));
+    IGRAPH_FINALLY(igraph_vector_ptr_destroy_all, &layouts);
+    igraph_vector_ptr_set_item_destructor(&layouts,
+                                          (igraph_finally_func_t*)igraph_matrix_destroy);
+
+    /* Lay out the components one by one */
+    IGRAPH_PROGRESS("Laying out components", 0.0, NULL);
+    for (c = 0; c < no_comps; c++) {
+        igraph_t subgraph;
+        igraph_vector_t subedges;
+        igraph_matrix_t *mat;
+        long int size = VECTOR(vfill)[c];
+
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        mat = igraph_Calloc(1, igraph_matrix_t);
+        if (mat == 0) {
+            IGRAPH_ERROR("Cannot lay out components", IGRAPH_ENOMEM);
+        }
+        IGRAPH_FINALLY(igraph_free, mat);
+        IGRAPH_CHECK(igraph_matrix_init(mat, 0, 0));
+        VECTOR(layouts)[c] = mat;
+        IGRAPH_FINALLY_CLEAN(1);  /* ownership of mat taken by layouts */
+
+        igraph_vector_view(&subedges, VECTOR(edges) + 2 * VECTOR(estart)[c],
+                           2 * (VECTOR(estart)[c + 1] - VECTOR(estart)[c]));
+        IGRAPH_CHECK(igraph_create(&subgraph, &subedges, (igraph_integer_t) size,
+                                   directed));
+        IGRAPH_FINALLY(igraph_destroy, &subgraph);
+
+        IGRAPH_CHECK(layout(&subgraph, mat, extra));
+        if (igraph_matrix_nrow(mat) != size || igraph_matrix_ncol(mat) != 2) {
+            IGRAPH_ERROR("Layout function returned a matrix of invalid size",
+                         IGRAPH_EINVAL);
+        }
+
+        igraph_destroy(&subgraph);
+        IGRAPH_FINALLY_CLEAN(1);
+
+        IGRAPH_PROGRESS("Laying out components", (100.0 * c) / no_comps, NULL);
+    }
+    IGRAPH_PROGRESS("Laying out components", 100.0, NULL);
+
+    IGRAPH_MATRIX_INIT_FINALLY(&merged, 0, 0);
+    IGRAPH_CHECK(igraph_layout_merge_pack(&layouts, &merged, gap));
+
+    /* Rows of 'merged' are grouped by component, reorder them */
+    IGRAPH_CHECK(igraph_matrix_resize(res, no_of_nodes, 2));
+    for (i = 0; i < no_of_nodes; i++) {
+        long int row;
+        c = (long int) VECTOR(membership)[i];
+        row = VECTOR(vstart)[c] + VECTOR(localid)[i];
+        MATRIX(*res, i, 0) = MATRIX(merged, row, 0);
+        MATRIX(*res, i, 1) = MATRIX(merged, row, 1);
+    }
+
+    igraph_matrix_destroy(&merged);
+    igraph_vector_ptr_destroy_all(&layouts);
+    igraph_vector_destroy(&edges);
+    igraph_vector_long_destroy(&efill);
+    igraph_vector_long_destroy(&vfill);
+    igraph_vector_long_destroy(&localid);
+    igraph_vector_long_destroy(&estart);
+    igraph_vector_long_destroy(&vstart);
+    igraph_vector_destroy(&membership);
+    IGRAPH_FINALLY_CLEAN(10);
+
+    return 0;
+}
+
 int igraph_i_layout_sphere_2d(igraph_matrix_t *coords,
                               igraph_real_t *x, igraph_real_t *y,
                               igraph_real_t *r) {
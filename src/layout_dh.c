@@ -23,6 +23,7 @@
 */
 
 #include "igraph_layout.h"
+#include "igraph_adjlist.h"
 #include "igraph_interface.h"
 #include "igraph_random.h"
 #include "igraph_math.h"
@@ -77,6 +78,28 @@ float igraph_i_point_segment_dist2(float v_x, float v_y,
     return (v_x - p_x) * (v_x - p_x) + (v_y - p_y) * (v_y - p_y);
 }
 
+/* Adds to diff_energy the change in the node-node distance component of the
+ * energy when a vertex moves from (old_x, old_y) to (new_x, new_y), summed
+ * over the vertices in the index range [from, to). The coordinates are read from the
+ * contiguous columns of the layout matrix, and the loop has no branches,
+ * which allows the compiler to vectorize the distance computations. */
+static float igraph_i_layout_dh_node_dist_diff(const igraph_real_t *xs,
+        const igraph_real_t *ys, igraph_integer_t from, igraph_integer_t to,
+        float old_x, float old_y, float new_x, float new_y,
+        float w_node_dist, float diff_energy) {
+    igraph_integer_t u;
+    for (u = from; u < to; u++) {
+        float odx = old_x - xs[u];
+        float ody = old_y - ys[u];
+        float dx = new_x - xs[u];
+        float dy = new_y - ys[u];
+        float odist2 = odx * odx + ody * ody;
+        float dist2 = dx * dx + dy * dy;
+        diff_energy += w_node_dist / dist2 - w_node_dist / odist2;
+    }
+    return diff_energy;
+}
+
 /**
  * \function igraph_layout_davidson_harel
  * Davidson-Harel layout algorithm
@@ -154,7 +177,9 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
     igraph_vector_int_t try_idx;
     float move_radius = width / 2;
     float fine_tuning_factor = 0.01;
-    igraph_vector_t neis;
+    igraph_adjlist_t adjlist;
+    igraph_inclist_t inclist;
+    igraph_real_t *xs, *ys;
     float min_x = width / 2, max_x = -width / 2, min_y = height / 2, max_y = -height / 2;
 
     igraph_integer_t no_tries = 30;
@@ -194,7 +219,10 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
     IGRAPH_FINALLY(igraph_vector_float_destroy, &try_y);
     IGRAPH_CHECK(igraph_vector_int_init_seq(&try_idx, 0, no_tries - 1));
     IGRAPH_FINALLY(igraph_vector_int_destroy, &try_idx);
-    IGRAPH_VECTOR_INIT_FINALLY(&neis, 100);
+    IGRAPH_CHECK(igraph_adjlist_init(graph, &adjlist, IGRAPH_ALL));
+    IGRAPH_FINALLY(igraph_adjlist_destroy, &adjlist);
+    IGRAPH_CHECK(igraph_inclist_init(graph, &inclist, IGRAPH_ALL));
+    IGRAPH_FINALLY(igraph_inclist_destroy, &inclist);
 
     RNG_BEGIN();
 
@@ -234,6 +262,10 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
         }
     }
 
+    /* The coordinate columns of the result, the matrix is column-major */
+    xs = &MATRIX(*res, 0, 0);
+    ys = &MATRIX(*res, 0, 1);
+
     for (i = 0; i < no_tries; i++) {
         float phi = 2 * M_PI / no_tries * i;
         VECTOR(try_x)[i] = cos(phi);
@@ -256,6 +288,8 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
         for (p = 0; p < no_nodes; p++) {
             igraph_integer_t t;
             igraph_integer_t v = VECTOR(perm)[p];
+            igraph_vector_int_t *neis = igraph_adjlist_get(&adjlist, v);
+            igraph_vector_int_t *incs = igraph_inclist_get(&inclist, v);
             igraph_vector_int_shuffle(&try_idx);
 
             for (t = 0; t < no_tries; t++) {
@@ -263,8 +297,8 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
                 int ti = VECTOR(try_idx)[t];
 
                 /* Try moving it */
-                float old_x = MATRIX(*res, v, 0);
-                float old_y = MATRIX(*res, v, 1);
+                float old_x = xs[v];
+                float old_y = ys[v];
                 float new_x = old_x + move_radius * VECTOR(try_x)[ti];
                 float new_y = old_y + move_radius * VECTOR(try_y)[ti];
 
@@ -282,20 +316,11 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
                 }
 
                 if (w_node_dist != 0) {
-                    igraph_integer_t u;
-                    for (u = 0; u < no_nodes; u++) {
-                        float odx, ody, odist2, dx, dy, dist2;
-                        if (u == v) {
-                            continue;
-                        }
-                        odx = old_x - MATRIX(*res, u, 0);
-                        ody = old_y - MATRIX(*res, u, 1);
-                        dx = new_x - MATRIX(*res, u, 0);
-                        dy = new_y - MATRIX(*res, u, 1);
-                        odist2 = odx * odx + ody * ody;
-                        dist2 = dx * dx + dy * dy;
-                        diff_energy += w_node_dist / dist2 - w_node_dist / odist2;
-                    }
+                    /* all vertices except v itself */
+                    diff_energy = igraph_i_layout_dh_node_dist_diff(xs, ys, 0, v,
+                                  old_x, old_y, new_x, new_y, w_node_dist, diff_energy);
+                    diff_energy = igraph_i_layout_dh_node_dist_diff(xs, ys, v + 1,
+                                  no_nodes, old_x, old_y, new_x, new_y, w_node_dist, diff_energy);
                 }
 
                 if (w_borderlines != 0) {
@@ -333,15 +358,14 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
 
                 if (w_edge_lengths != 0) {
                     igraph_integer_t len, j;
-                    igraph_neighbors(graph, &neis, v, IGRAPH_ALL);
-                    len = igraph_vector_size(&neis);
+                    len = igraph_vector_int_size(neis);
                     for (j = 0; j < len; j++) {
-                        igraph_integer_t u = VECTOR(neis)[j];
-                        float odx = old_x - MATRIX(*res, u, 0);
-                        float ody = old_y - MATRIX(*res, u, 1);
+                        igraph_integer_t u = VECTOR(*neis)[j];
+                        float odx = old_x - xs[u];
+                        float ody = old_y - ys[u];
                         float odist2 = odx * odx + ody * ody;
-                        float dx = new_x - MATRIX(*res, u, 0);
-                        float dy = new_y - MATRIX(*res, u, 1);
+                        float dx = new_x - xs[u];
+                        float dy = new_y - ys[u];
                         float dist2 = dx * dx + dy * dy;
                         diff_energy += w_edge_lengths * (dist2 - odist2);
                     }
@@ -349,12 +373,11 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
 
                 if (w_edge_crossings != 0) {
                     igraph_integer_t len, j, no = 0;
-                    igraph_neighbors(graph, &neis, v, IGRAPH_ALL);
-                    len = igraph_vector_size(&neis);
+                    len = igraph_vector_int_size(neis);
                     for (j = 0; j < len; j++) {
-                        igraph_integer_t u = VECTOR(neis)[j];
-                        float u_x = MATRIX(*res, u, 0);
-                        float u_y = MATRIX(*res, u, 1);
+                        igraph_integer_t u = VECTOR(*neis)[j];
+                        float u_x = xs[u];
+                        float u_y = ys[u];
                         igraph_integer_t e;
                         for (e = 0; e < no_edges; e++) {
                             igraph_integer_t u1 = IGRAPH_FROM(graph, e);
@@ -363,10 +386,10 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
                             if (u1 == v || u2 == v || u1 == u || u2 == u) {
                                 continue;
                             }
-                            u1_x = MATRIX(*res, u1, 0);
-                            u1_y = MATRIX(*res, u1, 1);
-                            u2_x = MATRIX(*res, u2, 0);
-                            u2_y = MATRIX(*res, u2, 1);
+                            u1_x = xs[u1];
+                            u1_y = ys[u1];
+                            u2_x = xs[u2];
+                            u2_y = ys[u2];
                             no -= igraph_i_segments_intersect(old_x, old_y, u_x, u_y,
                                                               u1_x, u1_y, u2_x, u2_y);
                             no += igraph_i_segments_intersect(new_x, new_y, u_x, u_y,
@@ -387,10 +410,10 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
                         if (u1 == v || u2 == v) {
                             continue;
                         }
-                        u1_x = MATRIX(*res, u1, 0);
-                        u1_y = MATRIX(*res, u1, 1);
-                        u2_x = MATRIX(*res, u2, 0);
-                        u2_y = MATRIX(*res, u2, 1);
+                        u1_x = xs[u1];
+                        u1_y = ys[u1];
+                        u2_x = xs[u2];
+                        u2_y = ys[u2];
                         d_ev = igraph_i_point_segment_dist2(old_x, old_y, u1_x, u1_y,
                                                             u2_x, u2_y);
                         diff_energy -= w_node_edge_dist / d_ev;
@@ -400,21 +423,20 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
                     }
 
                     /* All other nodes from all of v's incident edges */
-                    igraph_incident(graph, &neis, v, IGRAPH_ALL);
-                    no = igraph_vector_size(&neis);
+                    no = igraph_vector_int_size(incs);
                     for (e = 0; e < no; e++) {
-                        igraph_integer_t mye = VECTOR(neis)[e];
+                        igraph_integer_t mye = VECTOR(*incs)[e];
                         igraph_integer_t u = IGRAPH_OTHER(graph, mye, v);
-                        float u_x = MATRIX(*res, u, 0);
-                        float u_y = MATRIX(*res, u, 1);
+                        float u_x = xs[u];
+                        float u_y = ys[u];
                         igraph_integer_t w;
                         for (w = 0; w < no_nodes; w++) {
                             float w_x, w_y, d_ev;
                             if (w == v || w == u) {
                                 continue;
                             }
-                            w_x = MATRIX(*res, w, 0);
-                            w_y = MATRIX(*res, w, 1);
+                            w_x = xs[w];
+                            w_y = ys[w];
                             d_ev = igraph_i_point_segment_dist2(w_x, w_y, old_x,
                                                                 old_y, u_x, u_y);
                             diff_energy -= w_node_edge_dist / d_ev;
@@ -427,8 +449,8 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
 
                 if (diff_energy < 0 ||
                     (!fine_tuning && RNG_UNIF01() < exp(-diff_energy / move_radius))) {
-                    MATRIX(*res, v, 0) = new_x;
-                    MATRIX(*res, v, 1) = new_y;
+                    xs[v] = new_x;
+                    ys[v] = new_y;
                     if (new_x < min_x) {
                         min_x = new_x;
                     } else if (new_x > max_x) {
@@ -451,12 +473,13 @@ int igraph_layout_davidson_harel(const igraph_t *graph, igraph_matrix_t *res,
 
     RNG_END();
 
-    igraph_vector_destroy(&neis);
+    igraph_inclist_destroy(&inclist);
+    igraph_adjlist_destroy(&adjlist);
     igraph_vector_int_destroy(&try_idx);
     igraph_vector_float_destroy(&try_x);
     igraph_vector_float_destroy(&try_y);
     igraph_vector_int_destroy(&perm);
-    IGRAPH_FINALLY_CLEAN(5);
+    IGRAPH_FINALLY_CLEAN(6);
 
     return 0;
 }
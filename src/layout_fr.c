@@ -26,7 +26,11 @@
 #include "igraph_random.h"
 #include "igraph_interface.h"
 #include "igraph_components.h"
+#include "igraph_adjlist.h"
+#include "igraph_iterators.h"
+#include "igraph_interrupt_internal.h"
 #include "igraph_types_internal.h"
+#include "igraph_math.h"
 
 static int igraph_layout_i_fr(const igraph_t *graph,
                               igraph_matrix_t *res,
@@ -432,6 +436,406 @@ int igraph_layout_fruchterman_reingold(const igraph_t *graph,
     }
 }
 
+/* Places the vertices with placed[v] == 0, each one at the barycenter of
+ * its already placed neighbors, in breadth-first order from the placed
+ * part of the graph. Vertices that cannot be reached from a placed vertex
+ * are put at a random position within the bounding box of the layout and
+ * then act as new starting points. A small random offset keeps the new
+ * vertices from sitting exactly on top of their neighbors. */
+static int igraph_i_layout_fr_place_new(igraph_matrix_t *res,
+                                        igraph_adjlist_t *adjlist,
+                                        igraph_vector_bool_t *placed,
+                                        igraph_vector_int_t *queue) {
+
+    igraph_integer_t no_nodes = igraph_matrix_nrow(res);
+    igraph_integer_t i, head = 0;
+    igraph_real_t minx = 0, maxx = 0, miny = 0, maxy = 0;
+    igraph_bool_t have_bbox = 0;
+
+    for (i = 0; i < no_nodes; i++) {
+        if (VECTOR(*placed)[i]) {
+            igraph_real_t x = MATRIX(*res, i, 0), y = MATRIX(*res, i, 1);
+            if (!have_bbox) {
+                minx = maxx = x; miny = maxy = y;
+                have_bbox = 1;
+            } else {
+                if (x < minx) {
+                    minx = x;
+                } else if (x > maxx) {
+                    maxx = x;
+                }
+                if (y < miny) {
+                    miny = y;
+                } else if (y > maxy) {
+                    maxy = y;
+                }
+            }
+        }
+    }
+    if (!have_bbox) {
+        maxx = maxy = sqrt(no_nodes) / 2;
+        minx = miny = -maxx;
+    }
+
+    igraph_vector_int_clear(queue);
+    for (i = 0; i < no_nodes; i++) {
+        if (VECTOR(*placed)[i]) {
+            IGRAPH_CHECK(igraph_vector_int_push_back(queue, i));
+        }
+    }
+
+    for (i = 0; i < no_nodes; i++) {
+        if (!VECTOR(*placed)[i] && head == igraph_vector_int_size(queue)) {
+            /* nothing to grow from, start a new region */
+            MATRIX(*res, i, 0) = RNG_UNIF(minx, maxx);
+            MATRIX(*res, i, 1) = RNG_UNIF(miny, maxy);
+            VECTOR(*placed)[i] = 1;
+            IGRAPH_CHECK(igraph_vector_int_push_back(queue, i));
+        }
+        while (head < igraph_vector_int_size(queue)) {
+            igraph_integer_t v = VECTOR(*queue)[head++];
+            igraph_vector_int_t *neis = igraph_adjlist_get(adjlist, v);
+            igraph_integer_t j, n = igraph_vector_int_size(neis);
+            for (j = 0; j < n; j++) {
+                igraph_integer_t u = VECTOR(*neis)[j];
+                igraph_vector_int_t *uneis;
+                igraph_integer_t k, un, no_placed = 0;
+                igraph_real_t sx = 0, sy = 0, phi;
+                if (VECTOR(*placed)[u]) {
+                    continue;
+                }
+                uneis = igraph_adjlist_get(adjlist, u);
+                un = igraph_vector_int_size(uneis);
+                for (k = 0; k < un; k++) {
+                    igraph_integer_t w = VECTOR(*uneis)[k];
+                    if (VECTOR(*placed)[w]) {
+                        sx += MATRIX(*res, w, 0);
+                        sy += MATRIX(*res, w, 1);
+                        no_placed++;
+                    }
+                }
+                phi = RNG_UNIF(0, 2 * M_PI);
+                MATRIX(*res, u, 0) = sx / no_placed + 0.5 * cos(phi);
+                MATRIX(*res, u, 1) = sy / no_placed + 0.5 * sin(phi);
+                VECTOR(*placed)[u] = 1;
+                IGRAPH_CHECK(igraph_vector_int_push_back(queue, u));
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * \function igraph_layout_fruchterman_reingold_incremental
+ * \brief Updates a Fruchterman-Reingold layout after the graph has changed.
+ *
+ * </para><para>
+ * This function is meant for graphs that change a little at a time,
+ * e.g. in a live visualization, where rerunning \ref
+ * igraph_layout_fruchterman_reingold() on the whole graph after every
+ * modification is too slow and also moves vertices that were not
+ * affected by the change.
+ *
+ * </para><para>
+ * The rows of \p res are the previous coordinates of the vertices. If
+ * the graph has more vertices than \p res has rows, then the extra
+ * vertices are considered new: each one is placed at the barycenter of its
+ * already placed neighbors, or at a random position if it has none.
+ * Vertices are always added to the end of an igraph graph; when vertices
+ * are deleted, the caller must remove the corresponding rows of \p res,
+ * e.g. with \ref igraph_matrix_remove_row().
+ *
+ * </para><para>
+ * Then only the vertices within \p radius steps of a changed or new
+ * vertex are moved, using \p niter iterations of the force-directed
+ * algorithm, with a temperature decreasing linearly from \p start_temp
+ * to zero. All other vertices keep their positions, but they still repel
+ * and attract the moving ones. As in the grid based version of \ref
+ * igraph_layout_fruchterman_reingold(), repulsion is only calculated
+ * between vertices that are close to each other, so the cost of an
+ * iteration is proportional to the size of the affected region, not to
+ * the size of the graph.
+ *
+ * \param graph Pointer to an initialized graph object, the graph after
+ *        the modification.
+ * \param res Pointer to an initialized matrix object with two columns and
+ *        at most as many rows as vertices in \p graph, it contains the
+ *        previous layout. The updated layout is stored here, it will be
+ *        resized as needed. If it has zero rows, then all vertices are
+ *        new.
+ * \param changed The vertices whose neighborhood has changed, typically the
+ *        endpoints of added and removed edges. New vertices do not need to
+ *        be listed here.
+ * \param radius The size of the affected region: vertices at most this
+ *        many steps away from a changed or new vertex are moved. Zero
+ *        means that only the changed and new vertices are moved.
+ * \param niter The number of iterations to do. Since the rest of the
+ *        layout is already in equilibrium, a few dozen iterations are
+ *        usually enough.
+ * \param start_temp Start temperature, the maximum amount of movement
+ *        along one axis, within one step, for a vertex. It should be
+ *        small compared to the size of the layout, one is a reasonable
+ *        value for layouts created with \ref
+ *        igraph_layout_fruchterman_reingold().
+ * \param weight Pointer to a vector containing edge weights, the
+ *        attraction along the edges will be multiplied by these. It
+ *        will be ignored if it is a null-pointer.
+ * \return Error code.
+ *
+ * Time complexity: O(|V|+|E|) to find the affected region and set up the
+ * data structures, plus O(|A| d) for each iteration, where |A| is the
+ * number of vertices in the affected region and d is the average number of
+ * neighbors and nearby vertices of these.
+ */
+
+int igraph_layout_fruchterman_reingold_incremental(const igraph_t *graph,
+        igraph_matrix_t *res,
+        const igraph_vs_t changed,
+        igraph_integer_t radius,
+        igraph_integer_t niter,
+        igraph_real_t start_temp,
+        const igraph_vector_t *weight) {
+
+    igraph_integer_t no_nodes = igraph_vcount(graph);
+    igraph_integer_t old_nodes = igraph_matrix_nrow(res);
+    igraph_integer_t i, j, no_active, head;
+    igraph_adjlist_t adjlist;
+    igraph_inclist_t inclist;
+    igraph_vector_bool_t placed;
+    igraph_vector_int_t active, dist;
+    igraph_vector_float_t dispx, dispy;
+    igraph_vector_t col;
+    igraph_vit_t vit;
+    igraph_2dgrid_t grid;
+    igraph_real_t minx, maxx, miny, maxy, cellsize = 2.0;
+    igraph_real_t temp = start_temp;
+    igraph_real_t difftemp = niter > 0 ? start_temp / niter : 0;
+
+    if (niter < 0) {
+        IGRAPH_ERROR("Number of iterations must be non-negative in "
+                     "incremental Fruchterman-Reingold layout", IGRAPH_EINVAL);
+    }
+    if (radius < 0) {
+        IGRAPH_ERROR("Radius must be non-negative in incremental "
+                     "Fruchterman-Reingold layout", IGRAPH_EINVAL);
+    }
+    if (old_nodes > no_nodes ||
+        (old_nodes > 0 && igraph_matrix_ncol(res) != 2)) {
+        IGRAPH_ERROR("Invalid start position matrix size in incremental "
+                     "Fruchterman-Reingold layout", IGRAPH_EINVAL);
+    }
+    if (weight && igraph_vector_size(weight) != igraph_ecount(graph)) {
+        IGRAPH_ERROR("Invalid weight vector length", IGRAPH_EINVAL);
+    }
+
+    if (old_nodes == 0) {
+        IGRAPH_CHECK(igraph_matrix_resize(res, no_nodes, 2));
+    } else {
+        IGRAPH_CHECK(igraph_matrix_add_rows(res, no_nodes - old_nodes));
+    }
+    if (no_nodes == 0) {
+        return 0;
+    }
+
+    IGRAPH_CHECK(igraph_adjlist_init(graph, &adjlist, IGRAPH_ALL));
+    IGRAPH_FINALLY(igraph_adjlist_destroy, &adjlist);
+    IGRAPH_CHECK(igraph_vector_int_init(&active, 0));
+    IGRAPH_FINALLY(igraph_vector_int_destroy, &active);
+    IGRAPH_CHECK(igraph_vector_bool_init(&placed, no_nodes));
+    IGRAPH_FINALLY(igraph_vector_bool_destroy, &placed);
+
+    RNG_BEGIN();
+
+    /* Place the new vertices */
+    if (old_nodes < no_nodes) {
+        for (i = 0; i < old_nodes; i++) {
+            VECTOR(placed)[i] = 1;
+        }
+        IGRAPH_CHECK(igraph_i_layout_fr_place_new(res, &adjlist, &placed,
+                     &active));
+    }
+
+    /* Find the affected region with a breadth-first search from the
+       changed and the new vertices, 'dist' is -1 for unaffected vertices */
+    IGRAPH_CHECK(igraph_vector_int_init(&dist, no_nodes));
+    IGRAPH_FINALLY(igraph_vector_int_destroy, &dist);
+    igraph_vector_int_fill(&dist, -1);
+    igraph_vector_int_clear(&active);
+    for (i = old_nodes; i < no_nodes; i++) {
+        VECTOR(dist)[i] = 0;
+        IGRAPH_CHECK(igraph_vector_int_push_back(&active, i));
+    }
+    IGRAPH_CHECK(igraph_vit_create(graph, changed, &vit));
+    IGRAPH_FINALLY(igraph_vit_destroy, &vit);
+    for (; !IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit)) {
+        igraph_integer_t v = IGRAPH_VIT_GET(vit);
+        if (VECTOR(dist)[v] < 0) {
+            VECTOR(dist)[v] = 0;
+            IGRAPH_CHECK(igraph_vector_int_push_back(&active, v));
+        }
+    }
+    igraph_vit_destroy(&vit);
+    IGRAPH_FINALLY_CLEAN(1);
+    for (head = 0; head < igraph_vector_int_size(&active); head++) {
+        igraph_integer_t v = VECTOR(active)[head];
+        igraph_vector_int_t *neis;
+        igraph_integer_t n;
+        if (VECTOR(dist)[v] >= radius) {
+            continue;
+        }
+        neis = igraph_adjlist_get(&adjlist, v);
+        n = igraph_vector_int_size(neis);
+        for (j = 0; j < n; j++) {
+            igraph_integer_t u = VECTOR(*neis)[j];
+            if (VECTOR(dist)[u] < 0) {
+                VECTOR(dist)[u] = VECTOR(dist)[v] + 1;
+                IGRAPH_CHECK(igraph_vector_int_push_back(&active, u));
+            }
+        }
+    }
+    no_active = igraph_vector_int_size(&active);
+
+    igraph_vector_int_destroy(&dist);
+    igraph_vector_bool_destroy(&placed);
+    igraph_adjlist_destroy(&adjlist);
+    IGRAPH_FINALLY_CLEAN(4);
+    IGRAPH_FINALLY(igraph_vector_int_destroy, &active);
+
+    if (niter == 0 || no_active == 0) {
+        RNG_END();
+        igraph_vector_int_destroy(&active);
+        IGRAPH_FINALLY_CLEAN(1);
+        return 0;
+    }
+
+    /* Put all vertices on a grid, so that the vertices near an active
+       vertex can be found quickly. Vertices outside the grid are assigned
+       to the cells on its border. The cells are made larger if the layout
+       is very sparse, to keep the size of the grid proportional to the
+       number of vertices. */
+    igraph_vector_view(&col, &MATRIX(*res, 0, 0), no_nodes);
+    igraph_vector_minmax(&col, &minx, &maxx);
+    igraph_vector_view(&col, &MATRIX(*res, 0, 1), no_nodes);
+    igraph_vector_minmax(&col, &miny, &maxy);
+    if ((maxx - minx) * (maxy - miny) > 4.0 * no_nodes * cellsize * cellsize) {
+        cellsize = sqrt((maxx - minx) * (maxy - miny) / (4.0 * no_nodes));
+    }
+    minx -= cellsize; maxx += cellsize;
+    miny -= cellsize; maxy += cellsize;
+    IGRAPH_CHECK(igraph_2dgrid_init(&grid, res, minx, maxx, cellsize,
+                                    miny, maxy, cellsize));
+    IGRAPH_FINALLY(igraph_2dgrid_destroy, &grid);
+    for (i = 0; i < no_nodes; i++) {
+        igraph_2dgrid_add2(&grid, i);
+    }
+
+    IGRAPH_CHECK(igraph_inclist_init(graph, &inclist, IGRAPH_ALL));
+    IGRAPH_FINALLY(igraph_inclist_destroy, &inclist);
+    IGRAPH_CHECK(igraph_vector_float_init(&dispx, no_active));
+    IGRAPH_FINALLY(igraph_vector_float_destroy, &dispx);
+    IGRAPH_CHECK(igraph_vector_float_init(&dispy, no_active));
+    IGRAPH_FINALLY(igraph_vector_float_destroy, &dispy);
+
+    for (i = 0; i < niter; i++) {
+        igraph_integer_t a;
+
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        for (a = 0; a < no_active; a++) {
+            igraph_integer_t v = VECTOR(active)[a];
+            igraph_real_t vx = MATRIX(*res, v, 0), vy = MATRIX(*res, v, 1);
+            igraph_vector_int_t *incs = igraph_inclist_get(&inclist, v);
+            igraph_integer_t n = igraph_vector_int_size(incs);
+            long int cx, cy, x, y;
+            float fx = 0, fy = 0;
+
+            /* repulsion from the vertices in this and the adjacent cells */
+            cx = vx <= minx ? 0 : (long int) floor((vx - minx) / cellsize);
+            cy = vy <= miny ? 0 : (long int) floor((vy - miny) / cellsize);
+            if (cx >= grid.stepsx) {
+                cx = grid.stepsx - 1;
+            }
+            if (cy >= grid.stepsy) {
+                cy = grid.stepsy - 1;
+            }
+            for (x = cx - 1; x <= cx + 1; x++) {
+                if (x < 0 || x >= grid.stepsx) {
+                    continue;
+                }
+                for (y = cy - 1; y <= cy + 1; y++) {
+                    long int u;
+                    if (y < 0 || y >= grid.stepsy) {
+                        continue;
+                    }
+                    for (u = (long int) MATRIX(grid.startidx, x, y); u != 0;
+                         u = (long int) VECTOR(grid.next)[u - 1]) {
+                        float dx, dy, dlen;
+                        if (u - 1 == v) {
+                            continue;
+                        }
+                        dx = vx - MATRIX(*res, u - 1, 0);
+                        dy = vy - MATRIX(*res, u - 1, 1);
+                        dlen = dx * dx + dy * dy;
+                        if (dlen == 0) {
+                            dx = RNG_UNIF01() * 1e-9;
+                            dy = RNG_UNIF01() * 1e-9;
+                            dlen = dx * dx + dy * dy;
+                        }
+                        if (dlen < cellsize * cellsize) {
+                            fx += dx / dlen;
+                            fy += dy / dlen;
+                        }
+                    }
+                }
+            }
+
+            /* attraction along the incident edges */
+            for (j = 0; j < n; j++) {
+                igraph_integer_t e = VECTOR(*incs)[j];
+                igraph_integer_t u = IGRAPH_OTHER(graph, e, v);
+                igraph_real_t dx = vx - MATRIX(*res, u, 0);
+                igraph_real_t dy = vy - MATRIX(*res, u, 1);
+                igraph_real_t w = weight ? VECTOR(*weight)[e] : 1.0;
+                igraph_real_t dlen = sqrt(dx * dx + dy * dy) * w;
+                fx -= dx * dlen;
+                fy -= dy * dlen;
+            }
+
+            VECTOR(dispx)[a] = fx;
+            VECTOR(dispy)[a] = fy;
+        }
+
+        /* limit max displacement to the temperature and move the
+           vertices on the grid as well */
+        for (a = 0; a < no_active; a++) {
+            igraph_integer_t v = VECTOR(active)[a];
+            igraph_real_t dx = VECTOR(dispx)[a] + RNG_UNIF01() * 1e-9;
+            igraph_real_t dy = VECTOR(dispy)[a] + RNG_UNIF01() * 1e-9;
+            igraph_real_t displen = sqrt(dx * dx + dy * dy);
+            igraph_real_t mx = fabs(dx) < temp ? dx : temp;
+            igraph_real_t my = fabs(dy) < temp ? dy : temp;
+            if (displen > 0) {
+                igraph_2dgrid_move(&grid, v, (dx / displen) * mx,
+                                   (dy / displen) * my);
+            }
+        }
+
+        temp -= difftemp;
+    }
+
+    RNG_END();
+
+    igraph_vector_float_destroy(&dispy);
+    igraph_vector_float_destroy(&dispx);
+    igraph_inclist_destroy(&inclist);
+    igraph_2dgrid_destroy(&grid);
+    igraph_vector_int_destroy(&active);
+    IGRAPH_FINALLY_CLEAN(5);
+
+    return 0;
+}
+
 /**
  * \function igraph_layout_fruchterman_reingold_3d
  * \brief 3D Fruchterman-Reingold algorithm.
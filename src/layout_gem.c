@@ -23,11 +23,34 @@
 */
 
 #include "igraph_layout.h"
+#include "igraph_adjlist.h"
 #include "igraph_interface.h"
 #include "igraph_random.h"
 #include "igraph_math.h"
 #include "igraph_interrupt_internal.h"
 
+/* Adds the repulsive impulse exerted on a vertex at (vx, vy) by the
+ * vertices in the index range [from, to) to *px and *py. The coordinates
+ * are read from the columns of the layout matrix, which are contiguous,
+ * and the loop body has no data-dependent branches, so the distance
+ * computations can be vectorized by the compiler. */
+static void igraph_i_layout_gem_repulsion(const igraph_real_t *xs,
+        const igraph_real_t *ys, igraph_integer_t from, igraph_integer_t to,
+        igraph_real_t vx, igraph_real_t vy, float elen_des2,
+        float *px, float *py) {
+    float sum_x = *px, sum_y = *py;
+    igraph_integer_t u;
+    for (u = from; u < to; u++) {
+        float dx = vx - xs[u];
+        float dy = vy - ys[u];
+        float dist2 = dx * dx + dy * dy;
+        sum_x += dist2 != 0 ? dx * elen_des2 / dist2 : 0.0f;
+        sum_y += dist2 != 0 ? dy * elen_des2 / dist2 : 0.0f;
+    }
+    *px = sum_x;
+    *py = sum_y;
+}
+
 /**
  * \ingroup layout
  * \function igraph_layout_gem
@@ -76,7 +99,8 @@ int igraph_layout_gem(const igraph_t *graph, igraph_matrix_t *res,
     igraph_integer_t perm_pointer = 0;
     float barycenter_x = 0.0, barycenter_y = 0.0;
     igraph_vector_t phi;
-    igraph_vector_t neis;
+    igraph_adjlist_t adjlist;
+    igraph_real_t *xs, *ys;
     const float elen_des2 = 128 * 128;
     const float gamma = 1 / 16.0;
     const float alpha_o = M_PI;
@@ -125,7 +149,8 @@ int igraph_layout_gem(const igraph_t *graph, igraph_matrix_t *res,
     IGRAPH_CHECK(igraph_vector_int_init_seq(&perm, 0, no_nodes - 1));
     IGRAPH_FINALLY(igraph_vector_int_destroy, &perm);
     IGRAPH_VECTOR_INIT_FINALLY(&phi, no_nodes);
-    IGRAPH_VECTOR_INIT_FINALLY(&neis, 10);
+    IGRAPH_CHECK(igraph_adjlist_init(graph, &adjlist, IGRAPH_ALL));
+    IGRAPH_FINALLY(igraph_adjlist_destroy, &adjlist);
 
     RNG_BEGIN();
 
@@ -149,10 +174,16 @@ int igraph_layout_gem(const igraph_t *graph, igraph_matrix_t *res,
         }
     }
     igraph_vector_float_fill(&temp, temp_init);
+
+    /* The coordinate columns of the result, the matrix is column-major */
+    xs = &MATRIX(*res, 0, 0);
+    ys = &MATRIX(*res, 0, 1);
     temp_global = temp_init * no_nodes;
 
     while (temp_global > temp_min * no_nodes && maxiter > 0) {        
-        igraph_integer_t u, v, nlen, j;
+        igraph_integer_t v, nlen, j;
+        igraph_vector_int_t *neis;
+        igraph_real_t vx, vy;
         float px, py, pvx, pvy;
 
         IGRAPH_ALLOW_INTERRUPTION();
@@ -163,33 +194,26 @@ int igraph_layout_gem(const igraph_t *graph, igraph_matrix_t *res,
             perm_pointer = no_nodes - 1;
         }
         v = VECTOR(perm)[perm_pointer--];
+        vx = xs[v];
+        vy = ys[v];
 
         /* compute v's impulse */
-        px = (barycenter_x / no_nodes - MATRIX(*res, v, 0)) * gamma * VECTOR(phi)[v];
-        py = (barycenter_y / no_nodes - MATRIX(*res, v, 1)) * gamma * VECTOR(phi)[v];
+        px = (barycenter_x / no_nodes - vx) * gamma * VECTOR(phi)[v];
+        py = (barycenter_y / no_nodes - vy) * gamma * VECTOR(phi)[v];
         px += RNG_UNIF(-32.0, 32.0);
         py += RNG_UNIF(-32.0, 32.0);
 
-        for (u = 0; u < no_nodes; u++) {
-            float dx, dy, dist2;
-            if (u == v) {
-                continue;
-            }
-            dx = MATRIX(*res, v, 0) - MATRIX(*res, u, 0);
-            dy = MATRIX(*res, v, 1) - MATRIX(*res, u, 1);
-            dist2 = dx * dx + dy * dy;
-            if (dist2 != 0) {
-                px += dx * elen_des2 / dist2;
-                py += dy * elen_des2 / dist2;
-            }
-        }
+        /* repulsive forces from all other vertices, skipping v itself */
+        igraph_i_layout_gem_repulsion(xs, ys, 0, v, vx, vy, elen_des2, &px, &py);
+        igraph_i_layout_gem_repulsion(xs, ys, v + 1, no_nodes, vx, vy, elen_des2,
+                                      &px, &py);
 
-        IGRAPH_CHECK(igraph_neighbors(graph, &neis, v, IGRAPH_ALL));
-        nlen = igraph_vector_size(&neis);
+        neis = igraph_adjlist_get(&adjlist, v);
+        nlen = igraph_vector_int_size(neis);
         for (j = 0; j < nlen; j++) {
-            igraph_integer_t u = VECTOR(neis)[j];
-            float dx = MATRIX(*res, v, 0) - MATRIX(*res, u, 0);
-            float dy = MATRIX(*res, v, 1) - MATRIX(*res, u, 1);
+            igraph_integer_t u = VECTOR(*neis)[j];
+            float dx = vx - xs[u];
+            float dy = vy - ys[u];
             float dist2 = dx * dx + dy * dy;
             px -= dx * dist2 / (elen_des2 * VECTOR(phi)[v]);
             py -= dy * dist2 / (elen_des2 * VECTOR(phi)[v]);
@@ -200,8 +224,8 @@ int igraph_layout_gem(const igraph_t *graph, igraph_matrix_t *res,
             float plen = sqrtf(px * px + py * py);
             px *= VECTOR(temp)[v] / plen;
             py *= VECTOR(temp)[v] / plen;
-            MATRIX(*res, v, 0) += px;
-            MATRIX(*res, v, 1) += py;
+            xs[v] += px;
+            ys[v] += py;
             barycenter_x += px;
             barycenter_y += py;
         }
@@ -236,7 +260,7 @@ int igraph_layout_gem(const igraph_t *graph, igraph_matrix_t *res,
 
     RNG_END();
 
-    igraph_vector_destroy(&neis);
+    igraph_adjlist_destroy(&adjlist);
     igraph_vector_destroy(&phi);
     igraph_vector_int_destroy(&perm);
     igraph_vector_float_destroy(&skew_gauge);
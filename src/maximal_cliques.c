@@ -71,6 +71,19 @@ static int igraph_i_maximal_cliques_up(
         igraph_vector_int_t *R,
         igraph_vector_int_t *H);
 
+/* Steps of the Bron-Kerbosch recursion since the last interruption
+   check, see igraph_i_maximal_cliques_bk() in the template */
+static IGRAPH_THREAD_LOCAL int igraph_i_maximal_cliques_steps = 0;
+#define IGRAPH_I_MAXIMAL_CLIQUES_CHECK_PERIOD 1024
+
+/* Interruption check between two top-level vertices. The result is
+   passed to IGRAPH_CHECK(), so an interrupted call releases its
+   temporaries through the finally stack. */
+static int igraph_i_maximal_cliques_interruption(void) {
+    IGRAPH_ALLOW_INTERRUPTION();
+    return IGRAPH_SUCCESS;
+}
+
 #define PRINT_PX do {                              \
         int j;                                 \
         printf("PX=");                             \
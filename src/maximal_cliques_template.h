@@ -156,8 +156,8 @@ void igraph_i_maximal_cliques_free(void *ptr) {
     for (i = 0; i < n; i++) {
         igraph_vector_t *v = VECTOR(*res)[i];
         if (v) {
-            igraph_Free(v);
             igraph_vector_destroy(v);
+            igraph_Free(v);
         }
     }
     igraph_vector_ptr_clear(res);
@@ -172,8 +172,8 @@ void igraph_i_maximal_cliques_free_full(void *ptr) {
         for (i = 0; i < n; i++) {
             igraph_vector_t *v = VECTOR(*res)[i];
             if (v) {
-                igraph_Free(v);
                 igraph_vector_destroy(v);
+                igraph_Free(v);
             }
         }
         igraph_vector_ptr_clear(res);
@@ -211,6 +211,10 @@ int FUNCTION(igraph_i_maximal_cliques_bk, SUFFIX)(
         while ((mynextv = igraph_vector_int_pop_back(nextv)) != -1) {
             int newPS, newXE;
 
+            /* A single top-level call may recurse for a long time */
+            IGRAPH_ALLOW_INTERRUPTION_LIMITED(igraph_i_maximal_cliques_steps,
+                                              IGRAPH_I_MAXIMAL_CLIQUES_CHECK_PERIOD);
+
             /* Going down, prepare */
             igraph_i_maximal_cliques_down(PX, PS, PE, XS, XE, pos, adjlist,
                                           mynextv, R, &newPS, &newXE);
@@ -254,6 +258,7 @@ int FUNCTION(igraph_maximal_cliques, SUFFIX)(
     igraph_adjlist_t adjlist, fulladjlist;
     igraph_real_t pgreset = round(no_of_nodes / 100.0), pg = pgreset, pgc = 0;
     int err;
+    int finally_size = IGRAPH_FINALLY_STACK_SIZE();
     IGRAPH_UNUSED(nn);
 
     if (igraph_is_directed(graph)) {
@@ -261,14 +266,12 @@ int FUNCTION(igraph_maximal_cliques, SUFFIX)(
                        "calculation");
     }
 
-    igraph_vector_init(&order, no_of_nodes);
-    IGRAPH_FINALLY(igraph_vector_destroy, &order);
-    igraph_vector_int_init(&rank, no_of_nodes);
+    IGRAPH_VECTOR_INIT_FINALLY(&order, no_of_nodes);
+    IGRAPH_CHECK(igraph_vector_int_init(&rank, no_of_nodes));
     IGRAPH_FINALLY(igraph_vector_int_destroy, &rank);
-    igraph_vector_init(&coreness, no_of_nodes);
-    igraph_coreness(graph, &coreness, /*mode=*/ IGRAPH_ALL);
-    IGRAPH_FINALLY(igraph_vector_destroy, &coreness);
-    igraph_vector_qsort_ind(&coreness, &order, /*descending=*/ 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&coreness, no_of_nodes);
+    IGRAPH_CHECK(igraph_coreness(graph, &coreness, /*mode=*/ IGRAPH_ALL));
+    IGRAPH_CHECK(igraph_vector_qsort_ind(&coreness, &order, /*descending=*/ 0));
     for (ii = 0; ii < no_of_nodes; ii++) {
         int v = VECTOR(order)[ii];
         VECTOR(rank)[v] = ii;
@@ -277,21 +280,21 @@ int FUNCTION(igraph_maximal_cliques, SUFFIX)(
     igraph_vector_destroy(&coreness);
     IGRAPH_FINALLY_CLEAN(1);
 
-    igraph_adjlist_init(graph, &adjlist, IGRAPH_ALL);
-
-    igraph_adjlist_simplify(&adjlist);
-    igraph_adjlist_init(graph, &fulladjlist, IGRAPH_ALL);
+    IGRAPH_CHECK(igraph_adjlist_init(graph, &adjlist, IGRAPH_ALL));
+    IGRAPH_FINALLY(igraph_adjlist_destroy, &adjlist);
+    IGRAPH_CHECK(igraph_adjlist_simplify(&adjlist));
+    IGRAPH_CHECK(igraph_adjlist_init(graph, &fulladjlist, IGRAPH_ALL));
     IGRAPH_FINALLY(igraph_adjlist_destroy, &fulladjlist);
-    igraph_adjlist_simplify(&fulladjlist);
-    igraph_vector_int_init(&PX, 20);
+    IGRAPH_CHECK(igraph_adjlist_simplify(&fulladjlist));
+    IGRAPH_CHECK(igraph_vector_int_init(&PX, 20));
     IGRAPH_FINALLY(igraph_vector_int_destroy, &PX);
-    igraph_vector_int_init(&R,  20);
+    IGRAPH_CHECK(igraph_vector_int_init(&R,  20));
     IGRAPH_FINALLY(igraph_vector_int_destroy, &R);
-    igraph_vector_int_init(&H, 100);
+    IGRAPH_CHECK(igraph_vector_int_init(&H, 100));
     IGRAPH_FINALLY(igraph_vector_int_destroy, &H);
-    igraph_vector_int_init(&pos, no_of_nodes);
+    IGRAPH_CHECK(igraph_vector_int_init(&pos, no_of_nodes));
     IGRAPH_FINALLY(igraph_vector_int_destroy, &pos);
-    igraph_vector_int_init(&nextv, 100);
+    IGRAPH_CHECK(igraph_vector_int_init(&nextv, 100));
     IGRAPH_FINALLY(igraph_vector_int_destroy, &nextv);
 
     FINALLY;
@@ -318,13 +321,13 @@ int FUNCTION(igraph_maximal_cliques, SUFFIX)(
         pg = pgreset;
     }
 
-    IGRAPH_ALLOW_INTERRUPTION();
+    IGRAPH_CHECK(igraph_i_maximal_cliques_interruption());
 
-    igraph_vector_int_resize(&PX, vdeg);
-    igraph_vector_int_resize(&R, 1);
-    igraph_vector_int_resize(&H, 1);
+    IGRAPH_CHECK(igraph_vector_int_resize(&PX, vdeg));
+    IGRAPH_CHECK(igraph_vector_int_resize(&R, 1));
+    IGRAPH_CHECK(igraph_vector_int_resize(&H, 1));
     igraph_vector_int_null(&pos); /* TODO: makes it quadratic? */
-    igraph_vector_int_resize(&nextv, 1);
+    IGRAPH_CHECK(igraph_vector_int_resize(&nextv, 1));
 
     VECTOR(H)[0] = -1;      /* marks the end of the recursion */
     VECTOR(nextv)[0] = -1;
@@ -395,7 +398,7 @@ igraph_adjlist_destroy(&fulladjlist);
 igraph_adjlist_destroy(&adjlist);
 igraph_vector_int_destroy(&rank);
 igraph_vector_destroy(&order);
-IGRAPH_FINALLY_CLEAN(10); /* + res */
+IGRAPH_FINALLY_CLEAN_TO(finally_size); /* + res, if registered */
 
 return 0;
 }
@@ -22,8 +22,260 @@
 */
 
 #include "igraph_memory.h"
+#include "igraph_error.h"
+#include "igraph_types_internal.h"
+#include "igraph_counters_internal.h"
 #include "config.h"
 
+#include <string.h>
+
+static void *igraph_i_default_malloc(size_t size, void *state) {
+    IGRAPH_UNUSED(state);
+    return malloc(size);
+}
+
+static void *igraph_i_default_calloc(size_t count, size_t size, void *state) {
+    IGRAPH_UNUSED(state);
+    return calloc(count, size);
+}
+
+static void *igraph_i_default_realloc(void *ptr, size_t size, void *state) {
+    IGRAPH_UNUSED(state);
+    return realloc(ptr, size);
+}
+
+static void igraph_i_default_free(void *ptr, void *state) {
+    IGRAPH_UNUSED(state);
+    free(ptr);
+}
+
+static const igraph_allocator_t igraph_i_default_allocator = {
+    igraph_i_default_malloc, igraph_i_default_calloc,
+    igraph_i_default_realloc, igraph_i_default_free, 0
+};
+
+static IGRAPH_THREAD_LOCAL igraph_allocator_t igraph_i_allocator = {
+    igraph_i_default_malloc, igraph_i_default_calloc,
+    igraph_i_default_realloc, igraph_i_default_free, 0
+};
+
+/* Memory accounting. When it is enabled, the size of each block allocated
+ * through igraph_malloc() and friends is recorded in an open addressing hash
+ * table keyed by the address of the block, so that igraph_free() and
+ * igraph_realloc() know how many bytes they release. Blocks that are not in
+ * the table (e.g. allocated before accounting was turned on) are ignored.
+ * The table itself is allocated directly from the C library, so it is not
+ * counted and it does not recurse into the allocator. */
+
+typedef struct igraph_i_memory_accounting_t {
+    igraph_bool_t enabled;
+    size_t current, peak, budget;
+    size_t capacity, count;     /* capacity is zero or a power of two */
+    void **blocks;
+    size_t *sizes;
+} igraph_i_memory_accounting_t;
+
+static IGRAPH_THREAD_LOCAL igraph_i_memory_accounting_t igraph_i_accounting = {
+    0, 0, 0, 0, 0, 0, 0, 0
+};
+
+static size_t igraph_i_accounting_hash(const void *ptr, size_t capacity) {
+    size_t h = (size_t) ptr >> 4;
+    h ^= h >> 16;
+    h *= (size_t) 0x45d9f3bUL;
+    h ^= h >> 16;
+    return h & (capacity - 1);
+}
+
+/* Returns the slot of ptr, or the empty slot where it would be inserted. */
+static size_t igraph_i_accounting_slot(const void *ptr) {
+    igraph_i_memory_accounting_t *acc = &igraph_i_accounting;
+    size_t mask = acc->capacity - 1;
+    size_t i = igraph_i_accounting_hash(ptr, acc->capacity);
+    while (acc->blocks[i] && acc->blocks[i] != ptr) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static int igraph_i_accounting_grow(void) {
+    igraph_i_memory_accounting_t *acc = &igraph_i_accounting;
+    size_t i, old_capacity = acc->capacity;
+    void **old_blocks = acc->blocks;
+    size_t *old_sizes = acc->sizes;
+    size_t capacity = old_capacity ? 2 * old_capacity : 1024;
+    void **blocks = calloc(capacity, sizeof(void*));
+    size_t *sizes = calloc(capacity, sizeof(size_t));
+
+    if (!blocks || !sizes) {
+        free(blocks);
+        free(sizes);
+        return 1;
+    }
+    acc->blocks = blocks;
+    acc->sizes = sizes;
+    acc->capacity = capacity;
+    for (i = 0; i < old_capacity; i++) {
+        if (old_blocks[i]) {
+            size_t j = igraph_i_accounting_slot(old_blocks[i]);
+            blocks[j] = old_blocks[i];
+            sizes[j] = old_sizes[i];
+        }
+    }
+    free(old_blocks);
+    free(old_sizes);
+    return 0;
+}
+
+/* Checks whether 'size' more bytes fit into the budget. */
+static igraph_bool_t igraph_i_accounting_fits(size_t size) {
+    igraph_i_memory_accounting_t *acc = &igraph_i_accounting;
+    return acc->budget == 0 ||
+           (size <= acc->budget && acc->current <= acc->budget - size);
+}
+
+/* Records a new block. Returns nonzero if there is no memory to do so. */
+static int igraph_i_accounting_add(void *ptr, size_t size) {
+    igraph_i_memory_accounting_t *acc = &igraph_i_accounting;
+    size_t i;
+    if (2 * (acc->count + 1) > acc->capacity && igraph_i_accounting_grow()) {
+        return 1;
+    }
+    i = igraph_i_accounting_slot(ptr);
+    if (acc->blocks[i]) {
+        /* The block at this address was released with free() instead
+           of igraph_free(), forget about it. */
+        acc->current -= acc->sizes[i];
+    } else {
+        acc->blocks[i] = ptr;
+        acc->count++;
+    }
+    acc->sizes[i] = size;
+    acc->current += size;
+    if (acc->current > acc->peak) {
+        acc->peak = acc->current;
+    }
+    return 0;
+}
+
+/* Forgets about a block and returns its size, or zero if it is unknown. */
+static size_t igraph_i_accounting_remove(void *ptr) {
+    igraph_i_memory_accounting_t *acc = &igraph_i_accounting;
+    size_t i, j, k, size, mask = acc->capacity - 1;
+
+    if (acc->count == 0) {
+        return 0;
+    }
+    i = igraph_i_accounting_slot(ptr);
+    if (!acc->blocks[i]) {
+        return 0;
+    }
+    size = acc->sizes[i];
+    acc->current -= size;
+    acc->count--;
+
+    /* Backward shift deletion keeps the probe sequences intact */
+    j = i;
+    while (1) {
+        j = (j + 1) & mask;
+        if (!acc->blocks[j]) {
+            break;
+        }
+        k = igraph_i_accounting_hash(acc->blocks[j], acc->capacity);
+        if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j))) {
+            acc->blocks[i] = acc->blocks[j];
+            acc->sizes[i] = acc->sizes[j];
+            i = j;
+        }
+    }
+    acc->blocks[i] = 0;
+    return size;
+}
+
+static void *igraph_i_accounted_alloc(size_t size, igraph_bool_t zero) {
+    void *ptr;
+    if (!igraph_i_accounting_fits(size)) {
+        return 0;
+    }
+    ptr = zero ? igraph_i_allocator.calloc_func(1, size, igraph_i_allocator.state) :
+          igraph_i_allocator.malloc_func(size, igraph_i_allocator.state);
+    if (ptr && igraph_i_accounting_add(ptr, size)) {
+        igraph_i_allocator.free_func(ptr, igraph_i_allocator.state);
+        ptr = 0;
+    }
+    return ptr;
+}
+
+static void *igraph_i_accounted_realloc(void *p, size_t size) {
+    igraph_i_memory_accounting_t *acc = &igraph_i_accounting;
+    size_t old_size = 0;
+    void *ptr;
+
+    if (p && acc->count > 0) {
+        size_t i = igraph_i_accounting_slot(p);
+        if (acc->blocks[i]) {
+            old_size = acc->sizes[i];
+        }
+    }
+    if (size > old_size && !igraph_i_accounting_fits(size - old_size)) {
+        return 0;
+    }
+    /* Make sure that the new block can be recorded before resizing */
+    if (2 * (acc->count + 1) > acc->capacity && igraph_i_accounting_grow()) {
+        return 0;
+    }
+    ptr = igraph_i_allocator.realloc_func(p, size, igraph_i_allocator.state);
+    if (ptr) {
+        if (p) {
+            igraph_i_accounting_remove(p);
+        }
+        igraph_i_accounting_add(ptr, size);
+    }
+    return ptr;
+}
+
+/**
+ * \function igraph_set_allocator
+ * \brief Replaces the functions igraph uses to allocate memory.
+ *
+ * By default igraph allocates memory with the \c malloc() family of
+ * functions of the C standard library. This function installs another
+ * set of allocation functions, e.g. a pool allocator that is faster for
+ * the many small allocations some algorithms make, or an allocator that
+ * keeps track of the memory used by igraph. If igraph is built with
+ * thread-local storage support, then the allocator is set for the calling
+ * thread only.
+ *
+ * </para><para>
+ * Memory must always be released with the allocator that allocated it.
+ * Because of this the allocator should be set before any igraph objects
+ * are created, and it should not be changed while any igraph object, or
+ * any memory returned by igraph functions, is still alive.
+ *
+ * \param allocator Pointer to the new allocator table. It is copied, so
+ *        it does not need to stay alive after the call. A null pointer
+ *        restores the default allocator of the C standard library.
+ * \param old If not a null pointer, the previously used allocator table
+ *        is stored here, so that it can be restored later.
+ * \return Error code: \c IGRAPH_EINVAL if one of the functions in the
+ *        table is missing.
+ *
+ * Time complexity: O(1).
+ */
+
+int igraph_set_allocator(const igraph_allocator_t *allocator,
+                         igraph_allocator_t *old) {
+    if (allocator && (!allocator->malloc_func || !allocator->calloc_func ||
+                      !allocator->realloc_func || !allocator->free_func)) {
+        IGRAPH_ERROR("All functions of the allocator must be given", IGRAPH_EINVAL);
+    }
+    if (old) {
+        *old = igraph_i_allocator;
+    }
+    igraph_i_allocator = allocator ? *allocator : igraph_i_default_allocator;
+    return 0;
+}
+
 /**
  * \function igraph_free
  * Deallocate memory that was allocated by igraph functions
@@ -72,7 +324,10 @@
  */
 
 int igraph_free(void *p) {
-    igraph_Free(p);
+    if (igraph_i_accounting.enabled && p) {
+        igraph_i_accounting_remove(p);
+    }
+    igraph_i_allocator.free_func(p, igraph_i_allocator.state);
     return 0;
 }
 
@@ -95,5 +350,270 @@ int igraph_free(void *p) {
  */
 
 void *igraph_malloc(size_t n) {
-    return malloc(n);
+    IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_ALLOCATED_BYTES, n);
+    if (igraph_i_accounting.enabled) {
+        return igraph_i_accounted_alloc(n, 0);
+    }
+    return igraph_i_allocator.malloc_func(n, igraph_i_allocator.state);
+}
+
+/**
+ * \function igraph_calloc
+ * Allocate zero-filled memory that can be safely deallocated by igraph functions
+ *
+ * Works like \c calloc() from the C standard library, but it uses the
+ * allocator set by \ref igraph_set_allocator().
+ *
+ * \param count Number of elements to allocate.
+ * \param size Size of one element in bytes.
+ * \return Pointer to the piece of allocated memory.
+ *
+ * \sa \ref igraph_malloc(), \ref igraph_free()
+ */
+
+void *igraph_calloc(size_t count, size_t size) {
+    IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_ALLOCATED_BYTES, (double) count * size);
+    if (igraph_i_accounting.enabled) {
+        if (size != 0 && count > (size_t) -1 / size) {
+            return 0;
+        }
+        return igraph_i_accounted_alloc(count * size, 1);
+    }
+    return igraph_i_allocator.calloc_func(count, size, igraph_i_allocator.state);
+}
+
+/**
+ * \function igraph_realloc
+ * Resize memory that was allocated by igraph functions
+ *
+ * Works like \c realloc() from the C standard library, but it uses the
+ * allocator set by \ref igraph_set_allocator().
+ *
+ * \param p Pointer to the memory to be resized, or a null pointer.
+ * \param size The new size in bytes. If it is zero and \p p is not a
+ *   null pointer, the memory is released as with \ref igraph_free(),
+ *   and a null pointer is returned.
+ * \return Pointer to the resized memory, or a null pointer if there is
+ *   not enough memory; in this case the original memory is left intact.
+ *
+ * \sa \ref igraph_malloc(), \ref igraph_free()
+ */
+
+void *igraph_realloc(void *p, size_t size) {
+    /* realloc() may or may not free the block for a zero size; free it
+       here, so that its accounting entry goes away too */
+    if (p && size == 0) {
+        igraph_free(p);
+        return 0;
+    }
+    IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_ALLOCATED_BYTES, size);
+    if (igraph_i_accounting.enabled) {
+        return igraph_i_accounted_realloc(p, size);
+    }
+    return igraph_i_allocator.realloc_func(p, size, igraph_i_allocator.state);
+}
+
+/**
+ * \function igraph_set_memory_accounting
+ * \brief Turns the accounting of the memory allocated by igraph on or off.
+ *
+ * When memory accounting is on, igraph keeps track of the number of bytes
+ * that are currently allocated through \ref igraph_malloc(), \ref
+ * igraph_calloc() and \ref igraph_realloc() and not yet released with
+ * \ref igraph_free(), as well as the largest such value. These can be
+ * queried with \ref igraph_memory_usage(). Accounting is also needed to
+ * enforce a memory budget, see \ref igraph_set_memory_budget(). If igraph
+ * is built with thread-local storage support, then the accounting is done
+ * per thread, and this function only affects the calling thread.
+ *
+ * </para><para>
+ * Accounting adds a small overhead to each allocation, so it is off by
+ * default. Memory allocated by third-party libraries that igraph uses
+ * (e.g. ARPACK workspaces allocated by the caller, or the internal
+ * allocations of C++ components) is not counted. Memory that is released
+ * with \c free() instead of \ref igraph_free() is counted as in use until
+ * its address is reused by igraph.
+ *
+ * </para><para>
+ * Turning accounting off forgets about all blocks and resets the counters
+ * and the budget to zero. Turning it on when it is already on does nothing.
+ *
+ * \param enabled Whether to turn accounting on or off.
+ * \return Error code: \c IGRAPH_ENOMEM if there is not enough memory for
+ *    the bookkeeping.
+ *
+ * Time complexity: O(1).
+ *
+ * \sa \ref igraph_memory_usage(), \ref igraph_set_memory_budget().
+ */
+
+int igraph_set_memory_accounting(igraph_bool_t enabled) {
+    igraph_i_memory_accounting_t *acc = &igraph_i_accounting;
+    if (enabled) {
+        if (!acc->enabled) {
+            if (acc->capacity == 0 && igraph_i_accounting_grow()) {
+                IGRAPH_ERROR("Cannot turn on memory accounting", IGRAPH_ENOMEM);
+            }
+            acc->enabled = 1;
+        }
+    } else {
+        free(acc->blocks);
+        free(acc->sizes);
+        memset(acc, 0, sizeof(igraph_i_memory_accounting_t));
+    }
+    return 0;
+}
+
+/**
+ * \function igraph_set_memory_budget
+ * \brief Limits the amount of memory igraph may allocate.
+ *
+ * Once a budget is set, any allocation through \ref igraph_malloc(), \ref
+ * igraph_calloc() or \ref igraph_realloc() that would make the memory in
+ * use, as reported by \ref igraph_memory_usage(), larger than the budget
+ * fails and returns a null pointer. igraph functions report this as an
+ * \c IGRAPH_ENOMEM error, and release their temporary memory as for any
+ * other error, so the budget can be used to run algorithms safely on
+ * inputs of unknown size. Note that the default error handler aborts the
+ * program, see \ref igraph_set_error_handler().
+ *
+ * </para><para>
+ * Setting a nonzero budget also turns on memory accounting, see \ref
+ * igraph_set_memory_accounting(). Memory allocated before accounting was
+ * turned on does not count towards the budget. If igraph is built with
+ * thread-local storage support, then the budget applies to the calling
+ * thread only.
+ *
+ * \param budget The maximum number of bytes in use, zero means no limit.
+ *    It may be smaller than the memory currently in use, in which case
+ *    all new allocations fail until enough memory is released.
+ * \param old If not a null pointer, the previous budget is stored here.
+ * \return Error code: \c IGRAPH_ENOMEM if there is not enough memory to
+ *    turn on accounting.
+ *
+ * Time complexity: O(1).
+ */
+
+int igraph_set_memory_budget(size_t budget, size_t *old) {
+    if (old) {
+        *old = igraph_i_accounting.budget;
+    }
+    if (budget > 0) {
+        IGRAPH_CHECK(igraph_set_memory_accounting(1));
+    }
+    igraph_i_accounting.budget = budget;
+    return 0;
+}
+
+/**
+ * \function igraph_memory_usage
+ * \brief The amount of memory allocated by igraph.
+ *
+ * Both numbers are zero if memory accounting is off, see \ref
+ * igraph_set_memory_accounting().
+ *
+ * \param current If not a null pointer, the number of bytes currently
+ *    in use is stored here.
+ * \param peak If not a null pointer, the largest number of bytes in use
+ *    since accounting was turned on, or since the last call to \ref
+ *    igraph_memory_reset_peak(), is stored here.
+ *
+ * Time complexity: O(1).
+ */
+
+void igraph_memory_usage(size_t *current, size_t *peak) {
+    if (current) {
+        *current = igraph_i_accounting.current;
+    }
+    if (peak) {
+        *peak = igraph_i_accounting.peak;
+    }
+}
+
+/**
+ * \function igraph_memory_reset_peak
+ * \brief Resets the peak memory usage to the current usage.
+ *
+ * This is useful for measuring the peak memory usage of a single
+ * function call.
+ *
+ * Time complexity: O(1).
+ */
+
+void igraph_memory_reset_peak(void) {
+    igraph_i_accounting.peak = igraph_i_accounting.current;
+}
+
+/* Arena allocator. The memory is carved out of large blocks, and it is
+ * released all at once, which is much cheaper than many small calls to
+ * the allocator. Blocks are linked through their header, and each new
+ * block is at least twice as large as the previous one. */
+
+struct igraph_i_arena_block_t {
+    struct igraph_i_arena_block_t *prev;
+    size_t size, used;
+};
+
+/* Allocations are aligned to this many bytes */
+#define IGRAPH_I_ARENA_ALIGN 16
+#define IGRAPH_I_ARENA_ROUND(n) \
+    (((n) + IGRAPH_I_ARENA_ALIGN - 1) & ~((size_t) IGRAPH_I_ARENA_ALIGN - 1))
+#define IGRAPH_I_ARENA_HEADER IGRAPH_I_ARENA_ROUND(sizeof(struct igraph_i_arena_block_t))
+
+int igraph_arena_init(igraph_arena_t *arena, size_t block_size) {
+    arena->block = 0;
+    arena->block_size = block_size > 0 ? IGRAPH_I_ARENA_ROUND(block_size) : 4096;
+    return 0;
+}
+
+void igraph_arena_destroy(igraph_arena_t *arena) {
+    struct igraph_i_arena_block_t *block = arena->block;
+    while (block) {
+        struct igraph_i_arena_block_t *prev = block->prev;
+        igraph_free(block);
+        block = prev;
+    }
+    arena->block = 0;
+}
+
+void igraph_arena_reset(igraph_arena_t *arena) {
+    /* keep the last, largest block, release the others */
+    if (arena->block) {
+        struct igraph_i_arena_block_t *block = arena->block->prev;
+        while (block) {
+            struct igraph_i_arena_block_t *prev = block->prev;
+            igraph_free(block);
+            block = prev;
+        }
+        arena->block->prev = 0;
+        arena->block->used = 0;
+    }
+}
+
+void *igraph_arena_alloc(igraph_arena_t *arena, size_t size) {
+    struct igraph_i_arena_block_t *block = arena->block;
+    void *res;
+
+    size = IGRAPH_I_ARENA_ROUND(size > 0 ? size : 1);
+    if (!block || block->size - block->used < size) {
+        size_t block_size = arena->block_size;
+        if (block && block_size < 2 * block->size) {
+            block_size = 2 * block->size;
+        }
+        if (block_size < size) {
+            block_size = size;
+        }
+        block = igraph_malloc(IGRAPH_I_ARENA_HEADER + block_size);
+        if (!block) {
+            return 0;
+        }
+        block->prev = arena->block;
+        block->size = block_size;
+        block->used = 0;
+        arena->block = block;
+    }
+
+    res = (char*) block + IGRAPH_I_ARENA_HEADER + block->used;
+    block->used += size;
+    return res;
 }
@@ -30,9 +30,8 @@
 #include "igraph_adjlist.h"
 #include "igraph_attributes.h"
 #include "igraph_conversion.h"
-#include "igraph_qsort.h"
+#include "igraph_interface_internal.h"
 #include "config.h"
-#include <limits.h>
 
 /**
  * \function igraph_disjoint_union
@@ -183,212 +182,85 @@ int igraph_disjoint_union_many(igraph_t *res,
     return 0;
 }
 
-static int igraph_i_order_edgelist_cmp(void *edges, const void *e1, const void *e2) {
-    igraph_vector_t *edgelist = edges;
-    long int edge1 = (*(const long int*) e1) * 2;
-    long int edge2 = (*(const long int*) e2) * 2;
-    long int from1 = VECTOR(*edgelist)[edge1];
-    long int from2 = VECTOR(*edgelist)[edge2];
-    if (from1 < from2) {
-        return -1;
-    } else if (from1 > from2) {
-        return 1;
-    } else {
-        long int to1 = VECTOR(*edgelist)[edge1 + 1];
-        long int to2 = VECTOR(*edgelist)[edge2 + 1];
-        if (to1 < to2) {
-            return -1;
-        } else if (to1 > to2) {
-            return 1;
-        } else {
-            return 0;
+/* Turns a map from the edges of an operand to the edges of the result
+   (or -1) into a map from the edges of the result to the edges of the
+   operand; every edge of the result must have exactly one edge mapped
+   to it. */
+
+static int igraph_i_invert_edge_map(const igraph_vector_t *map,
+                                    igraph_vector_t *res,
+                                    long int no_of_edges) {
+    long int i, n = igraph_vector_size(map);
+    IGRAPH_CHECK(igraph_vector_resize(res, no_of_edges));
+    for (i = 0; i < n; i++) {
+        if (VECTOR(*map)[i] >= 0) {
+            VECTOR(*res)[(long int) VECTOR(*map)[i]] = i;
         }
     }
+    return 0;
 }
 
-#define IGRAPH_MODE_UNION        1
-#define IGRAPH_MODE_INTERSECTION 2
+/* Union or intersection of two graphs. The edges of the result are
+   sorted by their smaller (undirected) or source (directed) vertex,
+   then by the other one. */
 
-static int igraph_i_merge(igraph_t *res, int mode,
+static int igraph_i_merge(igraph_t *res, igraph_i_merge_mode_t mode,
                           const igraph_t *left, const igraph_t *right,
                           igraph_vector_t *edge_map1, igraph_vector_t *edge_map2) {
 
     long int no_of_nodes_left = igraph_vcount(left);
     long int no_of_nodes_right = igraph_vcount(right);
     long int no_of_nodes;
-    long int no_edges_left = igraph_ecount(left);
-    long int no_edges_right = igraph_ecount(right);
     igraph_bool_t directed = igraph_is_directed(left);
-    igraph_vector_t edges;
-    igraph_vector_t edges1, edges2;
-    igraph_vector_long_t order1, order2;
-    long int i, j, eptr = 0;
-    long int idx1, idx2, edge1 = -1, edge2 = -1, from1 = -1, from2 = -1, to1 = -1, to2 = -1;
-    igraph_bool_t l;
+    const igraph_t *graphs_array[2];
+    igraph_vector_t *maps_array[2];
+    igraph_vector_ptr_t graphs, maps;
+    igraph_vector_t map1, map2;
 
     if (directed != igraph_is_directed(right)) {
         IGRAPH_ERROR("Cannot make union or intersection of directed "
                      "and undirected graph", IGRAPH_EINVAL);
     }
 
-    IGRAPH_VECTOR_INIT_FINALLY(&edges, 0);
-    IGRAPH_VECTOR_INIT_FINALLY(&edges1, no_edges_left * 2);
-    IGRAPH_VECTOR_INIT_FINALLY(&edges2, no_edges_right * 2);
-    IGRAPH_CHECK(igraph_vector_long_init(&order1, no_edges_left));
-    IGRAPH_FINALLY(igraph_vector_long_destroy, &order1);
-    IGRAPH_CHECK(igraph_vector_long_init(&order2, no_edges_right));
-    IGRAPH_FINALLY(igraph_vector_long_destroy, &order2);
-
-    if (edge_map1) {
-        switch (mode) {
-        case IGRAPH_MODE_UNION:
-            IGRAPH_CHECK(igraph_vector_resize(edge_map1, no_edges_left));
-            break;
-        case IGRAPH_MODE_INTERSECTION:
-            igraph_vector_clear(edge_map1);
-            break;
-        }
-    }
-    if (edge_map2) {
-        switch (mode) {
-        case IGRAPH_MODE_UNION:
-            IGRAPH_CHECK(igraph_vector_resize(edge_map2, no_edges_right));
-            break;
-        case IGRAPH_MODE_INTERSECTION:
-            igraph_vector_clear(edge_map2);
-            break;
-        }
-    }
-
     no_of_nodes = no_of_nodes_left > no_of_nodes_right ?
                   no_of_nodes_left : no_of_nodes_right;
 
-    /* We merge the two edge lists. We need to sort them first.
-       For undirected graphs, we also need to make sure that
-       for every edge, that larger (non-smaller) vertex id is in the
-       second column. */
-
-    IGRAPH_CHECK(igraph_get_edgelist(left, &edges1, /*bycol=*/ 0));
-    IGRAPH_CHECK(igraph_get_edgelist(right, &edges2, /*bycol=*/ 0));
-    if (!directed) {
-        for (i = 0, j = 0; i < no_edges_left; i++, j += 2) {
-            if (VECTOR(edges1)[j] > VECTOR(edges1)[j + 1]) {
-                long int tmp = VECTOR(edges1)[j];
-                VECTOR(edges1)[j] = VECTOR(edges1)[j + 1];
-                VECTOR(edges1)[j + 1] = tmp;
-            }
-        }
-        for (i = 0, j = 0; i < no_edges_right; i++, j += 2) {
-            if (VECTOR(edges2)[j] > VECTOR(edges2)[j + 1]) {
-                long int tmp = VECTOR(edges2)[j];
-                VECTOR(edges2)[j] = VECTOR(edges2)[j + 1];
-                VECTOR(edges2)[j + 1] = tmp;
-            }
-        }
-    }
-
-    for (i = 0; i < no_edges_left; i++) {
-        VECTOR(order1)[i] = i;
-    }
-    for (i = 0; i < no_edges_right; i++) {
-        VECTOR(order2)[i] = i;
-    }
+    graphs_array[0] = left;
+    graphs_array[1] = right;
+    igraph_vector_ptr_view(&graphs, (void **) graphs_array, 2);
 
-    igraph_qsort_r(VECTOR(order1), no_edges_left, sizeof(VECTOR(order1)[0]),
-                   &edges1, igraph_i_order_edgelist_cmp);
-    igraph_qsort_r(VECTOR(order2), no_edges_right, sizeof(VECTOR(order2)[0]),
-                   &edges2, igraph_i_order_edgelist_cmp);
-
-#define INC1() if ( (++idx1) < no_edges_left) {          \
-        edge1 = VECTOR(order1)[idx1];                \
-        from1 = VECTOR(edges1)[2*edge1];                 \
-        to1 = VECTOR(edges1)[2*edge1+1];                 \
-    }
-#define INC2() if ( (++idx2) < no_edges_right) {         \
-        edge2 = VECTOR(order2)[idx2];                \
-        from2 = VECTOR(edges2)[2*edge2];                 \
-        to2 = VECTOR(edges2)[2*edge2+1];                 \
+    /* The intersection returns the maps in the other direction, from
+       the edges of the result to the edges of the operands */
+    if (mode == IGRAPH_I_MERGE_UNION) {
+        maps_array[0] = edge_map1;
+        maps_array[1] = edge_map2;
+    } else {
+        maps_array[0] = edge_map1 ? &map1 : 0;
+        maps_array[1] = edge_map2 ? &map2 : 0;
     }
+    igraph_vector_ptr_view(&maps, (void **) maps_array, 2);
+    IGRAPH_VECTOR_INIT_FINALLY(&map1, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&map2, 0);
 
-    idx1 = idx2 = -1;
-    INC1();
-    INC2();
-
-#define CONT() switch (mode) {              \
-    case IGRAPH_MODE_UNION:                \
-        l = idx1 < no_edges_left || idx2 < no_edges_right;   \
-        break;                       \
-    case IGRAPH_MODE_INTERSECTION:             \
-        l = idx1 < no_edges_left && idx2 < no_edges_right;   \
-        break;                       \
-    }
+    IGRAPH_CHECK(igraph_i_merge_sorted(res, &graphs, no_of_nodes, directed,
+                                       mode, /* desc_vertices= */ 0,
+                                       /* desc_neighbors= */ 0, &maps));
+    IGRAPH_FINALLY(igraph_destroy, res);
 
-    CONT();
-    while (l) {
-        if (idx2 >= no_edges_right ||
-            (idx1 < no_edges_left && from1 < from2) ||
-            (idx1 < no_edges_left && from1 == from2 && to1 < to2)) {
-            /* Edge from first graph */
-            if (mode == IGRAPH_MODE_UNION) {
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, from1));
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, to1));
-                if (edge_map1) {
-                    VECTOR(*edge_map1)[edge1] = eptr;
-                }
-                eptr++;
-            }
-            INC1();
-        } else if (idx1 >= no_edges_left ||
-                   (idx2 < no_edges_right && from2 < from1) ||
-                   (idx2 < no_edges_right && from1 == from2 && to2 < to1)) {
-            /* Edge from second graph */
-            if (mode == IGRAPH_MODE_UNION) {
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, from2));
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, to2));
-                if (edge_map2) {
-                    VECTOR(*edge_map2)[edge2] = eptr;
-                }
-                eptr++;
-            }
-            INC2();
-        } else {
-            /* Edge from both */
-            IGRAPH_CHECK(igraph_vector_push_back(&edges, from1));
-            IGRAPH_CHECK(igraph_vector_push_back(&edges, to1));
-            if (mode == IGRAPH_MODE_UNION) {
-                if (edge_map1) {
-                    VECTOR(*edge_map1)[edge1] = eptr;
-                }
-                if (edge_map2) {
-                    VECTOR(*edge_map2)[edge2] = eptr;
-                }
-            } else if (mode == IGRAPH_MODE_INTERSECTION) {
-                if (edge_map1) {
-                    IGRAPH_CHECK(igraph_vector_push_back(edge_map1, edge1));
-                }
-                if (edge_map2) {
-                    IGRAPH_CHECK(igraph_vector_push_back(edge_map2, edge2));
-                }
-            }
-            eptr++;
-            INC1();
-            INC2();
+    if (mode == IGRAPH_I_MERGE_INTERSECTION) {
+        if (edge_map1) {
+            IGRAPH_CHECK(igraph_i_invert_edge_map(&map1, edge_map1,
+                                                  igraph_ecount(res)));
+        }
+        if (edge_map2) {
+            IGRAPH_CHECK(igraph_i_invert_edge_map(&map2, edge_map2,
+                                                  igraph_ecount(res)));
         }
-        CONT();
     }
 
-#undef INC1
-#undef INC2
-
-    igraph_vector_long_destroy(&order2);
-    igraph_vector_long_destroy(&order1);
-    igraph_vector_destroy(&edges2);
-    igraph_vector_destroy(&edges1);
-    IGRAPH_FINALLY_CLEAN(4);
-
-    IGRAPH_CHECK(igraph_create(res, &edges, no_of_nodes, directed));
-    igraph_vector_destroy(&edges);
-    IGRAPH_FINALLY_CLEAN(1);
+    igraph_vector_destroy(&map2);
+    igraph_vector_destroy(&map1);
+    IGRAPH_FINALLY_CLEAN(3);   /* + res */
     return 0;
 }
 
@@ -426,32 +298,10 @@ int igraph_intersection(igraph_t *res,
                         const igraph_t *left, const igraph_t *right,
                         igraph_vector_t *edge_map1,
                         igraph_vector_t *edge_map2) {
-    return igraph_i_merge(res, IGRAPH_MODE_INTERSECTION, left, right,
+    return igraph_i_merge(res, IGRAPH_I_MERGE_INTERSECTION, left, right,
                           edge_map1, edge_map2);
 }
 
-static void igraph_i_union_many_free(igraph_vector_ptr_t *v) {
-    long int i, n = igraph_vector_ptr_size(v);
-    for (i = 0; i < n; i++) {
-        if (VECTOR(*v)[i] != 0) {
-            igraph_vector_destroy(VECTOR(*v)[i]);
-            igraph_Free(VECTOR(*v)[i]);
-        }
-    }
-    igraph_vector_ptr_destroy(v);
-}
-
-static void igraph_i_union_many_free2(igraph_vector_ptr_t *v) {
-    long int i, n = igraph_vector_ptr_size(v);
-    for (i = 0; i < n; i++) {
-        if (VECTOR(*v)[i] != 0) {
-            igraph_vector_long_destroy(VECTOR(*v)[i]);
-            igraph_Free(VECTOR(*v)[i]);
-        }
-    }
-    igraph_vector_ptr_destroy(v);
-}
-
 static void igraph_i_union_many_free3(igraph_vector_ptr_t *v) {
     long int i, n = igraph_vector_ptr_size(v);
     for (i = 0; i < n; i++) {
@@ -502,12 +352,7 @@ int igraph_intersection_many(igraph_t *res,
     long int no_of_graphs = igraph_vector_ptr_size(graphs);
     long int no_of_nodes = 0;
     igraph_bool_t directed = 1;
-    igraph_vector_t edges;
-    igraph_vector_ptr_t edge_vects, order_vects;
-    long int i, j, tailfrom = no_of_graphs > 0 ? 0 : -1, tailto = -1;
-    igraph_vector_long_t no_edges;
-    igraph_bool_t allne = no_of_graphs == 0 ? 0 : 1, allsame = 0;
-    long int idx = 0;
+    long int i;
 
     /* Check directedness */
     if (no_of_graphs != 0) {
@@ -526,18 +371,12 @@ int igraph_intersection_many(igraph_t *res,
         IGRAPH_FINALLY(igraph_i_union_many_free3, edgemaps);
     }
 
-    IGRAPH_VECTOR_INIT_FINALLY(&edges, 0);
-    IGRAPH_CHECK(igraph_vector_long_init(&no_edges, no_of_graphs));
-    IGRAPH_FINALLY(igraph_vector_long_destroy, &no_edges);
-
-    /* Calculate number of nodes, query number of edges */
+    /* Calculate number of nodes */
     for (i = 0; i < no_of_graphs; i++) {
         long int n = igraph_vcount(VECTOR(*graphs)[i]);
         if (n > no_of_nodes) {
             no_of_nodes = n;
         }
-        VECTOR(no_edges)[i] = igraph_ecount(VECTOR(*graphs)[i]);
-        allne = allne && VECTOR(no_edges)[i] > 0;
     }
 
     if (edgemaps) {
@@ -546,142 +385,18 @@ int igraph_intersection_many(igraph_t *res,
             if (!VECTOR(*edgemaps)[i]) {
                 IGRAPH_ERROR("Cannot intersect graphs", IGRAPH_ENOMEM);
             }
-            IGRAPH_CHECK(igraph_vector_init(VECTOR(*edgemaps)[i],
-                                            VECTOR(no_edges)[i]));
-            igraph_vector_fill(VECTOR(*edgemaps)[i], -1);
-        }
-    }
-
-    /* Allocate memory for the edge lists and their index vectors */
-    if (no_of_graphs != 0) {
-        IGRAPH_CHECK(igraph_vector_ptr_init(&edge_vects, no_of_graphs));
-        IGRAPH_FINALLY(igraph_i_union_many_free, &edge_vects);
-        IGRAPH_CHECK(igraph_vector_ptr_init(&order_vects, no_of_graphs));
-        IGRAPH_FINALLY(igraph_i_union_many_free2, &order_vects);
-    }
-    for (i = 0; i < no_of_graphs; i++) {
-        VECTOR(edge_vects)[i] = igraph_Calloc(1, igraph_vector_t);
-        VECTOR(order_vects)[i] = igraph_Calloc(1, igraph_vector_long_t);
-        if (! VECTOR(edge_vects)[i] || ! VECTOR(order_vects)[i]) {
-            IGRAPH_ERROR("Cannot intersect graphs", IGRAPH_ENOMEM);
-        }
-        IGRAPH_CHECK(igraph_vector_init(VECTOR(edge_vects)[i],
-                                        2 * VECTOR(no_edges)[i]));
-        IGRAPH_CHECK(igraph_vector_long_init(VECTOR(order_vects)[i],
-                                             VECTOR(no_edges)[i]));
-    }
-
-    /* Query and sort the edge lists */
-    for (i = 0; i < no_of_graphs; i++) {
-        long int k, j, n = VECTOR(no_edges)[i];
-        igraph_vector_t *edges = VECTOR(edge_vects)[i];
-        igraph_vector_long_t *order = VECTOR(order_vects)[i];
-        IGRAPH_CHECK(igraph_get_edgelist(VECTOR(*graphs)[i], edges, /*bycol=*/0));
-        if (!directed) {
-            for (k = 0, j = 0; k < n; k++, j += 2) {
-                if (VECTOR(*edges)[j] > VECTOR(*edges)[j + 1]) {
-                    long int tmp = VECTOR(*edges)[j];
-                    VECTOR(*edges)[j] = VECTOR(*edges)[j + 1];
-                    VECTOR(*edges)[j + 1] = tmp;
-                }
-            }
-        }
-        for (k = 0; k < n; k++) {
-            VECTOR(*order)[k] = k;
-        }
-        igraph_qsort_r(VECTOR(*order), n, sizeof(VECTOR(*order)[0]), edges,
-                       igraph_i_order_edgelist_cmp);
-    }
-
-    /* Do the merge. We work from the end of the edge lists,
-       because then we don't have to keep track of where we are right
-       now in the edge and order lists. We find the "largest" edge,
-       and if it is present in all graphs, then we copy it to the
-       result. We remove all instances of this edge.  */
-
-    while (allne) {
-
-        /* Look for the smallest tail element */
-        for (j = 0, tailfrom = LONG_MAX, tailto = LONG_MAX; j < no_of_graphs; j++) {
-            long int edge = igraph_vector_long_tail(VECTOR(order_vects)[j]);
-            igraph_vector_t *ev = VECTOR(edge_vects)[j];
-            long int from = VECTOR(*ev)[2 * edge];
-            long int to = VECTOR(*ev)[2 * edge + 1];
-            if (from < tailfrom || (from == tailfrom && to < tailto)) {
-                tailfrom = from; tailto = to;
-            }
-        }
-
-        /* OK, now remove all elements from the tail(s) that are bigger
-           than the smallest tail element. */
-        for (j = 0, allsame = 1; j < no_of_graphs; j++) {
-            long int from = -1, to = -1;
-            while (1) {
-                long int edge = igraph_vector_long_tail(VECTOR(order_vects)[j]);
-                igraph_vector_t *ev = VECTOR(edge_vects)[j];
-                from = VECTOR(*ev)[2 * edge];
-                to = VECTOR(*ev)[2 * edge + 1];
-                if (from > tailfrom || (from == tailfrom && to > tailto)) {
-                    igraph_vector_long_pop_back(VECTOR(order_vects)[j]);
-                    if (igraph_vector_long_empty(VECTOR(order_vects)[j])) {
-                        allne = 0;
-                        break;
-                    }
-                } else {
-                    break;
-                }
-            }
-            if (from != tailfrom || to != tailto) {
-                allsame = 0;
-            }
-        }
-
-        /* Add the edge, if the smallest tail element was present
-           in all graphs. */
-        if (allsame) {
-            IGRAPH_CHECK(igraph_vector_push_back(&edges, tailfrom));
-            IGRAPH_CHECK(igraph_vector_push_back(&edges, tailto));
-        }
-
-        /* Drop edges matching the smalles tail elements
-           from the order vectors, build edge maps */
-        if (allne) {
-            for (j = 0; j < no_of_graphs; j++) {
-                long int edge = igraph_vector_long_tail(VECTOR(order_vects)[j]);
-                igraph_vector_t *ev = VECTOR(edge_vects)[j];
-                long int from = VECTOR(*ev)[2 * edge];
-                long int to = VECTOR(*ev)[2 * edge + 1];
-                if (from == tailfrom && to == tailto) {
-                    igraph_vector_long_pop_back(VECTOR(order_vects)[j]);
-                    if (igraph_vector_long_empty(VECTOR(order_vects)[j])) {
-                        allne = 0;
-                    }
-                    if (edgemaps && allsame) {
-                        igraph_vector_t *map = VECTOR(*edgemaps)[j];
-                        VECTOR(*map)[edge] = idx;
-                    }
-                }
-            }
-            if (allsame) {
-                idx++;
-            }
+            IGRAPH_CHECK(igraph_vector_init(VECTOR(*edgemaps)[i], 0));
         }
-
-    } /* while allne */
-
-    if (no_of_graphs > 0) {
-        igraph_i_union_many_free2(&order_vects);
-        igraph_i_union_many_free(&edge_vects);
-        IGRAPH_FINALLY_CLEAN(2);
     }
 
-    igraph_vector_long_destroy(&no_edges);
-    IGRAPH_FINALLY_CLEAN(1);
+    /* Merge the sorted edge lists, from the largest edge to the
+       smallest one */
+    IGRAPH_CHECK(igraph_i_merge_sorted(res, graphs,
+                                       (igraph_integer_t) no_of_nodes, directed,
+                                       IGRAPH_I_MERGE_INTERSECTION,
+                                       /* desc_vertices= */ 1,
+                                       /* desc_neighbors= */ 1, edgemaps));
 
-    IGRAPH_CHECK(igraph_create(res, &edges, (igraph_integer_t) no_of_nodes,
-                               directed));
-    igraph_vector_destroy(&edges);
-    IGRAPH_FINALLY_CLEAN(1);
     if (edgemaps) {
         IGRAPH_FINALLY_CLEAN(1);
     }
@@ -722,7 +437,7 @@ int igraph_intersection_many(igraph_t *res,
 int igraph_union(igraph_t *res,
                  const igraph_t *left, const igraph_t *right,
                  igraph_vector_t *edge_map1, igraph_vector_t *edge_map2) {
-    return igraph_i_merge(res, IGRAPH_MODE_UNION, left, right,
+    return igraph_i_merge(res, IGRAPH_I_MERGE_UNION, left, right,
                           edge_map1, edge_map2);
 }
 
@@ -765,11 +480,7 @@ int igraph_union_many(igraph_t *res, const igraph_vector_ptr_t *graphs,
     long int no_of_graphs = igraph_vector_ptr_size(graphs);
     long int no_of_nodes = 0;
     igraph_bool_t directed = 1;
-    igraph_vector_t edges;
-    igraph_vector_ptr_t edge_vects, order_vects;
-    igraph_vector_long_t no_edges;
-    long int i, j, tailfrom = no_of_graphs > 0 ? 0 : -1, tailto = -1;
-    long int idx = 0;
+    long int i;
 
     /* Check directedness */
     if (no_of_graphs != 0) {
@@ -789,17 +500,12 @@ int igraph_union_many(igraph_t *res, const igraph_vector_ptr_t *graphs,
         IGRAPH_FINALLY(igraph_i_union_many_free3, edgemaps);
     }
 
-    IGRAPH_VECTOR_INIT_FINALLY(&edges, 0);
-    IGRAPH_CHECK(igraph_vector_long_init(&no_edges, no_of_graphs));
-    IGRAPH_FINALLY(igraph_vector_long_destroy, &no_edges);
-
-    /* Calculate number of nodes, query number of edges */
+    /* Calculate number of nodes */
     for (i = 0; i < no_of_graphs; i++) {
         long int n = igraph_vcount(VECTOR(*graphs)[i]);
         if (n > no_of_nodes) {
             no_of_nodes = n;
         }
-        VECTOR(no_edges)[i] = igraph_ecount(VECTOR(*graphs)[i]);
     }
 
     if (edgemaps) {
@@ -808,108 +514,18 @@ int igraph_union_many(igraph_t *res, const igraph_vector_ptr_t *graphs,
             if (!VECTOR(*edgemaps)[i]) {
                 IGRAPH_ERROR("Cannot union graphs", IGRAPH_ENOMEM);
             }
-            IGRAPH_CHECK(igraph_vector_init(VECTOR(*edgemaps)[i],
-                                            VECTOR(no_edges)[i]));
-        }
-    }
-
-    /* Allocate memory for the edge lists and their index vectors */
-    if (no_of_graphs != 0) {
-        IGRAPH_CHECK(igraph_vector_ptr_init(&edge_vects, no_of_graphs));
-        IGRAPH_FINALLY(igraph_i_union_many_free, &edge_vects);
-        IGRAPH_CHECK(igraph_vector_ptr_init(&order_vects, no_of_graphs));
-        IGRAPH_FINALLY(igraph_i_union_many_free2, &order_vects);
-    }
-    for (i = 0; i < no_of_graphs; i++) {
-        VECTOR(edge_vects)[i] = igraph_Calloc(1, igraph_vector_t);
-        VECTOR(order_vects)[i] = igraph_Calloc(1, igraph_vector_long_t);
-        if (! VECTOR(edge_vects)[i] || ! VECTOR(order_vects)[i]) {
-            IGRAPH_ERROR("Cannot union graphs", IGRAPH_ENOMEM);
-        }
-        IGRAPH_CHECK(igraph_vector_init(VECTOR(edge_vects)[i],
-                                        2 * VECTOR(no_edges)[i]));
-        IGRAPH_CHECK(igraph_vector_long_init(VECTOR(order_vects)[i],
-                                             VECTOR(no_edges)[i]));
-    }
-
-    /* Query and sort the edge lists */
-    for (i = 0; i < no_of_graphs; i++) {
-        long int k, j, n = VECTOR(no_edges)[i];
-        igraph_vector_t *edges = VECTOR(edge_vects)[i];
-        igraph_vector_long_t *order = VECTOR(order_vects)[i];
-        IGRAPH_CHECK(igraph_get_edgelist(VECTOR(*graphs)[i], edges, /*bycol=*/0));
-        if (!directed) {
-            for (k = 0, j = 0; k < n; k++, j += 2) {
-                if (VECTOR(*edges)[j] > VECTOR(*edges)[j + 1]) {
-                    long int tmp = VECTOR(*edges)[j];
-                    VECTOR(*edges)[j] = VECTOR(*edges)[j + 1];
-                    VECTOR(*edges)[j + 1] = tmp;
-                }
-            }
-        }
-        for (k = 0; k < n; k++) {
-            VECTOR(*order)[k] = k;
-        }
-        igraph_qsort_r(VECTOR(*order), n, sizeof(VECTOR(*order)[0]), edges,
-                       igraph_i_order_edgelist_cmp);
-    }
-
-    while (tailfrom >= 0) {
-
-        /* Get the largest tail element */
-        tailfrom = tailto = -1;
-        for (j = 0; j < no_of_graphs; j++) {
-            if (!igraph_vector_long_empty(VECTOR(order_vects)[j])) {
-                long int edge = igraph_vector_long_tail(VECTOR(order_vects)[j]);
-                igraph_vector_t *ev = VECTOR(edge_vects)[j];
-                long int from = VECTOR(*ev)[2 * edge];
-                long int to = VECTOR(*ev)[2 * edge + 1];
-                if (from > tailfrom || (from == tailfrom && to > tailto)) {
-                    tailfrom = from; tailto = to;
-                }
-            }
-        }
-        if (tailfrom < 0) {
-            continue;
-        }
-
-        /* add the edge */
-        IGRAPH_CHECK(igraph_vector_push_back(&edges, tailfrom));
-        IGRAPH_CHECK(igraph_vector_push_back(&edges, tailto));
-
-        /* update edge lists, we just modify the 'order' vectors */
-        for (j = 0; j < no_of_graphs; j++) {
-            if (!igraph_vector_long_empty(VECTOR(order_vects)[j])) {
-                long int edge = igraph_vector_long_tail(VECTOR(order_vects)[j]);
-                igraph_vector_t *ev = VECTOR(edge_vects)[j];
-                long int from = VECTOR(*ev)[2 * edge];
-                long int to = VECTOR(*ev)[2 * edge + 1];
-                if (from == tailfrom && to == tailto) {
-                    igraph_vector_long_pop_back(VECTOR(order_vects)[j]);
-                    if (edgemaps) {
-                        igraph_vector_t *map = VECTOR(*edgemaps)[j];
-                        VECTOR(*map)[edge] = idx;
-                    }
-                }
-            }
+            IGRAPH_CHECK(igraph_vector_init(VECTOR(*edgemaps)[i], 0));
         }
-        idx++;
-
     }
 
-    if (no_of_graphs > 0) {
-        igraph_i_union_many_free2(&order_vects);
-        igraph_i_union_many_free(&edge_vects);
-        IGRAPH_FINALLY_CLEAN(2);
-    }
-
-    igraph_vector_long_destroy(&no_edges);
-    IGRAPH_FINALLY_CLEAN(1);
+    /* Merge the sorted edge lists, from the largest edge to the
+       smallest one */
+    IGRAPH_CHECK(igraph_i_merge_sorted(res, graphs,
+                                       (igraph_integer_t) no_of_nodes, directed,
+                                       IGRAPH_I_MERGE_UNION,
+                                       /* desc_vertices= */ 1,
+                                       /* desc_neighbors= */ 1, edgemaps));
 
-    IGRAPH_CHECK(igraph_create(res, &edges, (igraph_integer_t) no_of_nodes,
-                               directed));
-    igraph_vector_destroy(&edges);
-    IGRAPH_FINALLY_CLEAN(1);
     if (edgemaps) {
         IGRAPH_FINALLY_CLEAN(1);
     }
@@ -945,128 +561,50 @@ int igraph_union_many(igraph_t *res, const igraph_vector_ptr_t *graphs,
 int igraph_difference(igraph_t *res,
                       const igraph_t *orig, const igraph_t *sub) {
 
-    /* Quite nasty, but we will use that an edge adjacency list
-       contains the vertices according to the order of the
-       vertex ids at the "other" end of the edge. */
-
-    long int no_of_nodes_orig = igraph_vcount(orig);
-    long int no_of_nodes_sub = igraph_vcount(sub);
-    long int no_of_nodes = no_of_nodes_orig;
-    long int smaller_nodes;
+    long int no_of_nodes = igraph_vcount(orig);
     igraph_bool_t directed = igraph_is_directed(orig);
-    igraph_vector_t edges;
-    igraph_vector_t edge_ids;
-    igraph_vector_int_t *nei1, *nei2;
-    igraph_inclist_t inc_orig, inc_sub;
-    long int i;
-    igraph_integer_t v1, v2;
+    const igraph_t *graphs_array[2];
+    igraph_vector_t *maps_array[2];
+    igraph_vector_ptr_t graphs, maps;
+    igraph_vector_t map, edge_ids;
 
     if (directed != igraph_is_directed(sub)) {
         IGRAPH_ERROR("Cannot subtract directed and undirected graphs",
                      IGRAPH_EINVAL);
     }
 
-    IGRAPH_VECTOR_INIT_FINALLY(&edge_ids, 0);
-    IGRAPH_VECTOR_INIT_FINALLY(&edges, 0);
-    IGRAPH_CHECK(igraph_inclist_init(orig, &inc_orig, IGRAPH_OUT));
-    IGRAPH_FINALLY(igraph_inclist_destroy, &inc_orig);
-    IGRAPH_CHECK(igraph_inclist_init(sub, &inc_sub, IGRAPH_OUT));
-    IGRAPH_FINALLY(igraph_inclist_destroy, &inc_sub);
-
-    smaller_nodes = no_of_nodes_orig > no_of_nodes_sub ?
-                    no_of_nodes_sub : no_of_nodes_orig;
-
-    for (i = 0; i < smaller_nodes; i++) {
-        long int n1, n2, e1, e2;
-        IGRAPH_ALLOW_INTERRUPTION();
-        nei1 = igraph_inclist_get(&inc_orig, i);
-        nei2 = igraph_inclist_get(&inc_sub, i);
-        n1 = igraph_vector_int_size(nei1) - 1;
-        n2 = igraph_vector_int_size(nei2) - 1;
-        while (n1 >= 0 && n2 >= 0) {
-            e1 = (long int) VECTOR(*nei1)[n1];
-            e2 = (long int) VECTOR(*nei2)[n2];
-            v1 = IGRAPH_OTHER(orig, e1, i);
-            v2 = IGRAPH_OTHER(sub, e2, i);
-
-            if (!directed && v1 < i) {
-                n1--;
-            } else if (!directed && v2 < i) {
-                n2--;
-            } else if (v1 > v2) {
-                IGRAPH_CHECK(igraph_vector_push_back(&edge_ids, e1));
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, v1));
-                n1--;
-                /* handle loop edges properly in undirected graphs */
-                if (!directed && i == v1) {
-                    n1--;
-                }
-            } else if (v2 > v1) {
-                n2--;
-            } else {
-                n1--;
-                n2--;
-            }
-        }
+    graphs_array[0] = orig;
+    graphs_array[1] = sub;
+    igraph_vector_ptr_view(&graphs, (void **) graphs_array, 2);
+    maps_array[0] = orig->attr ? &map : 0;
+    maps_array[1] = 0;
+    igraph_vector_ptr_view(&maps, (void **) maps_array, 2);
 
-        /* Copy remaining edges */
-        while (n1 >= 0) {
-            e1 = (long int) VECTOR(*nei1)[n1];
-            v1 = IGRAPH_OTHER(orig, e1, i);
-            if (directed || v1 >= i) {
-                IGRAPH_CHECK(igraph_vector_push_back(&edge_ids, e1));
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, v1));
-
-                /* handle loop edges properly in undirected graphs */
-                if (!directed && v1 == i) {
-                    n1--;
-                }
-            }
-            n1--;
-        }
-    }
-
-    /* copy remaining edges, use the previous value of 'i' */
-    for (; i < no_of_nodes_orig; i++) {
-        long int n1, e1;
-        nei1 = igraph_inclist_get(&inc_orig, i);
-        n1 = igraph_vector_int_size(nei1) - 1;
-        while (n1 >= 0) {
-            e1 = (long int) VECTOR(*nei1)[n1];
-            v1 = IGRAPH_OTHER(orig, e1, i);
-            if (directed || v1 >= i) {
-                IGRAPH_CHECK(igraph_vector_push_back(&edge_ids, e1));
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
-                IGRAPH_CHECK(igraph_vector_push_back(&edges, v1));
-
-                /* handle loop edges properly in undirected graphs */
-                if (!directed && v1 == i) {
-                    n1--;
-                }
-            }
-            n1--;
-        }
-    }
+    IGRAPH_VECTOR_INIT_FINALLY(&map, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&edge_ids, 0);
 
-    igraph_inclist_destroy(&inc_sub);
-    igraph_inclist_destroy(&inc_orig);
-    IGRAPH_FINALLY_CLEAN(2);
-    IGRAPH_CHECK(igraph_create(res, &edges, (igraph_integer_t) no_of_nodes,
-                               directed));
-    igraph_vector_destroy(&edges);
-    IGRAPH_FINALLY_CLEAN(1);
+    /* The edges are listed by their source (directed) or smaller
+       (undirected) vertex, and from the largest other endpoint to the
+       smallest one */
+    IGRAPH_CHECK(igraph_i_merge_sorted(res, &graphs,
+                                       (igraph_integer_t) no_of_nodes, directed,
+                                       IGRAPH_I_MERGE_DIFFERENCE,
+                                       /* desc_vertices= */ 0,
+                                       /* desc_neighbors= */ 1, &maps));
+    IGRAPH_FINALLY(igraph_destroy, res);
 
     /* Attributes */
     if (orig->attr) {
+        IGRAPH_CHECK(igraph_i_invert_edge_map(&map, &edge_ids,
+                                              igraph_ecount(res)));
         IGRAPH_I_ATTRIBUTE_DESTROY(res);
         IGRAPH_I_ATTRIBUTE_COPY(res, orig, /*graph=*/1, /*vertex=*/1, /*edge=*/0);
         IGRAPH_CHECK(igraph_i_attribute_permute_edges(orig, res, &edge_ids));
     }
 
     igraph_vector_destroy(&edge_ids);
-    IGRAPH_FINALLY_CLEAN(1);
+    igraph_vector_destroy(&map);
+    IGRAPH_FINALLY_CLEAN(3);   /* + res */
 
     return 0;
 }
@@ -1120,7 +658,11 @@ int igraph_complementer(igraph_t *res, const igraph_t *graph,
                     IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
                     IGRAPH_CHECK(igraph_vector_push_back(&edges, j));
                 } else {
-                    igraph_vector_pop_back(&neis);
+                    /* Skip all copies of multiple edges */
+                    while (!igraph_vector_empty(&neis) &&
+                           igraph_vector_tail(&neis) == j) {
+                        igraph_vector_pop_back(&neis);
+                    }
                 }
             }
         } else {
@@ -1131,7 +673,11 @@ int igraph_complementer(igraph_t *res, const igraph_t *graph,
                         IGRAPH_CHECK(igraph_vector_push_back(&edges, j));
                     }
                 } else {
-                    igraph_vector_pop_back(&neis);
+                    /* Skip all copies of multiple edges */
+                    while (!igraph_vector_empty(&neis) &&
+                           igraph_vector_tail(&neis) == j) {
+                        igraph_vector_pop_back(&neis);
+                    }
                 }
             }
         }
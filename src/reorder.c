@@ -0,0 +1,626 @@
+/* -*- mode: C -*-  */
+/*
+   IGraph library.
+   Copyright (C) 2021  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include "igraph_structural.h"
+#include "igraph_adjlist.h"
+#include "igraph_interface.h"
+#include "igraph_qsort.h"
+#include "igraph_topology.h"
+#include "igraph_interrupt_internal.h"
+#include "igraph_types_internal.h"
+#include "config.h"
+
+#include <math.h>
+
+/* Size of the window of Gorder: the score of a vertex is computed
+   against the last placed vertices, this many of them */
+#define IGRAPH_I_GORDER_WINDOW 5
+
+#define DEGREE(v) (igraph_vector_int_size(igraph_adjlist_get(al, (v))))
+
+/* Vertices with degree above 'threshold' come first, in decreasing
+   order of degree, the others follow in their original order. The
+   sort is stable, so the result does not depend on the sorting
+   algorithm. */
+
+static int igraph_i_reorder_degree(const igraph_adjlist_t *al,
+                                   igraph_vector_long_t *order,
+                                   long int threshold) {
+    long int no_of_nodes = al->length;
+    long int i, b, pos, maxdeg = 0;
+    igraph_vector_long_t start;
+
+    for (i = 0; i < no_of_nodes; i++) {
+        if (DEGREE(i) > maxdeg) {
+            maxdeg = DEGREE(i);
+        }
+    }
+
+    /* Counting sort, bucket b holds the vertices of degree maxdeg - b */
+    IGRAPH_CHECK(igraph_vector_long_init(&start, maxdeg + 1));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &start);
+    for (i = 0; i < no_of_nodes; i++) {
+        if (DEGREE(i) > threshold) {
+            VECTOR(start)[maxdeg - DEGREE(i)] += 1;
+        }
+    }
+    for (b = 0, pos = 0; b <= maxdeg; b++) {
+        long int count = VECTOR(start)[b];
+        VECTOR(start)[b] = pos;
+        pos += count;
+    }
+    for (i = 0; i < no_of_nodes; i++) {
+        if (DEGREE(i) > threshold) {
+            VECTOR(*order)[ VECTOR(start)[maxdeg - DEGREE(i)]++ ] = i;
+        } else {
+            VECTOR(*order)[pos++] = i;
+        }
+    }
+
+    igraph_vector_long_destroy(&start);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return 0;
+}
+
+static int igraph_i_reorder_bfs(const igraph_adjlist_t *al,
+                                igraph_vector_long_t *order) {
+    long int no_of_nodes = al->length;
+    long int root, head = 0, tail = 0;
+    igraph_vector_char_t seen;
+
+    IGRAPH_CHECK(igraph_vector_char_init(&seen, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_char_destroy, &seen);
+
+    /* The order itself is the queue of the search */
+    for (root = 0; root < no_of_nodes; root++) {
+        if (VECTOR(seen)[root]) {
+            continue;
+        }
+        VECTOR(seen)[root] = 1;
+        VECTOR(*order)[tail++] = root;
+        while (head < tail) {
+            long int v = VECTOR(*order)[head++];
+            igraph_vector_int_t *neis = igraph_adjlist_get(al, v);
+            long int j, n = igraph_vector_int_size(neis);
+            for (j = 0; j < n; j++) {
+                long int u = VECTOR(*neis)[j];
+                if (!VECTOR(seen)[u]) {
+                    VECTOR(seen)[u] = 1;
+                    VECTOR(*order)[tail++] = u;
+                }
+            }
+        }
+        IGRAPH_ALLOW_INTERRUPTION();
+    }
+
+    igraph_vector_char_destroy(&seen);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return 0;
+}
+
+static int igraph_i_reorder_dfs(const igraph_adjlist_t *al,
+                                igraph_vector_long_t *order) {
+    long int no_of_nodes = al->length;
+    long int root, pos = 0, sp = 0;
+    igraph_vector_char_t seen;
+    igraph_vector_long_t stack, next;
+
+    IGRAPH_CHECK(igraph_vector_char_init(&seen, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_char_destroy, &seen);
+    IGRAPH_CHECK(igraph_vector_long_init(&stack, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &stack);
+    /* The position of the next neighbor to try, for every vertex */
+    IGRAPH_CHECK(igraph_vector_long_init(&next, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &next);
+
+    for (root = 0; root < no_of_nodes; root++) {
+        if (VECTOR(seen)[root]) {
+            continue;
+        }
+        VECTOR(seen)[root] = 1;
+        VECTOR(*order)[pos++] = root;
+        VECTOR(stack)[sp++] = root;
+        while (sp > 0) {
+            long int v = VECTOR(stack)[sp - 1];
+            igraph_vector_int_t *neis = igraph_adjlist_get(al, v);
+            if (VECTOR(next)[v] < igraph_vector_int_size(neis)) {
+                long int u = VECTOR(*neis)[ VECTOR(next)[v]++ ];
+                if (!VECTOR(seen)[u]) {
+                    VECTOR(seen)[u] = 1;
+                    VECTOR(*order)[pos++] = u;
+                    VECTOR(stack)[sp++] = u;
+                }
+            } else {
+                sp--;
+            }
+        }
+        IGRAPH_ALLOW_INTERRUPTION();
+    }
+
+    igraph_vector_long_destroy(&next);
+    igraph_vector_long_destroy(&stack);
+    igraph_vector_char_destroy(&seen);
+    IGRAPH_FINALLY_CLEAN(3);
+
+    return 0;
+}
+
+/* Breadth-first search from 'root' into 'buf', visited vertices are
+   marked with 'stamp'. Returns the eccentricity of the root, the index
+   of the first vertex of the last level is stored in 'last' and the
+   number of reached vertices in 'size'. */
+
+static long int igraph_i_reorder_levels(const igraph_adjlist_t *al,
+                                        long int root, long int *buf,
+                                        long int *mark, long int stamp,
+                                        long int *last, long int *size) {
+    long int head = 0, tail = 0, level_end, ecc = 0;
+
+    mark[root] = stamp;
+    buf[tail++] = root;
+    *last = 0;
+    level_end = tail;
+    while (head < tail) {
+        long int v = buf[head++];
+        igraph_vector_int_t *neis = igraph_adjlist_get(al, v);
+        long int j, n = igraph_vector_int_size(neis);
+        for (j = 0; j < n; j++) {
+            long int u = VECTOR(*neis)[j];
+            if (mark[u] != stamp) {
+                mark[u] = stamp;
+                buf[tail++] = u;
+            }
+        }
+        if (head == level_end && tail > head) {
+            *last = head;
+            level_end = tail;
+            ecc++;
+        }
+    }
+    *size = tail;
+
+    return ecc;
+}
+
+static int igraph_i_reorder_degree_cmp(void *extra, const void *a,
+                                       const void *b) {
+    const igraph_adjlist_t *al = (const igraph_adjlist_t *) extra;
+    long int u = *(const long int *) a, v = *(const long int *) b;
+    long int du = DEGREE(u), dv = DEGREE(v);
+
+    if (du != dv) {
+        return du < dv ? -1 : 1;
+    }
+    return u < v ? -1 : (u > v ? 1 : 0);
+}
+
+/* Reverse Cuthill-McKee. Every component is searched from a
+   pseudo-peripheral vertex, found with the algorithm of George and
+   Liu, the neighbors of a vertex are visited in increasing order of
+   degree, and finally the whole order is reversed. */
+
+static int igraph_i_reorder_rcm(const igraph_adjlist_t *al,
+                                igraph_vector_long_t *order) {
+    long int no_of_nodes = al->length;
+    long int root, head = 0, tail = 0, stamp = 0;
+    igraph_vector_char_t seen;
+    igraph_vector_long_t buf, mark;
+
+    IGRAPH_CHECK(igraph_vector_char_init(&seen, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_char_destroy, &seen);
+    IGRAPH_CHECK(igraph_vector_long_init(&buf, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &buf);
+    IGRAPH_CHECK(igraph_vector_long_init(&mark, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &mark);
+
+    for (root = 0; root < no_of_nodes; root++) {
+        long int start = root, ecc, last, size;
+        if (VECTOR(seen)[root]) {
+            continue;
+        }
+
+        /* Find a pseudo-peripheral vertex: move to a vertex of minimum
+           degree in the last level as long as the eccentricity grows */
+        ecc = igraph_i_reorder_levels(al, start, VECTOR(buf), VECTOR(mark),
+                                      ++stamp, &last, &size);
+        while (1) {
+            long int j, cand = VECTOR(buf)[last], cand_ecc;
+            for (j = last + 1; j < size; j++) {
+                if (DEGREE(VECTOR(buf)[j]) < DEGREE(cand)) {
+                    cand = VECTOR(buf)[j];
+                }
+            }
+            cand_ecc = igraph_i_reorder_levels(al, cand, VECTOR(buf),
+                                               VECTOR(mark), ++stamp,
+                                               &last, &size);
+            if (cand_ecc <= ecc) {
+                break;
+            }
+            start = cand;
+            ecc = cand_ecc;
+        }
+
+        /* Cuthill-McKee search, the order itself is the queue */
+        VECTOR(seen)[start] = 1;
+        VECTOR(*order)[tail++] = start;
+        while (head < tail) {
+            long int v = VECTOR(*order)[head++], first = tail;
+            igraph_vector_int_t *neis = igraph_adjlist_get(al, v);
+            long int j, n = igraph_vector_int_size(neis);
+            for (j = 0; j < n; j++) {
+                long int u = VECTOR(*neis)[j];
+                if (!VECTOR(seen)[u]) {
+                    VECTOR(seen)[u] = 1;
+                    VECTOR(*order)[tail++] = u;
+                }
+            }
+            if (tail - first > 1) {
+                igraph_qsort_r(VECTOR(*order) + first, (size_t) (tail - first),
+                               sizeof(long int), (void *) al,
+                               igraph_i_reorder_degree_cmp);
+            }
+        }
+        IGRAPH_ALLOW_INTERRUPTION();
+    }
+
+    IGRAPH_CHECK(igraph_vector_long_reverse(order));
+
+    igraph_vector_long_destroy(&mark);
+    igraph_vector_long_destroy(&buf);
+    igraph_vector_char_destroy(&seen);
+    IGRAPH_FINALLY_CLEAN(3);
+
+    return 0;
+}
+
+/* The scores of Gorder change by one at a time, so they are kept in
+   buckets, which are doubly linked lists of the unplaced vertices with
+   a given score. Every operation takes constant time, except that
+   finding the maximum may need to skip empty buckets. */
+
+typedef struct {
+    igraph_vector_long_t score, next, prev, head;
+    long int top;
+} igraph_i_gorder_buckets_t;
+
+static void igraph_i_gorder_buckets_destroy(igraph_i_gorder_buckets_t *b) {
+    igraph_vector_long_destroy(&b->head);
+    igraph_vector_long_destroy(&b->prev);
+    igraph_vector_long_destroy(&b->next);
+    igraph_vector_long_destroy(&b->score);
+}
+
+static void igraph_i_gorder_unlink(igraph_i_gorder_buckets_t *b, long int v) {
+    long int next = VECTOR(b->next)[v], prev = VECTOR(b->prev)[v];
+    if (prev >= 0) {
+        VECTOR(b->next)[prev] = next;
+    } else {
+        VECTOR(b->head)[ VECTOR(b->score)[v] ] = next;
+    }
+    if (next >= 0) {
+        VECTOR(b->prev)[next] = prev;
+    }
+}
+
+static int igraph_i_gorder_link(igraph_i_gorder_buckets_t *b, long int v) {
+    long int s = VECTOR(b->score)[v], next;
+    if (s >= igraph_vector_long_size(&b->head)) {
+        long int i, size = igraph_vector_long_size(&b->head);
+        IGRAPH_CHECK(igraph_vector_long_resize(&b->head, 2 * s));
+        for (i = size; i < 2 * s; i++) {
+            VECTOR(b->head)[i] = -1;
+        }
+    }
+    next = VECTOR(b->head)[s];
+    VECTOR(b->next)[v] = next;
+    VECTOR(b->prev)[v] = -1;
+    if (next >= 0) {
+        VECTOR(b->prev)[next] = v;
+    }
+    VECTOR(b->head)[s] = v;
+    if (s > b->top) {
+        b->top = s;
+    }
+    return 0;
+}
+
+/* Adds 'delta' to the Gorder score of the unplaced vertices that are
+   neighbors or siblings (have a common neighbor) of 'v'. Common
+   neighbors with degree above 'hub' are ignored, they would make the
+   update too expensive while contributing little locality. */
+
+static int igraph_i_gorder_update(const igraph_adjlist_t *al,
+                                  igraph_i_gorder_buckets_t *b, long int v,
+                                  long int delta, long int hub) {
+    igraph_vector_int_t *neis = igraph_adjlist_get(al, v);
+    long int i, j, n = igraph_vector_int_size(neis);
+
+    for (i = 0; i < n; i++) {
+        long int u = VECTOR(*neis)[i];
+        igraph_vector_int_t *neis2;
+        long int n2;
+        if (VECTOR(b->score)[u] >= 0) {
+            igraph_i_gorder_unlink(b, u);
+            VECTOR(b->score)[u] += delta;
+            IGRAPH_CHECK(igraph_i_gorder_link(b, u));
+        }
+        neis2 = igraph_adjlist_get(al, u);
+        n2 = igraph_vector_int_size(neis2);
+        if (n2 > hub) {
+            continue;
+        }
+        for (j = 0; j < n2; j++) {
+            long int w = VECTOR(*neis2)[j];
+            if (w != v && VECTOR(b->score)[w] >= 0) {
+                igraph_i_gorder_unlink(b, w);
+                VECTOR(b->score)[w] += delta;
+                IGRAPH_CHECK(igraph_i_gorder_link(b, w));
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Gorder of Wei et al.: the next vertex is always the unplaced one
+   with the largest number of neighbors and siblings among the last
+   IGRAPH_I_GORDER_WINDOW placed vertices. */
+
+static int igraph_i_reorder_gorder(const igraph_adjlist_t *al,
+                                   igraph_vector_long_t *order) {
+    long int no_of_nodes = al->length;
+    long int i, v, start = 0, hub = (long int) sqrt((double) no_of_nodes);
+    igraph_i_gorder_buckets_t b;
+
+    if (no_of_nodes == 0) {
+        return 0;
+    }
+
+    IGRAPH_CHECK(igraph_vector_long_init(&b.score, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &b.score);
+    IGRAPH_CHECK(igraph_vector_long_init(&b.next, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &b.next);
+    IGRAPH_CHECK(igraph_vector_long_init(&b.prev, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &b.prev);
+    IGRAPH_CHECK(igraph_vector_long_init(&b.head, 16));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &b.head);
+    IGRAPH_FINALLY_CLEAN(4);
+    IGRAPH_FINALLY(igraph_i_gorder_buckets_destroy, &b);
+    igraph_vector_long_fill(&b.head, -1);
+    b.top = 0;
+
+    /* All vertices start with score zero, ties are broken by taking the
+       smallest id, so the vertices are linked in reverse order */
+    for (i = no_of_nodes - 1; i >= 0; i--) {
+        if (DEGREE(i) >= DEGREE(start)) {
+            start = i;
+        }
+        IGRAPH_CHECK(igraph_i_gorder_link(&b, i));
+    }
+
+    /* Start from a vertex of maximum degree */
+    v = start;
+    for (i = 0; i < no_of_nodes; i++) {
+        if (i > 0) {
+            while (VECTOR(b.head)[b.top] < 0) {
+                b.top--;
+            }
+            v = VECTOR(b.head)[b.top];
+        }
+        igraph_i_gorder_unlink(&b, v);
+        VECTOR(b.score)[v] = -1;
+        VECTOR(*order)[i] = v;
+        IGRAPH_CHECK(igraph_i_gorder_update(al, &b, v, 1, hub));
+        if (i >= IGRAPH_I_GORDER_WINDOW) {
+            IGRAPH_CHECK(igraph_i_gorder_update(al, &b,
+                                                VECTOR(*order)[i - IGRAPH_I_GORDER_WINDOW],
+                                                -1, hub));
+        }
+        if (i % 1024 == 0) {
+            IGRAPH_ALLOW_INTERRUPTION();
+        }
+    }
+
+    igraph_i_gorder_buckets_destroy(&b);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return 0;
+}
+
+#undef DEGREE
+
+/**
+ * \function igraph_vertex_reordering
+ * \brief Vertex ordering that improves memory locality.
+ *
+ * </para><para>
+ * Algorithms traverse the neighbors of a vertex much faster when these
+ * neighbors have ids close to each other, and to the id of the vertex
+ * itself, because their data is then close in memory. This function
+ * calculates a new order of the vertices with this property; use
+ * \ref igraph_reorder_vertices() to also relabel the graph.
+ *
+ * </para><para>
+ * The following algorithms are available:
+ * \clist
+ * \cli IGRAPH_REORDER_DEGREE
+ *   Vertices in decreasing order of degree, so that the
+ *   most often accessed vertices are close to each other.
+ * \cli IGRAPH_REORDER_HUB
+ *   Hub sorting: only the vertices with degree above the average
+ *   degree are sorted by decreasing degree and moved to the front,
+ *   the other vertices keep their relative order. This keeps the
+ *   locality already present in the original order.
+ * \cli IGRAPH_REORDER_BFS
+ *   The order in which a breadth-first search visits the vertices.
+ * \cli IGRAPH_REORDER_DFS
+ *   The order in which a depth-first search visits the vertices.
+ * \cli IGRAPH_REORDER_RCM
+ *   Reverse Cuthill-McKee ordering, which reduces the bandwidth of
+ *   the adjacency matrix, i.e. the largest difference between the
+ *   ids of adjacent vertices. It works best on mesh-like graphs,
+ *   e.g. road networks.
+ * \cli IGRAPH_REORDER_GORDER
+ *   Gorder, see Hao Wei, Jeffrey Xu Yu, Can Lu and Xuemin Lin: Speedup
+ *   Graph Processing by Graph Ordering, SIGMOD 2016. The vertices are
+ *   placed greedily, the next one always has the most neighbors and
+ *   siblings (vertices with a common neighbor) among the last five
+ *   placed vertices. Common neighbors with degree above the square
+ *   root of the number of vertices are ignored. This ordering is the
+ *   slowest to calculate, but it usually gives the best locality on
+ *   complex networks.
+ * \endclist
+ *
+ * </para><para>
+ * Edge directions are ignored. The searches visit the components in
+ * the order of their smallest vertex id, and the neighbors of a vertex
+ * in increasing order of id, except for reverse Cuthill-McKee, which
+ * visits them in increasing order of degree.
+ *
+ * \param graph The input graph.
+ * \param permutation Pointer to an initialized vector or a null
+ *    pointer. If not null, then the new id of every vertex is stored
+ *    here, in the format expected by \ref igraph_permute_vertices().
+ * \param invmap Pointer to an initialized vector or a null pointer. If
+ *    not null, then the inverse of the permutation is stored here: the
+ *    old id of every new vertex, i.e. the vertex ids in their new
+ *    order.
+ * \param algo The algorithm to use, see above.
+ * \return Error code:
+ *    \c IGRAPH_EINVAL: invalid algorithm.
+ *
+ * Time complexity: O(|V|+|E|) for the degree, hub, breadth-first and
+ * depth-first orders. For reverse Cuthill-McKee it is O(d|V|+d|E|)
+ * in the worst case, where d is the diameter of the graph, and usually
+ * O(|V|+|E|). For Gorder it is O(|E| sqrt(|V|)).
+ *
+ * \sa \ref igraph_reorder_vertices() to relabel the graph in one step.
+ */
+
+int igraph_vertex_reordering(const igraph_t *graph,
+                             igraph_vector_t *permutation,
+                             igraph_vector_t *invmap,
+                             igraph_reorder_algorithm_t algo) {
+    long int no_of_nodes = igraph_vcount(graph);
+    long int i;
+    igraph_adjlist_t al;
+    igraph_vector_long_t order;
+
+    IGRAPH_CHECK(igraph_vector_long_init(&order, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &order);
+    IGRAPH_CHECK(igraph_adjlist_init(graph, &al, IGRAPH_ALL));
+    IGRAPH_FINALLY(igraph_adjlist_destroy, &al);
+
+    switch (algo) {
+    case IGRAPH_REORDER_DEGREE:
+        IGRAPH_CHECK(igraph_i_reorder_degree(&al, &order, -1));
+        break;
+    case IGRAPH_REORDER_HUB:
+        /* Degree above the average, i.e. above 2|E|/|V| rounded down */
+        IGRAPH_CHECK(igraph_i_reorder_degree(&al, &order, no_of_nodes == 0 ? 0 :
+                                             2 * igraph_ecount(graph) / no_of_nodes));
+        break;
+    case IGRAPH_REORDER_BFS:
+        IGRAPH_CHECK(igraph_i_reorder_bfs(&al, &order));
+        break;
+    case IGRAPH_REORDER_DFS:
+        IGRAPH_CHECK(igraph_i_reorder_dfs(&al, &order));
+        break;
+    case IGRAPH_REORDER_RCM:
+        IGRAPH_CHECK(igraph_i_reorder_rcm(&al, &order));
+        break;
+    case IGRAPH_REORDER_GORDER:
+        IGRAPH_CHECK(igraph_i_reorder_gorder(&al, &order));
+        break;
+    default:
+        IGRAPH_ERROR("Invalid vertex reordering algorithm", IGRAPH_EINVAL);
+    }
+
+    igraph_adjlist_destroy(&al);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    if (permutation) {
+        IGRAPH_CHECK(igraph_vector_resize(permutation, no_of_nodes));
+        for (i = 0; i < no_of_nodes; i++) {
+            VECTOR(*permutation)[ VECTOR(order)[i] ] = i;
+        }
+    }
+    if (invmap) {
+        IGRAPH_CHECK(igraph_vector_resize(invmap, no_of_nodes));
+        for (i = 0; i < no_of_nodes; i++) {
+            VECTOR(*invmap)[i] = VECTOR(order)[i];
+        }
+    }
+
+    igraph_vector_long_destroy(&order);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return 0;
+}
+
+/**
+ * \function igraph_reorder_vertices
+ * \brief Relabels the vertices of a graph to improve memory locality.
+ *
+ * </para><para>
+ * This function calculates a new order of the vertices with \ref
+ * igraph_vertex_reordering() and creates the graph with the vertices
+ * in this order, with \ref igraph_permute_vertices(). Vertex, edge and
+ * graph attributes are kept, and the edges keep their ids.
+ *
+ * </para><para>
+ * Results calculated on the new graph can be mapped back to the
+ * original vertices with \c invmap: if \c res is a vector of values
+ * for the vertices of the new graph, then the value for original
+ * vertex <code>VECTOR(*invmap)[i]</code> is <code>VECTOR(res)[i]</code>.
+ *
+ * \param graph The input graph.
+ * \param res Pointer to an uninitialized graph object, the relabeled
+ *    graph is created here.
+ * \param invmap Pointer to an initialized vector or a null pointer. If
+ *    not null, then the original id of every vertex of the new graph is
+ *    stored here.
+ * \param algo The algorithm that calculates the order, see \ref
+ *    igraph_vertex_reordering() for the possible values.
+ * \return Error code:
+ *    \c IGRAPH_EINVAL: invalid algorithm.
+ *
+ * Time complexity: the time complexity of \ref
+ * igraph_vertex_reordering() plus O(|V|+|E|).
+ */
+
+int igraph_reorder_vertices(const igraph_t *graph, igraph_t *res,
+                            igraph_vector_t *invmap,
+                            igraph_reorder_algorithm_t algo) {
+    igraph_vector_t permutation;
+
+    IGRAPH_VECTOR_INIT_FINALLY(&permutation, 0);
+    IGRAPH_CHECK(igraph_vertex_reordering(graph, &permutation, invmap, algo));
+    IGRAPH_CHECK(igraph_permute_vertices(graph, res, &permutation));
+
+    igraph_vector_destroy(&permutation);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return 0;
+}
@@ -32,6 +32,7 @@
 #include "igraph_interface.h"
 #include "igraph_progress.h"
 #include "igraph_interrupt_internal.h"
+#include "igraph_counters_internal.h"
 #include "igraph_centrality.h"
 #include "igraph_components.h"
 #include "igraph_constructors.h"
@@ -44,6 +45,7 @@
 #include "igraph_qsort.h"
 #include "config.h"
 #include "structural_properties_internal.h"
+#include "igraph_interface_internal.h"
 
 #include <assert.h>
 #include <string.h>
@@ -532,10 +534,12 @@ int igraph_shortest_paths(const igraph_t *graph, igraph_matrix_t *res,
     IGRAPH_CHECK(igraph_matrix_resize(res, no_of_from, no_of_to));
     igraph_matrix_fill(res, my_infinity);
 
+    IGRAPH_TIMER_START(IGRAPH_TIMER_SHORTEST_PATHS);
+
     for (IGRAPH_VIT_RESET(fromvit), i = 0;
          !IGRAPH_VIT_END(fromvit);
          IGRAPH_VIT_NEXT(fromvit), i++) {
-        long int reached = 0;
+        long int reached = 0, scanned = 0;
         IGRAPH_CHECK(igraph_dqueue_push(&q, IGRAPH_VIT_GET(fromvit)));
         IGRAPH_CHECK(igraph_dqueue_push(&q, 0));
         already_counted[ (long int) IGRAPH_VIT_GET(fromvit) ] = i + 1;
@@ -560,6 +564,7 @@ int igraph_shortest_paths(const igraph_t *graph, igraph_matrix_t *res,
             }
 
             neis = igraph_adjlist_get(&adjlist, act);
+            scanned += igraph_vector_int_size(neis);
             for (j = 0; j < igraph_vector_int_size(neis); j++) {
                 long int neighbor = (long int) VECTOR(*neis)[j];
                 if (already_counted[neighbor] == i + 1) {
@@ -570,8 +575,13 @@ int igraph_shortest_paths(const igraph_t *graph, igraph_matrix_t *res,
                 IGRAPH_CHECK(igraph_dqueue_push(&q, actdist + 1));
             }
         }
+
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_SEARCH_SOURCES, 1);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_EDGES_SCANNED, scanned);
     }
 
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_SHORTEST_PATHS);
+
     /* Clean */
     if (!all_to) {
         igraph_vit_destroy(&tovit);
@@ -1843,40 +1853,85 @@ int igraph_i_subgraph_copy_and_delete(const igraph_t *graph, igraph_t *res,
     return 0;
 }
 
+/* Creates the subgraph induced by the vertices in 'vids', which are
+   sorted and made unique in place; they become the new-to-old vertex
+   map. 'old2new' must have a zero element for each vertex of 'graph'.
+   It is set to the old-to-new vertex map of
+   igraph_induced_subgraph_map() if 'keep_map' is true; otherwise it is
+   all zero again on return, so it can be reused for the next subgraph
+   without touching all of its elements. 'eids' is working space for
+   the old ids of the edges. */
+
+static int igraph_i_induced_subgraph_sorted(const igraph_t *graph,
+                                            igraph_t *res,
+                                            igraph_vector_t *vids,
+                                            igraph_vector_t *old2new,
+                                            igraph_vector_t *eids,
+                                            igraph_bool_t keep_map) {
+    long int i, n;
+
+    igraph_vector_sort(vids);
+    n = igraph_vector_size(vids);
+    for (i = 0; i < n; i++) {
+        long int vid = (long int) VECTOR(*vids)[i];
+        if (VECTOR(*old2new)[vid] == 0) {
+            VECTOR(*old2new)[vid] = i + 1;
+        }
+    }
+    /* Remove duplicates; the map gives the first position of each */
+    for (i = 0, n = 0; i < igraph_vector_size(vids); i++) {
+        long int vid = (long int) VECTOR(*vids)[i];
+        if (VECTOR(*old2new)[vid] == i + 1) {
+            VECTOR(*vids)[n++] = vid;
+            VECTOR(*old2new)[vid] = n;
+        }
+    }
+    IGRAPH_CHECK(igraph_vector_resize(vids, n));
+
+    IGRAPH_CHECK(igraph_i_create_induced_subgraph(graph, res, vids, old2new,
+                 eids));
+    IGRAPH_FINALLY(igraph_destroy, res);
+
+    if (!keep_map) {
+        for (i = 0; i < n; i++) {
+            VECTOR(*old2new)[(long int) VECTOR(*vids)[i]] = 0;
+        }
+    }
+
+    /* Copy the graph attributes, and permute the vertex and edge
+       attributes */
+    IGRAPH_I_ATTRIBUTE_DESTROY(res);
+    IGRAPH_CHECK(igraph_i_attribute_copy(res, graph,
+                                         /* ga = */ 1, /* va = */ 0, /* ea = */ 0));
+    IGRAPH_CHECK(igraph_i_attribute_permute_vertices(graph, res, vids));
+    IGRAPH_CHECK(igraph_i_attribute_permute_edges(graph, res, eids));
+
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return 0;
+}
+
 /**
  * Subgraph creation, new version: creates the new graph instead of
- * copying the old one.
+ * copying the old one. The edges are taken directly from the sorted
+ * edge index of the old graph, so the new graph needs no sorting.
  */
 int igraph_i_subgraph_create_from_scratch(const igraph_t *graph,
         igraph_t *res,
         const igraph_vs_t vids,
         igraph_vector_t *map,
         igraph_vector_t *invmap) {
-    igraph_bool_t directed = igraph_is_directed(graph);
     long int no_of_nodes = igraph_vcount(graph);
-    long int no_of_new_nodes = 0;
-    long int i, j, n;
-    long int to;
-    igraph_integer_t eid;
-    igraph_vector_t vids_old2new, vids_new2old;
-    igraph_vector_t eids_new2old;
-    igraph_vector_t nei_edges;
-    igraph_vector_t new_edges;
-    igraph_vit_t vit;
+    igraph_vector_t vids_old2new, vids_new2old, eids;
     igraph_vector_t *my_vids_old2new = &vids_old2new,
                      *my_vids_new2old = &vids_new2old;
+    igraph_vit_t vit;
 
-    /* The order of initialization is important here, they will be destroyed in the
-     * opposite order */
-    IGRAPH_VECTOR_INIT_FINALLY(&eids_new2old, 0);
     if (invmap) {
         my_vids_new2old = invmap;
-        igraph_vector_clear(my_vids_new2old);
     } else {
         IGRAPH_VECTOR_INIT_FINALLY(&vids_new2old, 0);
     }
-    IGRAPH_VECTOR_INIT_FINALLY(&new_edges, 0);
-    IGRAPH_VECTOR_INIT_FINALLY(&nei_edges, 0);
     if (map) {
         my_vids_old2new = map;
         IGRAPH_CHECK(igraph_vector_resize(map, no_of_nodes));
@@ -1885,127 +1940,108 @@ int igraph_i_subgraph_create_from_scratch(const igraph_t *graph,
         IGRAPH_VECTOR_INIT_FINALLY(&vids_old2new, no_of_nodes);
     }
 
+    /* The new vertex ids keep the order of the old ones, to be
+       compatible with igraph_i_subgraph_copy_and_delete() */
     IGRAPH_CHECK(igraph_vit_create(graph, vids, &vit));
     IGRAPH_FINALLY(igraph_vit_destroy, &vit);
-
-    /* Calculate the mapping from the old node IDs to the new ones. The other
-     * igraph_simplify implementation in igraph_i_simplify_copy_and_delete
-     * ensures that the order of vertex IDs is kept during remapping (i.e.
-     * if the old ID of vertex A is less than the old ID of vertex B, then
-     * the same will also be true for the new IDs). To ensure compatibility
-     * with the other implementation, we have to fetch the vertex IDs into
-     * a vector first and then sort it. We temporarily use new_edges for that.
-     */
-    IGRAPH_CHECK(igraph_vit_as_vector(&vit, &nei_edges));
+    IGRAPH_CHECK(igraph_vit_as_vector(&vit, my_vids_new2old));
     igraph_vit_destroy(&vit);
     IGRAPH_FINALLY_CLEAN(1);
 
-    igraph_vector_sort(&nei_edges);
-    n = igraph_vector_size(&nei_edges);
-    for (i = 0; i < n; i++) {
-        long int vid = (long int) VECTOR(nei_edges)[i];
-        if (VECTOR(*my_vids_old2new)[vid] == 0) {
-            IGRAPH_CHECK(igraph_vector_push_back(my_vids_new2old, vid));
-            no_of_new_nodes++;
-            VECTOR(*my_vids_old2new)[vid] = no_of_new_nodes;
-        }
-    }
-
-    /* Create the new edge list */
-    for (i = 0; i < no_of_new_nodes; i++) {
-        long int old_vid = (long int) VECTOR(*my_vids_new2old)[i];
-        long int new_vid = i;
-        igraph_bool_t skip_loop_edge;
-
-        IGRAPH_CHECK(igraph_incident(graph, &nei_edges, old_vid, IGRAPH_OUT));
-        n = igraph_vector_size(&nei_edges);
-
-        if (directed) {
-            /* directed graph; this is easier */
-            for (j = 0; j < n; j++) {
-                eid = (igraph_integer_t) VECTOR(nei_edges)[j];
-
-                to = (long int) VECTOR(*my_vids_old2new)[ (long int)IGRAPH_TO(graph, eid) ];
-                if (!to) {
-                    continue;
-                }
-
-                IGRAPH_CHECK(igraph_vector_push_back(&new_edges, new_vid));
-                IGRAPH_CHECK(igraph_vector_push_back(&new_edges, to - 1));
-                IGRAPH_CHECK(igraph_vector_push_back(&eids_new2old, eid));
-            }
-        } else {
-            /* undirected graph. We need to be careful with loop edges as each
-             * loop edge will appear twice. We use a boolean flag to skip every
-             * second loop edge */
-            skip_loop_edge = 0;
-            for (j = 0; j < n; j++) {
-                eid = (igraph_integer_t) VECTOR(nei_edges)[j];
-
-                if (IGRAPH_FROM(graph, eid) != old_vid) {
-                    /* avoid processing edges twice */
-                    continue;
-                }
-
-                to = (long int) VECTOR(*my_vids_old2new)[ (long int)IGRAPH_TO(graph, eid) ];
-                if (!to) {
-                    continue;
-                }
-                to -= 1;
-
-                if (new_vid == to) {
-                    /* this is a loop edge; check whether we need to skip it */
-                    skip_loop_edge = !skip_loop_edge;
-                    if (skip_loop_edge) {
-                        continue;
-                    }
-                }
-
-                IGRAPH_CHECK(igraph_vector_push_back(&new_edges, new_vid));
-                IGRAPH_CHECK(igraph_vector_push_back(&new_edges, to));
-                IGRAPH_CHECK(igraph_vector_push_back(&eids_new2old, eid));
-            }
-        }
-    }
+    IGRAPH_VECTOR_INIT_FINALLY(&eids, 0);
+    IGRAPH_CHECK(igraph_i_induced_subgraph_sorted(graph, res, my_vids_new2old,
+                 my_vids_old2new, &eids, /* keep_map= */ 1));
+    igraph_vector_destroy(&eids);
+    IGRAPH_FINALLY_CLEAN(1);
 
-    /* Get rid of some vectors that are not needed anymore */
     if (!map) {
         igraph_vector_destroy(&vids_old2new);
         IGRAPH_FINALLY_CLEAN(1);
     }
-    igraph_vector_destroy(&nei_edges);
-    IGRAPH_FINALLY_CLEAN(1);
-
-    /* Create the new graph */
-    IGRAPH_CHECK(igraph_create(res, &new_edges, (igraph_integer_t)
-                               no_of_new_nodes, directed));
-    IGRAPH_I_ATTRIBUTE_DESTROY(res);
+    if (!invmap) {
+        igraph_vector_destroy(&vids_new2old);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
 
-    /* Now we can also get rid of the new_edges vector */
-    igraph_vector_destroy(&new_edges);
-    IGRAPH_FINALLY_CLEAN(1);
+    return 0;
+}
 
-    /* Make sure that the newly created graph is destroyed if something happens from
-     * now on */
-    IGRAPH_FINALLY(igraph_destroy, res);
+/**
+ * \ingroup structural
+ * \function igraph_induced_subgraphs
+ * \brief Creates the subgraphs induced by several sets of vertices.
+ *
+ * </para><para>
+ * This function is equivalent to calling \ref igraph_induced_subgraph()
+ * for each vertex set in \p vids, but it is much faster if there are
+ * many small vertex sets in a large graph, e.g. ego networks: the
+ * temporary vertex map is allocated once, and only the vertices and
+ * edges of each subgraph are visited.
+ *
+ * </para><para>
+ * In each subgraph, the new vertex ids follow the order of the old
+ * ones, and duplicate vertex ids are ignored.
+ *
+ * \param graph The graph object.
+ * \param res An initialized pointer vector, the subgraphs are stored
+ *        here, in the same order as the vertex sets. It will be
+ *        resized as needed. The subgraphs are allocated with
+ *        \ref igraph_malloc(); call \ref igraph_destroy() and then
+ *        \ref igraph_free() on each of them if you don't need them any
+ *        more, e.g. with \ref igraph_decompose_destroy().
+ * \param vids A pointer vector of \type igraph_vector_t objects, each
+ *        of them is a set of vertex ids.
+ * \return Error code:
+ *         \c IGRAPH_ENOMEM, not enough memory for
+ *         temporary data.
+ *         \c IGRAPH_EINVVID, invalid vertex id in
+ *         \p vids.
+ *
+ * Time complexity: O(|V|+sum(n_i log n_i + d_i)), where n_i is the
+ * size of the i-th vertex set and d_i is the sum of the degrees of its
+ * vertices.
+ *
+ * \sa \ref igraph_induced_subgraph() for a single subgraph.
+ */
 
-    /* Copy the graph attributes */
-    IGRAPH_CHECK(igraph_i_attribute_copy(res, graph,
-                                         /* ga = */ 1, /* va = */ 0, /* ea = */ 0));
+int igraph_induced_subgraphs(const igraph_t *graph, igraph_vector_ptr_t *res,
+                             const igraph_vector_ptr_t *vids) {
+    long int no_of_nodes = igraph_vcount(graph);
+    long int i, n = igraph_vector_ptr_size(vids);
+    igraph_vector_t old2new, tmp, eids;
+    igraph_t *newg;
 
-    /* Copy the vertex attributes */
-    IGRAPH_CHECK(igraph_i_attribute_permute_vertices(graph, res,
-                 my_vids_new2old));
+    for (i = 0; i < n; i++) {
+        if (!igraph_vector_isininterval(VECTOR(*vids)[i], 0, no_of_nodes - 1)) {
+            IGRAPH_ERROR("Cannot create induced subgraphs", IGRAPH_EINVVID);
+        }
+    }
 
-    /* Copy the edge attributes */
-    IGRAPH_CHECK(igraph_i_attribute_permute_edges(graph, res, &eids_new2old));
+    IGRAPH_VECTOR_INIT_FINALLY(&old2new, no_of_nodes);
+    IGRAPH_VECTOR_INIT_FINALLY(&tmp, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&eids, 0);
+    igraph_vector_ptr_clear(res);
+    IGRAPH_FINALLY(igraph_decompose_destroy, res);
+    IGRAPH_CHECK(igraph_vector_ptr_reserve(res, n));
 
-    if (!invmap) {
-        igraph_vector_destroy(my_vids_new2old);
+    for (i = 0; i < n; i++) {
+        IGRAPH_ALLOW_INTERRUPTION();
+        IGRAPH_CHECK(igraph_vector_update(&tmp, VECTOR(*vids)[i]));
+        newg = igraph_Calloc(1, igraph_t);
+        if (newg == 0) {
+            IGRAPH_ERROR("Cannot create induced subgraphs", IGRAPH_ENOMEM);
+        }
+        IGRAPH_FINALLY(igraph_free, newg);
+        IGRAPH_CHECK(igraph_i_induced_subgraph_sorted(graph, newg, &tmp,
+                     &old2new, &eids, /* keep_map= */ 0));
         IGRAPH_FINALLY_CLEAN(1);
+        igraph_vector_ptr_push_back(res, newg); /* reserved */
     }
-    igraph_vector_destroy(&eids_new2old);
-    IGRAPH_FINALLY_CLEAN(2);   /* 1 + 1 since we don't need to destroy res */
+
+    igraph_vector_destroy(&eids);
+    igraph_vector_destroy(&tmp);
+    igraph_vector_destroy(&old2new);
+    IGRAPH_FINALLY_CLEAN(4);
 
     return 0;
 }
@@ -2074,13 +2110,13 @@ int igraph_subgraph(const igraph_t *graph, igraph_t *res,
  *        existing graph and deletes the vertices that are not needed
  *        in the new graph, while \c IGRAPH_SUBGRAPH_CREATE_FROM_SCRATCH
  *        constructs the new graph from scratch without copying the old
- *        one. The latter is more efficient if you are extracting a
- *        relatively small subpart of a very large graph, while the
- *        former is better if you want to extract a subgraph whose size
- *        is comparable to the size of the whole graph. There is a third
- *        possibility: \c IGRAPH_SUBGRAPH_AUTO will select one of the
- *        two methods automatically based on the ratio of the number
- *        of vertices in the new and the old graph.
+ *        one. The latter is faster, but it orders the edges of the
+ *        subgraph by their endpoints, while the former keeps the
+ *        relative order of the kept edges. There is a third
+ *        possibility: \c IGRAPH_SUBGRAPH_AUTO selects
+ *        \c IGRAPH_SUBGRAPH_COPY_AND_DELETE if more than half of the
+ *        vertices are kept, and \c IGRAPH_SUBGRAPH_CREATE_FROM_SCRATCH
+ *        otherwise.
  *
  * \return Error code:
  *         \c IGRAPH_ENOMEM, not enough memory for
@@ -2115,7 +2151,10 @@ int igraph_i_induced_subgraph_suggest_implementation(
         ratio = (igraph_real_t) num_vs / igraph_vcount(graph);
     }
 
-    /* TODO: needs benchmarking; threshold was chosen totally arbitrarily */
+    /* Creating the subgraph from the sorted edge index is faster at
+       every ratio, but it reorders the edges; copying keeps their
+       relative order, which callers of the default implementation may
+       rely on when mapping edge ids back to the original graph. */
     if (ratio > 0.5) {
         *result = IGRAPH_SUBGRAPH_COPY_AND_DELETE;
     } else {
@@ -2261,19 +2300,6 @@ int igraph_subgraph_edges(const igraph_t *graph, igraph_t *res,
     return 0;
 }
 
-void igraph_i_simplify_free(igraph_vector_ptr_t *p);
-
-void igraph_i_simplify_free(igraph_vector_ptr_t *p) {
-    long int i, n = igraph_vector_ptr_size(p);
-    for (i = 0; i < n; i++) {
-        igraph_vector_t *v = VECTOR(*p)[i];
-        if (v) {
-            igraph_vector_destroy(v);
-        }
-    }
-    igraph_vector_ptr_destroy(p);
-}
-
 /**
  * \ingroup structural
  * \function igraph_simplify
@@ -2297,11 +2323,10 @@ int igraph_simplify(igraph_t *graph, igraph_bool_t multiple,
                     const igraph_attribute_combination_t *edge_comb) {
 
     igraph_vector_t edges = IGRAPH_VECTOR_NULL;
-    long int no_of_nodes = igraph_vcount(graph);
     long int no_of_edges = igraph_ecount(graph);
     long int edge;
     igraph_bool_t attr = edge_comb && igraph_has_attribute_table();
-    long int from, to, pfrom = -1, pto = -2;
+    long int from, to;
     igraph_t res;
     igraph_es_t es;
     igraph_eit_t eit;
@@ -2350,50 +2375,11 @@ int igraph_simplify(igraph_t *graph, igraph_bool_t multiple,
     if (attr) {
         IGRAPH_VECTOR_INIT_FINALLY(&mergeinto, no_of_edges);
     }
-    IGRAPH_VECTOR_INIT_FINALLY(&edges, 0);
-    IGRAPH_CHECK(igraph_vector_reserve(&edges, no_of_edges * 2));
-
-    IGRAPH_CHECK(igraph_es_all(&es, IGRAPH_EDGEORDER_FROM));
-    IGRAPH_FINALLY(igraph_es_destroy, &es);
-    IGRAPH_CHECK(igraph_eit_create(graph, es, &eit));
-    IGRAPH_FINALLY(igraph_eit_destroy, &eit);
-
-    for (actedge = -1; !IGRAPH_EIT_END(eit); IGRAPH_EIT_NEXT(eit)) {
-        edge = IGRAPH_EIT_GET(eit);
-        from = IGRAPH_FROM(graph, edge);
-        to = IGRAPH_TO(graph, edge);
-
-        if (loops && from == to) {
-            /* Loop edge to be removed */
-            if (attr) {
-                VECTOR(mergeinto)[edge] = -1;
-            }
-        } else if (multiple && from == pfrom && to == pto) {
-            /* Multiple edge to be contracted */
-            if (attr) {
-                VECTOR(mergeinto)[edge] = actedge;
-            }
-        } else {
-            /* Edge to be kept */
-            igraph_vector_push_back(&edges, from);
-            igraph_vector_push_back(&edges, to);
-            if (attr) {
-                actedge++;
-                VECTOR(mergeinto)[edge] = actedge;
-            }
-        }
-        pfrom = from; pto = to;
-    }
-
-    igraph_eit_destroy(&eit);
-    igraph_es_destroy(&es);
-    IGRAPH_FINALLY_CLEAN(2);
 
-    IGRAPH_CHECK(igraph_create(&res, &edges, (igraph_integer_t) no_of_nodes,
-                               igraph_is_directed(graph)));
-
-    igraph_vector_destroy(&edges);
-    IGRAPH_FINALLY_CLEAN(1);
+    /* Builds the new graph directly from the sorted edge indices */
+    IGRAPH_CHECK(igraph_i_simplify_multiple(graph, &res, loops,
+                                            attr ? &mergeinto : NULL));
+    actedge = igraph_ecount(&res) - 1;
 
     IGRAPH_FINALLY(igraph_destroy, &res);
 
@@ -2959,6 +2945,60 @@ int igraph_density(const igraph_t *graph, igraph_real_t *res,
     return 0;
 }
 
+/* Breadth-first search from 'node' up to distance 'order'; collects
+   the vertices at distance 'mindist' or more into 'res', in the order
+   they are reached. 'added' holds the mark of the last search that
+   reached each vertex, so it needs no reset between searches if each
+   of them uses a new 'mark'. */
+
+static int igraph_i_neighborhood_bfs(const igraph_t *graph,
+                                     long int node, long int mark,
+                                     igraph_integer_t order,
+                                     igraph_neimode_t mode,
+                                     igraph_integer_t mindist,
+                                     long int *added, igraph_dqueue_t *q,
+                                     igraph_vector_t *neis,
+                                     igraph_vector_t *res) {
+    long int j;
+
+    igraph_vector_clear(res);
+    igraph_dqueue_clear(q);
+    added[node] = mark;
+    if (mindist == 0) {
+        IGRAPH_CHECK(igraph_vector_push_back(res, node));
+    }
+    if (order > 0) {
+        IGRAPH_CHECK(igraph_dqueue_push(q, node));
+        IGRAPH_CHECK(igraph_dqueue_push(q, 0));
+    }
+
+    while (!igraph_dqueue_empty(q)) {
+        long int actnode = (long int) igraph_dqueue_pop(q);
+        long int actdist = (long int) igraph_dqueue_pop(q);
+        long int n;
+
+        IGRAPH_CHECK(igraph_neighbors(graph, neis, (igraph_integer_t) actnode,
+                                      mode));
+        n = igraph_vector_size(neis);
+        for (j = 0; j < n; j++) {
+            long int nei = (long int) VECTOR(*neis)[j];
+            if (added[nei] != mark) {
+                added[nei] = mark;
+                /* the vertices at distance 'order' are not expanded */
+                if (actdist < order - 1) {
+                    IGRAPH_CHECK(igraph_dqueue_push(q, nei));
+                    IGRAPH_CHECK(igraph_dqueue_push(q, actdist + 1));
+                }
+                if (actdist + 1 >= mindist) {
+                    IGRAPH_CHECK(igraph_vector_push_back(res, nei));
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
 /**
  * \function igraph_neighborhood_size
  * \brief Calculates the size of the neighborhood of a given vertex.
@@ -3004,9 +3044,10 @@ int igraph_neighborhood_size(const igraph_t *graph, igraph_vector_t *res,
     long int no_of_nodes = igraph_vcount(graph);
     igraph_dqueue_t q;
     igraph_vit_t vit;
-    long int i, j;
+    long int i;
     long int *added;
     igraph_vector_t neis;
+    igraph_vector_t tmp;
 
     if (order < 0) {
         IGRAPH_ERROR("Negative order in neighborhood size", IGRAPH_EINVAL);
@@ -3026,61 +3067,23 @@ int igraph_neighborhood_size(const igraph_t *graph, igraph_vector_t *res,
     IGRAPH_CHECK(igraph_vit_create(graph, vids, &vit));
     IGRAPH_FINALLY(igraph_vit_destroy, &vit);
     IGRAPH_VECTOR_INIT_FINALLY(&neis, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&tmp, 0);
     IGRAPH_CHECK(igraph_vector_resize(res, IGRAPH_VIT_SIZE(vit)));
 
     for (i = 0; !IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit), i++) {
-        long int node = IGRAPH_VIT_GET(vit);
-        long int size = mindist == 0 ? 1 : 0;
-        added[node] = i + 1;
-        igraph_dqueue_clear(&q);
-        if (order > 0) {
-            igraph_dqueue_push(&q, node);
-            igraph_dqueue_push(&q, 0);
-        }
-
-        while (!igraph_dqueue_empty(&q)) {
-            long int actnode = (long int) igraph_dqueue_pop(&q);
-            long int actdist = (long int) igraph_dqueue_pop(&q);
-            long int n;
-            igraph_neighbors(graph, &neis, (igraph_integer_t) actnode, mode);
-            n = igraph_vector_size(&neis);
-
-            if (actdist < order - 1) {
-                /* we add them to the q */
-                for (j = 0; j < n; j++) {
-                    long int nei = (long int) VECTOR(neis)[j];
-                    if (added[nei] != i + 1) {
-                        added[nei] = i + 1;
-                        IGRAPH_CHECK(igraph_dqueue_push(&q, nei));
-                        IGRAPH_CHECK(igraph_dqueue_push(&q, actdist + 1));
-                        if (actdist + 1 >= mindist) {
-                            size++;
-                        }
-                    }
-                }
-            } else {
-                /* we just count them, but don't add them */
-                for (j = 0; j < n; j++) {
-                    long int nei = (long int) VECTOR(neis)[j];
-                    if (added[nei] != i + 1) {
-                        added[nei] = i + 1;
-                        if (actdist + 1 >= mindist) {
-                            size++;
-                        }
-                    }
-                }
-            }
-
-        } /* while q not empty */
-
-        VECTOR(*res)[i] = size;
-    } /* for VIT, i */
+        IGRAPH_ALLOW_INTERRUPTION();
+        IGRAPH_CHECK(igraph_i_neighborhood_bfs(graph, IGRAPH_VIT_GET(vit),
+                                               i + 1, order, mode, mindist,
+                                               added, &q, &neis, &tmp));
+        VECTOR(*res)[i] = igraph_vector_size(&tmp);
+    }
 
+    igraph_vector_destroy(&tmp);
     igraph_vector_destroy(&neis);
     igraph_vit_destroy(&vit);
     igraph_dqueue_destroy(&q);
     igraph_Free(added);
-    IGRAPH_FINALLY_CLEAN(4);
+    IGRAPH_FINALLY_CLEAN(5);
 
     return 0;
 }
@@ -3132,7 +3135,7 @@ int igraph_neighborhood(const igraph_t *graph, igraph_vector_ptr_t *res,
     long int no_of_nodes = igraph_vcount(graph);
     igraph_dqueue_t q;
     igraph_vit_t vit;
-    long int i, j;
+    long int i;
     long int *added;
     igraph_vector_t neis;
     igraph_vector_t tmp;
@@ -3160,51 +3163,10 @@ int igraph_neighborhood(const igraph_t *graph, igraph_vector_ptr_t *res,
     IGRAPH_CHECK(igraph_vector_ptr_resize(res, IGRAPH_VIT_SIZE(vit)));
 
     for (i = 0; !IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit), i++) {
-        long int node = IGRAPH_VIT_GET(vit);
-        added[node] = i + 1;
-        igraph_vector_clear(&tmp);
-        if (mindist == 0) {
-            IGRAPH_CHECK(igraph_vector_push_back(&tmp, node));
-        }
-        if (order > 0) {
-            igraph_dqueue_push(&q, node);
-            igraph_dqueue_push(&q, 0);
-        }
-
-        while (!igraph_dqueue_empty(&q)) {
-            long int actnode = (long int) igraph_dqueue_pop(&q);
-            long int actdist = (long int) igraph_dqueue_pop(&q);
-            long int n;
-            igraph_neighbors(graph, &neis, (igraph_integer_t) actnode, mode);
-            n = igraph_vector_size(&neis);
-
-            if (actdist < order - 1) {
-                /* we add them to the q */
-                for (j = 0; j < n; j++) {
-                    long int nei = (long int) VECTOR(neis)[j];
-                    if (added[nei] != i + 1) {
-                        added[nei] = i + 1;
-                        IGRAPH_CHECK(igraph_dqueue_push(&q, nei));
-                        IGRAPH_CHECK(igraph_dqueue_push(&q, actdist + 1));
-                        if (actdist + 1 >= mindist) {
-                            IGRAPH_CHECK(igraph_vector_push_back(&tmp, nei));
-                        }
-                    }
-                }
-            } else {
-                /* we just count them but don't add them to q */
-                for (j = 0; j < n; j++) {
-                    long int nei = (long int) VECTOR(neis)[j];
-                    if (added[nei] != i + 1) {
-                        added[nei] = i + 1;
-                        if (actdist + 1 >= mindist) {
-                            IGRAPH_CHECK(igraph_vector_push_back(&tmp, nei));
-                        }
-                    }
-                }
-            }
-
-        } /* while q not empty */
+        IGRAPH_ALLOW_INTERRUPTION();
+        IGRAPH_CHECK(igraph_i_neighborhood_bfs(graph, IGRAPH_VIT_GET(vit),
+                                               i + 1, order, mode, mindist,
+                                               added, &q, &neis, &tmp));
 
         newv = igraph_Calloc(1, igraph_vector_t);
         if (newv == 0) {
@@ -3277,10 +3239,11 @@ int igraph_neighborhood_graphs(const igraph_t *graph, igraph_vector_ptr_t *res,
     long int no_of_nodes = igraph_vcount(graph);
     igraph_dqueue_t q;
     igraph_vit_t vit;
-    long int i, j;
+    long int i;
     long int *added;
     igraph_vector_t neis;
     igraph_vector_t tmp;
+    igraph_vector_t old2new, eids;
     igraph_t *newg;
 
     if (order < 0) {
@@ -3302,54 +3265,15 @@ int igraph_neighborhood_graphs(const igraph_t *graph, igraph_vector_ptr_t *res,
     IGRAPH_FINALLY(igraph_vit_destroy, &vit);
     IGRAPH_VECTOR_INIT_FINALLY(&neis, 0);
     IGRAPH_VECTOR_INIT_FINALLY(&tmp, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&old2new, no_of_nodes);
+    IGRAPH_VECTOR_INIT_FINALLY(&eids, 0);
     IGRAPH_CHECK(igraph_vector_ptr_resize(res, IGRAPH_VIT_SIZE(vit)));
 
     for (i = 0; !IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit), i++) {
-        long int node = IGRAPH_VIT_GET(vit);
-        added[node] = i + 1;
-        igraph_vector_clear(&tmp);
-        if (mindist == 0) {
-            IGRAPH_CHECK(igraph_vector_push_back(&tmp, node));
-        }
-        if (order > 0) {
-            igraph_dqueue_push(&q, node);
-            igraph_dqueue_push(&q, 0);
-        }
-
-        while (!igraph_dqueue_empty(&q)) {
-            long int actnode = (long int) igraph_dqueue_pop(&q);
-            long int actdist = (long int) igraph_dqueue_pop(&q);
-            long int n;
-            igraph_neighbors(graph, &neis, (igraph_integer_t) actnode, mode);
-            n = igraph_vector_size(&neis);
-
-            if (actdist < order - 1) {
-                /* we add them to the q */
-                for (j = 0; j < n; j++) {
-                    long int nei = (long int) VECTOR(neis)[j];
-                    if (added[nei] != i + 1) {
-                        added[nei] = i + 1;
-                        IGRAPH_CHECK(igraph_dqueue_push(&q, nei));
-                        IGRAPH_CHECK(igraph_dqueue_push(&q, actdist + 1));
-                        if (actdist + 1 >= mindist) {
-                            IGRAPH_CHECK(igraph_vector_push_back(&tmp, nei));
-                        }
-                    }
-                }
-            } else {
-                /* we just count them but don't add them to q */
-                for (j = 0; j < n; j++) {
-                    long int nei = (long int) VECTOR(neis)[j];
-                    if (added[nei] != i + 1) {
-                        added[nei] = i + 1;
-                        if (actdist + 1 >= mindist) {
-                            IGRAPH_CHECK(igraph_vector_push_back(&tmp, nei));
-                        }
-                    }
-                }
-            }
-
-        } /* while q not empty */
+        IGRAPH_ALLOW_INTERRUPTION();
+        IGRAPH_CHECK(igraph_i_neighborhood_bfs(graph, IGRAPH_VIT_GET(vit),
+                                               i + 1, order, mode, mindist,
+                                               added, &q, &neis, &tmp));
 
         newg = igraph_Calloc(1, igraph_t);
         if (newg == 0) {
@@ -3357,9 +3281,8 @@ int igraph_neighborhood_graphs(const igraph_t *graph, igraph_vector_ptr_t *res,
         }
         IGRAPH_FINALLY(igraph_free, newg);
         if (igraph_vector_size(&tmp) < no_of_nodes) {
-            IGRAPH_CHECK(igraph_induced_subgraph(graph, newg,
-                                                 igraph_vss_vector(&tmp),
-                                                 IGRAPH_SUBGRAPH_AUTO));
+            IGRAPH_CHECK(igraph_i_induced_subgraph_sorted(graph, newg, &tmp,
+                         &old2new, &eids, /* keep_map= */ 0));
         } else {
             IGRAPH_CHECK(igraph_copy(newg, graph));
         }
@@ -3367,12 +3290,14 @@ int igraph_neighborhood_graphs(const igraph_t *graph, igraph_vector_ptr_t *res,
         IGRAPH_FINALLY_CLEAN(1);
     }
 
+    igraph_vector_destroy(&eids);
+    igraph_vector_destroy(&old2new);
     igraph_vector_destroy(&tmp);
     igraph_vector_destroy(&neis);
     igraph_vit_destroy(&vit);
     igraph_dqueue_destroy(&q);
     igraph_Free(added);
-    IGRAPH_FINALLY_CLEAN(5);
+    IGRAPH_FINALLY_CLEAN(7);
 
     return 0;
 }
@@ -4467,11 +4392,13 @@ int igraph_shortest_paths_dijkstra(const igraph_t *graph,
     IGRAPH_CHECK(igraph_matrix_resize(res, no_of_from, no_of_to));
     igraph_matrix_fill(res, my_infinity);
 
+    IGRAPH_TIMER_START(IGRAPH_TIMER_SHORTEST_PATHS);
+
     for (IGRAPH_VIT_RESET(fromvit), i = 0;
          !IGRAPH_VIT_END(fromvit);
          IGRAPH_VIT_NEXT(fromvit), i++) {
 
-        long int reached = 0;
+        long int reached = 0, scanned = 0, heapops = 1;
         long int source = IGRAPH_VIT_GET(fromvit);
         igraph_2wheap_clear(&Q);
         igraph_2wheap_push_with_index(&Q, source, -1.0);
@@ -4482,6 +4409,8 @@ int igraph_shortest_paths_dijkstra(const igraph_t *graph,
             igraph_vector_t *neis;
             long int nlen;
 
+            heapops++;
+
             if (all_to) {
                 MATRIX(*res, i, minnei) = mindist - 1.0;
             } else {
@@ -4498,6 +4427,7 @@ int igraph_shortest_paths_dijkstra(const igraph_t *graph,
             /* Now check all neighbors of 'minnei' for a shorter path */
             neis = igraph_lazy_inclist_get(&inclist, (igraph_integer_t) minnei);
             nlen = igraph_vector_size(neis);
+            scanned += nlen;
             for (j = 0; j < nlen; j++) {
                 long int edge = (long int) VECTOR(*neis)[j];
                 long int tto = IGRAPH_OTHER(graph, edge, minnei);
@@ -4508,16 +4438,24 @@ int igraph_shortest_paths_dijkstra(const igraph_t *graph,
                 if (!has) {
                     /* This is the first non-infinite distance */
                     IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q, tto, -altdist));
+                    heapops++;
                 } else if (altdist < curdist) {
                     /* This is a shorter path */
                     IGRAPH_CHECK(igraph_2wheap_modify(&Q, tto, -altdist));
+                    heapops++;
                 }
             }
 
         } /* !igraph_2wheap_empty(&Q) */
 
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_SEARCH_SOURCES, 1);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_EDGES_SCANNED, scanned);
+        IGRAPH_COUNTER_ADD(IGRAPH_COUNTER_HEAP_OPERATIONS, heapops);
+
     } /* !IGRAPH_VIT_END(fromvit) */
 
+    IGRAPH_TIMER_STOP(IGRAPH_TIMER_SHORTEST_PATHS);
+
     if (!all_to) {
         igraph_vit_destroy(&tovit);
         igraph_vector_destroy(&indexv);
@@ -5337,7 +5275,7 @@ int igraph_get_all_shortest_paths_dijkstra(const igraph_t *graph,
                 j++;
             } else {
                 /* we don't need this path, free it */
-                igraph_vector_destroy(path); free(path);
+                igraph_vector_destroy(path); igraph_Free(path);
             }
         }
         IGRAPH_CHECK(igraph_vector_ptr_resize(res, j));
@@ -6585,45 +6523,16 @@ int igraph_contract_vertices(igraph_t *graph,
                             /*vertex=*/ 0, /*edge=*/ 1);
 
     if (vattr) {
-        long int i;
-        igraph_vector_ptr_t merges;
-        igraph_vector_t sizes;
-        igraph_vector_t *vecs;
-
-        vecs = igraph_Calloc(no_new_vertices, igraph_vector_t);
-        if (!vecs) {
-            IGRAPH_ERROR("Cannot combine attributes while contracting"
-                         " vertices", IGRAPH_ENOMEM);
-        }
-        IGRAPH_FINALLY(igraph_free, vecs);
-        IGRAPH_CHECK(igraph_vector_ptr_init(&merges, no_new_vertices));
-        IGRAPH_FINALLY(igraph_i_simplify_free, &merges);
-        IGRAPH_VECTOR_INIT_FINALLY(&sizes, no_new_vertices);
-
-        for (i = 0; i < no_of_nodes; i++) {
-            long int to = (long int) VECTOR(*mapping)[i];
-            VECTOR(sizes)[to] += 1;
-        }
-        for (i = 0; i < no_new_vertices; i++) {
-            igraph_vector_t *v = &vecs[i];
-            IGRAPH_CHECK(igraph_vector_init(v, (long int) VECTOR(sizes)[i]));
-            igraph_vector_clear(v);
-            VECTOR(merges)[i] = v;
-        }
-        for (i = 0; i < no_of_nodes; i++) {
-            long int to = (long int) VECTOR(*mapping)[i];
-            igraph_vector_t *v = &vecs[to];
-            igraph_vector_push_back(v, i);
-        }
+        igraph_fixed_vectorlist_t vl;
+        IGRAPH_CHECK(igraph_fixed_vectorlist_convert(&vl, mapping,
+                     no_new_vertices));
+        IGRAPH_FINALLY(igraph_fixed_vectorlist_destroy, &vl);
 
-        IGRAPH_CHECK(igraph_i_attribute_combine_vertices(graph, &res,
-                     &merges,
+        IGRAPH_CHECK(igraph_i_attribute_combine_vertices(graph, &res, &vl.v,
                      vertex_comb));
 
-        igraph_vector_destroy(&sizes);
-        igraph_i_simplify_free(&merges);
-        igraph_free(vecs);
-        IGRAPH_FINALLY_CLEAN(3);
+        igraph_fixed_vectorlist_destroy(&vl);
+        IGRAPH_FINALLY_CLEAN(1);
     }
 
     IGRAPH_FINALLY_CLEAN(1);
@@ -23,6 +23,7 @@
 */
 
 #include "igraph_layout.h"
+#include "igraph_adjlist.h"
 #include "igraph_centrality.h"
 #include "igraph_components.h"
 #include "igraph_constants.h"
@@ -31,6 +32,8 @@
 #include "igraph_error.h"
 #include "igraph_glpk_support.h"
 #include "igraph_interface.h"
+#include "igraph_interrupt_internal.h"
+#include "igraph_layout_internal.h"
 #include "igraph_memory.h"
 #include "igraph_structural.h"
 #include "igraph_types.h"
@@ -132,7 +135,8 @@ static void debug(const char* fmt, ...) {
  *   3. Extracting weakly connected components. The remaining steps are
  *      executed for each component.
  *
- *   4. Compacting the layering using the method of [4]. TODO
+ *   4. Compacting the layering using the method of [4]. This is skipped
+ *      when the layering comes from the linear program, which is optimal.
  *      Steps 2-4 are performed only when no layering is given in advance.
  *
  *   5. Adding dummy nodes to ensure that each edge spans at most one layer
@@ -220,6 +224,8 @@ static igraph_vector_t* igraph_i_layering_get(const igraph_i_layering_t* layerin
 
 static int igraph_i_layout_sugiyama_place_nodes_vertically(const igraph_t* graph,
         const igraph_vector_t* weights, igraph_vector_t* membership);
+static int igraph_i_layout_sugiyama_promote_nodes(const igraph_t* graph,
+        igraph_vector_t* membership);
 static int igraph_i_layout_sugiyama_order_nodes_horizontally(const igraph_t* graph,
         igraph_matrix_t* layout, const igraph_i_layering_t* layering,
         long int maxiter);
@@ -315,6 +321,10 @@ int igraph_layout_sugiyama(const igraph_t *graph, igraph_matrix_t *res,
     igraph_bool_t directed = igraph_is_directed(graph);
     igraph_integer_t no_of_components;  /* number of components of the original graph */
     igraph_vector_t membership;         /* components of the original graph */
+    igraph_vector_long_t comp_vertices; /* vertices of the graph grouped by component */
+    igraph_vector_long_t comp_start;    /* start of each component in comp_vertices */
+    igraph_vector_t old2new_vertex_ids; /* vertex ids within the current component */
+    igraph_vector_t new2old_vertex_ids;
     igraph_vector_t extd_edgelist;   /* edge list of the extended graph */
     igraph_vector_t layers_own;  /* layer indices after having eliminated empty layers */
     igraph_real_t dx = 0, dx2 = 0; /* displacement of the current component on the X axis */
@@ -367,50 +377,67 @@ int igraph_layout_sugiyama(const igraph_t *graph, igraph_matrix_t *res,
         IGRAPH_FINALLY_CLEAN(1);
     }
 
-    /* 2. Find the connected components. */
+    /* 2. Find the connected components and group the vertices by component,
+     *    keeping them in increasing order of vertex ids within each component.
+     *    This way each component is processed in time proportional to its
+     *    own size, even if there are many components. */
     IGRAPH_CHECK(igraph_clusters(graph, &membership, 0, &no_of_components,
                                  IGRAPH_WEAK));
 
+    IGRAPH_CHECK(igraph_vector_long_init(&comp_start, no_of_components + 1));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &comp_start);
+    IGRAPH_CHECK(igraph_vector_long_init(&comp_vertices, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &comp_vertices);
+    IGRAPH_VECTOR_INIT_FINALLY(&new2old_vertex_ids, no_of_nodes);
+    IGRAPH_VECTOR_INIT_FINALLY(&old2new_vertex_ids, no_of_nodes);
+
+    for (i = 0; i < no_of_nodes; i++) {
+        VECTOR(comp_start)[(long int) VECTOR(membership)[i] + 1] += 1;
+    }
+    for (comp_idx = 0; comp_idx < no_of_components; comp_idx++) {
+        VECTOR(comp_start)[comp_idx + 1] += VECTOR(comp_start)[comp_idx];
+    }
+    for (i = 0; i < no_of_nodes; i++) {
+        /* old2new_vertex_ids is used as a fill pointer temporarily */
+        comp_idx = (long int) VECTOR(membership)[i];
+        VECTOR(comp_vertices)[VECTOR(comp_start)[comp_idx] +
+                              (long int) VECTOR(old2new_vertex_ids)[comp_idx]++] = i;
+    }
+
     /* 3. For each component... */
     dx = 0;
     for (comp_idx = 0; comp_idx < no_of_components; comp_idx++) {
         /* Extract the edges of the comp_idx'th component and add dummy nodes for edges
          * spanning more than one layer. */
-        long int component_size, next_new_vertex_id;
-        igraph_vector_t old2new_vertex_ids;
-        igraph_vector_t new2old_vertex_ids;
+        long int component_size, next_new_vertex_id, ii;
+        long int comp_from = VECTOR(comp_start)[comp_idx];
+        long int comp_to = VECTOR(comp_start)[comp_idx + 1];
         igraph_vector_t new_layers;
         igraph_vector_t edgelist;
         igraph_vector_t neis;
 
+        IGRAPH_ALLOW_INTERRUPTION();
+
         IGRAPH_VECTOR_INIT_FINALLY(&edgelist, 0);
         IGRAPH_VECTOR_INIT_FINALLY(&neis, 0);
-        IGRAPH_VECTOR_INIT_FINALLY(&new2old_vertex_ids, no_of_nodes);
-        IGRAPH_VECTOR_INIT_FINALLY(&old2new_vertex_ids, no_of_nodes);
         IGRAPH_VECTOR_INIT_FINALLY(&new_layers, 0);
 
-        igraph_vector_fill(&old2new_vertex_ids, -1);
-
         /* Construct a mapping from the old vertex ids to the new ones */
-        for (i = 0, next_new_vertex_id = 0; i < no_of_nodes; i++) {
-            if (VECTOR(membership)[i] == comp_idx) {
-                IGRAPH_CHECK(igraph_vector_push_back(&new_layers, VECTOR(layers_own)[i]));
-                VECTOR(new2old_vertex_ids)[next_new_vertex_id] = i;
-                VECTOR(old2new_vertex_ids)[i] = next_new_vertex_id;
-                next_new_vertex_id++;
-            }
+        for (ii = comp_from, next_new_vertex_id = 0; ii < comp_to; ii++) {
+            i = VECTOR(comp_vertices)[ii];
+            IGRAPH_CHECK(igraph_vector_push_back(&new_layers, VECTOR(layers_own)[i]));
+            VECTOR(new2old_vertex_ids)[next_new_vertex_id] = i;
+            VECTOR(old2new_vertex_ids)[i] = next_new_vertex_id;
+            next_new_vertex_id++;
         }
         component_size = next_new_vertex_id;
 
         /* Construct a proper layering of the component in new_graph where each edge
          * points downwards and spans exactly one layer. */
-        for (i = 0; i < no_of_nodes; i++) {
-            if (VECTOR(membership)[i] != comp_idx) {
-                continue;
-            }
+        for (ii = comp_from; ii < comp_to; ii++) {
+            i = VECTOR(comp_vertices)[ii];
 
-            /* Okay, this vertex is in the component we are considering.
-             * Add the neighbors of this vertex, excluding loops */
+            /* Add the neighbors of this vertex, excluding loops */
             IGRAPH_CHECK(igraph_incident(graph, &neis, (igraph_integer_t) i,
                                          IGRAPH_OUT));
             j = igraph_vector_size(&neis);
@@ -563,13 +590,17 @@ int igraph_layout_sugiyama(const igraph_t *graph, igraph_matrix_t *res,
         }
 
         igraph_vector_destroy(&new_layers);
-        igraph_vector_destroy(&old2new_vertex_ids);
-        igraph_vector_destroy(&new2old_vertex_ids);
         igraph_vector_destroy(&edgelist);
         igraph_vector_destroy(&neis);
-        IGRAPH_FINALLY_CLEAN(5);
+        IGRAPH_FINALLY_CLEAN(3);
     }
 
+    igraph_vector_destroy(&old2new_vertex_ids);
+    igraph_vector_destroy(&new2old_vertex_ids);
+    igraph_vector_long_destroy(&comp_vertices);
+    igraph_vector_long_destroy(&comp_start);
+    IGRAPH_FINALLY_CLEAN(4);
+
     igraph_vector_destroy(&layers_own);
     igraph_vector_destroy(&layer_to_y);
     igraph_vector_destroy(&membership);
@@ -691,8 +722,10 @@ static int igraph_i_layout_sugiyama_place_nodes_vertically(const igraph_t* graph
         IGRAPH_FINALLY_CLEAN(2);
     } else if (igraph_is_directed(graph)) {
         IGRAPH_CHECK(igraph_i_feedback_arc_set_eades(graph, 0, weights, membership));
+        IGRAPH_CHECK(igraph_i_layout_sugiyama_promote_nodes(graph, membership));
     } else {
         IGRAPH_CHECK(igraph_i_feedback_arc_set_undirected(graph, 0, weights, membership));
+        IGRAPH_CHECK(igraph_i_layout_sugiyama_promote_nodes(graph, membership));
     }
 #else
     if (igraph_is_directed(graph)) {
@@ -700,42 +733,327 @@ static int igraph_i_layout_sugiyama_place_nodes_vertically(const igraph_t* graph
     } else {
         IGRAPH_CHECK(igraph_i_feedback_arc_set_undirected(graph, 0, weights, membership));
     }
+    IGRAPH_CHECK(igraph_i_layout_sugiyama_promote_nodes(graph, membership));
 #endif
 
     return IGRAPH_SUCCESS;
 }
 
-static int igraph_i_layout_sugiyama_calculate_barycenters(const igraph_t* graph,
+/**
+ * Compacts a layering by the promotion of nodes [4]. Layer indices grow
+ * downwards here, so promoting a vertex moves it one layer down, along
+ * with the vertices right below it that it has an edge to, recursively.
+ * The change in the number of dummy nodes is the number of edges that
+ * enter the moved set minus the number of edges that leave it; the
+ * promotion is kept if this is negative. Passes over all vertices are
+ * repeated until no promotion is kept. Edges within a layer do not
+ * constrain the promotions and are not counted.
+ */
+static int igraph_i_layout_sugiyama_promote_nodes(const igraph_t* graph,
+        igraph_vector_t* membership) {
+    long int no_of_nodes = igraph_vcount(graph);
+    long int no_of_edges = igraph_ecount(graph);
+    long int i, j, v, promotions, attempt = 0;
+    igraph_vector_long_t down_start, down, balance, mark, stack, moved;
+
+    IGRAPH_CHECK(igraph_vector_long_init(&down_start, no_of_nodes + 1));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &down_start);
+    IGRAPH_CHECK(igraph_vector_long_init(&down, no_of_edges));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &down);
+    IGRAPH_CHECK(igraph_vector_long_init(&balance, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &balance);
+    IGRAPH_CHECK(igraph_vector_long_init(&mark, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &mark);
+    IGRAPH_CHECK(igraph_vector_long_init(&stack, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &stack);
+    IGRAPH_CHECK(igraph_vector_long_init(&moved, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &moved);
+
+    /* Edges pointing downwards, grouped by their upper endpoint. The
+     * promotions keep every such edge pointing downwards, so they can be
+     * collected once. 'balance' is the in-degree minus the out-degree. */
+    for (i = 0; i < no_of_edges; i++) {
+        long int from = IGRAPH_FROM(graph, i), to = IGRAPH_TO(graph, i);
+        if (VECTOR(*membership)[from] == VECTOR(*membership)[to]) {
+            continue;
+        }
+        if (VECTOR(*membership)[from] > VECTOR(*membership)[to]) {
+            long int tmp = from; from = to; to = tmp;
+        }
+        VECTOR(down_start)[from + 1] += 1;
+        VECTOR(balance)[from] -= 1;
+        VECTOR(balance)[to] += 1;
+    }
+    for (i = 0; i < no_of_nodes; i++) {
+        VECTOR(down_start)[i + 1] += VECTOR(down_start)[i];
+    }
+    for (i = 0; i < no_of_edges; i++) {
+        long int from = IGRAPH_FROM(graph, i), to = IGRAPH_TO(graph, i);
+        if (VECTOR(*membership)[from] == VECTOR(*membership)[to]) {
+            continue;
+        }
+        if (VECTOR(*membership)[from] > VECTOR(*membership)[to]) {
+            long int tmp = from; from = to; to = tmp;
+        }
+        /* 'mark' is used as a fill pointer temporarily */
+        VECTOR(down)[VECTOR(down_start)[from] + VECTOR(mark)[from]++] = to;
+    }
+    igraph_vector_long_null(&mark);
+
+    do {
+        promotions = 0;
+        for (v = 0; v < no_of_nodes; v++) {
+            long int diff = 0;
+
+            /* Moving a sink down only makes its edges longer */
+            if (VECTOR(down_start)[v] == VECTOR(down_start)[v + 1]) {
+                continue;
+            }
+
+            IGRAPH_ALLOW_INTERRUPTION();
+
+            /* Collect the vertices that have to move together with v;
+             * 'mark' holds the attempt in which a vertex was collected */
+            attempt++;
+            igraph_vector_long_clear(&moved);
+            IGRAPH_CHECK(igraph_vector_long_push_back(&stack, v));
+            VECTOR(mark)[v] = attempt;
+            while (!igraph_vector_long_empty(&stack)) {
+                long int u = igraph_vector_long_pop_back(&stack);
+                IGRAPH_CHECK(igraph_vector_long_push_back(&moved, u));
+                diff += VECTOR(balance)[u];
+                for (j = VECTOR(down_start)[u]; j < VECTOR(down_start)[u + 1]; j++) {
+                    long int w = VECTOR(down)[j];
+                    if (VECTOR(mark)[w] != attempt &&
+                        VECTOR(*membership)[w] == VECTOR(*membership)[u] + 1) {
+                        VECTOR(mark)[w] = attempt;
+                        IGRAPH_CHECK(igraph_vector_long_push_back(&stack, w));
+                    }
+                }
+            }
+
+            if (diff < 0) {
+                j = igraph_vector_long_size(&moved);
+                for (i = 0; i < j; i++) {
+                    VECTOR(*membership)[VECTOR(moved)[i]] += 1;
+                }
+                promotions++;
+            }
+        }
+    } while (promotions > 0);
+
+    igraph_vector_long_destroy(&moved);
+    igraph_vector_long_destroy(&stack);
+    igraph_vector_long_destroy(&mark);
+    igraph_vector_long_destroy(&balance);
+    igraph_vector_long_destroy(&down);
+    igraph_vector_long_destroy(&down_start);
+    IGRAPH_FINALLY_CLEAN(6);
+
+    return IGRAPH_SUCCESS;
+}
+
+static int igraph_i_layout_sugiyama_calculate_barycenters(
         const igraph_i_layering_t* layering, long int layer_index,
-        igraph_neimode_t direction, const igraph_matrix_t* layout,
+        const igraph_adjlist_t* adjlist, const igraph_matrix_t* layout,
         igraph_vector_t* barycenters) {
     long int i, j, m, n;
     igraph_vector_t* layer_members = igraph_i_layering_get(layering, layer_index);
-    igraph_vector_t neis;
-
-    IGRAPH_VECTOR_INIT_FINALLY(&neis, 0);
+    igraph_vector_int_t* neis;
 
     n = igraph_vector_size(layer_members);
     IGRAPH_CHECK(igraph_vector_resize(barycenters, n));
     igraph_vector_null(barycenters);
 
     for (i = 0; i < n; i++) {
-        IGRAPH_CHECK(igraph_neighbors(graph, &neis, (igraph_integer_t)
-                                      VECTOR(*layer_members)[i], direction));
-        m = igraph_vector_size(&neis);
+        neis = igraph_adjlist_get(adjlist, (long int) VECTOR(*layer_members)[i]);
+        m = igraph_vector_int_size(neis);
         if (m == 0) {
             /* No neighbors in this direction. Just use the current X coordinate */
             VECTOR(*barycenters)[i] = MATRIX(*layout, i, 0);
         } else {
             for (j = 0; j < m; j++) {
-                VECTOR(*barycenters)[i] += MATRIX(*layout, (long)VECTOR(neis)[j], 0);
+                VECTOR(*barycenters)[i] += MATRIX(*layout, (long)VECTOR(*neis)[j], 0);
             }
             VECTOR(*barycenters)[i] /= m;
         }
     }
 
-    igraph_vector_destroy(&neis);
-    IGRAPH_FINALLY_CLEAN(1);
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * Counts the number of edge crossings between consecutive layers in the
+ * current ordering, using the accumulator tree of Barth, Jünger and Mutzel:
+ *
+ * W. Barth, M. Jünger and P. Mutzel, "Simple and Efficient Bilayer Cross
+ * Counting". In: Lecture Notes in Computer Science 2528:130-141, 2002.
+ *
+ * The edges between two layers are visited in lexicographic order of the
+ * positions of their endpoints; the number of crossings is the number of
+ * inversions in the resulting sequence of lower endpoint positions, which
+ * the accumulator tree counts in O(|E| log |V|) time.
+ */
+static int igraph_i_layout_sugiyama_count_crossings(
+        const igraph_i_layering_t* layering, const igraph_adjlist_t* out_adjlist,
+        const igraph_matrix_t* layout, igraph_vector_long_t* tree,
+        igraph_vector_long_t* south, igraph_real_t* crossings) {
+    long int i, j, k, n, m, index, first_index;
+    long int no_of_layers = igraph_i_layering_num_layers(layering);
+    igraph_real_t result = 0;
+
+    for (i = 0; i < no_of_layers - 1; i++) {
+        igraph_vector_t* upper = igraph_i_layering_get(layering, i);
+        long int lower_size = igraph_vector_size(igraph_i_layering_get(layering, i + 1));
+
+        /* Collect the positions of the lower endpoints, sorted by the
+         * position of the upper endpoint first and the lower endpoint second */
+        igraph_vector_long_clear(south);
+        n = igraph_vector_size(upper);
+        for (j = 0; j < n; j++) {
+            igraph_vector_int_t* neis = igraph_adjlist_get(out_adjlist,
+                                        (long int) VECTOR(*upper)[j]);
+            long int start = igraph_vector_long_size(south);
+            m = igraph_vector_int_size(neis);
+            for (k = 0; k < m; k++) {
+                IGRAPH_CHECK(igraph_vector_long_push_back(south,
+                             (long int) MATRIX(*layout, (long int) VECTOR(*neis)[k], 0)));
+            }
+            if (m > 1) {
+                igraph_vector_long_t slice;
+                igraph_vector_long_view(&slice, VECTOR(*south) + start, m);
+                igraph_vector_long_sort(&slice);
+            }
+        }
+
+        /* Build the accumulator tree */
+        first_index = 1;
+        while (first_index < lower_size) {
+            first_index *= 2;
+        }
+        IGRAPH_CHECK(igraph_vector_long_resize(tree, 2 * first_index - 1));
+        igraph_vector_long_null(tree);
+        first_index -= 1;
+
+        m = igraph_vector_long_size(south);
+        for (j = 0; j < m; j++) {
+            index = VECTOR(*south)[j] + first_index;
+            VECTOR(*tree)[index]++;
+            while (index > 0) {
+                if (index % 2) {
+                    result += VECTOR(*tree)[index + 1];
+                }
+                index = (index - 1) / 2;
+                VECTOR(*tree)[index]++;
+            }
+        }
+    }
+
+    *crossings = result;
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * Counts the edge crossings of a properly layered graph with the
+ * accumulator tree, for testing. The first column of the layout must
+ * give the position of each vertex in its layer, from zero, and the
+ * second column its layer; every edge must point from a layer to the
+ * next one.
+ */
+int igraph_i_layout_sugiyama_crossings(const igraph_t *graph,
+                                       const igraph_matrix_t *layout,
+                                       igraph_real_t *crossings) {
+    long int i, no_of_vertices = igraph_vcount(graph);
+    igraph_vector_t membership;
+    igraph_i_layering_t layering;
+    igraph_adjlist_t out_adjlist;
+    igraph_vector_long_t tree, south;
+
+    IGRAPH_VECTOR_INIT_FINALLY(&membership, no_of_vertices);
+    IGRAPH_CHECK(igraph_matrix_get_col(layout, &membership, 1));
+    IGRAPH_CHECK(igraph_i_layering_init(&layering, &membership));
+    IGRAPH_FINALLY(igraph_i_layering_destroy, &layering);
+
+    /* The layers must list their members in the order of the positions */
+    for (i = 0; i < no_of_vertices; i++) {
+        igraph_vector_t* layer_members =
+            igraph_i_layering_get(&layering, (long int) MATRIX(*layout, i, 1));
+        VECTOR(*layer_members)[(long int) MATRIX(*layout, i, 0)] = i;
+    }
+
+    IGRAPH_CHECK(igraph_adjlist_init(graph, &out_adjlist, IGRAPH_OUT));
+    IGRAPH_FINALLY(igraph_adjlist_destroy, &out_adjlist);
+    IGRAPH_CHECK(igraph_vector_long_init(&tree, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &tree);
+    IGRAPH_CHECK(igraph_vector_long_init(&south, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &south);
+
+    IGRAPH_CHECK(igraph_i_layout_sugiyama_count_crossings(&layering, &out_adjlist,
+                 layout, &tree, &south, crossings));
+
+    igraph_vector_long_destroy(&south);
+    igraph_vector_long_destroy(&tree);
+    igraph_adjlist_destroy(&out_adjlist);
+    igraph_i_layering_destroy(&layering);
+    igraph_vector_destroy(&membership);
+    IGRAPH_FINALLY_CLEAN(5);
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * Saves the current ordering of the layers into the given vector, indexed
+ * by vertex ids.
+ */
+static void igraph_i_layout_sugiyama_save_ordering(const igraph_matrix_t* layout,
+        igraph_vector_t* ordering) {
+    long int i, n = igraph_vector_size(ordering);
+    for (i = 0; i < n; i++) {
+        VECTOR(*ordering)[i] = MATRIX(*layout, i, 0);
+    }
+}
+
+/**
+ * Restores an ordering saved with igraph_i_layout_sugiyama_save_ordering().
+ */
+static void igraph_i_layout_sugiyama_restore_ordering(igraph_matrix_t* layout,
+        const igraph_i_layering_t* layering, const igraph_vector_t* ordering) {
+    long int i, n = igraph_vector_size(ordering);
+    for (i = 0; i < n; i++) {
+        igraph_vector_t* layer_members =
+            igraph_i_layering_get(layering, (long int) MATRIX(*layout, i, 1));
+        MATRIX(*layout, i, 0) = VECTOR(*ordering)[i];
+        VECTOR(*layer_members)[(long int) VECTOR(*ordering)[i]] = i;
+    }
+}
+
+/**
+ * Sorts the members of a layer by the given barycenters and updates the
+ * positions in the layout. Returns whether the order of the layer changed.
+ */
+static int igraph_i_layout_sugiyama_sort_layer(igraph_vector_t* layer_members,
+        igraph_matrix_t* layout, igraph_vector_t* barycenters,
+        igraph_vector_t* sort_indices, igraph_bool_t* changed) {
+    long int i, nei, n = igraph_vector_size(layer_members);
+
+    IGRAPH_CHECK((int) igraph_vector_qsort_ind(barycenters, sort_indices, 0));
+    for (i = 0; i < n; i++) {
+        nei = (long)VECTOR(*layer_members)[(long)VECTOR(*sort_indices)[i]];
+        VECTOR(*barycenters)[i] = nei;
+        MATRIX(*layout, nei, 0) = i;
+    }
+    if (!igraph_vector_all_e(layer_members, barycenters)) {
+        IGRAPH_CHECK(igraph_vector_update(layer_members, barycenters));
+#ifdef SUGIYAMA_DEBUG
+        printf("New vertex order: "); igraph_vector_print(layer_members);
+#endif
+        *changed = 1;
+    } else {
+#ifdef SUGIYAMA_DEBUG
+        printf("Order did not change.\n");
+#endif
+    }
 
     return IGRAPH_SUCCESS;
 }
@@ -744,16 +1062,23 @@ static int igraph_i_layout_sugiyama_calculate_barycenters(const igraph_t* graph,
  * Given a properly layered graph where each edge points downwards and spans
  * exactly one layer, arranges the nodes in each layer horizontally in a way
  * that strives to minimize edge crossings.
+ *
+ * The neighbor lists are built only once, and the number of crossings is
+ * counted after every down-and-up sweep. The ordering with the fewest
+ * crossings seen is kept, and the sweeps stop as soon as a crossing-free
+ * ordering is found.
  */
 static int igraph_i_layout_sugiyama_order_nodes_horizontally(const igraph_t* graph,
         igraph_matrix_t* layout, const igraph_i_layering_t* layering,
         long int maxiter) {
-    long int i, n, nei;
+    long int i;
     long int no_of_vertices = igraph_vcount(graph);
     long int no_of_layers = igraph_i_layering_num_layers(layering);
     long int iter, layer_index;
-    igraph_vector_t* layer_members;
-    igraph_vector_t neis, barycenters, sort_indices;
+    igraph_vector_t barycenters, sort_indices, best_ordering;
+    igraph_vector_long_t tree, south;
+    igraph_adjlist_t in_adjlist, out_adjlist;
+    igraph_real_t crossings, best_crossings;
     igraph_bool_t changed;
 
     /* The first column of the matrix will serve as the ordering */
@@ -766,98 +1091,91 @@ static int igraph_i_layout_sugiyama_order_nodes_horizontally(const igraph_t* gra
         for (i = 0; i < no_of_vertices; i++) {
             MATRIX(*layout, i, 0) = xs[(long int)MATRIX(*layout, i, 1)]++;
         }
-        free(xs);
+        igraph_Free(xs);
     }
 
+    IGRAPH_CHECK(igraph_adjlist_init(graph, &in_adjlist, IGRAPH_IN));
+    IGRAPH_FINALLY(igraph_adjlist_destroy, &in_adjlist);
+    IGRAPH_CHECK(igraph_adjlist_init(graph, &out_adjlist, IGRAPH_OUT));
+    IGRAPH_FINALLY(igraph_adjlist_destroy, &out_adjlist);
+
     IGRAPH_VECTOR_INIT_FINALLY(&barycenters, 0);
-    IGRAPH_VECTOR_INIT_FINALLY(&neis, 0);
     IGRAPH_VECTOR_INIT_FINALLY(&sort_indices, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&best_ordering, no_of_vertices);
+    IGRAPH_CHECK(igraph_vector_long_init(&tree, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &tree);
+    IGRAPH_CHECK(igraph_vector_long_init(&south, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &south);
+
+    IGRAPH_CHECK(igraph_i_layout_sugiyama_count_crossings(layering, &out_adjlist,
+                 layout, &tree, &south, &best_crossings));
+    igraph_i_layout_sugiyama_save_ordering(layout, &best_ordering);
 
     /* Start the effective part of the Sugiyama algorithm */
     iter = 0; changed = 1;
-    while (changed && iter < maxiter) {
+    while (changed && iter < maxiter && best_crossings > 0) {
         changed = 0;
 
+        IGRAPH_ALLOW_INTERRUPTION();
+
         /* Phase 1 */
 
         /* Moving downwards and sorting by upper barycenters */
         for (layer_index = 1; layer_index < no_of_layers; layer_index++) {
-            layer_members = igraph_i_layering_get(layering, layer_index);
-            n = igraph_vector_size(layer_members);
-
-            igraph_i_layout_sugiyama_calculate_barycenters(graph,
-                    layering, layer_index, IGRAPH_IN, layout, &barycenters);
+            IGRAPH_CHECK(igraph_i_layout_sugiyama_calculate_barycenters(
+                             layering, layer_index, &in_adjlist, layout, &barycenters));
 
 #ifdef SUGIYAMA_DEBUG
             printf("Layer %ld, aligning to upper barycenters\n", layer_index);
-            printf("Vertices: "); igraph_vector_print(layer_members);
+            printf("Vertices: "); igraph_vector_print(igraph_i_layering_get(layering, layer_index));
             printf("Barycenters: "); igraph_vector_print(&barycenters);
 #endif
-            IGRAPH_CHECK((int) igraph_vector_qsort_ind(&barycenters,
-                         &sort_indices, 0));
-            for (i = 0; i < n; i++) {
-                nei = (long)VECTOR(*layer_members)[(long)VECTOR(sort_indices)[i]];
-                VECTOR(barycenters)[i] = nei;
-                MATRIX(*layout, nei, 0) = i;
-            }
-            if (!igraph_vector_all_e(layer_members, &barycenters)) {
-                IGRAPH_CHECK(igraph_vector_update(layer_members, &barycenters));
-#ifdef SUGIYAMA_DEBUG
-                printf("New vertex order: "); igraph_vector_print(layer_members);
-#endif
-                changed = 1;
-            } else {
-#ifdef SUGIYAMA_DEBUG
-                printf("Order did not change.\n");
-#endif
-            }
+            IGRAPH_CHECK(igraph_i_layout_sugiyama_sort_layer(
+                             igraph_i_layering_get(layering, layer_index), layout,
+                             &barycenters, &sort_indices, &changed));
         }
 
         /* Moving upwards and sorting by lower barycenters */
         for (layer_index = no_of_layers - 2; layer_index >= 0; layer_index--) {
-            layer_members = igraph_i_layering_get(layering, layer_index);
-            n = igraph_vector_size(layer_members);
-
-            igraph_i_layout_sugiyama_calculate_barycenters(graph,
-                    layering, layer_index, IGRAPH_OUT, layout, &barycenters);
+            IGRAPH_CHECK(igraph_i_layout_sugiyama_calculate_barycenters(
+                             layering, layer_index, &out_adjlist, layout, &barycenters));
 
 #ifdef SUGIYAMA_DEBUG
             printf("Layer %ld, aligning to lower barycenters\n", layer_index);
-            printf("Vertices: "); igraph_vector_print(layer_members);
+            printf("Vertices: "); igraph_vector_print(igraph_i_layering_get(layering, layer_index));
             printf("Barycenters: "); igraph_vector_print(&barycenters);
 #endif
+            IGRAPH_CHECK(igraph_i_layout_sugiyama_sort_layer(
+                             igraph_i_layering_get(layering, layer_index), layout,
+                             &barycenters, &sort_indices, &changed));
+        }
 
-            IGRAPH_CHECK((int) igraph_vector_qsort_ind(&barycenters,
-                         &sort_indices, 0));
-            for (i = 0; i < n; i++) {
-                nei = (long)VECTOR(*layer_members)[(long)VECTOR(sort_indices)[i]];
-                VECTOR(barycenters)[i] = nei;
-                MATRIX(*layout, nei, 0) = i;
-            }
-            if (!igraph_vector_all_e(layer_members, &barycenters)) {
-                IGRAPH_CHECK(igraph_vector_update(layer_members, &barycenters));
-#ifdef SUGIYAMA_DEBUG
-                printf("New vertex order: "); igraph_vector_print(layer_members);
-#endif
-                changed = 1;
-            } else {
-#ifdef SUGIYAMA_DEBUG
-                printf("Order did not change.\n");
-#endif
-            }
+        /* Keep the ordering with the fewest crossings. Ties are resolved in
+         * favour of the newer ordering. */
+        IGRAPH_CHECK(igraph_i_layout_sugiyama_count_crossings(layering, &out_adjlist,
+                     layout, &tree, &south, &crossings));
+        if (crossings <= best_crossings) {
+            best_crossings = crossings;
+            igraph_i_layout_sugiyama_save_ordering(layout, &best_ordering);
         }
 
 #ifdef SUGIYAMA_DEBUG
-        printf("==== Finished iteration %ld\n", iter);
+        printf("==== Finished iteration %ld, %g crossings\n", iter, crossings);
 #endif
 
         iter++;
     }
 
-    igraph_vector_destroy(&barycenters);
-    igraph_vector_destroy(&neis);
+    igraph_i_layout_sugiyama_restore_ordering(layout, layering, &best_ordering);
+
+    igraph_vector_long_destroy(&south);
+    igraph_vector_long_destroy(&tree);
+    igraph_vector_destroy(&best_ordering);
     igraph_vector_destroy(&sort_indices);
-    IGRAPH_FINALLY_CLEAN(3);
+    igraph_vector_destroy(&barycenters);
+    igraph_adjlist_destroy(&out_adjlist);
+    igraph_adjlist_destroy(&in_adjlist);
+    IGRAPH_FINALLY_CLEAN(7);
 
     return IGRAPH_SUCCESS;
 }
@@ -889,7 +1207,7 @@ static int igraph_i_layout_sugiyama_place_nodes_horizontally(const igraph_t* gra
     long int no_of_layers = igraph_i_layering_num_layers(layering);
     long int no_of_nodes = igraph_vcount(graph);
     long int no_of_edges = igraph_ecount(graph);
-    igraph_vector_t neis1, neis2;
+    igraph_inclist_t in_inclist;
     igraph_vector_t xs[4];
     igraph_vector_t roots, align;
     igraph_vector_t vertex_to_the_left;
@@ -915,64 +1233,69 @@ static int igraph_i_layout_sugiyama_place_nodes_horizontally(const igraph_t* gra
     IGRAPH_FINALLY(igraph_vector_bool_destroy, &ignored_edges);
 
     IGRAPH_VECTOR_INIT_FINALLY(&vertex_to_the_left, no_of_nodes);
-    IGRAPH_VECTOR_INIT_FINALLY(&neis1, 0);
-    IGRAPH_VECTOR_INIT_FINALLY(&neis2, 0);
+    IGRAPH_CHECK(igraph_inclist_init(graph, &in_inclist, IGRAPH_IN));
+    IGRAPH_FINALLY(igraph_inclist_destroy, &in_inclist);
 
     /* First, find all type 1 conflicts and mark one of the edges participating
      * in the conflict as being ignored. If one of the edges in the conflict
      * is a non-inner segment and the other is an inner segment, we ignore the
      * non-inner segment as we want to keep inner segments vertical.
+     *
+     * This is Alg. 1 of Brandes & Köpf: the lower layer is scanned from left
+     * to right, and the upper endpoints of inner segments split the upper
+     * layer into intervals. A non-inner segment whose upper endpoint falls
+     * outside the interval of its lower endpoint crosses an inner segment.
+     * This takes linear time in the number of edges between the two layers.
      */
     for (i = 0; i < no_of_layers - 1; i++) {
-        igraph_vector_t* vertices = igraph_i_layering_get(layering, i);
-        n = igraph_vector_size(vertices);
-
-        /* Find all the edges from this layer to the next */
-        igraph_vector_clear(&neis1);
-        for (j = 0; j < n; j++) {
-            IGRAPH_CHECK(igraph_neighbors(graph, &neis2, (igraph_integer_t)
-                                          VECTOR(*vertices)[j], IGRAPH_OUT));
-            IGRAPH_CHECK(igraph_vector_append(&neis1, &neis2));
-        }
-
-        /* Consider all pairs of edges and check whether they are in a type 1
-         * conflict */
-        n = igraph_vector_size(&neis1);
-        for (j = 0; j < n; j++) {
-            long int u = IGRAPH_FROM(graph, j);
-            long int v = IGRAPH_TO(graph, j);
-            igraph_bool_t j_inner = IS_INNER_SEGMENT(u, v);
-            igraph_bool_t crossing;
-
-            for (k = j + 1; k < n; k++) {
-                long int w = IGRAPH_FROM(graph, k);
-                long int x = IGRAPH_TO(graph, k);
-                if (IS_INNER_SEGMENT(w, x) == j_inner) {
-                    continue;
-                }
-                /* Do the u --> v and w --> x edges cross? */
-                crossing = (u == w || v == x);
-                if (!crossing) {
-                    if (X_POS(u) <= X_POS(w)) {
-                        crossing = X_POS(v) >= X_POS(x);
-                    } else {
-                        crossing = X_POS(v) <= X_POS(x);
+        igraph_vector_t* upper = igraph_i_layering_get(layering, i);
+        igraph_vector_t* lower = igraph_i_layering_get(layering, i + 1);
+        long int k0 = 0, k1, l1, inner_upper;
+
+        n = igraph_vector_size(lower);
+        l = 0;
+        for (l1 = 0; l1 < n; l1++) {
+            long int v = (long int) VECTOR(*lower)[l1];
+            igraph_vector_int_t* incs = igraph_inclist_get(&in_inclist, v);
+
+            /* Is v the lower endpoint of an inner segment? */
+            inner_upper = -1;
+            if (IS_DUMMY(v)) {
+                k = igraph_vector_int_size(incs);
+                for (j = 0; j < k; j++) {
+                    long int u = IGRAPH_FROM(graph, (long int) VECTOR(*incs)[j]);
+                    if (IS_DUMMY(u)) {
+                        inner_upper = u;
+                        break;
                     }
                 }
-                if (crossing) {
-                    if (j_inner) {
-                        VECTOR(ignored_edges)[k] = 1;
-                    } else {
-                        VECTOR(ignored_edges)[j] = 1;
+            }
+
+            if (l1 != n - 1 && inner_upper < 0) {
+                continue;
+            }
+
+            k1 = inner_upper >= 0 ? (long int) X_POS(inner_upper) :
+                 igraph_vector_size(upper) - 1;
+            for (; l <= l1; l++) {
+                incs = igraph_inclist_get(&in_inclist, (long int) VECTOR(*lower)[l]);
+                k = igraph_vector_int_size(incs);
+                for (j = 0; j < k; j++) {
+                    long int eid = (long int) VECTOR(*incs)[j];
+                    long int u = IGRAPH_FROM(graph, eid);
+                    long int pos = (long int) X_POS(u);
+                    if ((pos < k0 || pos > k1) &&
+                        !IS_INNER_SEGMENT(u, IGRAPH_TO(graph, eid))) {
+                        VECTOR(ignored_edges)[eid] = 1;
                     }
                 }
             }
+            k0 = k1;
         }
     }
 
-    igraph_vector_destroy(&neis1);
-    igraph_vector_destroy(&neis2);
-    IGRAPH_FINALLY_CLEAN(2);
+    igraph_inclist_destroy(&in_inclist);
+    IGRAPH_FINALLY_CLEAN(1);
 
     /*
      * Prepare vertex_to_the_left where the ith element stores
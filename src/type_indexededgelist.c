@@ -25,6 +25,8 @@
 #include "igraph_interface.h"
 #include "igraph_attributes.h"
 #include "igraph_memory.h"
+#include "igraph_interface_internal.h"
+#include "igraph_interrupt_internal.h"
 #include "config.h"
 
 /* Internal functions */
@@ -874,6 +876,839 @@ static int igraph_i_create_start(
     return 0;
 }
 
+/* Creates 'res' from the edges of 'graph' without multiple edges and,
+   if 'loops' is true, without loop edges. The edges are visited in the
+   order of IGRAPH_EDGEORDER_FROM, i.e. in the order of 'oi' for
+   directed and of 'ii' for undirected graphs, so multiple edges are
+   next to each other and the kept edges are already sorted for one of
+   the indices; only the other one needs a counting sort. The new graph
+   is the same as the one igraph_create() would create from the kept
+   edges. If 'mergeinto' is not a null pointer, the new id of each edge
+   of 'graph' is stored there, -1 for removed loop edges. No attributes
+   are copied. */
+
+int igraph_i_simplify_multiple(const igraph_t *graph, igraph_t *res,
+                               igraph_bool_t loops,
+                               igraph_vector_t *mergeinto) {
+    long int no_of_nodes = graph->n;
+    long int no_of_edges = igraph_vector_size(&graph->from);
+    igraph_bool_t directed = graph->directed;
+    const igraph_vector_t *start = directed ? &graph->os : &graph->is;
+    const igraph_vector_t *index = directed ? &graph->oi : &graph->ii;
+    const igraph_vector_t *other = directed ? &graph->to : &graph->from;
+    igraph_vector_t *newstart, *newindex, *newkey, *newother;
+    igraph_vector_t *otherstart, *otherindex;
+    long int i, j, k = 0;
+
+    IGRAPH_CHECK(igraph_empty(res, (igraph_integer_t) no_of_nodes, directed));
+    IGRAPH_FINALLY(igraph_destroy, res);
+
+    if (mergeinto) {
+        IGRAPH_CHECK(igraph_vector_resize(mergeinto, no_of_edges));
+    }
+
+    /* The new graph is sorted by 'key', then by 'newother' */
+    newstart = directed ? &res->os : &res->is;
+    newindex = directed ? &res->oi : &res->ii;
+    newkey = directed ? &res->from : &res->to;
+    newother = directed ? &res->to : &res->from;
+    otherstart = directed ? &res->is : &res->os;
+    otherindex = directed ? &res->ii : &res->oi;
+
+    IGRAPH_CHECK(igraph_vector_resize(newkey, no_of_edges));
+    IGRAPH_CHECK(igraph_vector_resize(newother, no_of_edges));
+    IGRAPH_CHECK(igraph_vector_resize(newstart, no_of_nodes + 1));
+    IGRAPH_CHECK(igraph_vector_resize(otherstart, no_of_nodes + 1));
+
+    VECTOR(*newstart)[0] = 0;
+    for (i = 0; i < no_of_nodes; i++) {
+        long int end = (long int) VECTOR(*start)[i + 1];
+        long int prev = -1;
+        for (j = (long int) VECTOR(*start)[i]; j < end; j++) {
+            long int edge = (long int) VECTOR(*index)[j];
+            long int nei = (long int) VECTOR(*other)[edge];
+            if (loops && nei == i) {
+                if (mergeinto) {
+                    VECTOR(*mergeinto)[edge] = -1;
+                }
+            } else if (nei == prev) {
+                if (mergeinto) {
+                    VECTOR(*mergeinto)[edge] = k - 1;
+                }
+            } else {
+                VECTOR(*newkey)[k] = i;
+                VECTOR(*newother)[k] = nei;
+                if (mergeinto) {
+                    VECTOR(*mergeinto)[edge] = k;
+                }
+                k++;
+                prev = nei;
+            }
+        }
+        VECTOR(*newstart)[i + 1] = k;
+    }
+
+    IGRAPH_CHECK(igraph_vector_resize(newkey, k));
+    IGRAPH_CHECK(igraph_vector_resize(newother, k));
+    IGRAPH_CHECK(igraph_vector_resize_min(newkey));
+    IGRAPH_CHECK(igraph_vector_resize_min(newother));
+    IGRAPH_CHECK(igraph_vector_resize(newindex, k));
+    IGRAPH_CHECK(igraph_vector_resize(otherindex, k));
+
+    /* The kept edges are sorted for the first index */
+    for (i = 0; i < k; i++) {
+        VECTOR(*newindex)[i] = i;
+    }
+
+    /* Counting sort for the other one. There are no multiple edges
+       and ties are broken by 'key' because the edges are visited in
+       increasing 'key' order. */
+    igraph_vector_null(otherstart);
+    for (i = 0; i < k; i++) {
+        VECTOR(*otherstart)[(long int) VECTOR(*newother)[i] + 1] += 1;
+    }
+    for (i = 0; i < no_of_nodes; i++) {
+        VECTOR(*otherstart)[i + 1] += VECTOR(*otherstart)[i];
+    }
+    for (i = 0; i < k; i++) {
+        long int nei = (long int) VECTOR(*newother)[i];
+        VECTOR(*otherindex)[(long int) VECTOR(*otherstart)[nei]] = i;
+        VECTOR(*otherstart)[nei] += 1;
+    }
+    for (i = no_of_nodes; i > 0; i--) {
+        VECTOR(*otherstart)[i] = VECTOR(*otherstart)[i - 1];
+    }
+    VECTOR(*otherstart)[0] = 0;
+
+    IGRAPH_FINALLY_CLEAN(1);
+    return 0;
+}
+
+/* Creates 'res' with the vertices 'vids' of 'graph' and the edges
+   among them. 'vids' must be sorted and free of duplicates, and
+   'old2new' must map each vertex of 'vids' to its position in 'vids'
+   plus one, and all other vertices to zero. The edges are visited in
+   the order of 'oi' (for undirected graphs, 'oi' lists each edge at
+   its larger endpoint), so the new edge list comes out sorted by
+   source and target; only the ties of multiple edges need reversing
+   for the new 'oi', and 'ii' needs one stable counting sort. The new
+   graph is the same as the one igraph_create() would create from the
+   kept edges in this order. The ids of the kept edges in 'graph' are
+   stored in 'eids'; they are collected there first, so that the
+   vectors of the new graph are allocated once, with their final size.
+   No attributes are copied. */
+
+int igraph_i_create_induced_subgraph(const igraph_t *graph, igraph_t *res,
+                                     const igraph_vector_t *vids,
+                                     const igraph_vector_t *old2new,
+                                     igraph_vector_t *eids) {
+    long int no_of_new_nodes = igraph_vector_size(vids);
+    long int i, j, k, m;
+
+    IGRAPH_CHECK(igraph_empty(res, (igraph_integer_t) no_of_new_nodes,
+                              graph->directed));
+    IGRAPH_FINALLY(igraph_destroy, res);
+
+    igraph_vector_clear(eids);
+
+    IGRAPH_CHECK(igraph_vector_resize(&res->os, no_of_new_nodes + 1));
+    IGRAPH_CHECK(igraph_vector_resize(&res->is, no_of_new_nodes + 1));
+    VECTOR(res->os)[0] = 0;
+    for (i = 0; i < no_of_new_nodes; i++) {
+        long int v = (long int) VECTOR(*vids)[i];
+        long int end = (long int) VECTOR(graph->os)[v + 1];
+        for (j = (long int) VECTOR(graph->os)[v]; j < end; j++) {
+            long int edge = (long int) VECTOR(graph->oi)[j];
+            if (VECTOR(*old2new)[(long int) VECTOR(graph->to)[edge]]) {
+                IGRAPH_CHECK(igraph_vector_push_back(eids, edge));
+            }
+        }
+        VECTOR(res->os)[i + 1] = igraph_vector_size(eids);
+    }
+    m = igraph_vector_size(eids);
+
+    IGRAPH_CHECK(igraph_vector_resize(&res->from, m));
+    IGRAPH_CHECK(igraph_vector_resize(&res->to, m));
+    IGRAPH_CHECK(igraph_vector_resize(&res->oi, m));
+    IGRAPH_CHECK(igraph_vector_resize(&res->ii, m));
+    for (i = 0; i < no_of_new_nodes; i++) {
+        long int end = (long int) VECTOR(res->os)[i + 1];
+        for (j = (long int) VECTOR(res->os)[i]; j < end; j++) {
+            long int edge = (long int) VECTOR(*eids)[j];
+            VECTOR(res->from)[j] = i;
+            VECTOR(res->to)[j] =
+                VECTOR(*old2new)[(long int) VECTOR(graph->to)[edge]] - 1;
+        }
+    }
+
+    /* Multiple edges are visited in decreasing order of their old ids,
+       so they get increasing new ids, but 'oi' lists them in
+       decreasing order */
+    for (i = 0; i < m; i = j) {
+        for (j = i + 1; j < m && VECTOR(res->from)[j] == VECTOR(res->from)[i] &&
+             VECTOR(res->to)[j] == VECTOR(res->to)[i]; j++) ;
+        for (k = i; k < j; k++) {
+            VECTOR(res->oi)[k] = j - 1 - (k - i);
+        }
+    }
+
+    /* Stable counting sort of 'oi' by target */
+    igraph_vector_null(&res->is);
+    for (i = 0; i < m; i++) {
+        VECTOR(res->is)[(long int) VECTOR(res->to)[i] + 1] += 1;
+    }
+    for (i = 0; i < no_of_new_nodes; i++) {
+        VECTOR(res->is)[i + 1] += VECTOR(res->is)[i];
+    }
+    for (i = 0; i < m; i++) {
+        long int edge = (long int) VECTOR(res->oi)[i];
+        long int to = (long int) VECTOR(res->to)[edge];
+        VECTOR(res->ii)[(long int) VECTOR(res->is)[to]] = edge;
+        VECTOR(res->is)[to] += 1;
+    }
+    for (i = no_of_new_nodes; i > 0; i--) {
+        VECTOR(res->is)[i] = VECTOR(res->is)[i - 1];
+    }
+    VECTOR(res->is)[0] = 0;
+
+    IGRAPH_FINALLY_CLEAN(1);
+    return 0;
+}
+
+/* Reverses the elements from 'from' to 'to' (exclusive) of 'v' */
+
+static void igraph_i_reverse_section(igraph_vector_t *v, long int from,
+                                     long int to) {
+    for (to--; from < to; from++, to--) {
+        igraph_real_t tmp = VECTOR(*v)[from];
+        VECTOR(*v)[from] = VECTOR(*v)[to];
+        VECTOR(*v)[to] = tmp;
+    }
+}
+
+/* Stable counting sort of the edges of 'graph' by 'key' (its 'from' or
+   'to' vector). The edges are taken in the order of 'index', or in
+   increasing id order if 'index' is a null pointer; the sorted edges
+   go to 'res' and the start of each key value to 'start'. Both must
+   have the right size already. */
+
+static void igraph_i_index_by_key(const igraph_t *graph,
+                                  const igraph_vector_t *key,
+                                  const igraph_vector_t *index,
+                                  igraph_vector_t *start,
+                                  igraph_vector_t *res) {
+    long int no_of_nodes = graph->n;
+    long int no_of_edges = igraph_vector_size(key);
+    long int i;
+
+    igraph_vector_null(start);
+    for (i = 0; i < no_of_edges; i++) {
+        VECTOR(*start)[(long int) VECTOR(*key)[i] + 1] += 1;
+    }
+    for (i = 0; i < no_of_nodes; i++) {
+        VECTOR(*start)[i + 1] += VECTOR(*start)[i];
+    }
+    for (i = 0; i < no_of_edges; i++) {
+        long int edge = index ? (long int) VECTOR(*index)[i] : i;
+        long int k = (long int) VECTOR(*key)[edge];
+        VECTOR(*res)[(long int) VECTOR(*start)[k]] = edge;
+        VECTOR(*start)[k] += 1;
+    }
+    for (i = no_of_nodes; i > 0; i--) {
+        VECTOR(*start)[i] = VECTOR(*start)[i - 1];
+    }
+    VECTOR(*start)[0] = 0;
+}
+
+/* Set operations on the edge multisets of 'graphs', without sorting.
+   The edges of each graph are visited in the order of 'oi' (directed
+   graphs) or 'ii' (undirected graphs), i.e. grouped by source vertex,
+   or by smaller endpoint, and sorted by the other endpoint inside a
+   group. All graphs are walked together, one group at a time, which
+   is a merge of their sorted edge lists. The groups are visited in
+   decreasing vertex order if 'desc_vertices' is true, and the
+   neighbors in a group in decreasing order if 'desc_neighbors' is
+   true; the new edges get their ids in this order.
+
+   If an edge has c_j copies in the j-th graph, it has max(c_j) copies
+   in the union, min(c_j) copies in the intersection and c_0 - c_1
+   copies in the difference (of two graphs). The t-th copy of the
+   result corresponds to the copy with the t-th smallest edge id in
+   each graph, or the t-th largest one if the neighbors are visited in
+   decreasing order, as if the edges were sorted stably. (The index
+   stores the copies in decreasing id order, so this is the reverse of
+   the walk.) In the difference, it corresponds to the (c_1 + t)-th
+   copy of the first graph.
+
+   'edgemaps' is a null pointer, or a pointer vector with an
+   initialized vector or a null pointer for each graph; the vectors map
+   the edges of the graphs to the edges of the result, or to -1 if
+   they have no corresponding edge. Only the edges of the result need
+   memory, and its index is built from the order of the walk with two
+   counting sorts. */
+
+int igraph_i_merge_sorted(igraph_t *res, const igraph_vector_ptr_t *graphs,
+                          igraph_integer_t no_of_nodes,
+                          igraph_bool_t directed, igraph_i_merge_mode_t mode,
+                          igraph_bool_t desc_vertices,
+                          igraph_bool_t desc_neighbors,
+                          igraph_vector_ptr_t *edgemaps) {
+    long int no_of_graphs = igraph_vector_ptr_size(graphs);
+    long int step = desc_neighbors ? -1 : 1;
+    igraph_vector_long_t neis, shift, pos, end, first, count;
+    igraph_vector_t *key = directed ? &res->from : &res->to;
+    igraph_vector_t *other = directed ? &res->to : &res->from;
+    igraph_vector_t *start = directed ? &res->os : &res->is;
+    igraph_vector_t *index = directed ? &res->oi : &res->ii;
+    long int i, j, t, m;
+
+    IGRAPH_CHECK(igraph_empty(res, no_of_nodes, directed));
+    IGRAPH_FINALLY(igraph_destroy, res);
+    IGRAPH_CHECK(igraph_vector_long_init(&neis, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &neis);
+    IGRAPH_CHECK(igraph_vector_long_init(&shift, no_of_graphs));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &shift);
+    IGRAPH_CHECK(igraph_vector_long_init(&pos, no_of_graphs));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &pos);
+    IGRAPH_CHECK(igraph_vector_long_init(&end, no_of_graphs));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &end);
+    IGRAPH_CHECK(igraph_vector_long_init(&first, no_of_graphs));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &first);
+    IGRAPH_CHECK(igraph_vector_long_init(&count, no_of_graphs));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &count);
+
+    if (edgemaps) {
+        for (j = 0; j < no_of_graphs; j++) {
+            igraph_vector_t *map = VECTOR(*edgemaps)[j];
+            if (map) {
+                const igraph_t *graph = VECTOR(*graphs)[j];
+                IGRAPH_CHECK(igraph_vector_resize(map,
+                                                  igraph_vector_size(&graph->from)));
+                igraph_vector_fill(map, -1);
+            }
+        }
+    }
+
+    for (i = 0; i < no_of_nodes; i++) {
+        long int v = desc_vertices ? no_of_nodes - 1 - i : i;
+        long int active = 0, size = 0;
+
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        /* Collect the neighbors of 'v' in all graphs first; these
+           loads are independent of each other, unlike the ones in the
+           merge below. 'shift' converts a position in 'neis' to a
+           position in the index of the graph. */
+        for (j = 0; j < no_of_graphs; j++) {
+            const igraph_t *graph = VECTOR(*graphs)[j];
+            const igraph_vector_t *gstart = directed ? &graph->os : &graph->is;
+            if (v < graph->n) {
+                size += (long int) (VECTOR(*gstart)[v + 1] - VECTOR(*gstart)[v]);
+            }
+        }
+        IGRAPH_CHECK(igraph_vector_long_resize(&neis, size));
+        for (j = 0, size = 0; j < no_of_graphs; j++) {
+            const igraph_t *graph = VECTOR(*graphs)[j];
+            const igraph_vector_t *gstart = directed ? &graph->os : &graph->is;
+            const igraph_vector_t *gindex = directed ? &graph->oi : &graph->ii;
+            const igraph_vector_t *gother = directed ? &graph->to : &graph->from;
+            long int from = 0, to = 0, p;
+            if (v < graph->n) {
+                from = (long int) VECTOR(*gstart)[v];
+                to = (long int) VECTOR(*gstart)[v + 1];
+            }
+            VECTOR(shift)[j] = from - size;
+            for (p = from; p < to; p++) {
+                VECTOR(neis)[size++] =
+                    (long int) VECTOR(*gother)[(long int) VECTOR(*gindex)[p]];
+            }
+            VECTOR(pos)[j] = desc_neighbors ? size - 1 : size - (to - from);
+            VECTOR(end)[j] = desc_neighbors ? size - (to - from) - 1 : size;
+            if (from < to) {
+                active++;
+            }
+        }
+
+        while (1) {
+            long int nei = -1, copies;
+
+            /* Stop if no (more) edges can be added in this group */
+            if (active == 0 ||
+                (mode == IGRAPH_I_MERGE_INTERSECTION && active < no_of_graphs) ||
+                (mode == IGRAPH_I_MERGE_DIFFERENCE &&
+                 VECTOR(pos)[0] == VECTOR(end)[0])) {
+                break;
+            }
+
+            /* The next neighbor in the order of the walk */
+            for (j = 0; j < no_of_graphs; j++) {
+                if (VECTOR(pos)[j] != VECTOR(end)[j]) {
+                    long int n = VECTOR(neis)[VECTOR(pos)[j]];
+                    if (nei < 0 || (desc_neighbors ? n > nei : n < nei)) {
+                        nei = n;
+                    }
+                }
+            }
+
+            /* Count its copies in each graph */
+            for (j = 0; j < no_of_graphs; j++) {
+                VECTOR(first)[j] = VECTOR(pos)[j];
+                while (VECTOR(pos)[j] != VECTOR(end)[j] &&
+                       VECTOR(neis)[VECTOR(pos)[j]] == nei) {
+                    VECTOR(pos)[j] += step;
+                }
+                VECTOR(count)[j] = (VECTOR(pos)[j] - VECTOR(first)[j]) * step;
+                if (VECTOR(count)[j] > 0 && VECTOR(pos)[j] == VECTOR(end)[j]) {
+                    active--;
+                }
+            }
+
+            switch (mode) {
+            case IGRAPH_I_MERGE_UNION:
+                copies = igraph_vector_long_max(&count);
+                break;
+            case IGRAPH_I_MERGE_INTERSECTION:
+                copies = igraph_vector_long_min(&count);
+                break;
+            default:
+                copies = VECTOR(count)[0] - VECTOR(count)[1];
+                break;
+            }
+
+            for (t = 0; t < copies; t++) {
+                long int edge = igraph_vector_size(key);
+                IGRAPH_CHECK(igraph_vector_push_back(key, v));
+                IGRAPH_CHECK(igraph_vector_push_back(other, nei));
+                if (!edgemaps) {
+                    continue;
+                }
+                for (j = 0; j < no_of_graphs; j++) {
+                    const igraph_t *graph = VECTOR(*graphs)[j];
+                    igraph_vector_t *map = VECTOR(*edgemaps)[j];
+                    long int c = mode == IGRAPH_I_MERGE_DIFFERENCE ?
+                                 (j == 0 ? VECTOR(count)[1] + t : -1) : t;
+                    if (map && c >= 0 && c < VECTOR(count)[j]) {
+                        long int p = VECTOR(first)[j] + VECTOR(shift)[j] +
+                                 (VECTOR(count)[j] - 1 - c) * step;
+                        VECTOR(*map)[(long int) VECTOR(directed ? graph->oi : graph->ii)[p]] = edge;
+                    }
+                }
+            }
+        }
+    }
+
+    igraph_vector_long_destroy(&count);
+    igraph_vector_long_destroy(&first);
+    igraph_vector_long_destroy(&end);
+    igraph_vector_long_destroy(&pos);
+    igraph_vector_long_destroy(&shift);
+    igraph_vector_long_destroy(&neis);
+    IGRAPH_FINALLY_CLEAN(6);
+
+    m = igraph_vector_size(key);
+    IGRAPH_CHECK(igraph_vector_resize_min(key));
+    IGRAPH_CHECK(igraph_vector_resize_min(other));
+    IGRAPH_CHECK(igraph_vector_resize(&res->oi, m));
+    IGRAPH_CHECK(igraph_vector_resize(&res->ii, m));
+    IGRAPH_CHECK(igraph_vector_resize(&res->os, no_of_nodes + 1));
+    IGRAPH_CHECK(igraph_vector_resize(&res->is, no_of_nodes + 1));
+
+    /* The groups of the walk are the groups of the index for 'key';
+       inside them, the neighbors must be increasing and the copies of
+       an edge decreasing */
+    igraph_i_index_by_key(res, key, NULL, start, index);
+    for (i = 0; i < no_of_nodes; i++) {
+        long int from = (long int) VECTOR(*start)[i];
+        long int to = (long int) VECTOR(*start)[i + 1];
+        if (desc_neighbors) {
+            igraph_i_reverse_section(index, from, to);
+        } else {
+            for (j = from; j < to; j = t) {
+                long int nei = (long int) VECTOR(*other)[(long int) VECTOR(*index)[j]];
+                for (t = j + 1; t < to &&
+                     VECTOR(*other)[(long int) VECTOR(*index)[t]] == nei; t++) ;
+                igraph_i_reverse_section(index, j, t);
+            }
+        }
+    }
+    igraph_i_index_by_key(res, other, index, directed ? &res->is : &res->os,
+                          directed ? &res->ii : &res->oi);
+
+    IGRAPH_FINALLY_CLEAN(1);
+    return 0;
+}
+
+/* Creates the undirected version of the directed 'graph' in 'res':
+   one edge for each connected pair of vertices, or, if 'mutual' is
+   true, one edge for each pair of mutual edges. The new edges are
+   found at their larger endpoint i, by merging the out-edges of i in
+   'oi' and its in-edges in 'ii' up to the neighbor i, both sorted by
+   neighbor. So the new edges come out sorted by their larger and then
+   by their smaller endpoint, as the new 'oi' needs them; the ties of
+   multiple edges (mutual mode only) need reversing, and 'ii' needs one
+   stable counting sort. The new graph is the same as the one
+   igraph_create() would create from the new edges in this order. If
+   'mergeinto' is not a null pointer, the new id of each edge of
+   'graph' is stored there, -1 for edges without a mutual pair. No
+   attributes are copied. */
+
+int igraph_i_to_undirected_sorted(const igraph_t *graph, igraph_t *res,
+                                  igraph_bool_t mutual,
+                                  igraph_vector_t *mergeinto) {
+    long int no_of_nodes = graph->n;
+    long int no_of_edges = igraph_vector_size(&graph->from);
+    long int i, j, t, k = 0;
+
+    IGRAPH_CHECK(igraph_empty(res, (igraph_integer_t) no_of_nodes,
+                              IGRAPH_UNDIRECTED));
+    IGRAPH_FINALLY(igraph_destroy, res);
+
+    if (mergeinto) {
+        IGRAPH_CHECK(igraph_vector_resize(mergeinto, no_of_edges));
+        igraph_vector_fill(mergeinto, -1);
+    }
+
+    IGRAPH_CHECK(igraph_vector_resize(&res->from, no_of_edges));
+    IGRAPH_CHECK(igraph_vector_resize(&res->to, no_of_edges));
+    IGRAPH_CHECK(igraph_vector_resize(&res->os, no_of_nodes + 1));
+    IGRAPH_CHECK(igraph_vector_resize(&res->is, no_of_nodes + 1));
+
+#define OUTNEI(p) ((p) < end1 ? \
+                   (long int) VECTOR(graph->to)[(long int) VECTOR(graph->oi)[(p)]] : \
+                   no_of_nodes)
+#define INNEI(p)  ((p) < end2 ? \
+                   (long int) VECTOR(graph->from)[(long int) VECTOR(graph->ii)[(p)]] : \
+                   no_of_nodes)
+
+    VECTOR(res->os)[0] = 0;
+    for (i = 0; i < no_of_nodes; i++) {
+        long int p1 = (long int) VECTOR(graph->os)[i];
+        long int end1 = (long int) VECTOR(graph->os)[i + 1];
+        long int p2 = (long int) VECTOR(graph->is)[i];
+        long int end2 = (long int) VECTOR(graph->is)[i + 1];
+        while (1) {
+            long int n1 = OUTNEI(p1), n2 = INNEI(p2);
+            long int nei = n1 < n2 ? n1 : n2;
+            if (mutual) {
+                if (n1 > i || n2 > i) {
+                    break;
+                }
+                if (n1 != n2) {
+                    if (n1 < n2) {
+                        p1++;
+                    } else {
+                        p2++;
+                    }
+                    continue;
+                }
+                if (mergeinto) {
+                    VECTOR(*mergeinto)[(long int) VECTOR(graph->oi)[p1]] = k;
+                    VECTOR(*mergeinto)[(long int) VECTOR(graph->ii)[p2]] = k;
+                }
+                p1++;
+                p2++;
+            } else {
+                if (nei > i) {
+                    break;
+                }
+                for (; OUTNEI(p1) == nei; p1++) {
+                    if (mergeinto) {
+                        VECTOR(*mergeinto)[(long int) VECTOR(graph->oi)[p1]] = k;
+                    }
+                }
+                for (; INNEI(p2) == nei; p2++) {
+                    if (mergeinto) {
+                        VECTOR(*mergeinto)[(long int) VECTOR(graph->ii)[p2]] = k;
+                    }
+                }
+            }
+            VECTOR(res->from)[k] = i;
+            VECTOR(res->to)[k] = nei;
+            k++;
+        }
+        VECTOR(res->os)[i + 1] = k;
+    }
+
+#undef OUTNEI
+#undef INNEI
+
+    IGRAPH_CHECK(igraph_vector_resize(&res->from, k));
+    IGRAPH_CHECK(igraph_vector_resize(&res->to, k));
+    IGRAPH_CHECK(igraph_vector_resize_min(&res->from));
+    IGRAPH_CHECK(igraph_vector_resize_min(&res->to));
+    IGRAPH_CHECK(igraph_vector_resize(&res->oi, k));
+    IGRAPH_CHECK(igraph_vector_resize(&res->ii, k));
+
+    /* Multiple edges get increasing new ids, but 'oi' lists them in
+       decreasing order */
+    for (i = 0; i < k; i = j) {
+        for (j = i + 1; j < k && VECTOR(res->from)[j] == VECTOR(res->from)[i] &&
+             VECTOR(res->to)[j] == VECTOR(res->to)[i]; j++) ;
+        for (t = i; t < j; t++) {
+            VECTOR(res->oi)[t] = j - 1 - (t - i);
+        }
+    }
+    igraph_i_index_by_key(res, &res->to, &res->oi, &res->is, &res->ii);
+
+    IGRAPH_FINALLY_CLEAN(1);
+    return 0;
+}
+
+/* Creates the directed version of the undirected 'graph' in 'res'. An
+   undirected edge is stored with 'from' >= 'to', and the directed edge
+   points the way igraph_edge() reports it, from 'to' to 'from'; so the
+   old 'ii' is the new 'oi' and vice versa. If 'mutual' is true, then
+   edge i also gets a reverse pair, edge m + i, where m is the number of
+   edges; the new index of a vertex is then the merge of its old 'oi'
+   and 'ii' runs. The new graph is the same as the one igraph_create()
+   would create from these edges. No attributes are copied. */
+
+int igraph_i_to_directed_sorted(const igraph_t *graph, igraph_t *res,
+                                igraph_bool_t mutual) {
+    long int no_of_nodes = graph->n;
+    long int no_of_edges = igraph_vector_size(&graph->from);
+    long int i, j;
+
+    IGRAPH_CHECK(igraph_empty(res, (igraph_integer_t) no_of_nodes,
+                              IGRAPH_DIRECTED));
+    IGRAPH_FINALLY(igraph_destroy, res);
+
+    if (!mutual) {
+        IGRAPH_CHECK(igraph_vector_update(&res->from, &graph->to));
+        IGRAPH_CHECK(igraph_vector_update(&res->to, &graph->from));
+        IGRAPH_CHECK(igraph_vector_update(&res->oi, &graph->ii));
+        IGRAPH_CHECK(igraph_vector_update(&res->ii, &graph->oi));
+        IGRAPH_CHECK(igraph_vector_update(&res->os, &graph->is));
+        IGRAPH_CHECK(igraph_vector_update(&res->is, &graph->os));
+        IGRAPH_FINALLY_CLEAN(1);
+        return 0;
+    }
+
+    IGRAPH_CHECK(igraph_vector_resize(&res->from, 2 * no_of_edges));
+    IGRAPH_CHECK(igraph_vector_resize(&res->to, 2 * no_of_edges));
+    IGRAPH_CHECK(igraph_vector_resize(&res->oi, 2 * no_of_edges));
+    IGRAPH_CHECK(igraph_vector_resize(&res->ii, 2 * no_of_edges));
+    IGRAPH_CHECK(igraph_vector_resize(&res->os, no_of_nodes + 1));
+    IGRAPH_CHECK(igraph_vector_resize(&res->is, no_of_nodes + 1));
+
+    for (i = 0; i < no_of_edges; i++) {
+        VECTOR(res->from)[i] = VECTOR(res->to)[no_of_edges + i] =
+                                   VECTOR(graph->to)[i];
+        VECTOR(res->to)[i] = VECTOR(res->from)[no_of_edges + i] =
+                                 VECTOR(graph->from)[i];
+    }
+
+    /* Every vertex has the same number of in- and out-edges. For 'oi',
+       the new edges i pointing away from vertex v are in the 'ii' run
+       of v, the new edges m + i in its 'oi' run; for 'ii' it is the
+       other way around. Among the edges to the same neighbor, the
+       ones with larger ids, i.e. the reverse pairs, come first. */
+    for (j = 0; j < 2; j++) {
+        const igraph_vector_t *first = j == 0 ? &graph->ii : &graph->oi;
+        const igraph_vector_t *second = j == 0 ? &graph->oi : &graph->ii;
+        const igraph_vector_t *nei1 = j == 0 ? &graph->from : &graph->to;
+        const igraph_vector_t *nei2 = j == 0 ? &graph->to : &graph->from;
+        const igraph_vector_t *start1 = j == 0 ? &graph->is : &graph->os;
+        const igraph_vector_t *start2 = j == 0 ? &graph->os : &graph->is;
+        igraph_vector_t *index = j == 0 ? &res->oi : &res->ii;
+        igraph_vector_t *start = j == 0 ? &res->os : &res->is;
+        long int p = 0;
+
+        VECTOR(*start)[0] = 0;
+        for (i = 0; i < no_of_nodes; i++) {
+            long int p1 = (long int) VECTOR(*start1)[i];
+            long int end1 = (long int) VECTOR(*start1)[i + 1];
+            long int p2 = (long int) VECTOR(*start2)[i];
+            long int end2 = (long int) VECTOR(*start2)[i + 1];
+            while (p1 < end1 || p2 < end2) {
+                long int e1 = p1 < end1 ? (long int) VECTOR(*first)[p1] : -1;
+                long int e2 = p2 < end2 ? (long int) VECTOR(*second)[p2] : -1;
+                if (e1 < 0 || (e2 >= 0 && VECTOR(*nei2)[e2] <= VECTOR(*nei1)[e1])) {
+                    VECTOR(*index)[p++] = no_of_edges + e2;
+                    p2++;
+                } else {
+                    VECTOR(*index)[p++] = e1;
+                    p1++;
+                }
+            }
+            VECTOR(*start)[i + 1] = p;
+        }
+    }
+
+    IGRAPH_FINALLY_CLEAN(1);
+    return 0;
+}
+
+/* Writes the adjacency matrix of 'graph' in compressed sparse row
+   format: row i of 'indices' lists the out-neighbors (IGRAPH_OUT), the
+   in-neighbors (IGRAPH_IN) or both (IGRAPH_ALL) of vertex i, and the
+   row starts at 'offsets[i]'. The rows are read from 'oi' and 'ii',
+   which are sorted by neighbor already; for IGRAPH_ALL, the two runs
+   of a vertex are merged. In undirected graphs, the 'oi' run of a
+   vertex has the neighbors up to the vertex itself and the 'ii' run
+   the ones from the vertex itself, so the row is the 'oi' run followed
+   by the 'ii' run without the loop edges, which would be listed
+   twice. 'nnz' is the number of entries, which the caller has checked
+   to fit into an int. If 'values' is not a null pointer, the weight of
+   the edge of each entry is stored there. */
+
+int igraph_i_get_csr(const igraph_t *graph, igraph_vector_int_t *offsets,
+                     igraph_vector_int_t *indices,
+                     const igraph_vector_t *weights, igraph_vector_t *values,
+                     igraph_neimode_t mode, long int nnz) {
+    long int no_of_nodes = graph->n;
+    igraph_bool_t directed = graph->directed;
+    igraph_bool_t out = !directed || (mode & IGRAPH_OUT);
+    igraph_bool_t in = !directed || (mode & IGRAPH_IN);
+    long int i, p = 0;
+
+    IGRAPH_CHECK(igraph_vector_int_resize(offsets, no_of_nodes + 1));
+    IGRAPH_CHECK(igraph_vector_int_resize(indices, nnz));
+    if (values) {
+        IGRAPH_CHECK(igraph_vector_resize(values, nnz));
+    }
+
+#define ADD(edge, nei) do { \
+        VECTOR(*indices)[p] = (int) (nei); \
+        if (values) { \
+            VECTOR(*values)[p] = VECTOR(*weights)[(edge)]; \
+        } \
+        p++; \
+    } while (0)
+
+    for (i = 0; i < no_of_nodes; i++) {
+        long int p1 = out ? (long int) VECTOR(graph->os)[i] : 0;
+        long int end1 = out ? (long int) VECTOR(graph->os)[i + 1] : 0;
+        long int p2 = in ? (long int) VECTOR(graph->is)[i] : 0;
+        long int end2 = in ? (long int) VECTOR(graph->is)[i + 1] : 0;
+        VECTOR(*offsets)[i] = (int) p;
+        if (!directed) {
+            for (; p1 < end1; p1++) {
+                long int edge = (long int) VECTOR(graph->oi)[p1];
+                ADD(edge, VECTOR(graph->to)[edge]);
+            }
+            for (; p2 < end2; p2++) {
+                long int edge = (long int) VECTOR(graph->ii)[p2];
+                if (VECTOR(graph->from)[edge] != i) {
+                    ADD(edge, VECTOR(graph->from)[edge]);
+                }
+            }
+            continue;
+        }
+        while (p1 < end1 || p2 < end2) {
+            long int e1 = p1 < end1 ? (long int) VECTOR(graph->oi)[p1] : -1;
+            long int e2 = p2 < end2 ? (long int) VECTOR(graph->ii)[p2] : -1;
+            if (e2 < 0 || (e1 >= 0 && VECTOR(graph->to)[e1] <= VECTOR(graph->from)[e2])) {
+                ADD(e1, VECTOR(graph->to)[e1]);
+                p1++;
+            } else {
+                ADD(e2, VECTOR(graph->from)[e2]);
+                p2++;
+            }
+        }
+    }
+    VECTOR(*offsets)[no_of_nodes] = (int) p;
+
+#undef ADD
+
+    /* The index lists multiple edges in decreasing id order, but
+       igraph_create_from_csr() gives increasing ids to the entries of
+       a row, so the values of equal entries are reversed */
+    if (values && !(directed && mode == IGRAPH_ALL)) {
+        for (i = 0; i < no_of_nodes; i++) {
+            long int end = VECTOR(*offsets)[i + 1];
+            long int j, k, t;
+            for (j = VECTOR(*offsets)[i]; j < end; j = k) {
+                for (k = j + 1; k < end && VECTOR(*indices)[k] == VECTOR(*indices)[j]; k++) ;
+                for (t = 0; j + t < k - 1 - t; t++) {
+                    igraph_real_t tmp = VECTOR(*values)[j + t];
+                    VECTOR(*values)[j + t] = VECTOR(*values)[k - 1 - t];
+                    VECTOR(*values)[k - 1 - t] = tmp;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Creates 'res' from a compressed sparse row matrix with valid
+   'offsets' and 'indices'. Entry k of row i is an edge from i to
+   'indices[k]' (IGRAPH_OUT) or from 'indices[k]' to i (IGRAPH_IN); in
+   undirected graphs, only the entries of the lower triangle, i.e.
+   with 'indices[k]' <= i, are edges. The edges get their ids in the
+   order of the entries, and the rows must be sorted, so they are
+   sorted already for 'oi' (IGRAPH_OUT) or 'ii' (IGRAPH_IN); only the
+   ties of multiple edges need reversing, and the other index needs
+   one stable counting sort. The new graph is the same as the one
+   igraph_create() would create from these edges. */
+
+int igraph_i_create_csr_sorted(igraph_t *res,
+                               const igraph_vector_int_t *offsets,
+                               const igraph_vector_int_t *indices,
+                               igraph_bool_t directed,
+                               igraph_neimode_t mode) {
+    long int no_of_nodes = igraph_vector_int_size(offsets) - 1;
+    igraph_bool_t byrow = !directed || mode == IGRAPH_OUT;
+    igraph_vector_t *newkey, *newother, *newstart, *newindex;
+    igraph_vector_t *otherstart, *otherindex;
+    long int i, j, k, m = 0;
+
+    for (i = 0; i < no_of_nodes; i++) {
+        for (k = VECTOR(*offsets)[i]; k < VECTOR(*offsets)[i + 1]; k++) {
+            if (directed || VECTOR(*indices)[k] <= i) {
+                m++;
+            }
+        }
+    }
+
+    IGRAPH_CHECK(igraph_empty(res, (igraph_integer_t) no_of_nodes, directed));
+    IGRAPH_FINALLY(igraph_destroy, res);
+
+    /* The rows are sorted by 'newkey', then by 'newother' */
+    newkey = byrow ? &res->from : &res->to;
+    newother = byrow ? &res->to : &res->from;
+    newstart = byrow ? &res->os : &res->is;
+    newindex = byrow ? &res->oi : &res->ii;
+    otherstart = byrow ? &res->is : &res->os;
+    otherindex = byrow ? &res->ii : &res->oi;
+
+    IGRAPH_CHECK(igraph_vector_resize(newkey, m));
+    IGRAPH_CHECK(igraph_vector_resize(newother, m));
+    IGRAPH_CHECK(igraph_vector_resize(newindex, m));
+    IGRAPH_CHECK(igraph_vector_resize(otherindex, m));
+    IGRAPH_CHECK(igraph_vector_resize(newstart, no_of_nodes + 1));
+    IGRAPH_CHECK(igraph_vector_resize(otherstart, no_of_nodes + 1));
+
+    m = 0;
+    VECTOR(*newstart)[0] = 0;
+    for (i = 0; i < no_of_nodes; i++) {
+        for (k = VECTOR(*offsets)[i]; k < VECTOR(*offsets)[i + 1]; k++) {
+            long int nei = VECTOR(*indices)[k];
+            if (directed || nei <= i) {
+                VECTOR(*newkey)[m] = i;
+                VECTOR(*newother)[m] = nei;
+                m++;
+            }
+        }
+        VECTOR(*newstart)[i + 1] = m;
+    }
+
+    /* Multiple edges get increasing ids, but the index lists them in
+       decreasing order */
+    for (i = 0; i < m; i = j) {
+        for (j = i + 1; j < m && VECTOR(*newkey)[j] == VECTOR(*newkey)[i] &&
+             VECTOR(*newother)[j] == VECTOR(*newother)[i]; j++) ;
+        for (k = i; k < j; k++) {
+            VECTOR(*newindex)[k] = j - 1 - (k - i);
+        }
+    }
+    igraph_i_index_by_key(res, newother, newindex, otherstart, otherindex);
+
+    IGRAPH_FINALLY_CLEAN(1);
+    return 0;
+}
+
 /**
  * \ingroup interface
  * \function igraph_is_directed
@@ -1177,6 +2012,149 @@ int igraph_get_eid(const igraph_t *graph, igraph_integer_t *eid,
     return IGRAPH_SUCCESS;
 }
 
+/* Whether to look up 'n' pairs in 'graph' in a batch. Sorting the
+   pairs takes O(n + |V|) time, so it only pays off if there are enough
+   pairs, and if the graph is too large for binary searches to stay in
+   the cache. */
+
+#define IGRAPH_I_GET_EIDS_BATCHED(graph, n) \
+    ((n) >= igraph_vcount(graph) / 4 && igraph_ecount(graph) >= (1 << 20))
+
+/* Looks up the edges from[i] -> to[i] (or {from[i], to[i]} in
+   undirected graphs) for many pairs at once. The pairs are sorted with
+   a counting sort and then merged with the sorted out-adjacency
+   lists, so each adjacency list is read sequentially once, instead of
+   a binary search with cache misses for each pair. The result is the
+   same edge as FIND_DIRECTED_EDGE() finds, -1 for pairs that are not
+   connected. 'from' and 'to' are overwritten. */
+
+static int igraph_i_get_eids_batched(const igraph_t *graph,
+                                     igraph_vector_t *eids,
+                                     igraph_vector_t *from,
+                                     igraph_vector_t *to) {
+    long int n = igraph_vector_size(from);
+    long int no_of_nodes = igraph_vcount(graph);
+    igraph_vector_t order;
+    long int i, j;
+
+    IGRAPH_CHECK(igraph_vector_resize(eids, n));
+
+    if (!igraph_is_directed(graph)) {
+        /* Undirected edges are stored with the larger vertex id first */
+        for (i = 0; i < n; i++) {
+            if (VECTOR(*from)[i] < VECTOR(*to)[i]) {
+                igraph_real_t tmp = VECTOR(*from)[i];
+                VECTOR(*from)[i] = VECTOR(*to)[i];
+                VECTOR(*to)[i] = tmp;
+            }
+        }
+    }
+
+    IGRAPH_VECTOR_INIT_FINALLY(&order, 0);
+    IGRAPH_CHECK(igraph_vector_order(from, to, &order, no_of_nodes - 1));
+
+    for (i = 0; i < n; i = j) {
+        long int v = (long int) VECTOR(*from)[(long int) VECTOR(order)[i]];
+        long int start = (long int) VECTOR(graph->os)[v];
+        long int end = (long int) VECTOR(graph->os)[v + 1];
+        igraph_bool_t merge;
+
+        for (j = i + 1; j < n &&
+             VECTOR(*from)[(long int) VECTOR(order)[j]] == v; j++) ;
+
+        /* Merge if there are many queries for this vertex, otherwise
+           binary search, so that a few queries do not scan a hub */
+        merge = (j - i) * 8 >= end - start;
+
+        for (; i < j; i++) {
+            long int q = (long int) VECTOR(order)[i];
+            igraph_real_t target = VECTOR(*to)[q];
+            if (merge) {
+                while (start < end &&
+                       VECTOR(graph->to)[(long int) VECTOR(graph->oi)[start]] < target) {
+                    start++;
+                }
+            } else {
+                long int lo = start, hi = end;
+                while (lo < hi) {
+                    long int mid = lo + (hi - lo) / 2;
+                    if (VECTOR(graph->to)[(long int) VECTOR(graph->oi)[mid]] < target) {
+                        lo = mid + 1;
+                    } else {
+                        hi = mid;
+                    }
+                }
+                start = lo;
+            }
+            if (start < end &&
+                VECTOR(graph->to)[(long int) VECTOR(graph->oi)[start]] == target) {
+                VECTOR(*eids)[q] = VECTOR(graph->oi)[start];
+            } else {
+                VECTOR(*eids)[q] = -1;
+            }
+        }
+    }
+
+    igraph_vector_destroy(&order);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return 0;
+}
+
+/* Batched version of igraph_get_eids_pairs() and
+   igraph_get_eids_path(): the i-th query is the pair (from[i],
+   to[i]). Ignoring edge directions is handled by looking up the
+   reversed pairs of the missing edges in a second batch. */
+
+static int igraph_i_get_eids_sorted(const igraph_t *graph,
+                                    igraph_vector_t *eids,
+                                    igraph_vector_t *from,
+                                    igraph_vector_t *to,
+                                    igraph_bool_t directed,
+                                    igraph_bool_t error) {
+    long int n = igraph_vector_size(from);
+    long int i, k;
+
+    IGRAPH_CHECK(igraph_i_get_eids_batched(graph, eids, from, to));
+
+    if (igraph_is_directed(graph) && !directed) {
+        igraph_vector_t missing, eids2;
+
+        IGRAPH_VECTOR_INIT_FINALLY(&missing, 0);
+        IGRAPH_VECTOR_INIT_FINALLY(&eids2, 0);
+        for (i = 0, k = 0; i < n; i++) {
+            if (VECTOR(*eids)[i] < 0) {
+                igraph_real_t tmp = VECTOR(*from)[i];
+                IGRAPH_CHECK(igraph_vector_push_back(&missing, i));
+                VECTOR(*from)[k] = VECTOR(*to)[i];
+                VECTOR(*to)[k] = tmp;
+                k++;
+            }
+        }
+        if (k > 0) {
+            IGRAPH_CHECK(igraph_vector_resize(from, k));
+            IGRAPH_CHECK(igraph_vector_resize(to, k));
+            IGRAPH_CHECK(igraph_i_get_eids_batched(graph, &eids2, from, to));
+            for (i = 0; i < k; i++) {
+                VECTOR(*eids)[(long int) VECTOR(missing)[i]] = VECTOR(eids2)[i];
+            }
+        }
+        igraph_vector_destroy(&eids2);
+        igraph_vector_destroy(&missing);
+        IGRAPH_FINALLY_CLEAN(2);
+    }
+
+    if (error) {
+        for (i = 0; i < n; i++) {
+            if (VECTOR(*eids)[i] < 0) {
+                IGRAPH_ERROR("Cannot get edge id, no such edge", IGRAPH_EINVAL);
+            }
+        }
+    }
+
+    return 0;
+}
+
 int igraph_get_eids_pairs(const igraph_t *graph, igraph_vector_t *eids,
                           const igraph_vector_t *pairs,
                           igraph_bool_t directed, igraph_bool_t error);
@@ -1201,6 +2179,22 @@ int igraph_get_eids_pairs(const igraph_t *graph, igraph_vector_t *eids,
         IGRAPH_ERROR("Cannot get edge ids, invalid vertex id", IGRAPH_EINVVID);
     }
 
+    if (IGRAPH_I_GET_EIDS_BATCHED(graph, n / 2)) {
+        igraph_vector_t from, to;
+        IGRAPH_VECTOR_INIT_FINALLY(&from, n / 2);
+        IGRAPH_VECTOR_INIT_FINALLY(&to, n / 2);
+        for (i = 0; i < n / 2; i++) {
+            VECTOR(from)[i] = VECTOR(*pairs)[2 * i];
+            VECTOR(to)[i] = VECTOR(*pairs)[2 * i + 1];
+        }
+        IGRAPH_CHECK(igraph_i_get_eids_sorted(graph, eids, &from, &to,
+                                              directed, error));
+        igraph_vector_destroy(&to);
+        igraph_vector_destroy(&from);
+        IGRAPH_FINALLY_CLEAN(2);
+        return 0;
+    }
+
     IGRAPH_CHECK(igraph_vector_resize(eids, n / 2));
 
     if (igraph_is_directed(graph)) {
@@ -1249,6 +2243,22 @@ int igraph_get_eids_path(const igraph_t *graph, igraph_vector_t *eids,
         IGRAPH_ERROR("Cannot get edge ids, invalid vertex id", IGRAPH_EINVVID);
     }
 
+    if (IGRAPH_I_GET_EIDS_BATCHED(graph, n - 1)) {
+        igraph_vector_t from, to;
+        IGRAPH_VECTOR_INIT_FINALLY(&from, n - 1);
+        IGRAPH_VECTOR_INIT_FINALLY(&to, n - 1);
+        for (i = 0; i < n - 1; i++) {
+            VECTOR(from)[i] = VECTOR(*path)[i];
+            VECTOR(to)[i] = VECTOR(*path)[i + 1];
+        }
+        IGRAPH_CHECK(igraph_i_get_eids_sorted(graph, eids, &from, &to,
+                                              directed, error));
+        igraph_vector_destroy(&to);
+        igraph_vector_destroy(&from);
+        IGRAPH_FINALLY_CLEAN(2);
+        return 0;
+    }
+
     IGRAPH_CHECK(igraph_vector_resize(eids, n == 0 ? 0 : n - 1));
 
     if (igraph_is_directed(graph)) {
@@ -1332,8 +2342,16 @@ int igraph_get_eids_path(const igraph_t *graph, igraph_vector_t *eids,
  *        returned for non-connected pairs.
  * \return Error code.
  *
+ * </para><para>
+ * If many edges are queried in a large graph, then the queries are
+ * sorted first and the edges are looked up together, reading the
+ * adjacency list of each vertex only once; the result is the same.
+ *
  * Time complexity: O(n log(d)), where n is the number of queried
- * edges and d is the average degree of the vertices.
+ * edges and d is the average degree of the vertices. For at least
+ * |V|/4 queries in a graph with at least 2^20 edges it is
+ * O(n+|V|+s), where s is the sum of the out-degrees of the queried
+ * vertices.
  *
  * \sa \ref igraph_get_eid() for a single edge, \ref
  * igraph_get_eids_multi() for a version that handles multiple edges
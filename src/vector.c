@@ -102,7 +102,7 @@ int igraph_vector_order2(igraph_vector_t *v) {
 
     igraph_indheap_t heap;
 
-    igraph_indheap_init_array(&heap, VECTOR(*v), igraph_vector_size(v));
+    IGRAPH_CHECK(igraph_indheap_init_array(&heap, VECTOR(*v), igraph_vector_size(v)));
     IGRAPH_FINALLY(igraph_indheap_destroy, &heap);
 
     igraph_vector_clear(v);
@@ -116,6 +116,33 @@ int igraph_vector_order2(igraph_vector_t *v) {
     return 0;
 }
 
+/* Computes the position of the first element of each bucket of a
+   counting sort on the keys in 'v', which are between zero and
+   'nodes'. 'pos' is resized to hold nodes + 1 elements. */
+
+static int igraph_i_vector_order_buckets(const igraph_vector_t *v,
+                                         igraph_vector_long_t *pos,
+                                         long int nodes) {
+    long int i, n = igraph_vector_size(v);
+    long int sum = 0;
+    long int *p;
+
+    IGRAPH_CHECK(igraph_vector_long_resize(pos, nodes + 1));
+    igraph_vector_long_null(pos);
+    p = VECTOR(*pos);
+
+    for (i = 0; i < n; i++) {
+        p[(long int) VECTOR(*v)[i]] += 1;
+    }
+    for (i = 0; i <= nodes; i++) {
+        long int count = p[i];
+        p[i] = sum;
+        sum += count;
+    }
+
+    return 0;
+}
+
 /**
  * \ingroup vector
  * \function igraph_vector_order
@@ -124,6 +151,12 @@ int igraph_vector_order2(igraph_vector_t *v) {
  * </para><para>
  * The smallest element will have order zero, the second smallest
  * order one, etc.
+ *
+ * </para><para>
+ * The elements are sorted by \p v, ties are broken by \p v2, and
+ * elements equal in both keys are listed in decreasing order of
+ * their index. The sort is a two-pass counting sort, so both keys
+ * must be integers between zero and \p nodes.
  * \param v The original \type igraph_vector_t object.
  * \param v2 A secondary key, another \type igraph_vector_t object.
  * \param res An initialized \type igraph_vector_t object, it will be
@@ -133,70 +166,45 @@ int igraph_vector_order2(igraph_vector_t *v) {
  * \return Error code:
  *         \c IGRAPH_ENOMEM: out of memory
  *
- * Time complexity: O()
+ * Time complexity: O(n+nodes), n is the length of \p v.
  */
 
 int igraph_vector_order(const igraph_vector_t* v,
                         const igraph_vector_t *v2,
                         igraph_vector_t* res, igraph_real_t nodes) {
     long int edges = igraph_vector_size(v);
-    igraph_vector_t ptr;
-    igraph_vector_t rad;
-    long int i, j;
+    igraph_vector_long_t pos, tmp;
+    long int *p, *t;
+    long int i;
 
     assert(v != NULL);
     assert(v->stor_begin != NULL);
 
-    IGRAPH_VECTOR_INIT_FINALLY(&ptr, (long int) nodes + 1);
-    IGRAPH_VECTOR_INIT_FINALLY(&rad, edges);
+    IGRAPH_CHECK(igraph_vector_long_init(&pos, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &pos);
+    IGRAPH_CHECK(igraph_vector_long_init(&tmp, edges));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &tmp);
     IGRAPH_CHECK(igraph_vector_resize(res, edges));
-
-    for (i = 0; i < edges; i++) {
-        long int radix = (long int) v2->stor_begin[i];
-        if (VECTOR(ptr)[radix] != 0) {
-            VECTOR(rad)[i] = VECTOR(ptr)[radix];
-        }
-        VECTOR(ptr)[radix] = i + 1;
-    }
-
-    j = 0;
-    for (i = 0; i < nodes + 1; i++) {
-        if (VECTOR(ptr)[i] != 0) {
-            long int next = (long int) VECTOR(ptr)[i] - 1;
-            res->stor_begin[j++] = next;
-            while (VECTOR(rad)[next] != 0) {
-                next = (long int) VECTOR(rad)[next] - 1;
-                res->stor_begin[j++] = next;
-            }
-        }
+    t = VECTOR(tmp);
+
+    /* Sort by the secondary key first. Going backwards puts the
+       elements of each bucket in decreasing index order. */
+    IGRAPH_CHECK(igraph_i_vector_order_buckets(v2, &pos, (long int) nodes));
+    p = VECTOR(pos);
+    for (i = edges - 1; i >= 0; i--) {
+        t[p[(long int) VECTOR(*v2)[i]]++] = i;
     }
 
-    igraph_vector_null(&ptr);
-    igraph_vector_null(&rad);
-
+    /* Then stably by the primary key */
+    IGRAPH_CHECK(igraph_i_vector_order_buckets(v, &pos, (long int) nodes));
+    p = VECTOR(pos);
     for (i = 0; i < edges; i++) {
-        long int edge = (long int) VECTOR(*res)[edges - i - 1];
-        long int radix = (long int) VECTOR(*v)[edge];
-        if (VECTOR(ptr)[radix] != 0) {
-            VECTOR(rad)[edge] = VECTOR(ptr)[radix];
-        }
-        VECTOR(ptr)[radix] = edge + 1;
-    }
-
-    j = 0;
-    for (i = 0; i < nodes + 1; i++) {
-        if (VECTOR(ptr)[i] != 0) {
-            long int next = (long int) VECTOR(ptr)[i] - 1;
-            res->stor_begin[j++] = next;
-            while (VECTOR(rad)[next] != 0) {
-                next = (long int) VECTOR(rad)[next] - 1;
-                res->stor_begin[j++] = next;
-            }
-        }
+        long int edge = t[i];
+        VECTOR(*res)[p[(long int) VECTOR(*v)[edge]]++] = edge;
     }
 
-    igraph_vector_destroy(&ptr);
-    igraph_vector_destroy(&rad);
+    igraph_vector_long_destroy(&tmp);
+    igraph_vector_long_destroy(&pos);
     IGRAPH_FINALLY_CLEAN(2);
 
     return 0;
@@ -205,40 +213,25 @@ int igraph_vector_order(const igraph_vector_t* v,
 int igraph_vector_order1(const igraph_vector_t* v,
                          igraph_vector_t* res, igraph_real_t nodes) {
     long int edges = igraph_vector_size(v);
-    igraph_vector_t ptr;
-    igraph_vector_t rad;
-    long int i, j;
+    igraph_vector_long_t pos;
+    long int *p;
+    long int i;
 
     assert(v != NULL);
     assert(v->stor_begin != NULL);
 
-    IGRAPH_VECTOR_INIT_FINALLY(&ptr, (long int) nodes + 1);
-    IGRAPH_VECTOR_INIT_FINALLY(&rad, edges);
+    IGRAPH_CHECK(igraph_vector_long_init(&pos, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &pos);
     IGRAPH_CHECK(igraph_vector_resize(res, edges));
 
-    for (i = 0; i < edges; i++) {
-        long int radix = (long int) v->stor_begin[i];
-        if (VECTOR(ptr)[radix] != 0) {
-            VECTOR(rad)[i] = VECTOR(ptr)[radix];
-        }
-        VECTOR(ptr)[radix] = i + 1;
+    IGRAPH_CHECK(igraph_i_vector_order_buckets(v, &pos, (long int) nodes));
+    p = VECTOR(pos);
+    for (i = edges - 1; i >= 0; i--) {
+        VECTOR(*res)[p[(long int) VECTOR(*v)[i]]++] = i;
     }
 
-    j = 0;
-    for (i = 0; i < nodes + 1; i++) {
-        if (VECTOR(ptr)[i] != 0) {
-            long int next = (long int) VECTOR(ptr)[i] - 1;
-            res->stor_begin[j++] = next;
-            while (VECTOR(rad)[next] != 0) {
-                next = (long int) VECTOR(rad)[next] - 1;
-                res->stor_begin[j++] = next;
-            }
-        }
-    }
-
-    igraph_vector_destroy(&ptr);
-    igraph_vector_destroy(&rad);
-    IGRAPH_FINALLY_CLEAN(2);
+    igraph_vector_long_destroy(&pos);
+    IGRAPH_FINALLY_CLEAN(1);
 
     return 0;
 }
@@ -247,40 +240,25 @@ int igraph_vector_order1_int(const igraph_vector_t* v,
                              igraph_vector_int_t* res,
                              igraph_real_t nodes) {
     long int edges = igraph_vector_size(v);
-    igraph_vector_t ptr;
-    igraph_vector_t rad;
-    long int i, j;
+    igraph_vector_long_t pos;
+    long int *p;
+    long int i;
 
     assert(v != NULL);
     assert(v->stor_begin != NULL);
 
-    IGRAPH_VECTOR_INIT_FINALLY(&ptr, (long int) nodes + 1);
-    IGRAPH_VECTOR_INIT_FINALLY(&rad, edges);
+    IGRAPH_CHECK(igraph_vector_long_init(&pos, 0));
+    IGRAPH_FINALLY(igraph_vector_long_destroy, &pos);
     IGRAPH_CHECK(igraph_vector_int_resize(res, edges));
 
-    for (i = 0; i < edges; i++) {
-        long int radix = (long int) v->stor_begin[i];
-        if (VECTOR(ptr)[radix] != 0) {
-            VECTOR(rad)[i] = VECTOR(ptr)[radix];
-        }
-        VECTOR(ptr)[radix] = i + 1;
+    IGRAPH_CHECK(igraph_i_vector_order_buckets(v, &pos, (long int) nodes));
+    p = VECTOR(pos);
+    for (i = edges - 1; i >= 0; i--) {
+        VECTOR(*res)[p[(long int) VECTOR(*v)[i]]++] = (int) i;
     }
 
-    j = 0;
-    for (i = 0; i < nodes + 1; i++) {
-        if (VECTOR(ptr)[i] != 0) {
-            long int next = (long int) VECTOR(ptr)[i] - 1;
-            res->stor_begin[j++] = next;
-            while (VECTOR(rad)[next] != 0) {
-                next = (long int) VECTOR(rad)[next] - 1;
-                res->stor_begin[j++] = next;
-            }
-        }
-    }
-
-    igraph_vector_destroy(&ptr);
-    igraph_vector_destroy(&rad);
-    IGRAPH_FINALLY_CLEAN(2);
+    igraph_vector_long_destroy(&pos);
+    IGRAPH_FINALLY_CLEAN(1);
 
     return 0;
 }
@@ -102,13 +102,94 @@ int igraph_bfs(const igraph_t *graph,
                igraph_vector_t *dist, igraph_bfshandler_t *callback,
                void *extra) {
 
+    igraph_lazy_adjlist_t adjlist;
+
+    if (mode != IGRAPH_OUT && mode != IGRAPH_IN &&
+        mode != IGRAPH_ALL) {
+        IGRAPH_ERROR("Invalid mode argument", IGRAPH_EINVMODE);
+    }
+
+    IGRAPH_CHECK(igraph_lazy_adjlist_init(graph, &adjlist, mode, /*simplify=*/ 0));
+    IGRAPH_FINALLY(igraph_lazy_adjlist_destroy, &adjlist);
+
+    IGRAPH_CHECK(igraph_bfs_lazy_adjlist(&adjlist, root, roots, unreachable,
+                                         restricted, order, rank, father,
+                                         pred, succ, dist, callback, extra));
+
+    igraph_lazy_adjlist_destroy(&adjlist);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return 0;
+}
+
+/**
+ * \function igraph_bfs_lazy_adjlist
+ * Breadth-first search on a lazy adjacency list
+ *
+ * The same as \ref igraph_bfs(), but the neighbors of the vertices
+ * are taken from a lazy adjacency list. This makes it possible to
+ * search graphs that are not created explicitly, e.g. the complementer
+ * or the line graph of a graph, see \ref
+ * igraph_lazy_adjlist_init_complementer() and \ref
+ * igraph_lazy_adjlist_init_linegraph(). The neighbor list of each
+ * vertex is released after the vertex was visited, so only the lists
+ * of the vertices in the queue are stored at the same time.
+ *
+ * </para><para>
+ * The vertex ids are those of the adjacency list, e.g. the edge ids
+ * of the original graph for a line graph. The callback receives the
+ * graph of the adjacency list, which is a null pointer for compressed
+ * adjacency lists.
+ * \param al The lazy adjacency list. Its \c mode gives the edges to
+ *        follow.
+ * \param root The id of the root vertex. It is ignored if the \c
+ *        roots argument is not a null pointer.
+ * \param roots Pointer to an initialized vector, or a null
+ *        pointer, see \ref igraph_bfs().
+ * \param unreachable Logical scalar, whether the search should visit
+ *        the vertices that are unreachable from the given root
+ *        node(s).
+ * \param restricted If not a null pointer, then it must be a pointer
+ *        to a vector containing vertex ids. The BFS is carried out
+ *        only on these vertices.
+ * \param order If not null pointer, then the vertex ids are stored
+ *        here, in the same order as they were visited.
+ * \param rank If not a null pointer, then the rank of each vertex is
+ *        stored here.
+ * \param father If not a null pointer, then the id of the father of
+ *        each vertex is stored here.
+ * \param pred If not a null pointer, then the id of vertex that was
+ *        visited before the current one is stored here.
+ * \param succ If not a null pointer, then the id of the vertex that
+ *        was visited after the current one is stored here.
+ * \param dist If not a null pointer, then the distance from the root of
+ *        the current search tree is stored here.
+ * \param callback If not null, then it should be a pointer to a
+ *        function of type \ref igraph_bfshandler_t. This function
+ *        will be called, whenever a new vertex is visited.
+ * \param extra Extra argument to pass to the callback function.
+ * \return Error code.
+ *
+ * Time complexity: O(|V|+|E|), linear in the number of vertices and
+ * edges of the searched graph, plus the time needed to query the
+ * neighbor lists; for the complementer, this is O(|V|^2) in total.
+ */
+
+int igraph_bfs_lazy_adjlist(igraph_lazy_adjlist_t *al,
+                            igraph_integer_t root, const igraph_vector_t *roots,
+                            igraph_bool_t unreachable,
+                            const igraph_vector_t *restricted,
+                            igraph_vector_t *order, igraph_vector_t *rank,
+                            igraph_vector_t *father,
+                            igraph_vector_t *pred, igraph_vector_t *succ,
+                            igraph_vector_t *dist, igraph_bfshandler_t *callback,
+                            void *extra) {
+
     igraph_dqueue_t Q;
-    long int no_of_nodes = igraph_vcount(graph);
+    long int no_of_nodes = al->length;
     long int actroot = 0;
     igraph_vector_char_t added;
 
-    igraph_lazy_adjlist_t adjlist;
-
     long int act_rank = 0;
     long int pred_vec = -1;
 
@@ -135,23 +216,11 @@ int igraph_bfs(const igraph_t *graph,
         }
     }
 
-    if (mode != IGRAPH_OUT && mode != IGRAPH_IN &&
-        mode != IGRAPH_ALL) {
-        IGRAPH_ERROR("Invalid mode argument", IGRAPH_EINVMODE);
-    }
-
-    if (!igraph_is_directed(graph)) {
-        mode = IGRAPH_ALL;
-    }
-
     IGRAPH_CHECK(igraph_vector_char_init(&added, no_of_nodes));
     IGRAPH_FINALLY(igraph_vector_char_destroy, &added);
     IGRAPH_CHECK(igraph_dqueue_init(&Q, 100));
     IGRAPH_FINALLY(igraph_dqueue_destroy, &Q);
 
-    IGRAPH_CHECK(igraph_lazy_adjlist_init(graph, &adjlist, mode, /*simplify=*/ 0));
-    IGRAPH_FINALLY(igraph_lazy_adjlist_destroy, &adjlist);
-
     /* Mark the vertices that are not in the restricted set, as already
        found. Special care must be taken for vertices that are not in
        the restricted set, but are to be used as 'root' vertices. */
@@ -219,9 +288,14 @@ int igraph_bfs(const igraph_t *graph,
             long int actvect = (long int) igraph_dqueue_pop(&Q);
             long int actdist = (long int) igraph_dqueue_pop(&Q);
             long int succ_vec;
-            igraph_vector_t *neis = igraph_lazy_adjlist_get(&adjlist,
+            igraph_vector_t *neis = igraph_lazy_adjlist_get(al,
                                     (igraph_integer_t) actvect);
-            long int i, n = igraph_vector_size(neis);
+            long int i, n;
+
+            if (!neis) {
+                IGRAPH_ERROR("Cannot query neighbors in BFS", IGRAPH_ENOMEM);
+            }
+            n = igraph_vector_size(neis);
 
             if (pred) {
                 VECTOR(*pred)[actvect] = pred_vec;
@@ -247,20 +321,20 @@ int igraph_bfs(const igraph_t *graph,
                     }
                 }
             }
+            igraph_lazy_adjlist_release(al, (igraph_integer_t) actvect);
 
             succ_vec = igraph_dqueue_empty(&Q) ? -1L :
                        (long int) igraph_dqueue_head(&Q);
             if (callback) {
                 igraph_bool_t terminate =
-                    callback(graph, (igraph_integer_t) actvect, (igraph_integer_t)
+                    callback(al->graph, (igraph_integer_t) actvect, (igraph_integer_t)
                              pred_vec, (igraph_integer_t) succ_vec,
                              (igraph_integer_t) act_rank - 1, (igraph_integer_t) actdist,
                              extra);
                 if (terminate) {
-                    igraph_lazy_adjlist_destroy(&adjlist);
                     igraph_dqueue_destroy(&Q);
                     igraph_vector_char_destroy(&added);
-                    IGRAPH_FINALLY_CLEAN(3);
+                    IGRAPH_FINALLY_CLEAN(2);
                     return 0;
                 }
             }
@@ -274,10 +348,9 @@ int igraph_bfs(const igraph_t *graph,
 
     } /* for actroot < no_of_nodes */
 
-    igraph_lazy_adjlist_destroy(&adjlist);
     igraph_dqueue_destroy(&Q);
     igraph_vector_char_destroy(&added);
-    IGRAPH_FINALLY_CLEAN(3);
+    IGRAPH_FINALLY_CLEAN(2);
 
     return 0;
 }